@@ -38,6 +38,8 @@
 #include "common/logging.h"
 #include "common/logging_format_colors.h"
 #include "machine/machineconfig.h"
+#include "machine/memory/cache/cache_sweep.h"
+#include "machine/memorytrace.h"
 #include "msgreport.h"
 #include "reporter.h"
 #include "tracer.h"
@@ -45,10 +47,16 @@
 #include <QCommandLineParser>
 #include <QCoreApplication>
 #include <QFile>
+#include <QRunnable>
 #include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
 #include <cctype>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
 #include <utility>
 
 using namespace machine;
@@ -57,6 +65,15 @@ using namespace std;
 using ae = machine::AccessEffects; // For enum values, type is obvious from
                                    // context.
 
+// Cycles simulated between returns to the event loop
+#define CLI_RUN_BATCH_CYCLES 100000
+
+/** Invalid command line or job configuration, message is shown to the user. */
+class CliError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
 void create_parser(QCommandLineParser &p) {
     p.setApplicationDescription("QtMips CLI machine simulator");
     p.addHelpOption();
@@ -69,9 +86,22 @@ void create_parser(QCommandLineParser &p) {
     p.addOption({ "asm", "Treat provided file argument as assembler source." });
     p.addOption({ "pipelined", "Configure CPU to use five stage pipeline." });
     p.addOption({ "no-delay-slot", "Disable jump delay slot." });
+    p.addOption({ "jit", "Execute hot code of non-pipelined core as native code." });
+    p.addOption({ "mapped-ram", "Back RAM by single host memory mapping." });
     p.addOption({ "hazard-unit",
                   "Specify hazard unit imeplementation [none|stall|forward].",
                   "HUKIND" });
+    p.addOption(
+        { "branch-predictor",
+          "Predict control transfers in fetch stage of pipelined core, "
+          "mispredictions stall the pipeline "
+          "[none|not-taken|bimodal|gshare|tournament][,BITS]. BITS is log2 of "
+          "predictor table size.",
+          "BPKIND" });
+    p.addOption({ "btb-entries", "Branch target buffer entries (0 disables).", "ENTRIES" });
+    p.addOption({ "ras-depth", "Return address stack depth (0 disables).", "DEPTH" });
+    p.addOption(
+        { "mispredict-penalty", "Cycles lost by mispredicted control transfer.", "CYCLES" });
     p.addOption(
         { { "trace-fetch", "tr-fetch" },
           "Trace fetched instruction (for both pipelined and not core)." });
@@ -101,8 +131,44 @@ void create_parser(QCommandLineParser &p) {
         { "dump-cache-stats", "Dump cache statistics at program exit." });
     p.addOption(
         { "dump-cycles", "Dump number of CPU cycles till program end." });
+    p.addOption(
+        { "dump-branch-stats",
+          "Dump branch predictor statistics (total and per instruction) at program exit." });
+    p.addOption(
+        { "profile",
+          "Dump flat profile (cycles, stalls, cache misses and exceptions per "
+          "instruction, most expensive first) at program exit." });
+    p.addOption(
+        { "callgrind",
+          "Write call graph profile (inclusive and exclusive costs of functions) "
+          "in callgrind format to FNAME at program exit.",
+          "FNAME" });
     p.addOption({ "dump-range", "Dump memory range.", "START,LENGTH,FNAME" });
+    p.addOption(
+        { "step-back",
+          "Return CYCLES back in execution history before dumps at program "
+          "exit or trap.",
+          "CYCLES" });
     p.addOption({ "load-range", "Load memory range.", "START,FNAME" });
+    p.addOption(
+        { "check-range",
+          "Compare memory with content of file (same format as for load-range) "
+          "at program end and fail on mismatch.",
+          "START,FNAME" });
+    p.addOption(
+        { "cycle-limit", "Stop and fail simulation after given number of cycles.", "CYCLES" });
+    p.addOption(
+        { "batch",
+          "Run jobs listed in MANIFEST in parallel and print JSON report. Each "
+          "line of the manifest holds whitespace separated arguments of one "
+          "job (quotes and backslash keep spaces in an argument), empty lines "
+          "and lines starting with # are ignored.",
+          "MANIFEST" });
+    p.addOption(
+        { "jobs",
+          "Number of batch jobs simulated in parallel or of threads replaying "
+          "memory trace on cache sweeps (default: CPU count).",
+          "N" });
     p.addOption(
         { "expect-fail",
           "Expect that program causes CPU trap and fail if it doesn't." });
@@ -116,16 +182,71 @@ void create_parser(QCommandLineParser &p) {
     p.addOption(
         { "d-cache",
           "Data cache. Format policy,sets,words_in_blocks,associativity where "
-          "policy is random/lru/lfu",
+          "policy is random/lru/lfu/plru/nru/srrip/brrip",
           "DCACHE" });
     p.addOption(
         { "i-cache",
           "Instruction cache. Format policy,sets,words_in_blocks,associativity "
-          "where policy is random/lru/lfu",
+          "where policy is random/lru/lfu/plru/nru/srrip/brrip",
           "ICACHE" });
+    p.addOption(
+        { "d-cache-prefetch",
+          "Data cache hardware prefetcher. Format kind[,degree[,distance]] "
+          "where kind is none/next-line/stride/stream",
+          "PREFETCH" });
+    p.addOption(
+        { "i-cache-prefetch",
+          "Instruction cache hardware prefetcher, format is the same as for "
+          "d-cache-prefetch.",
+          "PREFETCH" });
+    p.addOption(
+        { "l2-cache",
+          "Unified second level cache shared by instruction and data caches. "
+          "Same format as for d-cache.",
+          "L2CACHE" });
+    p.addOption(
+        { "l3-cache",
+          "Unified third level cache placed between second level cache and "
+          "memory. Same format as for d-cache.",
+          "L3CACHE" });
+    p.addOption({ "l2-time", "Second level cache access time (cycles).", "L2TIME" });
+    p.addOption({ "l3-time", "Third level cache access time (cycles).", "L3TIME" });
+    p.addOption(
+        { "cache-inclusion",
+          "Content relation of shared cache levels to inner levels "
+          "[non-inclusive|inclusive|exclusive].",
+          "INCLUSION" });
+    p.addOption(
+        { "d-cache-sweep",
+          "Evaluate data cache configuration in the same run (or on replayed "
+          "memory trace in parallel) and report its statistics at program "
+          "exit. Same format as for d-cache, numeric component can be range "
+          "MIN-MAX of powers of two. Can be repeated.",
+          "DCACHE" });
+    p.addOption(
+        { "i-cache-sweep",
+          "Evaluate instruction cache configuration in the same run (or on "
+          "replayed memory trace), format is the same as for d-cache-sweep.",
+          "ICACHE" });
+    p.addOption(
+        { "memory-trace",
+          "Record instruction fetches, loads and stores to compact binary "
+          "file which can be replayed on caches without the program. Cannot "
+          "be combined with cache sweeps.",
+          "FNAME" });
+    p.addOption(
+        { "memory-trace-replay",
+          "Replay memory trace recorded by memory-trace on configured caches "
+          "instead of running a program and report cache statistics. Cache "
+          "sweeps are evaluated on the trace by jobs threads.",
+          "FNAME" });
     p.addOption({ "read-time", "Memory read access time (cycles).", "RTIME" });
     p.addOption({ "write-time", "Memory read access time (cycles).", "WTIME" });
     p.addOption({ "burst-time", "Memory read access time (cycles).", "BTIME" });
+    p.addOption(
+        { "memory-stalls",
+          "Stall pipelined core for access time of cache misses and uncached "
+          "memory accesses (otherwise used for statistics only)." });
     p.addOption({ { "serial-in", "serin" },
                   "File connected to the serial port input.",
                   "FNAME" });
@@ -134,24 +255,16 @@ void create_parser(QCommandLineParser &p) {
                   "FNAME" });
 }
 
-void configure_cache(
-    CacheConfig &cacheconf,
-    const QStringList &cachearg,
-    const QString &which) {
-    if (cachearg.empty()) {
-        return;
-    }
+void parse_cache(CacheConfig &cacheconf, const QString &cachearg, const QString &which) {
     cacheconf.set_enabled(true);
-    QStringList pieces = cachearg.at(cachearg.size() - 1).split(",");
+    QStringList pieces = cachearg.split(",");
     if (pieces.size() < 3) {
-        std::cerr << "Parameters for " << which.toLocal8Bit().data()
-                  << " cache incorrect (correct lru,4,2,2,wb)." << std::endl;
-        exit(1);
+        throw CliError(
+            "Parameters for " + which.toStdString()
+            + " cache incorrect (correct lru,4,2,2,wb).");
     }
     if (pieces.at(0).size() < 1) {
-        std::cerr << "Policy for " << which.toLocal8Bit().data()
-                  << " cache is incorrect." << std::endl;
-        exit(1);
+        throw CliError("Policy for " + which.toStdString() + " cache is incorrect.");
     }
     if (!pieces.at(0).at(0).isDigit()) {
         if (pieces.at(0).toLower() == "random") {
@@ -160,26 +273,31 @@ void configure_cache(
             cacheconf.set_replacement_policy(CacheConfig::RP_LRU);
         } else if (pieces.at(0).toLower() == "lfu") {
             cacheconf.set_replacement_policy(CacheConfig::RP_LFU);
+        } else if (pieces.at(0).toLower() == "plru") {
+            cacheconf.set_replacement_policy(CacheConfig::RP_PLRU);
+        } else if (pieces.at(0).toLower() == "nru") {
+            cacheconf.set_replacement_policy(CacheConfig::RP_NRU);
+        } else if (pieces.at(0).toLower() == "srrip") {
+            cacheconf.set_replacement_policy(CacheConfig::RP_SRRIP);
+        } else if (pieces.at(0).toLower() == "brrip") {
+            cacheconf.set_replacement_policy(CacheConfig::RP_BRRIP);
         } else {
-            std::cerr << "Policy for " << which.toLocal8Bit().data()
-                      << " cache is incorrect." << std::endl;
-            exit(1);
+            throw CliError("Policy for " + which.toStdString() + " cache is incorrect.");
         }
         pieces.removeFirst();
     }
     if (pieces.size() < 3) {
-        std::cerr << "Parameters for " << which.toLocal8Bit().data()
-                  << " cache incorrect (correct lru,4,2,2,wb)." << std::endl;
-        exit(1);
+        throw CliError(
+            "Parameters for " + which.toStdString()
+            + " cache incorrect (correct lru,4,2,2,wb).");
     }
     cacheconf.set_set_count(pieces.at(0).toLong());
     cacheconf.set_block_size(pieces.at(1).toLong());
     cacheconf.set_associativity(pieces.at(2).toLong());
     if (cacheconf.set_count() == 0 || cacheconf.block_size() == 0
         || cacheconf.associativity() == 0) {
-        std::cerr << "Parameters for " << which.toLocal8Bit().data()
-                  << " cache cannot have zero component." << std::endl;
-        exit(1);
+        throw CliError(
+            "Parameters for " + which.toStdString() + " cache cannot have zero component.");
     }
     if (pieces.size() > 3) {
         if (pieces.at(3).toLower() == "wb") {
@@ -191,35 +309,164 @@ void configure_cache(
         } else if (pieces.at(3).toLower() == "wta") {
             cacheconf.set_write_policy(CacheConfig::WP_THROUGH_ALLOC);
         } else {
-            std::cerr << "Write policy for " << which.toLocal8Bit().data()
-                      << " cache is incorrect (correct wb/wt/wtna/wta)."
-                      << std::endl;
-            exit(1);
+            throw CliError(
+                "Write policy for " + which.toStdString()
+                + " cache is incorrect (correct wb/wt/wtna/wta).");
         }
     }
 }
 
+void configure_cache(
+    CacheConfig &cacheconf,
+    const QStringList &cachearg,
+    const QString &which) {
+    if (cachearg.empty()) {
+        return;
+    }
+    parse_cache(cacheconf, cachearg.at(cachearg.size() - 1), which);
+}
+
+void configure_prefetch(
+    CacheConfig &cacheconf,
+    const QStringList &prefetcharg,
+    const QString &which) {
+    if (prefetcharg.empty()) {
+        return;
+    }
+    QStringList pieces = prefetcharg.at(prefetcharg.size() - 1).split(",");
+    QString kind = pieces.at(0).toLower();
+    if (kind == "none") {
+        cacheconf.set_prefetcher(CacheConfig::PF_NONE);
+    } else if (kind == "next-line") {
+        cacheconf.set_prefetcher(CacheConfig::PF_NEXT_LINE);
+    } else if (kind == "stride") {
+        cacheconf.set_prefetcher(CacheConfig::PF_STRIDE);
+    } else if (kind == "stream") {
+        cacheconf.set_prefetcher(CacheConfig::PF_STREAM);
+    } else {
+        throw CliError("Prefetcher for " + which.toStdString() + " cache is incorrect.");
+    }
+    if (pieces.size() > 3 || (pieces.size() > 1 && pieces.at(1).toUInt() == 0)
+        || (pieces.size() > 2 && pieces.at(2).toUInt() == 0)) {
+        throw CliError(
+            "Parameters for " + which.toStdString()
+            + " cache prefetcher incorrect (correct stride,2,1).");
+    }
+    if (pieces.size() > 1) {
+        cacheconf.set_prefetch_degree(pieces.at(1).toUInt());
+    }
+    if (pieces.size() > 2) {
+        cacheconf.set_prefetch_distance(pieces.at(2).toUInt());
+    }
+}
+
+std::vector<CacheConfig> configure_cache_sweep(const QStringList &sweeparg, const QString &which) {
+    std::vector<CacheConfig> configs;
+    foreach (QString arg, sweeparg) {
+        // Expand ranges into all combinations of single configurations
+        QStringList specs { "" };
+        foreach (QString piece, arg.split(",")) {
+            QStringList values;
+            int dash = piece.indexOf("-");
+            if (dash > 0) {
+                bool ok1, ok2;
+                unsigned min = piece.mid(0, dash).toUInt(&ok1);
+                unsigned max = piece.mid(dash + 1).toUInt(&ok2);
+                if (!ok1 || !ok2 || min == 0 || min > max) {
+                    throw CliError(
+                        "Range " + piece.toStdString() + " for " + which.toStdString()
+                        + " cache sweep is incorrect.");
+                }
+                for (unsigned val = min; val <= max && val != 0; val <<= 1) {
+                    values.append(QString::number(val));
+                }
+            } else {
+                values.append(piece);
+            }
+            QStringList expanded;
+            foreach (QString spec, specs) {
+                foreach (QString val, values) {
+                    expanded.append(spec.isEmpty() ? val : spec + "," + val);
+                }
+            }
+            specs = expanded;
+        }
+        foreach (QString spec, specs) {
+            CacheConfig cacheconf;
+            parse_cache(cacheconf, spec, which);
+            configs.push_back(cacheconf);
+        }
+    }
+    return configs;
+}
+
+int parse_jobs(QCommandLineParser &p) {
+    int threads = QThread::idealThreadCount();
+    if (p.isSet("jobs")) {
+        bool ok;
+        threads = p.value("jobs").toInt(&ok, 0);
+        if (!ok || threads <= 0) {
+            throw CliError("Invalid number of parallel jobs");
+        }
+    }
+    return threads;
+}
+
 void configure_machine(QCommandLineParser &p, MachineConfig &cc) {
     QStringList pa = p.positionalArguments();
     int siz;
-    if (pa.size() != 1) {
-        std::cerr << "Single ELF file has to be specified" << std::endl;
-        exit(1);
+    if (p.isSet("memory-trace-replay")) {
+        if (!pa.isEmpty()) {
+            throw CliError("Memory trace is replayed without program");
+        }
+    } else {
+        if (pa.size() != 1) {
+            throw CliError("Single ELF file has to be specified");
+        }
+        cc.set_elf(pa[0]);
     }
-    cc.set_elf(pa[0]);
 
     cc.set_delay_slot(!p.isSet("no-delay-slot"));
     cc.set_pipelined(p.isSet("pipelined"));
+    cc.set_jit(p.isSet("jit"));
+    cc.set_mapped_ram(p.isSet("mapped-ram"));
 
     siz = p.values("hazard-unit").size();
     if (siz >= 1) {
         QString hukind = p.values("hazard-unit").at(siz - 1).toLower();
         if (!cc.set_hazard_unit(hukind)) {
-            std::cerr << "Unknown kind of hazard unit specified" << std::endl;
-            exit(1);
+            throw CliError("Unknown kind of hazard unit specified");
         }
     }
 
+    siz = p.values("branch-predictor").size();
+    if (siz >= 1) {
+        QStringList bpspec = p.values("branch-predictor").at(siz - 1).toLower().split(',');
+        if (!cc.set_branch_predictor(bpspec.at(0))) {
+            throw CliError("Unknown kind of branch predictor specified");
+        }
+        if (bpspec.size() > 1) {
+            bool ok;
+            unsigned bits = bpspec.at(1).toUInt(&ok, 0);
+            if (!ok || bpspec.size() > 2) {
+                throw CliError("Invalid branch predictor table size");
+            }
+            cc.set_branch_predictor_bits(bits);
+        }
+    }
+    siz = p.values("btb-entries").size();
+    if (siz >= 1) {
+        cc.set_branch_target_buffer(p.values("btb-entries").at(siz - 1).toUInt());
+    }
+    siz = p.values("ras-depth").size();
+    if (siz >= 1) {
+        cc.set_return_address_stack(p.values("ras-depth").at(siz - 1).toUInt());
+    }
+    siz = p.values("mispredict-penalty").size();
+    if (siz >= 1) {
+        cc.set_branch_mispredict_penalty(p.values("mispredict-penalty").at(siz - 1).toUInt());
+    }
+
     siz = p.values("read-time").size();
     if (siz >= 1) {
         cc.set_memory_access_time_read(
@@ -235,10 +482,38 @@ void configure_machine(QCommandLineParser &p, MachineConfig &cc) {
         cc.set_memory_access_time_burst(
             p.values("burst-time").at(siz - 1).toLong());
     }
+    cc.set_memory_stalls(p.isSet("memory-stalls"));
 
     configure_cache(*cc.access_cache_data(), p.values("d-cache"), "data");
     configure_cache(
         *cc.access_cache_program(), p.values("i-cache"), "instruction");
+    configure_prefetch(*cc.access_cache_data(), p.values("d-cache-prefetch"), "data");
+    configure_prefetch(
+        *cc.access_cache_program(), p.values("i-cache-prefetch"), "instruction");
+    configure_cache(*cc.access_cache_level2(), p.values("l2-cache"), "second level");
+    configure_cache(*cc.access_cache_level3(), p.values("l3-cache"), "third level");
+
+    siz = p.values("l2-time").size();
+    if (siz >= 1) {
+        cc.set_cache_level2_access_time(p.values("l2-time").at(siz - 1).toLong());
+    }
+    siz = p.values("l3-time").size();
+    if (siz >= 1) {
+        cc.set_cache_level3_access_time(p.values("l3-time").at(siz - 1).toLong());
+    }
+    siz = p.values("cache-inclusion").size();
+    if (siz >= 1) {
+        QString inclusion = p.values("cache-inclusion").at(siz - 1).toLower();
+        if (inclusion == "non-inclusive") {
+            cc.set_cache_inclusion(MachineConfig::CI_NON_INCLUSIVE);
+        } else if (inclusion == "inclusive") {
+            cc.set_cache_inclusion(MachineConfig::CI_INCLUSIVE);
+        } else if (inclusion == "exclusive") {
+            cc.set_cache_inclusion(MachineConfig::CI_EXCLUSIVE);
+        } else {
+            throw CliError("Unknown cache inclusion specified");
+        }
+    }
 }
 
 void configure_tracer(QCommandLineParser &p, Tracer &tr) {
@@ -276,9 +551,8 @@ void configure_tracer(QCommandLineParser &p, Tracer &tr) {
             if (res && num <= 32) {
                 tr.reg_gp(num);
             } else {
-                cout << "Unknown register number given for trace-gp: "
-                     << gps[i].toStdString() << endl;
-                exit(1);
+                throw CliError(
+                    "Unknown register number given for trace-gp: " + gps[i].toStdString());
             }
         }
     }
@@ -293,6 +567,58 @@ void configure_tracer(QCommandLineParser &p, Tracer &tr) {
     // TODO
 }
 
+Address parse_range_start(const QString &str, const SymbolTable *symtab) {
+    bool ok = true;
+    Address start;
+    if (str.size() >= 1 && !str.at(0).isDigit() && symtab != nullptr) {
+        SymbolValue _start;
+        ok = symtab->name_to_value(_start, str);
+        start = Address(_start);
+    } else {
+        start = Address(str.toULong(&ok, 0));
+    }
+    if (!ok) {
+        throw CliError("Range start/length specification error.");
+    }
+    return start;
+}
+
+/** Reads words of memory range file (one number per line) used by load and check range. */
+QVector<uint32_t> read_range_file(const QString &fname) {
+    QVector<uint32_t> data;
+    ifstream in;
+    in.open(fname.toLocal8Bit().data(), ios::in);
+    for (std::string line; getline(in, line);) {
+        size_t endpos = line.find_last_not_of(" \t\n");
+        size_t startpos = line.find_first_not_of(" \t\n");
+        size_t idx = 0;
+        if (std::string::npos == endpos) {
+            continue;
+        }
+        line = line.substr(0, endpos + 1);
+        line = line.substr(startpos);
+        uint32_t val = 0;
+        try {
+            val = stoul(line, &idx, 0);
+        } catch (std::logic_error &) {}
+        if (idx != line.size() || idx == 0) {
+            throw CliError("cannot parse load range data.");
+        }
+        data.append(val);
+    }
+    in.close();
+    return data;
+}
+
+unsigned int parse_cycle_limit(QCommandLineParser &p) {
+    bool ok;
+    unsigned int cycles = p.value("cycle-limit").toUInt(&ok, 0);
+    if (!ok || cycles == 0) {
+        throw CliError("Invalid cycle limit");
+    }
+    return cycles;
+}
+
 void configure_reporter(
     QCommandLineParser &p,
     Reporter &r,
@@ -303,9 +629,29 @@ void configure_reporter(
     if (p.isSet("dump-cache-stats")) {
         r.cache_stats();
     }
+    if (p.isSet("dump-branch-stats")) {
+        r.branch_stats();
+    }
+    if (p.isSet("profile")) {
+        r.profile();
+    }
+    if (p.isSet("callgrind")) {
+        r.call_graph(p.value("callgrind"));
+    }
     if (p.isSet("dump-cycles")) {
         r.cycles();
     }
+    if (p.isSet("step-back")) {
+        bool ok;
+        unsigned int cycles = p.value("step-back").toUInt(&ok, 0);
+        if (!ok) {
+            throw CliError("Invalid step back cycles count");
+        }
+        if (p.isSet("mapped-ram")) {
+            throw CliError("Step back is not supported with mapped RAM.");
+        }
+        r.step_back(cycles);
+    }
 
     QStringList fail = p.values("fail-match");
     for (int i = 0; i < fail.size(); i++) {
@@ -317,9 +663,8 @@ void configure_reporter(
             case 'o': reason = Reporter::FR_O; break;
             case 'j': reason = Reporter::FR_J; break;
             default:
-                cout << "Unknown fail condition: " << fail[i].toStdString()[y]
-                     << endl;
-                exit(1);
+                throw CliError(
+                    "Unknown fail condition: " + fail[i].mid(y, 1).toStdString());
             }
             r.expect_fail(reason);
         }
@@ -330,41 +675,42 @@ void configure_reporter(
 
     foreach (QString range_arg, p.values("dump-range")) {
         uint64_t len;
-        bool ok1 = true;
-        bool ok2 = true;
+        bool ok = true;
         QString str;
         int comma1 = range_arg.indexOf(",");
         if (comma1 < 0) {
-            cout << "Range start missing" << endl;
-            exit(1);
+            throw CliError("Range start missing");
         }
         int comma2 = range_arg.indexOf(",", comma1 + 1);
         if (comma2 < 0) {
-            cout << "Range lengt/name missing" << endl;
-            exit(1);
-        }
-        str = range_arg.mid(0, comma1);
-        Address start;
-        if (str.size() >= 1 && !str.at(0).isDigit() && symtab != nullptr) {
-            SymbolValue _start;
-            ok1 = symtab->name_to_value(_start, str);
-            start = Address(_start);
-        } else {
-            start = Address(str.toULong(&ok1, 0));
+            throw CliError("Range lengt/name missing");
         }
+        Address start = parse_range_start(range_arg.mid(0, comma1), symtab);
         str = range_arg.mid(comma1 + 1, comma2 - comma1 - 1);
         if (str.size() >= 1 && !str.at(0).isDigit() && symtab != nullptr) {
-            ok2 = symtab->name_to_value(len, str);
+            ok = symtab->name_to_value(len, str);
         } else {
-            len = str.toULong(&ok2, 0);
+            len = str.toULong(&ok, 0);
         }
-        if (!ok1 || !ok2) {
-            cout << "Range start/length specification error." << endl;
-            exit(1);
+        if (!ok) {
+            throw CliError("Range start/length specification error.");
         }
         r.add_dump_range(start, len, range_arg.mid(comma2 + 1));
     }
 
+    foreach (QString range_arg, p.values("check-range")) {
+        int comma1 = range_arg.indexOf(",");
+        if (comma1 < 0) {
+            throw CliError("Range start missing");
+        }
+        Address start = parse_range_start(range_arg.mid(0, comma1), symtab);
+        r.add_check_range(start, read_range_file(range_arg.mid(comma1 + 1)));
+    }
+
+    if (p.isSet("cycle-limit")) {
+        r.cycle_limit(parse_cycle_limit(p));
+    }
+
     // TODO
 }
 
@@ -391,8 +737,7 @@ void configure_serial_port(QCommandLineParser &p, SerialPort *ser_port) {
             }
         }
         if (!ser_in->open(mode)) {
-            cout << "Serial port input file cannot be open for read." << endl;
-            exit(1);
+            throw CliError("Serial port input file cannot be open for read.");
         }
     }
 
@@ -402,9 +747,7 @@ void configure_serial_port(QCommandLineParser &p, SerialPort *ser_port) {
             auto *qf = new QFile(p.values("serial-out").at(siz - 1));
             ser_out = new CharIOHandler(qf, ser_port);
             if (!ser_out->open(QFile::WriteOnly)) {
-                cout << "Serial port output file cannot be open for write."
-                     << endl;
-                exit(1);
+                throw CliError("Serial port output file cannot be open for write.");
             }
         }
     }
@@ -430,50 +773,15 @@ void configure_serial_port(QCommandLineParser &p, SerialPort *ser_port) {
 
 void load_ranges(Machine &machine, const QStringList &ranges) {
     foreach (QString range_arg, ranges) {
-        bool ok = true;
-        QString str;
         int comma1 = range_arg.indexOf(",");
         if (comma1 < 0) {
-            cout << "Range start missing" << endl;
-            exit(1);
-        }
-        str = range_arg.mid(0, comma1);
-        Address start;
-        if (str.size() >= 1 && !str.at(0).isDigit()
-            && machine.symbol_table() != nullptr) {
-            SymbolValue _start;
-            ok = machine.symbol_table()->name_to_value(_start, str);
-            start = Address(_start);
-        } else {
-            start = Address(str.toULong(&ok, 0));
+            throw CliError("Range start missing");
         }
-        if (!ok) {
-            cout << "Range start/length specification error." << endl;
-            exit(1);
-        }
-        ifstream in;
-        uint32_t val;
-        Address addr = start;
-        in.open(range_arg.mid(comma1 + 1).toLocal8Bit().data(), ios::in);
-        start = start & ~3;
-        for (std::string line; getline(in, line);) {
-            size_t endpos = line.find_last_not_of(" \t\n");
-            size_t startpos = line.find_first_not_of(" \t\n");
-            size_t idx;
-            if (std::string::npos == endpos) {
-                continue;
-            }
-            line = line.substr(0, endpos + 1);
-            line = line.substr(startpos);
-            val = stoul(line, &idx, 0);
-            if (idx != line.size()) {
-                cout << "cannot parse load range data." << endl;
-                exit(1);
-            }
+        Address addr = parse_range_start(range_arg.mid(0, comma1), machine.symbol_table());
+        for (uint32_t val : read_range_file(range_arg.mid(comma1 + 1))) {
             machine.memory_data_bus_rw()->write_u32(addr, val, ae::INTERNAL);
             addr += 4;
         }
-        in.close();
     }
 }
 
@@ -498,39 +806,306 @@ bool assemble(Machine &machine, MsgReport &msgrep, QString filename) {
     return sasm.finish();
 }
 
-int main(int argc, char *argv[]) {
-    QCoreApplication app(argc, argv);
-    QCoreApplication::setApplicationName("cli");
-    QCoreApplication::setApplicationVersion("0.8.0");
-    set_default_log_pattern();
+/**
+ * Machine with its tracer and reporter configured from parsed arguments.
+ * Used directly by single program run and by each batch job.
+ */
+struct Simulation {
+    // Fed by machine caches, therefore released after the machine
+    std::unique_ptr<CacheSweep> program_sweep;
+    std::unique_ptr<CacheSweep> data_sweep;
+    std::unique_ptr<MemoryTraceWriter> memory_trace;
+    std::unique_ptr<Machine> machine;
+    std::unique_ptr<Tracer> tracer;
+    std::unique_ptr<Reporter> reporter;
+    unsigned int cycle_limit = 0;
+    // Memory trace replayed on caches instead of program run (when not empty)
+    QString memory_trace_replay;
+    // Sweeps evaluated in parallel on replayed memory trace
+    struct ReplaySweep {
+        QString name;
+        std::vector<CacheConfig> configs;
+        bool program;
+    };
+    std::vector<ReplaySweep> replay_sweeps;
+    int replay_threads = 1;
 
-    QCommandLineParser p;
-    create_parser(p);
-    p.process(app);
+    Simulation(QCommandLineParser &p, QCoreApplication *app, ostream &out);
+    // Runs synchronously (without event loop) till the reporter finishes
+    void run();
+};
 
+Simulation::Simulation(QCommandLineParser &p, QCoreApplication *app, ostream &out) {
     bool asm_source = p.isSet("asm");
+    memory_trace_replay = p.value("memory-trace-replay");
+    bool program = memory_trace_replay.isEmpty();
 
     MachineConfig cc;
     configure_machine(p, cc);
-    Machine machine(cc, !asm_source, !asm_source);
+    if (p.isSet("cycle-limit")) {
+        cycle_limit = parse_cycle_limit(p);
+    }
+    machine.reset(new Machine(cc, program && !asm_source, program && !asm_source));
 
-    Tracer tr(&machine);
-    configure_tracer(p, tr);
+    tracer.reset(new Tracer(machine.get(), out));
+    configure_tracer(p, *tracer);
 
-    Reporter r(&app, &machine);
-    configure_reporter(p, r, machine.symbol_table());
+    reporter.reset(new Reporter(app, machine.get(), out));
+    configure_reporter(p, *reporter, machine->symbol_table());
+    if (!program) {
+        reporter->cache_stats();
+    }
 
-    configure_serial_port(p, machine.serial_port());
+    std::vector<CacheConfig> sweep
+        = configure_cache_sweep(p.values("i-cache-sweep"), "instruction");
+    if (!program) {
+        // Trace file is read by each sweep replay thread on its own
+        replay_threads = parse_jobs(p);
+        if (!sweep.empty()) {
+            replay_sweeps.push_back({ "i-cache", sweep, true });
+        }
+        sweep = configure_cache_sweep(p.values("d-cache-sweep"), "data");
+        if (!sweep.empty()) {
+            replay_sweeps.push_back({ "d-cache", sweep, false });
+        }
+        if (p.isSet("memory-trace")) {
+            throw CliError("Memory trace cannot be recorded during its replay.");
+        }
+        // Replayed accesses carry no data, keep them away from serial port files
+        return;
+    }
+    if (!sweep.empty()) {
+        program_sweep.reset(new CacheSweep(
+            sweep, cc.memory_access_time_read(), cc.memory_access_time_write(),
+            cc.memory_access_time_burst()));
+        machine->cache_program_rw()->set_access_sink(program_sweep.get());
+        reporter->add_cache_sweep("i-cache", program_sweep.get());
+    }
+    sweep = configure_cache_sweep(p.values("d-cache-sweep"), "data");
+    if (!sweep.empty()) {
+        data_sweep.reset(new CacheSweep(
+            sweep, cc.memory_access_time_read(), cc.memory_access_time_write(),
+            cc.memory_access_time_burst()));
+        machine->cache_data_rw()->set_access_sink(data_sweep.get());
+        reporter->add_cache_sweep("d-cache", data_sweep.get());
+    }
+    if (p.isSet("memory-trace")) {
+        if (program_sweep || data_sweep) {
+            throw CliError("Memory trace cannot be combined with cache sweep.");
+        }
+        memory_trace.reset(new MemoryTraceWriter(p.value("memory-trace"), machine->core()));
+        memory_trace->attach(machine->cache_program_rw(), machine->cache_data_rw());
+    }
+
+    configure_serial_port(p, machine->serial_port());
 
     if (asm_source) {
-        MsgReport msgrep(&app);
-        if (!assemble(machine, msgrep, p.positionalArguments()[0])) {
-            exit(1);
+        MsgReport msgrep(app, out);
+        if (!assemble(*machine, msgrep, p.positionalArguments()[0])) {
+            throw CliError("Assembly of " + p.positionalArguments()[0].toStdString() + " failed.");
         }
     }
 
-    load_ranges(machine, p.values("load-range"));
+    load_ranges(*machine, p.values("load-range"));
+}
 
-    machine.play();
-    return QCoreApplication::exec();
+void Simulation::run() {
+    if (!memory_trace_replay.isEmpty()) {
+        MemoryTraceReader trace(memory_trace_replay);
+        uint64_t records = trace.replay(machine->cache_program_rw(), machine->cache_data_rw());
+        const MachineConfig &cc = machine->config();
+        for (const ReplaySweep &sweep : replay_sweeps) {
+            reporter->add_cache_sweep(
+                sweep.name,
+                CacheSweep::replay_parallel(
+                    sweep.configs, memory_trace_replay, sweep.program, replay_threads,
+                    cc.memory_access_time_read(), cc.memory_access_time_write(),
+                    cc.memory_access_time_burst()));
+        }
+        reporter->memory_trace_replayed(records);
+        return;
+    }
+    while (!reporter->finished()) {
+        unsigned int cycles = CLI_RUN_BATCH_CYCLES;
+        if (cycle_limit != 0) {
+            cycles = std::min(cycles, cycle_limit - machine->core()->get_cycle_count());
+        }
+        if (machine->run_for(cycles) == 0 && !reporter->finished()) {
+            throw CliError("Simulation cannot continue.");
+        }
+    }
+}
+
+/** One line of the batch manifest, simulated in a thread pool worker. */
+class BatchJob : public QRunnable {
+public:
+    BatchJob(const QStringList &args, unsigned int cycle_limit, Reporter::BatchResult &result)
+        : args(args)
+        , cycle_limit(cycle_limit)
+        , result(result) {}
+
+    void run() override {
+        ostringstream out;
+        QCommandLineParser p;
+        create_parser(p);
+        result.args = args;
+        result.outcome = "error";
+        result.exit_code = 1;
+        result.cycles = 0;
+        result.stalls = 0;
+        // The first argument is skipped by the parser as the program name
+        if (!p.parse(QStringList(QCoreApplication::applicationName()) + args)) {
+            out << p.errorText().toStdString() << endl;
+        } else {
+            try {
+                Simulation sim(p, nullptr, out);
+                if (sim.cycle_limit == 0 && cycle_limit != 0) {
+                    sim.cycle_limit = cycle_limit;
+                    sim.reporter->cycle_limit(cycle_limit);
+                }
+                sim.run();
+                result.outcome = sim.reporter->outcome();
+                result.exit_code = sim.reporter->exit_code();
+                result.cycles = sim.machine->core()->get_cycle_count();
+                result.stalls = sim.machine->core()->get_stall_count();
+            } catch (CliError &e) {
+                out << e.what() << endl;
+            } catch (SimulatorException &e) {
+                out << e.msg(false).toStdString() << endl;
+            } catch (std::exception &e) {
+                // Exception escaping QRunnable::run would abort whole batch
+                out << "Internal error: " << e.what() << endl;
+            }
+        }
+        result.output = QString::fromStdString(out.str());
+    }
+
+private:
+    QStringList args;
+    unsigned int cycle_limit;
+    Reporter::BatchResult &result;
+};
+
+/**
+ * Splits manifest line to arguments. Whitespace separates arguments unless
+ * it is quoted by single or double quotes or escaped by backslash.
+ */
+QStringList split_batch_line(const QString &line, int line_number) {
+    QStringList args;
+    QString arg;
+    bool in_arg = false;
+    QChar quote; // Null when outside of quotes
+    for (int i = 0; i < line.size(); i++) {
+        QChar ch = line.at(i);
+        if (ch == '\\' && quote != QChar('\'')) {
+            if (++i >= line.size()) {
+                break;
+            }
+            arg += line.at(i);
+            in_arg = true;
+        } else if (!quote.isNull()) {
+            if (ch == quote) {
+                quote = QChar();
+            } else {
+                arg += ch;
+            }
+        } else if (ch == '"' || ch == '\'') {
+            quote = ch;
+            in_arg = true;
+        } else if (ch.isSpace()) {
+            if (in_arg) {
+                args.append(arg);
+                arg.clear();
+                in_arg = false;
+            }
+        } else {
+            arg += ch;
+            in_arg = true;
+        }
+    }
+    if (!quote.isNull()) {
+        throw CliError(
+            "Unterminated quote on line " + std::to_string(line_number) + " of batch manifest.");
+    }
+    if (in_arg) {
+        args.append(arg);
+    }
+    return args;
+}
+
+int run_batch(QCommandLineParser &p) {
+    QFile manifest(p.value("batch"));
+    if (!manifest.open(QFile::ReadOnly | QFile::Text)) {
+        throw CliError("Batch manifest cannot be open for read.");
+    }
+    QVector<QStringList> jobs;
+    QTextStream in(&manifest);
+    int line_number = 0;
+    while (!in.atEnd()) {
+        QString line = in.readLine().trimmed();
+        line_number++;
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+        jobs.append(split_batch_line(line, line_number));
+    }
+
+    int threads = parse_jobs(p);
+    unsigned int cycle_limit = 0;
+    if (p.isSet("cycle-limit")) {
+        cycle_limit = parse_cycle_limit(p);
+    }
+
+    QVector<Reporter::BatchResult> results(jobs.size());
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+    for (int i = 0; i < jobs.size(); i++) {
+        pool.start(new BatchJob(jobs[i], cycle_limit, results[i]));
+    }
+    pool.waitForDone();
+
+    Reporter::batch_report(cout, results);
+    for (const Reporter::BatchResult &res : results) {
+        if (res.exit_code != 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("cli");
+    QCoreApplication::setApplicationVersion("0.8.0");
+    set_default_log_pattern();
+
+    QCommandLineParser p;
+    create_parser(p);
+    p.process(app);
+
+    try {
+        if (p.isSet("batch")) {
+            return run_batch(p);
+        }
+        if (p.isSet("memory-trace-replay")) {
+            Simulation sim(p, nullptr, cout);
+            sim.run();
+            return sim.reporter->exit_code();
+        }
+
+        Simulation sim(p, &app, cout);
+        unsigned int batch_cycles = CLI_RUN_BATCH_CYCLES;
+        if (sim.cycle_limit != 0) {
+            batch_cycles = std::min(batch_cycles, sim.cycle_limit);
+        }
+        sim.machine->set_run_batch(batch_cycles);
+        sim.machine->play();
+        return QCoreApplication::exec();
+    } catch (CliError &e) {
+        cerr << e.what() << endl;
+        return 1;
+    } catch (SimulatorException &e) {
+        cerr << e.msg(false).toStdString() << endl;
+        return 1;
+    }
 }
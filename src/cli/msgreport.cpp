@@ -39,7 +39,7 @@
 
 using namespace std;
 
-MsgReport::MsgReport(QCoreApplication *app) : Super(app) {
+MsgReport::MsgReport(QCoreApplication *app, ostream &out) : Super(app), out(out) {
 }
 
 void MsgReport::report_message(
@@ -59,15 +59,15 @@ void MsgReport::report_message(
     default: return;
     }
 
-    cout << file.toLocal8Bit().data() << ":";
+    out << file.toLocal8Bit().data() << ":";
     if (line != 0) {
-        cout << line << ":";
+        out << line << ":";
     }
     if (column != 0) {
-        cout << column << ":";
+        out << column << ":";
     }
 
-    cout << typestr.toLocal8Bit().data() << ":";
-    cout << text.toLocal8Bit().data();
-    cout << endl;
+    out << typestr.toLocal8Bit().data() << ":";
+    out << text.toLocal8Bit().data();
+    out << endl;
 }
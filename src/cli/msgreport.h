@@ -42,6 +42,7 @@
 #include <QObject>
 #include <QString>
 #include <QVector>
+#include <iostream>
 
 class MsgReport : public QObject {
     Q_OBJECT
@@ -49,16 +50,19 @@ class MsgReport : public QObject {
     using Super = QObject;
 
 public:
-    MsgReport(QCoreApplication *app);
+    MsgReport(QCoreApplication *app, std::ostream &out = std::cout);
 
 public slots:
-    static void report_message(
+    void report_message(
         messagetype::Type type,
         const QString &file,
         int line,
         int column,
         const QString &text,
         const QString &hint);
+
+private:
+    std::ostream &out;
 };
 
 #endif // MSGREPORT_H
@@ -35,6 +35,10 @@
 
 #include "reporter.h"
 
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -44,7 +48,9 @@
 using namespace machine;
 using namespace std;
 
-Reporter::Reporter(QCoreApplication *app, Machine *machine) : QObject() {
+Reporter::Reporter(QCoreApplication *app, Machine *machine, ostream &out)
+    : QObject()
+    , out(out) {
     this->app = app;
     this->machine = machine;
 
@@ -53,11 +59,18 @@ Reporter::Reporter(QCoreApplication *app, Machine *machine) : QObject() {
     connect(
         machine->core(), &Core::stop_on_exception_reached, this,
         &Reporter::machine_exception_reached);
+    connect(machine, &Machine::post_tick, this, &Reporter::machine_post_tick);
 
     e_regs = false;
     e_cache_stats = false;
+    e_branch_stats = false;
+    e_profile = false;
     e_cycles = false;
+    e_step_back = 0;
     e_fail = (enum FailReason)0;
+    e_cycle_limit = 0;
+    e_finished = false;
+    e_exit_code = 0;
 }
 
 void Reporter::regs() {
@@ -68,10 +81,29 @@ void Reporter::cache_stats() {
     e_cache_stats = true;
 }
 
+void Reporter::branch_stats() {
+    e_branch_stats = true;
+}
+
+void Reporter::profile() {
+    e_profile = true;
+    machine->set_profiling(true);
+}
+
+void Reporter::call_graph(const QString &path_to_write) {
+    e_callgrind = path_to_write;
+    machine->set_call_graph(true);
+}
+
 void Reporter::cycles() {
     e_cycles = true;
 }
 
+void Reporter::step_back(unsigned int cycles) {
+    e_step_back = cycles;
+    machine->set_history(HISTORY_INTERVAL_DEFAULT, HISTORY_SNAPSHOTS_DEFAULT);
+}
+
 void Reporter::expect_fail(enum FailReason reason) {
     e_fail = (enum FailReason)(e_fail | reason);
 }
@@ -83,14 +115,58 @@ void Reporter::add_dump_range(
     dump_ranges.append({ start, len, path_to_write });
 }
 
+void Reporter::add_check_range(Address start, const QVector<uint32_t> &expected) {
+    check_ranges.append({ start, expected });
+}
+
+void Reporter::add_cache_sweep(const QString &name, const CacheSweep *sweep) {
+    cache_sweeps.append({ name, sweep, {} });
+}
+
+void Reporter::add_cache_sweep(const QString &name, std::vector<CacheSweep::Result> results) {
+    cache_sweeps.append({ name, nullptr, std::move(results) });
+}
+
+void Reporter::cycle_limit(unsigned int cycles) {
+    e_cycle_limit = cycles;
+}
+
+bool Reporter::finished() const {
+    return e_finished;
+}
+
+const QString &Reporter::outcome() const {
+    return e_outcome;
+}
+
+int Reporter::exit_code() const {
+    return e_exit_code;
+}
+
+void Reporter::finish(const QString &outcome, int code) {
+    e_finished = true;
+    e_outcome = outcome;
+    e_exit_code = code;
+    if (app != nullptr) {
+        QCoreApplication::exit(code);
+    }
+}
+
 void Reporter::machine_exit() {
+    rewind();
     report();
+    bool passed = check();
     if (e_fail != 0) {
-        cout << "Machine was expected to fail but it didn't." << endl;
-        QCoreApplication::exit(1);
-    } else {
-        QCoreApplication::exit();
+        out << "Machine was expected to fail but it didn't." << endl;
+        passed = false;
     }
+    finish("exit", passed ? 0 : 1);
+}
+
+void Reporter::memory_trace_replayed(uint64_t records) {
+    out << "memory-trace:records:" << records << endl;
+    report();
+    finish("exit", check() ? 0 : 1);
 }
 
 void Reporter::machine_exception_reached() {
@@ -98,42 +174,55 @@ void Reporter::machine_exception_reached() {
     excause = machine->get_exception_cause();
     switch (excause) {
     case EXCAUSE_NONE:
-        cout << "Machine stopped on NONE exception." << endl;
+        out << "Machine stopped on NONE exception." << endl;
         break;
     case EXCAUSE_INT:
-        cout << "Machine stopped on INT exception." << endl;
+        out << "Machine stopped on INT exception." << endl;
         break;
     case EXCAUSE_ADDRL:
-        cout << "Machine stopped on ADDRL exception." << endl;
+        out << "Machine stopped on ADDRL exception." << endl;
         break;
     case EXCAUSE_ADDRS:
-        cout << "Machine stopped on ADDRS exception." << endl;
+        out << "Machine stopped on ADDRS exception." << endl;
         break;
     case EXCAUSE_IBUS:
-        cout << "Machine stopped on IBUS exception." << endl;
+        out << "Machine stopped on IBUS exception." << endl;
         break;
     case EXCAUSE_DBUS:
-        cout << "Machine stopped on DBUS exception." << endl;
+        out << "Machine stopped on DBUS exception." << endl;
         break;
     case EXCAUSE_SYSCALL:
-        cout << "Machine stopped on SYSCALL exception." << endl;
+        out << "Machine stopped on SYSCALL exception." << endl;
         break;
     case EXCAUSE_OVERFLOW:
-        cout << "Machine stopped on OVERFLOW exception." << endl;
+        out << "Machine stopped on OVERFLOW exception." << endl;
         break;
     case EXCAUSE_TRAP:
-        cout << "Machine stopped on TRAP exception." << endl;
+        out << "Machine stopped on TRAP exception." << endl;
         break;
     case EXCAUSE_HWBREAK:
-        cout << "Machine stopped on HWBREAK exception." << endl;
+        out << "Machine stopped on HWBREAK exception." << endl;
         break;
     default: break;
     }
     report();
-    QCoreApplication::exit();
+    finish("exception", check() ? 0 : 1);
+}
+
+void Reporter::machine_post_tick() {
+    if (e_finished || e_cycle_limit == 0
+        || machine->core()->get_cycle_count() < e_cycle_limit) {
+        return;
+    }
+    machine->pause();
+    out << "Cycle limit reached." << endl;
+    report();
+    check();
+    finish("cycle-limit", 1);
 }
 
 void Reporter::machine_trap(SimulatorException &e) {
+    rewind();
     report();
 
     bool expected = false;
@@ -148,8 +237,20 @@ void Reporter::machine_trap(SimulatorException &e) {
         expected = e_fail & FR_J;
     }
 
-    cout << "Machine trapped: " << e.msg(false).toStdString() << endl;
-    QCoreApplication::exit(expected ? 0 : 1);
+    out << "Machine trapped: " << e.msg(false).toStdString() << endl;
+    bool passed = check();
+    finish("trap", expected && passed ? 0 : 1);
+}
+
+void Reporter::rewind() {
+    if (e_step_back == 0) {
+        return;
+    }
+    if (machine->step_back(e_step_back)) {
+        out << "Stepped back to cycle " << machine->core()->get_cycle_count() << "." << endl;
+    } else {
+        out << "Execution history is not available." << endl;
+    }
 }
 
 static void out_hex(ostream &out, uint64_t val, int digits) {
@@ -161,85 +262,207 @@ static void out_hex(ostream &out, uint64_t val, int digits) {
     out.flags(saveflg);
 }
 
+// Cache configuration in the format of command line options
+static string cache_spec(const CacheConfig &config) {
+    static const char *const policies[]
+        = { "random", "lru", "lfu", "plru", "nru", "srrip", "brrip" };
+    static const char *const write_policies[] = { "wtna", "wta", "wb" };
+    return string(policies[config.replacement_policy()]) + ","
+           + to_string(config.set_count()) + "," + to_string(config.block_size()) + ","
+           + to_string(config.associativity()) + ","
+           + write_policies[config.write_policy()];
+}
+
+void Reporter::report_profile() {
+    // Flat profile, instructions which took most cycles first
+    std::vector<Profiler::Sample> samples = machine->profiler()->samples();
+    const auto cost = [](const Profiler::Sample &s) {
+        return (uint64_t)s.counters.executed + s.counters.stall_cycles;
+    };
+    std::stable_sort(
+        samples.begin(), samples.end(),
+        [&cost](const Profiler::Sample &a, const Profiler::Sample &b) {
+            return cost(a) > cost(b);
+        });
+    uint64_t total = 0;
+    for (const auto &s : samples) {
+        total += cost(s);
+    }
+    const SymbolTable *symtab = machine->symbol_table();
+    out << "Profile report:" << endl;
+    out << "profile:cycles:" << total << endl;
+    for (const auto &s : samples) {
+        QString name;
+        SymbolValue offset = 0;
+        if (symtab != nullptr
+            && symtab->location_to_name(name, offset, s.pc.get_raw()) && offset != 0) {
+            name += QString("+0x%1").arg(offset, 0, 16);
+        }
+        out << "profile:0x";
+        out_hex(out, s.pc.get_raw(), 8);
+        out << ":" << name.toStdString() << ":cycles:" << cost(s) << ":percent:"
+            << (total != 0 ? 100.0 * cost(s) / total : 0.0)
+            << ":executed:" << s.counters.executed
+            << ":stall-cycles:" << s.counters.stall_cycles
+            << ":i-cache-misses:" << s.counters.icache_misses
+            << ":d-cache-misses:" << s.counters.dcache_misses
+            << ":exceptions:" << s.counters.exceptions << endl;
+    }
+}
+
 void Reporter::report() {
-    cout << dec;
+    out << dec;
     if (e_regs) {
-        cout << "Machine state report:" << endl;
-        cout << "PC:0x";
-        out_hex(cout, machine->registers()->read_pc().get_raw(), 8);
-        cout << endl;
+        out << "Machine state report:" << endl;
+        out << "PC:0x";
+        out_hex(out, machine->registers()->read_pc().get_raw(), 8);
+        out << endl;
         for (int i = 0; i < 32; i++) {
-            cout << "R" << i << ":0x";
-            out_hex(cout, machine->registers()->read_gp(i).as_u64(), 8);
+            out << "R" << i << ":0x";
+            out_hex(out, machine->registers()->read_gp(i).as_u64(), 8);
             if (i != 31) {
-                cout << " ";
+                out << " ";
             } else {
-                cout << endl;
+                out << endl;
             }
         }
-        cout << "HI:0x";
-        out_hex(cout, machine->registers()->read_hi_lo(true).as_u64(), 8);
-        cout << " LO:0x";
-        out_hex(cout, machine->registers()->read_hi_lo(false).as_u64(), 8);
-        cout << endl;
+        out << "HI:0x";
+        out_hex(out, machine->registers()->read_hi_lo(true).as_u64(), 8);
+        out << " LO:0x";
+        out_hex(out, machine->registers()->read_hi_lo(false).as_u64(), 8);
+        out << endl;
         for (int i = 1; i < Cop0State::COP0REGS_CNT; i++) {
-            cout << Cop0State::cop0reg_name((Cop0State::Cop0Registers)i)
+            out << Cop0State::cop0reg_name((Cop0State::Cop0Registers)i)
                         .toLocal8Bit()
                         .data()
                  << ":0x";
             out_hex(
-                cout,
+                out,
                 machine->cop0state()->read_cop0reg((Cop0State::Cop0Registers)i),
                 8);
             if (i != Cop0State::COP0REGS_CNT - 1) {
-                cout << " ";
+                out << " ";
             } else {
-                cout << endl;
+                out << endl;
             }
         }
     }
     if (e_cache_stats) {
-        cout << "Cache statistics report:" << endl;
-        cout << "i-cache:reads:" << machine->cache_program()->get_read_count()
+        // Prefetch statistics are reported only for caches with prefetcher
+        const auto report_prefetch = [this](const char *name, const Cache *cache) {
+            if (cache->get_config().prefetcher() == CacheConfig::PF_NONE) {
+                return;
+            }
+            out << name << ":prefetches:" << cache->get_prefetch_count() << endl;
+            out << name << ":prefetch-accuracy:" << cache->get_prefetch_accuracy() << endl;
+            out << name << ":prefetch-coverage:" << cache->get_prefetch_coverage() << endl;
+            out << name << ":prefetch-pollution:" << cache->get_prefetch_pollution() << endl;
+        };
+        out << "Cache statistics report:" << endl;
+        out << "i-cache:reads:" << machine->cache_program()->get_read_count()
              << endl;
-        cout << "i-cache:hit:" << machine->cache_program()->get_hit_count()
+        out << "i-cache:hit:" << machine->cache_program()->get_hit_count()
              << endl;
-        cout << "i-cache:miss:" << machine->cache_program()->get_miss_count()
+        out << "i-cache:miss:" << machine->cache_program()->get_miss_count()
              << endl;
-        cout << "i-cache:hit-rate:" << machine->cache_program()->get_hit_rate()
+        out << "i-cache:hit-rate:" << machine->cache_program()->get_hit_rate()
              << endl;
-        cout << "i-cache:stalled-cycles:"
+        out << "i-cache:stalled-cycles:"
              << machine->cache_program()->get_stall_count() << endl;
-        cout << "i-cache:improved-speed:"
+        out << "i-cache:improved-speed:"
              << machine->cache_program()->get_speed_improvement() << endl;
-        cout << "d-cache:reads:" << machine->cache_data()->get_read_count()
+        report_prefetch("i-cache", machine->cache_program());
+        out << "d-cache:reads:" << machine->cache_data()->get_read_count()
              << endl;
-        cout << "d-cache:writes:" << machine->cache_data()->get_write_count()
+        out << "d-cache:writes:" << machine->cache_data()->get_write_count()
              << endl;
-        cout << "d-cache:hit:" << machine->cache_data()->get_hit_count()
+        out << "d-cache:hit:" << machine->cache_data()->get_hit_count()
              << endl;
-        cout << "d-cache:miss:" << machine->cache_data()->get_miss_count()
+        out << "d-cache:miss:" << machine->cache_data()->get_miss_count()
              << endl;
-        cout << "d-cache:hit-rate:" << machine->cache_data()->get_hit_rate()
+        out << "d-cache:hit-rate:" << machine->cache_data()->get_hit_rate()
              << endl;
-        cout << "d-cache:stalled-cycles:"
+        out << "d-cache:stalled-cycles:"
              << machine->cache_data()->get_stall_count() << endl;
-        cout << "d-cache:improved-speed:"
+        out << "d-cache:improved-speed:"
              << machine->cache_data()->get_speed_improvement() << endl;
+        report_prefetch("d-cache", machine->cache_data());
+        const struct {
+            const char *name;
+            const Cache *cache;
+        } levels[] = { { "l2-cache", machine->cache_level2() },
+                       { "l3-cache", machine->cache_level3() } };
+        for (const auto &level : levels) {
+            if (!level.cache->get_config().enabled()) {
+                continue;
+            }
+            out << level.name << ":reads:" << level.cache->get_read_count() << endl;
+            out << level.name << ":writes:" << level.cache->get_write_count() << endl;
+            out << level.name << ":hit:" << level.cache->get_hit_count() << endl;
+            out << level.name << ":miss:" << level.cache->get_miss_count() << endl;
+            out << level.name << ":hit-rate:" << level.cache->get_hit_rate() << endl;
+            out << level.name << ":stalled-cycles:" << level.cache->get_stall_count()
+                << endl;
+            out << level.name << ":improved-speed:"
+                << level.cache->get_speed_improvement() << endl;
+            report_prefetch(level.name, level.cache);
+        }
+    }
+    const machine::BranchPredictionUnit *bpu = machine->core()->get_branch_predictor();
+    if (e_branch_stats && bpu != nullptr) {
+        out << "Branch predictor statistics report:" << endl;
+        out << "branch-predictor:control-transfers:" << bpu->get_control_count() << endl;
+        out << "branch-predictor:branches:" << bpu->get_branch_count() << endl;
+        out << "branch-predictor:mispredictions:" << bpu->get_mispredict_count() << endl;
+        out << "branch-predictor:accuracy:" << bpu->get_accuracy() << endl;
+        out << "branch-predictor:flush-cycles:"
+            << machine->core()->get_mispredict_stall_count() << endl;
+        for (const auto &pc : bpu->get_pc_statistics()) {
+            out << "branch:0x";
+            out_hex(out, pc.inst_addr.get_raw(), 8);
+            out << ":executed:" << pc.executed << ":taken:" << pc.taken
+                << ":mispredicted:" << pc.mispredicted << endl;
+        }
+    }
+    if (e_profile && machine->profiler() != nullptr) {
+        report_profile();
     }
     if (e_cycles) {
-        cout << "d-cache:stalled-cycles:"
+        out << "d-cache:stalled-cycles:"
              << machine->cache_data()->get_stall_count() << endl;
-        cout << "d-cache:improved-speed:"
+        out << "d-cache:improved-speed:"
              << machine->cache_data()->get_speed_improvement() << endl;
     }
+    for (const auto &sweep : cache_sweeps) {
+        const std::vector<CacheSweep::Result> results
+            = sweep.sweep != nullptr ? sweep.sweep->results() : sweep.results;
+        for (const CacheSweep::Result &res : results) {
+            out << sweep.name.toStdString() << "-sweep:" << cache_spec(res.config)
+                << ":hit:" << res.statistics.hit_read + res.statistics.hit_write
+                << ":miss:" << res.statistics.miss_read + res.statistics.miss_write
+                << ":hit-rate:" << res.hit_rate << ":stalled-cycles:" << res.stall_count
+                << ":improved-speed:" << res.speed_improvement << endl;
+        }
+    }
     if (e_cycles) {
-        cout << "cycles:" << machine->core()->get_cycle_count() << endl;
-        cout << "stalls:" << machine->core()->get_stall_count() << endl;
+        out << "cycles:" << machine->core()->get_cycle_count() << endl;
+        out << "stalls:" << machine->core()->get_stall_count() << endl;
+        if (machine->config().memory_stalls()) {
+            out << "memory-stalls:" << machine->core()->get_memory_stall_count() << endl;
+        }
+        if (bpu != nullptr) {
+            out << "mispredict-stalls:" << machine->core()->get_mispredict_stall_count() << endl;
+        }
+    }
+    if (!e_callgrind.isEmpty() && machine->call_graph() != nullptr) {
+        ofstream callgrind;
+        callgrind.open(e_callgrind.toLocal8Bit().data(), ios::out | ios::trunc);
+        machine->call_graph()->write_callgrind(callgrind, machine->config().elf());
+        callgrind.close();
     }
     foreach (DumpRange range, dump_ranges) {
-        ofstream out;
-        out.open(
+        ofstream dump;
+        dump.open(
             range.path_to_write.toLocal8Bit().data(), ios::out | ios::trunc);
         Address start = range.start & ~3;
         Address end = range.start + range.len;
@@ -248,11 +471,57 @@ void Reporter::report() {
         }
         const MemoryDataBus *mem = machine->memory_data_bus();
         for (Address addr = start; addr < end; addr += 4) {
-            out << "0x";
+            dump << "0x";
             out_hex(
-                out, mem->read_u32(addr, ae::INTERNAL), 8);
-            out << endl;
+                dump, mem->read_u32(addr, ae::INTERNAL), 8);
+            dump << endl;
+        }
+        dump.close();
+    }
+}
+
+bool Reporter::check() {
+    bool passed = true;
+    const MemoryDataBus *mem = machine->memory_data_bus();
+    foreach (const CheckRange &range, check_ranges) {
+        Address addr = range.start & ~3;
+        for (uint32_t expected : range.expected) {
+            uint32_t val = mem->read_u32(addr, ae::INTERNAL);
+            if (val != expected) {
+                out << "Memory check failed at 0x";
+                out_hex(out, addr.get_raw(), 8);
+                out << ": expected 0x";
+                out_hex(out, expected, 8);
+                out << " got 0x";
+                out_hex(out, val, 8);
+                out << endl;
+                passed = false;
+            }
+            addr += 4;
+        }
+    }
+    return passed;
+}
+
+void Reporter::batch_report(ostream &out, const QVector<BatchResult> &results) {
+    QJsonArray jobs;
+    int failed = 0;
+    foreach (const BatchResult &res, results) {
+        QJsonObject job;
+        job["args"] = QJsonArray::fromStringList(res.args);
+        job["outcome"] = res.outcome;
+        job["exit_code"] = res.exit_code;
+        job["cycles"] = (qint64)res.cycles;
+        job["stalls"] = (qint64)res.stalls;
+        job["output"] = res.output;
+        jobs.append(job);
+        if (res.exit_code != 0) {
+            failed++;
         }
-        out.close();
     }
+    QJsonObject root;
+    root["jobs"] = jobs;
+    root["passed"] = results.size() - failed;
+    root["failed"] = failed;
+    out << QJsonDocument(root).toJson().toStdString();
 }
@@ -37,11 +37,14 @@
 #define REPORTER_H
 
 #include "machine/machine.h"
+#include "machine/memory/cache/cache_sweep.h"
 
 #include <QCoreApplication>
 #include <QObject>
 #include <QString>
+#include <QStringList>
 #include <QVector>
+#include <iostream>
 
 using machine::Address;
 
@@ -49,11 +52,24 @@ class Reporter : public QObject {
     Q_OBJECT
 
 public:
-    Reporter(QCoreApplication *app, machine::Machine *machine);
+    /**
+     * Reports are written to out. When app is null (batch job), the end of
+     * the simulation is only recorded and can be queried by finished().
+     */
+    Reporter(
+        QCoreApplication *app,
+        machine::Machine *machine,
+        std::ostream &out = std::cout);
 
     void regs(); // Report status of registers
     void cache_stats();
+    void branch_stats(); // Report branch predictor statistics
+    void profile();      // Collect and report per instruction profile
+    // Collect call graph and write it in callgrind format to given file
+    void call_graph(const QString &path_to_write);
     void cycles();
+    // Step back in execution history before reporting at exit or trap
+    void step_back(unsigned int cycles);
 
     enum FailReason {
         FR_I = (1 << 0), // Unsupported Instruction
@@ -72,23 +88,77 @@ public:
         QString path_to_write;
     };
     void add_dump_range(Address start, size_t len, const QString &path_to_write);
+    // Results of evaluated cache configurations are reported under given name
+    void add_cache_sweep(const QString &name, const machine::CacheSweep *sweep);
+    // Results of sweep already evaluated (by parallel replay of memory trace)
+    void add_cache_sweep(const QString &name, std::vector<machine::CacheSweep::Result> results);
+    // Memory content compared at program end, mismatch fails the run
+    void add_check_range(Address start, const QVector<uint32_t> &expected);
+    // Stop simulation as failed once this number of cycles is reached
+    void cycle_limit(unsigned int cycles);
+
+    // Reports statistics of caches after replay of memory trace and finishes
+    void memory_trace_replayed(uint64_t records);
+
+    bool finished() const;
+    // Outcome of finished simulation (exit, trap, exception or cycle-limit)
+    const QString &outcome() const;
+    int exit_code() const;
+
+    struct BatchResult {
+        QStringList args;
+        QString outcome;
+        int exit_code;
+        unsigned int cycles;
+        unsigned int stalls;
+        QString output;
+    };
+    // Aggregated machine readable (JSON) report of all batch jobs
+    static void batch_report(std::ostream &out, const QVector<BatchResult> &results);
 
 private slots:
     void machine_exit();
     void machine_trap(machine::SimulatorException &e);
     void machine_exception_reached();
+    void machine_post_tick();
 
 private:
+    struct CheckRange {
+        Address start;
+        QVector<uint32_t> expected;
+    };
+    struct NamedSweep {
+        QString name;
+        const machine::CacheSweep *sweep; // Null for already evaluated results
+        std::vector<machine::CacheSweep::Result> results;
+    };
+
     QCoreApplication *app;
     machine::Machine *machine;
+    std::ostream &out;
     QVector<DumpRange> dump_ranges;
+    QVector<CheckRange> check_ranges;
+    QVector<NamedSweep> cache_sweeps;
 
     bool e_regs;
     bool e_cache_stats;
+    bool e_branch_stats;
+    bool e_profile;
+    QString e_callgrind;
     bool e_cycles;
+    unsigned int e_step_back;
     enum FailReason e_fail;
+    unsigned int e_cycle_limit;
+
+    bool e_finished;
+    QString e_outcome;
+    int e_exit_code;
 
+    void rewind();
     void report();
+    void report_profile();
+    bool check();
+    void finish(const QString &outcome, int code);
 };
 
 #endif // REPORTER_H
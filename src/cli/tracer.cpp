@@ -41,7 +41,7 @@
 using namespace std;
 using namespace machine;
 
-Tracer::Tracer(Machine *machine) {
+Tracer::Tracer(Machine *machine, ostream &out) : out(out) {
     this->machine = machine;
     for (bool &gp_reg : gp_regs) {
         gp_reg = false;
@@ -115,7 +115,7 @@ void Tracer::instruction_fetch(
     Address inst_addr,
     ExceptionCause excause,
     bool valid) {
-    cout << "Fetch: " << (excause != EXCAUSE_NONE ? "!" : "")
+    out << "Fetch: " << (excause != EXCAUSE_NONE ? "!" : "")
          << (valid ? inst.to_str(inst_addr).toStdString() : "Idle") << endl;
 }
 
@@ -124,7 +124,7 @@ void Tracer::instruction_decode(
     Address inst_addr,
     ExceptionCause excause,
     bool valid) {
-    cout << "Decode: " << (excause != EXCAUSE_NONE ? "!" : "")
+    out << "Decode: " << (excause != EXCAUSE_NONE ? "!" : "")
          << (valid ? inst.to_str(inst_addr).toStdString() : "Idle") << endl;
 }
 
@@ -133,7 +133,7 @@ void Tracer::instruction_execute(
     Address inst_addr,
     ExceptionCause excause,
     bool valid) {
-    cout << "Execute: " << (excause != EXCAUSE_NONE ? "!" : "")
+    out << "Execute: " << (excause != EXCAUSE_NONE ? "!" : "")
          << (valid ? inst.to_str(inst_addr).toStdString() : "Idle") << endl;
 }
 
@@ -142,7 +142,7 @@ void Tracer::instruction_memory(
     Address inst_addr,
     ExceptionCause excause,
     bool valid) {
-    cout << "Memory: " << (excause != EXCAUSE_NONE ? "!" : "")
+    out << "Memory: " << (excause != EXCAUSE_NONE ? "!" : "")
          << (valid ? inst.to_str(inst_addr).toStdString() : "Idle") << endl;
 }
 
@@ -151,25 +151,25 @@ void Tracer::instruction_writeback(
     Address inst_addr,
     ExceptionCause excause,
     bool valid) {
-    cout << "Writeback: " << (excause != EXCAUSE_NONE ? "!" : "")
+    out << "Writeback: " << (excause != EXCAUSE_NONE ? "!" : "")
          << (valid ? inst.to_str(inst_addr).toStdString() : "Idle") << endl;
 }
 
 void Tracer::regs_pc_update(Address val) {
-    cout << "PC:" << hex << val.get_raw() << endl;
+    out << "PC:" << hex << val.get_raw() << endl;
 }
 
 void Tracer::regs_gp_update(RegisterId i, RegisterValue val) {
     if (gp_regs[i.data]) {
-        cout << "GP" << dec << (unsigned)i.data << ":" << hex << val.as_u32()
+        out << "GP" << dec << (unsigned)i.data << ":" << hex << val.as_u32()
              << endl;
     }
 }
 
 void Tracer::regs_hi_lo_update(bool hi, RegisterValue val) const {
     if (hi && r_hi) {
-        cout << "HI:" << hex << val.as_u32() << endl;
+        out << "HI:" << hex << val.as_u32() << endl;
     } else if (!hi && r_lo) {
-        cout << "LO:" << hex << val.as_u32() << endl;
+        out << "LO:" << hex << val.as_u32() << endl;
     }
 }
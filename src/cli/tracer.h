@@ -41,11 +41,12 @@
 #include "machine/memory/address.h"
 
 #include <QObject>
+#include <iostream>
 
 class Tracer : public QObject {
     Q_OBJECT
 public:
-    Tracer(machine::Machine *machine);
+    Tracer(machine::Machine *machine, std::ostream &out = std::cout);
 
     // Trace instructions in different stages/sections
     void fetch();
@@ -92,6 +93,7 @@ private slots:
 
 private:
     machine::Machine *machine;
+    std::ostream &out;
 
     bool gp_regs[32] {};
     bool r_hi, r_lo;
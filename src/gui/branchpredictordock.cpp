@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*******************************************************************************
+ * QtMips - MIPS 32-bit Architecture Subset Simulator
+ *
+ * Implemented to support following courses:
+ *
+ *   B35APO - Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b35apo
+ *
+ *   B4M35PAP - Advanced Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b4m35pap/start
+ *
+ * Copyright (c) 2017-2019 Karel Koci<cynerd@email.cz>
+ * Copyright (c) 2019      Pavel Pisa <pisa@cmp.felk.cvut.cz>
+ *
+ * Faculty of Electrical Engineering (http://www.fel.cvut.cz)
+ * Czech Technical University        (http://www.cvut.cz/)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+
+#include "branchpredictordock.h"
+
+#include <QHeaderView>
+
+BranchPredictorDock::BranchPredictorDock(QWidget *parent)
+    : QDockWidget(parent) {
+    machine = nullptr;
+    top_widget = new QWidget(this);
+    setWidget(top_widget);
+    layout_box = new QVBoxLayout(top_widget);
+
+    top_form = new QWidget(top_widget);
+    top_form->setVisible(false);
+    layout_box->addWidget(top_form);
+    layout_top_form = new QFormLayout(top_form);
+
+    l_transfers = new QLabel("0", top_form);
+    layout_top_form->addRow("Control transfers:", l_transfers);
+    l_branches = new QLabel("0", top_form);
+    layout_top_form->addRow("Conditional branches:", l_branches);
+    l_mispredictions = new QLabel("0", top_form);
+    layout_top_form->addRow("Mispredictions:", l_mispredictions);
+    l_accuracy = new QLabel("0.000%", top_form);
+    layout_top_form->addRow("Accuracy:", l_accuracy);
+    l_flush = new QLabel("0", top_form);
+    layout_top_form->addRow("Flush stall cycles:", l_flush);
+
+    table = new QTableWidget(0, 5, top_widget);
+    table->setHorizontalHeaderLabels(
+        { "Address", "Executed", "Taken", "Mispredicted", "Accuracy" });
+    table->verticalHeader()->setVisible(false);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setVisible(false);
+    layout_box->addWidget(table);
+
+    no_predictor = new QLabel("No branch predictor configured", top_widget);
+    layout_box->addWidget(no_predictor);
+
+    connect(
+        this, &QDockWidget::visibilityChanged, this,
+        &BranchPredictorDock::update_statistics);
+
+    setObjectName("BranchPredictor");
+    setWindowTitle("Branch Predictor");
+}
+
+void BranchPredictorDock::setup(machine::Machine *machine) {
+    this->machine = machine;
+    if (machine != nullptr) {
+        connect(
+            machine, &machine::Machine::post_tick, this,
+            &BranchPredictorDock::update_statistics);
+    }
+    update_statistics();
+}
+
+void BranchPredictorDock::update_statistics() {
+    const machine::BranchPredictionUnit *bpu
+        = machine != nullptr ? machine->core()->get_branch_predictor()
+                             : nullptr;
+    top_form->setVisible(bpu != nullptr);
+    table->setVisible(bpu != nullptr);
+    no_predictor->setVisible(bpu == nullptr);
+    if (bpu == nullptr || !isVisible()) {
+        return;
+    }
+
+    l_transfers->setText(QString::number(bpu->get_control_count()));
+    l_branches->setText(QString::number(bpu->get_branch_count()));
+    l_mispredictions->setText(QString::number(bpu->get_mispredict_count()));
+    l_accuracy->setText(
+        QString::number(bpu->get_accuracy(), 'f', 3) + QString("%"));
+    l_flush->setText(
+        QString::number(machine->core()->get_mispredict_stall_count()));
+
+    const std::vector<machine::BranchPredictionUnit::PcStatistics> stats
+        = bpu->get_pc_statistics();
+    table->setRowCount((int)stats.size());
+    for (size_t i = 0; i < stats.size(); i++) {
+        const auto &pc = stats[i];
+        const double accuracy = 100.0 * (pc.executed - pc.mispredicted)
+                                / (pc.executed > 0 ? pc.executed : 1);
+        const QString cells[] = {
+            "0x"
+                + QString("%1").arg(pc.inst_addr.get_raw(), 8, 16, QChar('0')),
+            QString::number(pc.executed),
+            QString::number(pc.taken),
+            QString::number(pc.mispredicted),
+            QString::number(accuracy, 'f', 3) + QString("%"),
+        };
+        for (int col = 0; col < 5; col++) {
+            QTableWidgetItem *item = table->item((int)i, col);
+            if (item == nullptr) {
+                item = new QTableWidgetItem();
+                table->setItem((int)i, col, item);
+            }
+            item->setText(cells[col]);
+        }
+    }
+}
@@ -61,6 +61,20 @@ CacheDock::CacheDock(QWidget *parent, const QString &type)
     l_speed = new QLabel("100%", top_form);
     layout_top_form->addRow("Improved speed:", l_speed);
 
+    // Shown only when prefetcher is configured
+    prefetch_form = new QWidget(top_widget);
+    prefetch_form->setVisible(false);
+    layout_box->addWidget(prefetch_form);
+    layout_prefetch_form = new QFormLayout(prefetch_form);
+    l_prefetches = new QLabel("0", prefetch_form);
+    layout_prefetch_form->addRow("Prefetches:", l_prefetches);
+    l_pf_accuracy = new QLabel("0.000%", prefetch_form);
+    layout_prefetch_form->addRow("Prefetch accuracy:", l_pf_accuracy);
+    l_pf_coverage = new QLabel("0.000%", prefetch_form);
+    layout_prefetch_form->addRow("Prefetch coverage:", l_pf_coverage);
+    l_pf_pollution = new QLabel("0", prefetch_form);
+    layout_prefetch_form->addRow("Prefetch pollution:", l_pf_pollution);
+
     graphicsview = new GraphicsView(top_widget);
     graphicsview->setVisible(false);
     layout_box->addWidget(graphicsview);
@@ -81,6 +95,10 @@ void CacheDock::setup(const machine::Cache *cache) {
     l_m_writes->setText("0");
     l_hit_rate->setText("0.000%");
     l_speed->setText("100%");
+    l_prefetches->setText("0");
+    l_pf_accuracy->setText("0.000%");
+    l_pf_coverage->setText("0.000%");
+    l_pf_pollution->setText("0");
     if (cache != nullptr) {
         connect(
             cache, &machine::Cache::hit_update, this, &CacheDock::hit_update);
@@ -95,8 +113,14 @@ void CacheDock::setup(const machine::Cache *cache) {
         connect(
             cache, &machine::Cache::statistics_update, this,
             &CacheDock::statistics_update);
+        connect(
+            cache, &machine::Cache::prefetch_update, this,
+            &CacheDock::prefetch_update);
     }
     top_form->setVisible(cache != nullptr);
+    prefetch_form->setVisible(
+        cache != nullptr && cache->get_config().enabled()
+        && cache->get_config().prefetcher() != machine::CacheConfig::PF_NONE);
     no_cache->setVisible(!cache->get_config().enabled());
 
     delete cachescene;
@@ -129,3 +153,14 @@ void CacheDock::statistics_update(
     l_hit_rate->setText(QString::number(hit_rate, 'f', 3) + QString("%"));
     l_speed->setText(QString::number(speed_improv, 'f', 0) + QString("%"));
 }
+
+void CacheDock::prefetch_update(
+    unsigned prefetches,
+    double accuracy,
+    double coverage,
+    unsigned pollution) {
+    l_prefetches->setText(QString::number(prefetches));
+    l_pf_accuracy->setText(QString::number(accuracy, 'f', 3) + QString("%"));
+    l_pf_coverage->setText(QString::number(coverage, 'f', 3) + QString("%"));
+    l_pf_pollution->setText(QString::number(pollution));
+}
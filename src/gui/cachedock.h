@@ -60,11 +60,17 @@ private slots:
         unsigned stalled_cycles,
         double speed_improv,
         double hit_rate);
+    void prefetch_update(
+        unsigned prefetches,
+        double accuracy,
+        double coverage,
+        unsigned pollution);
 
 private:
     QVBoxLayout *layout_box;
-    QWidget *top_widget, *top_form;
-    QFormLayout *layout_top_form;
+    QWidget *top_widget, *top_form, *prefetch_form;
+    QFormLayout *layout_top_form, *layout_prefetch_form;
+    QLabel *l_prefetches, *l_pf_accuracy, *l_pf_coverage, *l_pf_pollution;
     QLabel *l_hit, *l_miss, *l_stalled, *l_speed, *l_hit_rate;
     QLabel *no_cache;
     QLabel *l_m_reads, *l_m_writes;
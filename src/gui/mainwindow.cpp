@@ -96,6 +96,10 @@ MainWindow::MainWindow(QSettings *settings, QWidget *parent)
     cache_program->hide();
     cache_data = new CacheDock(this, "Data");
     cache_data->hide();
+    cache_level2 = new CacheDock(this, "L2");
+    cache_level2->hide();
+    cache_level3 = new CacheDock(this, "L3");
+    cache_level3->hide();
     peripherals = new PeripheralsDock(this, settings);
     peripherals->hide();
     terminal = new TerminalDock(this, settings);
@@ -104,6 +108,8 @@ MainWindow::MainWindow(QSettings *settings, QWidget *parent)
     lcd_display->hide();
     cop0dock = new Cop0Dock(this);
     cop0dock->hide();
+    branch_predictor = new BranchPredictorDock(this);
+    branch_predictor->hide();
     messages = new MessagesDock(this, settings);
     messages->hide();
 
@@ -141,6 +147,12 @@ MainWindow::MainWindow(QSettings *settings, QWidget *parent)
     connect(
         ui->actionMnemonicRegisters, &QAction::triggered, this,
         &MainWindow::view_mnemonics_registers);
+    connect(
+        ui->actionProfile, &QAction::triggered, this,
+        &MainWindow::view_profile);
+    connect(
+        ui->actionHistory, &QAction::triggered, this,
+        &MainWindow::record_history);
     connect(
         ui->actionCompileSource, &QAction::triggered, this,
         &MainWindow::compile_source);
@@ -164,6 +176,12 @@ MainWindow::MainWindow(QSettings *settings, QWidget *parent)
     connect(
         ui->actionData_Cache, &QAction::triggered, this,
         &MainWindow::show_cache_data);
+    connect(
+        ui->actionL2_Cache, &QAction::triggered, this,
+        &MainWindow::show_cache_level2);
+    connect(
+        ui->actionL3_Cache, &QAction::triggered, this,
+        &MainWindow::show_cache_level3);
     connect(
         ui->actionPeripherals, &QAction::triggered, this,
         &MainWindow::show_peripherals);
@@ -176,6 +194,9 @@ MainWindow::MainWindow(QSettings *settings, QWidget *parent)
     connect(
         ui->actionCop0State, &QAction::triggered, this,
         &MainWindow::show_cop0dock);
+    connect(
+        ui->actionBranch_Predictor, &QAction::triggered, this,
+        &MainWindow::show_branch_predictor);
     connect(
         ui->actionCore_View_show, &QAction::triggered, this,
         &MainWindow::show_hide_coreview);
@@ -247,6 +268,8 @@ MainWindow::~MainWindow() {
     delete memory;
     delete cache_program;
     delete cache_data;
+    delete cache_level2;
+    delete cache_level3;
     delete peripherals;
     delete terminal;
     delete lcd_display;
@@ -319,8 +342,14 @@ void MainWindow::create_core(
     machine::Machine *new_machine
         = new machine::Machine(config, true, load_executable);
 
+    bool memory_lost = false;
     if (keep_memory && (machine != nullptr)) {
-        new_machine->memory_rw()->reset(*machine->memory());
+        if ((machine->memory() != nullptr) && (new_machine->memory_rw() != nullptr)) {
+            new_machine->memory_rw()->reset(*machine->memory());
+        } else {
+            // Content of mapped RAM cannot be transferred
+            memory_lost = true;
+        }
     }
 
     // Remove old machine
@@ -333,6 +362,9 @@ void MainWindow::create_core(
     show_hide_coreview(coreview_shown);
 
     set_speed(); // Update machine speed to current settings
+    ui->actionHistory->setEnabled(machine->checkpoint_supported());
+    record_history(ui->actionHistory->isChecked());
+    machine->set_profiling(ui->actionProfile->isChecked());
 
     if (config.osemu_enable()) {
         osemu::OsSyscallExceptionHandler *osemu_handler
@@ -363,6 +395,8 @@ void MainWindow::create_core(
         &machine::Machine::pause);
     connect(
         ui->actionStep, &QAction::triggered, machine, &machine::Machine::step);
+    connect(ui->actionStepBack, &QAction::triggered, this, &MainWindow::step_back);
+    connect(ui->actionRunBack, &QAction::triggered, this, &MainWindow::run_back);
     connect(
         ui->actionRestart, &QAction::triggered, machine,
         &machine::Machine::restart);
@@ -386,10 +420,13 @@ void MainWindow::create_core(
     memory->setup(machine);
     cache_program->setup(machine->cache_program());
     cache_data->setup(machine->cache_data());
+    cache_level2->setup(machine->cache_level2());
+    cache_level3->setup(machine->cache_level3());
     terminal->setup(machine->serial_port());
     peripherals->setup(machine->peripheral_spi_led());
     lcd_display->setup(machine->peripheral_lcd_display());
     cop0dock->setup(machine);
+    branch_predictor->setup(machine);
 
     // Connect signals for instruction address followup
     connect(
@@ -410,6 +447,9 @@ void MainWindow::create_core(
 
     // Set status to ready
     machine_status(machine::Machine::ST_READY);
+    if (memory_lost) {
+        ui->statusBar->showMessage("Memory content is not kept when mapped RAM is used");
+    }
 }
 
 bool MainWindow::configured() {
@@ -487,10 +527,13 @@ SHOW_HANDLER(program, Qt::LeftDockWidgetArea)
 SHOW_HANDLER(memory, Qt::RightDockWidgetArea)
 SHOW_HANDLER(cache_program, Qt::RightDockWidgetArea)
 SHOW_HANDLER(cache_data, Qt::RightDockWidgetArea)
+SHOW_HANDLER(cache_level2, Qt::RightDockWidgetArea)
+SHOW_HANDLER(cache_level3, Qt::RightDockWidgetArea)
 SHOW_HANDLER(peripherals, Qt::RightDockWidgetArea)
 SHOW_HANDLER(terminal, Qt::RightDockWidgetArea)
 SHOW_HANDLER(lcd_display, Qt::RightDockWidgetArea)
 SHOW_HANDLER(cop0dock, Qt::TopDockWidgetArea)
+SHOW_HANDLER(branch_predictor, Qt::RightDockWidgetArea)
 SHOW_HANDLER(messages, Qt::BottomDockWidgetArea)
 #undef SHOW_HANDLER
 
@@ -547,6 +590,46 @@ void MainWindow::set_speed() {
         machine->set_speed(0);
 }
 
+void MainWindow::record_history(bool enable) {
+    if (machine == nullptr) {
+        return;
+    }
+    if (enable && machine->checkpoint_supported()) {
+        machine->set_history(
+            machine::HISTORY_INTERVAL_DEFAULT, machine::HISTORY_SNAPSHOTS_DEFAULT);
+    } else {
+        machine->set_history(0, 0);
+    }
+    if (machine->status() != machine::Machine::ST_RUNNING) {
+        ui->actionStepBack->setEnabled(history_available());
+        ui->actionRunBack->setEnabled(history_available());
+    }
+}
+
+bool MainWindow::history_available() const {
+    return machine->checkpoint_supported() && ui->actionHistory->isChecked();
+}
+
+void MainWindow::step_back() {
+    if (machine == nullptr) {
+        return;
+    }
+    if (!machine->step_back()) {
+        ui->statusBar->showMessage(
+            "No execution history to step back (history restarts after interrupts "
+            "and emulated syscalls)");
+    }
+}
+
+void MainWindow::run_back() {
+    if (machine == nullptr) {
+        return;
+    }
+    if (!machine->run_back()) {
+        ui->statusBar->showMessage("No earlier breakpoint, at the start of execution history");
+    }
+}
+
 void MainWindow::view_mnemonics_registers(bool enable) {
     machine::Instruction::set_symbolic_registers(enable);
     if (program == nullptr) {
@@ -555,6 +638,14 @@ void MainWindow::view_mnemonics_registers(bool enable) {
     program->request_update_all();
 }
 
+void MainWindow::view_profile(bool enable) {
+    if (machine == nullptr) {
+        return;
+    }
+    machine->set_profiling(enable);
+    program->request_update_all();
+}
+
 void MainWindow::closeEvent(QCloseEvent *event) {
     settings->setValue("windowGeometry", saveGeometry());
     settings->setValue("windowState", saveState());
@@ -633,12 +724,16 @@ void MainWindow::machine_status(enum machine::Machine::Status st) {
         ui->actionPause->setEnabled(false);
         ui->actionRun->setEnabled(true);
         ui->actionStep->setEnabled(true);
+        ui->actionStepBack->setEnabled(history_available());
+        ui->actionRunBack->setEnabled(history_available());
         status = "Ready";
         break;
     case machine::Machine::ST_RUNNING:
         ui->actionPause->setEnabled(true);
         ui->actionRun->setEnabled(false);
         ui->actionStep->setEnabled(false);
+        ui->actionStepBack->setEnabled(false);
+        ui->actionRunBack->setEnabled(false);
         status = "Running";
         break;
     case machine::Machine::ST_BUSY:
@@ -661,6 +756,9 @@ void MainWindow::machine_exit() {
     ui->actionPause->setEnabled(false);
     ui->actionRun->setEnabled(false);
     ui->actionStep->setEnabled(false);
+    // Execution history can still be inspected
+    ui->actionStepBack->setEnabled(history_available());
+    ui->actionRunBack->setEnabled(history_available());
 }
 
 void MainWindow::machine_trap(machine::SimulatorException &e) {
@@ -37,6 +37,7 @@
 #define MAINWINDOW_H
 
 #include "assembler/simpleasm.h"
+#include "branchpredictordock.h"
 #include "cachedock.h"
 #include "cop0dock.h"
 #include "coreview.h"
@@ -110,10 +111,13 @@ public slots:
     void show_memory();
     void show_cache_data();
     void show_cache_program();
+    void show_cache_level2();
+    void show_cache_level3();
     void show_peripherals();
     void show_terminal();
     void show_lcd_display();
     void show_cop0dock();
+    void show_branch_predictor();
     void show_hide_coreview(bool show);
     void show_symbol_dialog();
     void show_messages();
@@ -122,6 +126,10 @@ public slots:
     void about_qt();
     // Actions - execution speed
     void set_speed();
+    // Actions - reverse execution
+    void record_history(bool enable);
+    void step_back();
+    void run_back();
     // Machine signals
     void machine_status(enum machine::Machine::Status st);
     void machine_exit();
@@ -129,6 +137,7 @@ public slots:
     void central_tab_changed(int index);
     void tab_widget_destroyed(QObject *obj);
     void view_mnemonics_registers(bool enable);
+    void view_profile(bool enable);
     void message_selected(
         messagetype::Type type,
         const QString &file,
@@ -158,11 +167,13 @@ private:
     RegistersDock *registers {};
     ProgramDock *program {};
     MemoryDock *memory {};
-    CacheDock *cache_program {}, *cache_data {};
+    CacheDock *cache_program {}, *cache_data {}, *cache_level2 {},
+        *cache_level3 {};
     PeripheralsDock *peripherals {};
     TerminalDock *terminal {};
     LcdDisplayDock *lcd_display {};
     Cop0Dock *cop0dock {};
+    BranchPredictorDock *branch_predictor {};
     MessagesDock *messages {};
     bool coreview_shown;
     SrcEditor *current_srceditor;
@@ -178,6 +189,7 @@ private:
         Qt::DockWidgetArea area = Qt::RightDockWidgetArea);
     void add_src_editor_to_tabs(SrcEditor *editor);
     void update_open_file_list();
+    bool history_available() const;
     bool modified_file_list(QStringList &list, bool report_unnamed = false);
     SrcEditor *source_editor_for_file(const QString &filename, bool open);
     QPointer<ExtProcess> build_process;
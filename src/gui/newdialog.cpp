@@ -60,6 +60,10 @@ NewDialog::NewDialog(QWidget *parent, QSettings *settings) : QDialog(parent) {
     ui_cache_p->label_writeback->hide();
     ui_cache_d = new Ui::NewDialogCache();
     ui_cache_d->setupUi(ui->tab_cache_data);
+    ui_cache_l2 = new Ui::NewDialogCache();
+    ui_cache_l2->setupUi(ui->tab_cache_level2);
+    ui_cache_l3 = new Ui::NewDialogCache();
+    ui_cache_l3->setupUi(ui->tab_cache_level3);
 
     connect(
         ui->pushButton_start_empty, &QAbstractButton::clicked, this,
@@ -106,6 +110,21 @@ NewDialog::NewDialog(QWidget *parent, QSettings *settings) : QDialog(parent) {
     connect(
         ui->hazard_stall_forward, &QAbstractButton::clicked, this,
         &NewDialog::hazard_unit_change);
+    connect(
+        ui->branch_predictor, QOverload<int>::of(&QComboBox::activated), this,
+        &NewDialog::branch_predictor_change);
+    connect(
+        ui->branch_predictor_bits, QOverload<int>::of(&QSpinBox::valueChanged),
+        this, &NewDialog::branch_predictor_bits_change);
+    connect(
+        ui->btb_entries, QOverload<int>::of(&QSpinBox::valueChanged), this,
+        &NewDialog::btb_entries_change);
+    connect(
+        ui->ras_depth, QOverload<int>::of(&QSpinBox::valueChanged), this,
+        &NewDialog::ras_depth_change);
+    connect(
+        ui->mispredict_penalty, QOverload<int>::of(&QSpinBox::valueChanged),
+        this, &NewDialog::mispredict_penalty_change);
 
     connect(
         ui->mem_protec_exec, &QAbstractButton::clicked, this,
@@ -122,6 +141,18 @@ NewDialog::NewDialog(QWidget *parent, QSettings *settings) : QDialog(parent) {
     connect(
         ui->mem_time_burst, QOverload<int>::of(&QSpinBox::valueChanged), this,
         &NewDialog::mem_time_burst_change);
+    connect(
+        ui->mem_stalls, &QAbstractButton::clicked, this,
+        &NewDialog::mem_stalls_change);
+    connect(
+        ui->cache_level2_time, QOverload<int>::of(&QSpinBox::valueChanged),
+        this, &NewDialog::cache_level2_time_change);
+    connect(
+        ui->cache_level3_time, QOverload<int>::of(&QSpinBox::valueChanged),
+        this, &NewDialog::cache_level3_time_change);
+    connect(
+        ui->cache_inclusion, QOverload<int>::of(&QComboBox::activated), this,
+        &NewDialog::cache_inclusion_change);
 
     connect(
         ui->osemu_enable, &QAbstractButton::clicked, this,
@@ -147,6 +178,8 @@ NewDialog::NewDialog(QWidget *parent, QSettings *settings) : QDialog(parent) {
 
     cache_handler_d = new NewDialogCacheHandler(this, ui_cache_d);
     cache_handler_p = new NewDialogCacheHandler(this, ui_cache_p);
+    cache_handler_l2 = new NewDialogCacheHandler(this, ui_cache_l2);
+    cache_handler_l3 = new NewDialogCacheHandler(this, ui_cache_l3);
 
     // TODO remove this block when protections are implemented
     ui->mem_protec_exec->setVisible(false);
@@ -158,6 +191,8 @@ NewDialog::NewDialog(QWidget *parent, QSettings *settings) : QDialog(parent) {
 NewDialog::~NewDialog() {
     delete ui_cache_d;
     delete ui_cache_p;
+    delete ui_cache_l2;
+    delete ui_cache_l3;
     delete ui;
     // Settings is freed by parent
     delete config;
@@ -204,7 +239,20 @@ void NewDialog::create() {
 
 void NewDialog::create_empty() {
     MainWindow *prnt = (MainWindow *)parent();
-    prnt->create_core(*config, false, true);
+
+    try {
+        prnt->create_core(*config, false, true);
+    } catch (const machine::SimulatorExceptionInput &e) {
+        // Configuration not supported by the host (e.g. mapped RAM)
+        QMessageBox msg(this);
+        msg.setText(e.msg(false));
+        msg.setIcon(QMessageBox::Critical);
+        msg.setDetailedText(e.msg(true));
+        msg.setWindowTitle("Error while initializing new machine");
+        msg.exec();
+        return;
+    }
+
     store_settings(); // Save to settings
     this->close();
 }
@@ -268,6 +316,42 @@ void NewDialog::hazard_unit_change() {
     switch2custom();
 }
 
+void NewDialog::branch_predictor_change(int index) {
+    auto bp = (enum machine::MachineConfig::BranchPredictor)index;
+    if (config->branch_predictor() != bp) {
+        config->set_branch_predictor(bp);
+        switch2custom();
+    }
+}
+
+void NewDialog::branch_predictor_bits_change(int v) {
+    if (config->branch_predictor_bits() != (unsigned)v) {
+        config->set_branch_predictor_bits(v);
+        switch2custom();
+    }
+}
+
+void NewDialog::btb_entries_change(int v) {
+    if (config->branch_target_buffer() != (unsigned)v) {
+        config->set_branch_target_buffer(v);
+        switch2custom();
+    }
+}
+
+void NewDialog::ras_depth_change(int v) {
+    if (config->return_address_stack() != (unsigned)v) {
+        config->set_return_address_stack(v);
+        switch2custom();
+    }
+}
+
+void NewDialog::mispredict_penalty_change(int v) {
+    if (config->branch_mispredict_penalty() != (unsigned)v) {
+        config->set_branch_mispredict_penalty(v);
+        switch2custom();
+    }
+}
+
 void NewDialog::mem_protec_exec_change(bool v) {
     config->set_memory_execute_protection(v);
     switch2custom();
@@ -299,6 +383,30 @@ void NewDialog::mem_time_burst_change(int v) {
     }
 }
 
+void NewDialog::mem_stalls_change(bool v) {
+    config->set_memory_stalls(v);
+    switch2custom();
+}
+
+void NewDialog::cache_level2_time_change(int v) {
+    if (config->cache_level2_access_time() != (unsigned)v) {
+        config->set_cache_level2_access_time(v);
+        switch2custom();
+    }
+}
+
+void NewDialog::cache_level3_time_change(int v) {
+    if (config->cache_level3_access_time() != (unsigned)v) {
+        config->set_cache_level3_access_time(v);
+        switch2custom();
+    }
+}
+
+void NewDialog::cache_inclusion_change(int v) {
+    config->set_cache_inclusion((enum machine::MachineConfig::CacheInclusion)v);
+    switch2custom();
+}
+
 void NewDialog::osemu_enable_change(bool v) {
     config->set_osemu_enable(v);
 }
@@ -351,15 +459,26 @@ void NewDialog::config_gui() {
         config->hazard_unit() == machine::MachineConfig::HU_STALL);
     ui->hazard_stall_forward->setChecked(
         config->hazard_unit() == machine::MachineConfig::HU_STALL_FORWARD);
+    ui->branch_predictor->setCurrentIndex(config->branch_predictor());
+    ui->branch_predictor_bits->setValue(config->branch_predictor_bits());
+    ui->btb_entries->setValue(config->branch_target_buffer());
+    ui->ras_depth->setValue(config->return_address_stack());
+    ui->mispredict_penalty->setValue(config->branch_mispredict_penalty());
     // Memory
     ui->mem_protec_exec->setChecked(config->memory_execute_protection());
     ui->mem_protec_write->setChecked(config->memory_write_protection());
     ui->mem_time_read->setValue(config->memory_access_time_read());
     ui->mem_time_write->setValue(config->memory_access_time_write());
     ui->mem_time_burst->setValue(config->memory_access_time_burst());
+    ui->mem_stalls->setChecked(config->memory_stalls());
+    ui->cache_level2_time->setValue(config->cache_level2_access_time());
+    ui->cache_level3_time->setValue(config->cache_level3_access_time());
+    ui->cache_inclusion->setCurrentIndex(config->cache_inclusion());
     // Cache
     cache_handler_d->config_gui();
     cache_handler_p->config_gui();
+    cache_handler_l2->config_gui();
+    cache_handler_l3->config_gui();
     // Operating system and exceptions
     ui->osemu_enable->setChecked(config->osemu_enable());
     ui->osemu_known_syscall_stop->setChecked(
@@ -373,6 +492,8 @@ void NewDialog::config_gui() {
     // Disable various sections according to configuration
     ui->delay_slot->setEnabled(!config->pipelined());
     ui->hazard_unit->setEnabled(config->pipelined());
+    ui->mem_stalls->setEnabled(config->pipelined());
+    ui->branch_predictor_box->setEnabled(config->pipelined());
 }
 
 unsigned NewDialog::preset_number() {
@@ -397,6 +518,8 @@ void NewDialog::load_settings() {
     config = new machine::MachineConfig(settings);
     cache_handler_d->set_config(config->access_cache_data());
     cache_handler_p->set_config(config->access_cache_program());
+    cache_handler_l2->set_config(config->access_cache_level2());
+    cache_handler_l3->set_config(config->access_cache_level3());
 
     // Load preset
     unsigned preset = settings->value("Preset", 1).toUInt();
@@ -457,6 +580,15 @@ NewDialogCacheHandler::NewDialogCacheHandler(
     connect(
         ui->writeback_policy, QOverload<int>::of(&QComboBox::activated), this,
         &NewDialogCacheHandler::writeback);
+    connect(
+        ui->prefetcher, QOverload<int>::of(&QComboBox::activated), this,
+        &NewDialogCacheHandler::prefetcher);
+    connect(
+        ui->prefetch_degree, &QAbstractSpinBox::editingFinished, this,
+        &NewDialogCacheHandler::prefetchdegree);
+    connect(
+        ui->prefetch_distance, &QAbstractSpinBox::editingFinished, this,
+        &NewDialogCacheHandler::prefetchdistance);
 }
 
 void NewDialogCacheHandler::set_config(machine::CacheConfig *config) {
@@ -470,6 +602,9 @@ void NewDialogCacheHandler::config_gui() {
     ui->degree_of_associativity->setValue(config->associativity());
     ui->replacement_policy->setCurrentIndex((int)config->replacement_policy());
     ui->writeback_policy->setCurrentIndex((int)config->write_policy());
+    ui->prefetcher->setCurrentIndex((int)config->prefetcher());
+    ui->prefetch_degree->setValue(config->prefetch_degree());
+    ui->prefetch_distance->setValue(config->prefetch_distance());
 }
 
 void NewDialogCacheHandler::enabled(bool val) {
@@ -502,3 +637,18 @@ void NewDialogCacheHandler::writeback(int val) {
     config->set_write_policy((enum machine::CacheConfig::WritePolicy)val);
     nd->switch2custom();
 }
+
+void NewDialogCacheHandler::prefetcher(int val) {
+    config->set_prefetcher((enum machine::CacheConfig::Prefetcher)val);
+    nd->switch2custom();
+}
+
+void NewDialogCacheHandler::prefetchdegree() {
+    config->set_prefetch_degree(ui->prefetch_degree->value());
+    nd->switch2custom();
+}
+
+void NewDialogCacheHandler::prefetchdistance() {
+    config->set_prefetch_distance(ui->prefetch_distance->value());
+    nd->switch2custom();
+}
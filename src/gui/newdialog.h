@@ -68,11 +68,20 @@ private slots:
     void pipelined_change(bool);
     void delay_slot_change(bool);
     void hazard_unit_change();
+    void branch_predictor_change(int);
+    void branch_predictor_bits_change(int);
+    void btb_entries_change(int);
+    void ras_depth_change(int);
+    void mispredict_penalty_change(int);
     void mem_protec_exec_change(bool);
     void mem_protec_write_change(bool);
     void mem_time_read_change(int);
     void mem_time_write_change(int);
     void mem_time_burst_change(int);
+    void mem_stalls_change(bool);
+    void cache_level2_time_change(int);
+    void cache_level3_time_change(int);
+    void cache_inclusion_change(int);
     void osemu_enable_change(bool);
     void osemu_known_syscall_stop_change(bool);
     void osemu_unknown_syscall_stop_change(bool);
@@ -84,7 +93,8 @@ private slots:
 
 private:
     Ui::NewDialog *ui {};
-    Ui::NewDialogCache *ui_cache_p {}, *ui_cache_d {};
+    Ui::NewDialogCache *ui_cache_p {}, *ui_cache_d {}, *ui_cache_l2 {},
+        *ui_cache_l3 {};
     QSettings *settings;
 
     machine::MachineConfig *config;
@@ -93,7 +103,8 @@ private:
     unsigned preset_number();
     void load_settings();
     void store_settings();
-    NewDialogCacheHandler *cache_handler_p {}, *cache_handler_d {};
+    NewDialogCacheHandler *cache_handler_p {}, *cache_handler_d {},
+        *cache_handler_l2 {}, *cache_handler_l3 {};
 };
 
 class NewDialogCacheHandler : public QObject {
@@ -112,6 +123,9 @@ private slots:
     void degreeassociativity();
     void replacement(int);
     void writeback(int);
+    void prefetcher(int);
+    void prefetchdegree();
+    void prefetchdistance();
 
 private:
     NewDialog *nd;
@@ -36,6 +36,7 @@
 #include "programmodel.h"
 
 #include <QBrush>
+#include <algorithm>
 #include <QtGui/qbrush.h>
 
 using ae = machine::AccessEffects; // For enum values, type is obvious from
@@ -53,6 +54,7 @@ ProgramModel::ProgramModel(QObject *parent)
         i = machine::STAGEADDR_NONE;
     }
     stages_need_update = false;
+    profile_max = 0;
 }
 
 const machine::FrontendMemory *ProgramModel::mem_access() const {
@@ -77,12 +79,24 @@ machine::FrontendMemory *ProgramModel::mem_access_rw() const {
     //    return machine->memory_rw();
 }
 
+const machine::Profiler::Counters *
+ProgramModel::profile(machine::Address address) const {
+    if (machine == nullptr || machine->profiler() == nullptr) {
+        return nullptr;
+    }
+    return machine->profiler()->find(address);
+}
+
+static uint64_t profile_cost(const machine::Profiler::Counters &c) {
+    return (uint64_t)c.executed + c.stall_cycles;
+}
+
 int ProgramModel::rowCount(const QModelIndex & /*parent*/) const {
     return 750;
 }
 
 int ProgramModel::columnCount(const QModelIndex & /*parent*/) const {
-    return 4;
+    return 5;
 }
 QVariant ProgramModel::headerData(
     int section,
@@ -95,6 +109,7 @@ QVariant ProgramModel::headerData(
             case 1: return tr("Address");
             case 2: return tr("Code");
             case 3: return tr("Instruction");
+            case 4: return tr("Heat");
             default: return tr("");
             }
         }
@@ -137,6 +152,10 @@ QVariant ProgramModel::data(const QModelIndex &index, int role) const {
             s.fill('0', 8 - t.count());
             return s + t.toUpper();
         case 3: return inst.to_str(address);
+        case 4: {
+            const machine::Profiler::Counters *c = profile(address);
+            return c != nullptr ? QString::number(c->executed) : QString("");
+        }
         default: return tr("");
         }
     }
@@ -172,9 +191,34 @@ QVariant ProgramModel::data(const QModelIndex &index, int role) const {
                 QBrush bgd(QColor(255, 173, 173));
                 return bgd;
             }
+        } else if (index.column() == 4) {
+            const machine::Profiler::Counters *c = profile(address);
+            if (c != nullptr && profile_max != 0) {
+                // White for cold instructions up to red for the hottest one
+                int shade = 255 - (int)(200 * profile_cost(*c) / profile_max);
+                QBrush bgd(QColor(255, shade, shade));
+                return bgd;
+            }
         }
         return QVariant();
     }
+    if (role == Qt::ToolTipRole && index.column() == 4) {
+        machine::Address address;
+        if (!get_row_address(address, index.row())) {
+            return QVariant();
+        }
+        const machine::Profiler::Counters *c = profile(address);
+        if (c == nullptr) {
+            return QVariant();
+        }
+        return tr("Executed: %1\nStall cycles: %2\nI-cache misses: %3\n"
+                  "D-cache misses: %4\nExceptions: %5")
+            .arg(c->executed)
+            .arg(c->stall_cycles)
+            .arg(c->icache_misses)
+            .arg(c->dcache_misses)
+            .arg(c->exceptions);
+    }
     if (role == Qt::FontRole) {
         return data_font;
     }
@@ -210,6 +254,17 @@ void ProgramModel::update_all() {
         }
     }
     stages_need_update = false;
+    profile_max = 0;
+    machine::Address address;
+    for (int row = 0; row < rowCount(); row++) {
+        if (!get_row_address(address, row)) {
+            continue;
+        }
+        const machine::Profiler::Counters *c = profile(address);
+        if (c != nullptr) {
+            profile_max = std::max(profile_max, profile_cost(*c));
+        }
+    }
     emit dataChanged(index(0, 0), index(rowCount() - 1, columnCount() - 1));
 }
 
@@ -224,6 +279,9 @@ void ProgramModel::check_for_updates() {
     if (memory_change_counter != mem->get_change_counter()) {
         need_update = true;
     }
+    if (machine->profiler() != nullptr) {
+        need_update = true;
+    }
     if (machine->cache_data() != nullptr) {
         if (cache_program_change_counter
             != machine->cache_program()->get_change_counter()) {
@@ -108,6 +108,8 @@ public slots:
 private:
     const machine::FrontendMemory *mem_access() const;
     machine::FrontendMemory *mem_access_rw() const;
+    // Profile of instruction at address, nullptr when not profiled
+    const machine::Profiler::Counters *profile(machine::Address address) const;
     machine::Address index0_offset;
     QFont data_font;
     machine::Machine *machine;
@@ -115,6 +117,7 @@ private:
     uint32_t cache_program_change_counter;
     machine::Address stage_addr[STAGEADDR_COUNT] {};
     bool stages_need_update;
+    uint64_t profile_max; // Highest cost of shown instructions for heat scale
 };
 
 #endif // PROGRAMMODEL_H
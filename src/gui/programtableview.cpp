@@ -102,6 +102,12 @@ void ProgramTableView::adjustColumnCount() {
     horizontalHeader()->setSectionResizeMode(3, QHeaderView::Stretch);
     idx = m->index(0, 3);
     totwidth += delegate->sizeHintForText(viewOpts, idx, "BEQ $18, $17, 0x80020058").width() + 2;
+
+    idx = m->index(0, 4);
+    cwidth_dh = delegate->sizeHintForText(viewOpts, idx, "0000000").width() + 2;
+    horizontalHeader()->setSectionResizeMode(4, QHeaderView::Fixed);
+    horizontalHeader()->resizeSection(4, cwidth_dh);
+    totwidth += cwidth_dh;
     totwidth += verticalHeader()->width();
     setColumnHidden(2, totwidth > width());
 
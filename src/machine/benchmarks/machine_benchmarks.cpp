@@ -0,0 +1,420 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*******************************************************************************
+ * QtMips - MIPS 32-bit Architecture Subset Simulator
+ *
+ * Implemented to support following courses:
+ *
+ *   B35APO - Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b35apo
+ *
+ *   B4M35PAP - Advanced Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b4m35pap/start
+ *
+ * Copyright (c) 2017-2019 Karel Koci<cynerd@email.cz>
+ * Copyright (c) 2019      Pavel Pisa <pisa@cmp.felk.cvut.cz>
+ *
+ * Faculty of Electrical Engineering (http://www.fel.cvut.cz)
+ * Czech Technical University        (http://www.cvut.cz/)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+/**
+ * Host throughput benchmarks of the simulator.
+ *
+ * Every workload is assembled by the integrated assembler and executed
+ * till its final break instruction on single cycle and pipelined core,
+ * both with caches enabled and disabled. One line is reported for each
+ * run:
+ *
+ *   benchmark:WORKLOAD:CORE:CACHE:instructions:N:cycles:N:mips:X:ns-per-inst:X:peak-rss-kib:N
+ *
+ * Arguments select workloads to run by name, all are run by default.
+ * Each run is executed in its own child process (the program started again
+ * with --run option), so the reported peak resident set size belongs to that
+ * single configuration only.
+ */
+
+#include "assembler/simpleasm.h"
+#include "machine/machine.h"
+#include "machine/machineconfig.h"
+
+#include <QCoreApplication>
+#include <QProcess>
+#include <QStringList>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#ifdef __unix__
+    #include <sys/resource.h>
+#endif
+
+using namespace machine;
+
+// Cycles executed by single run call between checks of the end
+constexpr unsigned int BENCHMARK_RUN_BATCH = 100000;
+
+struct Workload {
+    const char *name;
+    const char *source;
+};
+
+static const Workload workloads[] = {
+    { "alu", R"(
+// Register only arithmetic and logic
+_start:
+	li	$t0, 100000
+	li	$t1, 1
+	li	$t2, 0x12345
+loop:
+	addu	$t3, $t1, $t2
+	xor	$t1, $t3, $t2
+	sll	$t4, $t1, 3
+	subu	$t2, $t4, $t3
+	or	$t5, $t2, $t1
+	and	$t6, $t5, $t3
+	slt	$t7, $t6, $t5
+	addu	$t2, $t2, $t7
+	addiu	$t0, $t0, -1
+	bne	$t0, $zero, loop
+	nop
+	break
+)" },
+    { "memcpy", R"(
+// Word copy of 16 KiB block
+_start:
+	li	$s0, 32
+pass:
+	la	$a0, dst
+	la	$a1, src
+	li	$a2, 4096
+copy:
+	lw	$t0, 0($a1)
+	addiu	$a1, $a1, 4
+	addiu	$a2, $a2, -1
+	sw	$t0, 0($a0)
+	bne	$a2, $zero, copy
+	addiu	$a0, $a0, 4
+	addiu	$s0, $s0, -1
+	bne	$s0, $zero, pass
+	nop
+	break
+
+.org 0x80100000
+src:
+.org 0x80104000
+dst:
+)" },
+    { "matmul", R"(
+// Product of two 32x32 word matrices
+_start:
+	la	$s0, mat_a
+	la	$s1, mat_b
+	li	$t0, 1024
+	li	$t1, 0
+init:
+	sw	$t1, 0($s0)
+	sw	$t0, 0($s1)
+	addiu	$s0, $s0, 4
+	addiu	$s1, $s1, 4
+	addiu	$t0, $t0, -1
+	bne	$t0, $zero, init
+	addiu	$t1, $t1, 3
+	li	$s7, 4
+repeat:
+	la	$s0, mat_a
+	la	$s2, mat_c
+	li	$t0, 32
+row:
+	la	$s1, mat_b
+	li	$t1, 32
+col:
+	addu	$a0, $s0, $zero
+	addu	$a1, $s1, $zero
+	addu	$t3, $zero, $zero
+	li	$t2, 32
+inner:
+	lw	$t6, 0($a0)
+	lw	$t7, 0($a1)
+	addiu	$a0, $a0, 4
+	addiu	$a1, $a1, 128
+	mul	$t8, $t6, $t7
+	addiu	$t2, $t2, -1
+	bne	$t2, $zero, inner
+	addu	$t3, $t3, $t8
+	sw	$t3, 0($s2)
+	addiu	$s2, $s2, 4
+	addiu	$t1, $t1, -1
+	bne	$t1, $zero, col
+	addiu	$s1, $s1, 4
+	addiu	$t0, $t0, -1
+	bne	$t0, $zero, row
+	addiu	$s0, $s0, 128
+	addiu	$s7, $s7, -1
+	bne	$s7, $zero, repeat
+	nop
+	break
+
+.org 0x80100000
+mat_a:
+.org 0x80101000
+mat_b:
+.org 0x80102000
+mat_c:
+)" },
+    { "quicksort", R"(
+// Recursive sort of 2048 pseudo random words
+_start:
+	la	$sp, stack_top
+	li	$s7, 4
+	li	$t2, 12345
+repeat:
+	la	$t0, array
+	li	$t1, 2048
+	li	$t3, 1103515245
+fill:
+	mul	$t2, $t2, $t3
+	addiu	$t2, $t2, 12345
+	sw	$t2, 0($t0)
+	addiu	$t1, $t1, -1
+	bne	$t1, $zero, fill
+	addiu	$t0, $t0, 4
+	la	$a0, array
+	addiu	$a1, $a0, 8188
+	jal	qsort
+	nop
+	addiu	$s7, $s7, -1
+	bne	$s7, $zero, repeat
+	nop
+	break
+
+// Sorts words from $a0 to $a1 (both inclusive)
+qsort:
+	sltu	$t0, $a0, $a1
+	beq	$t0, $zero, qsort_ret
+	nop
+	addiu	$sp, $sp, -12
+	sw	$ra, 8($sp)
+	sw	$s0, 4($sp)
+	sw	$s1, 0($sp)
+	lw	$t1, 0($a1)
+	addu	$t2, $a0, $zero
+	addu	$t3, $a0, $zero
+partition:
+	lw	$t4, 0($t3)
+	slt	$t5, $t4, $t1
+	beq	$t5, $zero, no_swap
+	nop
+	lw	$t6, 0($t2)
+	sw	$t4, 0($t2)
+	sw	$t6, 0($t3)
+	addiu	$t2, $t2, 4
+no_swap:
+	addiu	$t3, $t3, 4
+	bne	$t3, $a1, partition
+	nop
+	lw	$t6, 0($t2)
+	sw	$t1, 0($t2)
+	sw	$t6, 0($a1)
+	addu	$s0, $t2, $zero
+	addu	$s1, $a1, $zero
+	jal	qsort
+	addiu	$a1, $t2, -4
+	addiu	$a0, $s0, 4
+	jal	qsort
+	addu	$a1, $s1, $zero
+	lw	$s1, 0($sp)
+	lw	$s0, 4($sp)
+	lw	$ra, 8($sp)
+	addiu	$sp, $sp, 12
+qsort_ret:
+	jr	$ra
+	nop
+
+.org 0x80100000
+array:
+.org 0x80200000
+stack_top:
+)" },
+    { "linked-list", R"(
+// Pointer chase through 4096 nodes of 16 bytes in scattered order
+_start:
+	la	$s0, nodes
+	li	$t9, 4096
+	addu	$t0, $zero, $zero
+build:
+	addiu	$t1, $t0, 1597
+	andi	$t1, $t1, 4095
+	sll	$t2, $t0, 4
+	addu	$t2, $s0, $t2
+	sll	$t3, $t1, 4
+	addu	$t3, $s0, $t3
+	sw	$t3, 0($t2)
+	sw	$t0, 4($t2)
+	addiu	$t0, $t0, 1
+	bne	$t0, $t9, build
+	nop
+	li	$s7, 48
+chase_pass:
+	li	$t0, 4096
+	addu	$t1, $s0, $zero
+	addu	$t4, $zero, $zero
+chase:
+	lw	$t2, 4($t1)
+	lw	$t1, 0($t1)
+	addiu	$t0, $t0, -1
+	bne	$t0, $zero, chase
+	addu	$t4, $t4, $t2
+	addiu	$s7, $s7, -1
+	bne	$s7, $zero, chase_pass
+	nop
+	break
+
+.org 0x80100000
+nodes:
+)" },
+    { "lcd-fill", R"(
+// Fills whole 480x320 LCD display by word stores
+_start:
+	li	$s7, 4
+	li	$t2, 0x001f001f
+frame:
+	la	$t0, 0xffe00000
+	li	$t1, 76800
+fill:
+	sw	$t2, 0($t0)
+	addiu	$t1, $t1, -1
+	bne	$t1, $zero, fill
+	addiu	$t0, $t0, 4
+	addiu	$s7, $s7, -1
+	bne	$s7, $zero, frame
+	sll	$t2, $t2, 5
+	break
+)" },
+};
+
+static long peak_rss_kib() {
+#ifdef __unix__
+    struct rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+#else
+    return 0;
+#endif
+}
+
+static bool assemble(Machine &machine, const Workload &workload) {
+    SymbolTableDb symtab(machine.symbol_table_rw(true));
+    SimpleAsm sasm;
+    QObject::connect(
+        &sasm, &SimpleAsm::report_message,
+        [](messagetype::Type, const QString &file, int line, int, const QString &text,
+           const QString &) {
+            std::cerr << file.toStdString() << ":" << line << ": " << text.toStdString()
+                      << std::endl;
+        });
+    sasm.setup(machine.memory_data_bus_rw(), &symtab, 0x80020000_addr);
+    const QStringList lines = QString(workload.source).split('\n');
+    for (int i = 0; i < lines.size(); i++) {
+        if (!sasm.process_line(lines.at(i), workload.name, i)) {
+            return false;
+        }
+    }
+    return sasm.finish();
+}
+
+// Returns false when the workload did not finish by its break instruction
+static bool run(const Workload &workload, bool pipelined, bool cache) {
+    MachineConfig config;
+    config.preset(pipelined ? CP_PIPE : CP_SINGLE_CACHE);
+    config.access_cache_program()->set_enabled(cache);
+    config.access_cache_data()->set_enabled(cache);
+    Machine machine(config, false, false);
+    if (!assemble(machine, workload)) {
+        std::cerr << workload.name << ": assembly failed" << std::endl;
+        return false;
+    }
+
+    bool stopped = false;
+    QObject::connect(
+        machine.core(), &Core::stop_on_exception_reached, [&stopped]() { stopped = true; });
+    auto start = std::chrono::steady_clock::now();
+    while (!stopped && !machine.exited()) {
+        machine.run_for(BENCHMARK_RUN_BATCH);
+    }
+    auto end = std::chrono::steady_clock::now();
+    // Any other exception (address error, overflow, ...) stops the machine too
+    if (!stopped || machine.get_exception_cause() != EXCAUSE_BREAK) {
+        std::cerr << workload.name << ": not finished by break" << std::endl;
+        return false;
+    }
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    unsigned instructions = machine.core()->get_retired_count();
+    std::cout << "benchmark:" << workload.name << ":" << (pipelined ? "pipelined" : "single")
+              << ":" << (cache ? "cache-on" : "cache-off") << ":instructions:" << instructions
+              << ":cycles:" << machine.core()->get_cycle_count() << std::fixed
+              << std::setprecision(3) << ":mips:" << instructions * 1e3 / ns
+              << ":ns-per-inst:" << ns / instructions << ":peak-rss-kib:" << peak_rss_kib()
+              << std::endl;
+    return true;
+}
+
+// Runs single configuration in child process and passes its report through
+static bool run_child(const Workload &workload, bool pipelined, bool cache) {
+    QProcess child;
+    child.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    child.start(
+        QCoreApplication::applicationFilePath(),
+        { "--run", workload.name, pipelined ? "pipelined" : "single",
+          cache ? "cache-on" : "cache-off" });
+    if (!child.waitForFinished(-1)) {
+        std::cerr << workload.name << ": " << child.errorString().toStdString() << std::endl;
+        return false;
+    }
+    std::cout << child.readAllStandardOutput().toStdString() << std::flush;
+    return child.exitStatus() == QProcess::NormalExit && child.exitCode() == 0;
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QStringList args = app.arguments().mid(1);
+
+    if (args.size() == 4 && args.at(0) == "--run") {
+        for (const Workload &workload : workloads) {
+            if (args.at(1) == workload.name) {
+                return run(workload, args.at(2) == "pipelined", args.at(3) == "cache-on") ? 0 : 1;
+            }
+        }
+        std::cerr << "unknown workload " << args.at(1).toStdString() << std::endl;
+        return 1;
+    }
+
+    bool ok = true;
+    for (const Workload &workload : workloads) {
+        if (!args.isEmpty() && !args.contains(workload.name)) {
+            continue;
+        }
+        for (bool pipelined : { false, true }) {
+            for (bool cache : { false, true }) {
+                ok = run_child(workload, pipelined, cache) && ok;
+            }
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,290 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*******************************************************************************
+ * QtMips - MIPS 32-bit Architecture Subset Simulator
+ *
+ * Implemented to support following courses:
+ *
+ *   B35APO - Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b35apo
+ *
+ *   B4M35PAP - Advanced Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b4m35pap/start
+ *
+ * Copyright (c) 2017-2019 Karel Koci<cynerd@email.cz>
+ * Copyright (c) 2019      Pavel Pisa <pisa@cmp.felk.cvut.cz>
+ *
+ * Faculty of Electrical Engineering (http://www.fel.cvut.cz)
+ * Czech Technical University        (http://www.cvut.cz/)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+
+#include "branch_predictor.h"
+
+#include <algorithm>
+
+namespace machine {
+
+std::unique_ptr<BranchPredictor>
+BranchPredictor::get_predictor_instance(const MachineConfig &config) {
+    switch (config.branch_predictor()) {
+    case MachineConfig::BP_NONE: return { nullptr };
+    case MachineConfig::BP_STATIC_NOT_TAKEN:
+        return std::make_unique<BranchPredictorStaticNotTaken>();
+    case MachineConfig::BP_BIMODAL:
+        return std::make_unique<BranchPredictorBimodal>(config.branch_predictor_bits());
+    case MachineConfig::BP_GSHARE:
+        return std::make_unique<BranchPredictorGshare>(config.branch_predictor_bits());
+    case MachineConfig::BP_TOURNAMENT:
+        return std::make_unique<BranchPredictorTournament>(config.branch_predictor_bits());
+    }
+    Q_UNREACHABLE();
+}
+
+// Two bit saturating counter, values 2 and 3 predict taken
+static inline void counter_update(uint8_t &counter, bool taken) {
+    if (taken) {
+        if (counter < 3) {
+            counter++;
+        }
+    } else if (counter > 0) {
+        counter--;
+    }
+}
+
+bool BranchPredictorStaticNotTaken::predict(Address pc) const {
+    (void)pc;
+    return false;
+}
+
+void BranchPredictorStaticNotTaken::update(Address pc, bool taken) {
+    (void)pc;
+    (void)taken;
+}
+
+std::unique_ptr<BranchPredictor> BranchPredictorStaticNotTaken::clone() const {
+    return std::make_unique<BranchPredictorStaticNotTaken>(*this);
+}
+
+// Counters start weakly not taken
+BranchPredictorBimodal::BranchPredictorBimodal(unsigned bits)
+    : counters((size_t)1 << bits, 1) {}
+
+size_t BranchPredictorBimodal::index(Address pc) const {
+    return (pc.get_raw() >> 2) & (counters.size() - 1);
+}
+
+bool BranchPredictorBimodal::predict(Address pc) const {
+    return counters[index(pc)] >= 2;
+}
+
+void BranchPredictorBimodal::update(Address pc, bool taken) {
+    counter_update(counters[index(pc)], taken);
+}
+
+std::unique_ptr<BranchPredictor> BranchPredictorBimodal::clone() const {
+    return std::make_unique<BranchPredictorBimodal>(*this);
+}
+
+BranchPredictorGshare::BranchPredictorGshare(unsigned bits)
+    : counters((size_t)1 << bits, 1) {}
+
+size_t BranchPredictorGshare::index(Address pc) const {
+    return ((pc.get_raw() >> 2) ^ history) & (counters.size() - 1);
+}
+
+bool BranchPredictorGshare::predict(Address pc) const {
+    return counters[index(pc)] >= 2;
+}
+
+void BranchPredictorGshare::update(Address pc, bool taken) {
+    counter_update(counters[index(pc)], taken);
+    history = ((history << 1) | (taken ? 1 : 0)) & (counters.size() - 1);
+}
+
+std::unique_ptr<BranchPredictor> BranchPredictorGshare::clone() const {
+    return std::make_unique<BranchPredictorGshare>(*this);
+}
+
+BranchPredictorTournament::BranchPredictorTournament(unsigned bits)
+    : local(bits)
+    , global(bits)
+    , choosers((size_t)1 << bits, 1) {}
+
+size_t BranchPredictorTournament::index(Address pc) const {
+    return (pc.get_raw() >> 2) & (choosers.size() - 1);
+}
+
+bool BranchPredictorTournament::predict(Address pc) const {
+    return choosers[index(pc)] >= 2 ? global.predict(pc) : local.predict(pc);
+}
+
+void BranchPredictorTournament::update(Address pc, bool taken) {
+    const bool local_correct = local.predict(pc) == taken;
+    const bool global_correct = global.predict(pc) == taken;
+    // Chooser moves only when exactly one of predictors was right
+    if (local_correct != global_correct) {
+        counter_update(choosers[index(pc)], global_correct);
+    }
+    local.update(pc, taken);
+    global.update(pc, taken);
+}
+
+std::unique_ptr<BranchPredictor> BranchPredictorTournament::clone() const {
+    return std::make_unique<BranchPredictorTournament>(*this);
+}
+
+BranchPredictionUnit::BranchPredictionUnit(const MachineConfig &config)
+    : kind(config.branch_predictor())
+    , mispredict_penalty(config.branch_mispredict_penalty())
+    , btb_entries(config.branch_target_buffer())
+    , ras_depth(config.return_address_stack())
+    , initial_predictor(BranchPredictor::get_predictor_instance(config)) {
+    reset();
+}
+
+BranchPredictionUnit::BranchPredictionUnit(const BranchPredictionUnit &other)
+    : kind(other.kind)
+    , mispredict_penalty(other.mispredict_penalty)
+    , btb_entries(other.btb_entries)
+    , ras_depth(other.ras_depth)
+    , initial_predictor(
+          other.initial_predictor != nullptr ? other.initial_predictor->clone() : nullptr)
+    , predictor(other.predictor != nullptr ? other.predictor->clone() : nullptr)
+    , btb(other.btb)
+    , ras(other.ras)
+    , ras_top(other.ras_top)
+    , ras_count(other.ras_count)
+    , control_count(other.control_count)
+    , branch_count(other.branch_count)
+    , mispredict_count(other.mispredict_count)
+    , pc_counts(other.pc_counts) {}
+
+void BranchPredictionUnit::reset() {
+    predictor = initial_predictor != nullptr ? initial_predictor->clone() : nullptr;
+    btb.assign(btb_entries, BtbEntry());
+    ras.assign(ras_depth, Address::null());
+    ras_top = 0;
+    ras_count = 0;
+    control_count = 0;
+    branch_count = 0;
+    mispredict_count = 0;
+    pc_counts.clear();
+}
+
+bool BranchPredictionUnit::btb_lookup(Address pc, Address &target) const {
+    if (btb.empty()) {
+        return false;
+    }
+    const BtbEntry &entry = btb[(pc.get_raw() >> 2) % btb.size()];
+    if (entry.tag != pc.get_raw()) {
+        return false;
+    }
+    target = entry.target;
+    return true;
+}
+
+void BranchPredictionUnit::btb_update(Address pc, Address target) {
+    if (btb.empty()) {
+        return;
+    }
+    BtbEntry &entry = btb[(pc.get_raw() >> 2) % btb.size()];
+    entry.tag = pc.get_raw();
+    entry.target = target;
+}
+
+bool BranchPredictionUnit::resolve(const ControlTransfer &ct) {
+    // Without predicted target fetch continues behind the delay slot
+    Address predicted = ct.inst_addr + 8;
+    Address target;
+    if (ct.ret && ras_count > 0) {
+        ras_top = (ras_top + ras.size() - 1) % ras.size();
+        ras_count--;
+        predicted = ras[ras_top];
+    } else if (!ct.conditional || predictor->predict(ct.inst_addr)) {
+        if (btb_lookup(ct.inst_addr, target)) {
+            predicted = target;
+        }
+    }
+    const bool mispredicted = predicted != ct.next_addr;
+
+    if (ct.conditional) {
+        predictor->update(ct.inst_addr, ct.taken);
+        branch_count++;
+    }
+    if (ct.taken) {
+        btb_update(ct.inst_addr, ct.next_addr);
+    }
+    if (ct.call && !ras.empty()) {
+        ras[ras_top] = ct.inst_addr + 8;
+        ras_top = (ras_top + 1) % ras.size();
+        ras_count = std::min(ras_count + 1, ras.size());
+    }
+
+    Counts &counts = pc_counts[ct.inst_addr.get_raw()];
+    counts.executed++;
+    counts.taken += ct.taken ? 1 : 0;
+    counts.mispredicted += mispredicted ? 1 : 0;
+    control_count++;
+    mispredict_count += mispredicted ? 1 : 0;
+    return mispredicted;
+}
+
+enum MachineConfig::BranchPredictor BranchPredictionUnit::get_kind() const {
+    return kind;
+}
+
+unsigned BranchPredictionUnit::get_mispredict_penalty() const {
+    return mispredict_penalty;
+}
+
+uint32_t BranchPredictionUnit::get_control_count() const {
+    return control_count;
+}
+
+uint32_t BranchPredictionUnit::get_branch_count() const {
+    return branch_count;
+}
+
+uint32_t BranchPredictionUnit::get_mispredict_count() const {
+    return mispredict_count;
+}
+
+double BranchPredictionUnit::get_accuracy() const {
+    if (control_count == 0) {
+        return 0.0;
+    }
+    return 100.0 * (control_count - mispredict_count) / control_count;
+}
+
+std::vector<BranchPredictionUnit::PcStatistics> BranchPredictionUnit::get_pc_statistics() const {
+    std::vector<PcStatistics> result;
+    result.reserve(pc_counts.size());
+    for (const auto &item : pc_counts) {
+        result.push_back({ .inst_addr = Address(item.first),
+                           .executed = item.second.executed,
+                           .taken = item.second.taken,
+                           .mispredicted = item.second.mispredicted });
+    }
+    std::sort(result.begin(), result.end(), [](const PcStatistics &a, const PcStatistics &b) {
+        return a.inst_addr < b.inst_addr;
+    });
+    return result;
+}
+
+} // namespace machine
@@ -0,0 +1,218 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*******************************************************************************
+ * QtMips - MIPS 32-bit Architecture Subset Simulator
+ *
+ * Implemented to support following courses:
+ *
+ *   B35APO - Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b35apo
+ *
+ *   B4M35PAP - Advanced Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b4m35pap/start
+ *
+ * Copyright (c) 2017-2019 Karel Koci<cynerd@email.cz>
+ * Copyright (c) 2019      Pavel Pisa <pisa@cmp.felk.cvut.cz>
+ *
+ * Faculty of Electrical Engineering (http://www.fel.cvut.cz)
+ * Czech Technical University        (http://www.cvut.cz/)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+
+#ifndef BRANCH_PREDICTOR_H
+#define BRANCH_PREDICTOR_H
+
+#include "machineconfig.h"
+#include "memory/address.h"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace machine {
+
+/**
+ * Direction predictor of conditional branches interface.
+ *
+ * Predictor is updated with the outcome of every conditional branch right
+ * after it is looked up, so prediction of the following branch always sees
+ * the resolved history.
+ */
+class BranchPredictor {
+public:
+    virtual bool predict(Address pc) const = 0;
+    virtual void update(Address pc, bool taken) = 0;
+
+    virtual ~BranchPredictor() = default;
+
+    // Independent copy including current prediction state
+    virtual std::unique_ptr<BranchPredictor> clone() const = 0;
+
+    // Returns nullptr when no prediction is configured
+    static std::unique_ptr<BranchPredictor>
+    get_predictor_instance(const MachineConfig &config);
+};
+
+/**
+ * Static predictor
+ *
+ *  Conditional branches are always predicted not taken.
+ */
+class BranchPredictorStaticNotTaken final : public BranchPredictor {
+public:
+    bool predict(Address pc) const final;
+    void update(Address pc, bool taken) final;
+
+    std::unique_ptr<BranchPredictor> clone() const final;
+};
+
+/**
+ * Bimodal predictor
+ *
+ *  Table of two bit saturating counters indexed by instruction address.
+ */
+class BranchPredictorBimodal final : public BranchPredictor {
+public:
+    explicit BranchPredictorBimodal(unsigned bits);
+
+    bool predict(Address pc) const final;
+    void update(Address pc, bool taken) final;
+
+    std::unique_ptr<BranchPredictor> clone() const final;
+
+private:
+    size_t index(Address pc) const;
+
+    std::vector<uint8_t> counters;
+};
+
+/**
+ * Gshare predictor
+ *
+ *  Table of two bit saturating counters indexed by instruction address xor
+ *  global history of conditional branch outcomes.
+ */
+class BranchPredictorGshare final : public BranchPredictor {
+public:
+    explicit BranchPredictorGshare(unsigned bits);
+
+    bool predict(Address pc) const final;
+    void update(Address pc, bool taken) final;
+
+    std::unique_ptr<BranchPredictor> clone() const final;
+
+private:
+    size_t index(Address pc) const;
+
+    std::vector<uint8_t> counters;
+    uint32_t history = 0;
+};
+
+/**
+ * Tournament predictor
+ *
+ *  Bimodal and gshare predictors run side by side, two bit counters indexed
+ *  by instruction address choose the one which was recently more accurate
+ *  for given branch.
+ */
+class BranchPredictorTournament final : public BranchPredictor {
+public:
+    explicit BranchPredictorTournament(unsigned bits);
+
+    bool predict(Address pc) const final;
+    void update(Address pc, bool taken) final;
+
+    std::unique_ptr<BranchPredictor> clone() const final;
+
+private:
+    size_t index(Address pc) const;
+
+    BranchPredictorBimodal local;
+    BranchPredictorGshare global;
+    std::vector<uint8_t> choosers; // Upper half selects gshare
+};
+
+/**
+ * Fetch stage prediction of control transfers.
+ *
+ * Combines direction predictor with branch target buffer (direct mapped,
+ * tagged by full address) and return address stack. Core reports each
+ * resolved control transfer, the unit decides whether fetch behind its delay
+ * slot would have continued at the right address and keeps per instruction
+ * statistics.
+ */
+class BranchPredictionUnit {
+public:
+    explicit BranchPredictionUnit(const MachineConfig &config);
+    BranchPredictionUnit(const BranchPredictionUnit &other);
+
+    struct ControlTransfer {
+        Address inst_addr; // Address of branch or jump instruction
+        Address next_addr; // Address fetched after delay slot
+        bool conditional;  // Conditional branch (direction is predicted)
+        bool taken;
+        bool call;         // Links return address to $ra
+        bool ret;          // Jump to $ra
+    };
+    // Returns true when control transfer was mispredicted
+    bool resolve(const ControlTransfer &ct);
+    void reset();
+
+    enum MachineConfig::BranchPredictor get_kind() const;
+    unsigned get_mispredict_penalty() const;
+
+    struct PcStatistics {
+        Address inst_addr;
+        uint32_t executed, taken, mispredicted;
+    };
+    uint32_t get_control_count() const;    // Resolved control transfers
+    uint32_t get_branch_count() const;     // Resolved conditional branches
+    uint32_t get_mispredict_count() const; // Mispredicted transfers
+    double get_accuracy() const;           // Correct predictions in percents
+    // Statistics of each executed control instruction ordered by address
+    std::vector<PcStatistics> get_pc_statistics() const;
+
+private:
+    struct BtbEntry {
+        uint64_t tag = UINT64_MAX;
+        Address target;
+    };
+    struct Counts {
+        uint32_t executed = 0, taken = 0, mispredicted = 0;
+    };
+
+    bool btb_lookup(Address pc, Address &target) const;
+    void btb_update(Address pc, Address target);
+
+    const enum MachineConfig::BranchPredictor kind;
+    const unsigned mispredict_penalty;
+    const unsigned btb_entries, ras_depth;
+    const std::unique_ptr<BranchPredictor> initial_predictor; // Used by reset
+    std::unique_ptr<BranchPredictor> predictor;
+    std::vector<BtbEntry> btb;
+    std::vector<Address> ras; // Circular, overflow overwrites the oldest entry
+    size_t ras_top = 0, ras_count = 0;
+
+    uint32_t control_count = 0, branch_count = 0, mispredict_count = 0;
+    std::unordered_map<uint64_t, Counts> pc_counts;
+};
+
+} // namespace machine
+
+#endif // BRANCH_PREDICTOR_H
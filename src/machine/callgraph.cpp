@@ -0,0 +1,256 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*******************************************************************************
+ * QtMips - MIPS 32-bit Architecture Subset Simulator
+ *
+ * Implemented to support following courses:
+ *
+ *   B35APO - Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b35apo
+ *
+ *   B4M35PAP - Advanced Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b4m35pap/start
+ *
+ * Copyright (c) 2017-2019 Karel Koci<cynerd@email.cz>
+ * Copyright (c) 2019      Pavel Pisa <pisa@cmp.felk.cvut.cz>
+ *
+ * Faculty of Electrical Engineering (http://www.fel.cvut.cz)
+ * Czech Technical University        (http://www.cvut.cz/)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+#include "callgraph.h"
+
+#include "memory/cache/cache.h"
+
+#include <algorithm>
+
+namespace machine {
+
+CallGraph::Cost &CallGraph::Cost::operator+=(const Cost &other) {
+    instructions += other.instructions;
+    cycles += other.cycles;
+    icache_misses += other.icache_misses;
+    dcache_misses += other.dcache_misses;
+    return *this;
+}
+
+CallGraph::Cost CallGraph::Cost::operator-(const Cost &other) const {
+    Cost result;
+    result.instructions = instructions - other.instructions;
+    result.cycles = cycles - other.cycles;
+    result.icache_misses = icache_misses - other.icache_misses;
+    result.dcache_misses = dcache_misses - other.dcache_misses;
+    return result;
+}
+
+CallGraph::CallGraph(const SymbolTable *symtab) : symtab(symtab) {}
+
+void CallGraph::set_caches(const Cache *program, const Cache *data) {
+    this->program = program;
+    this->data = data;
+    program_misses = program != nullptr ? program->get_miss_count() : 0;
+    data_misses = data != nullptr ? data->get_miss_count() : 0;
+}
+
+void CallGraph::retired(Address pc, const Instruction &inst) {
+    // Delay slot of call or return still belongs to the current function
+    if (pending != PENDING_NONE && pc != pending_pc + 4) {
+        if (pending == PENDING_RETURN) {
+            leave();
+        } else if (pc != pending_pc + 8) { // Not taken branch and link
+            enter(pending_pc, pc);
+        }
+        pending = PENDING_NONE;
+    }
+    if (stack.empty()) {
+        stack.push_back({ function_of(pc), pc, sum });
+        funcs[stack.back().function.get_raw()].called++;
+    }
+    position = &funcs[stack.back().function.get_raw()].self[pc.get_raw()];
+    position->instructions++;
+    sum.instructions++;
+
+    enum InstructionFlags flags = inst.flags();
+    if (flags & (IMF_PC_TO_R31 | IMF_PC8_TO_RT)) {
+        pending = PENDING_CALL;
+        pending_pc = pc;
+    } else if ((flags & IMF_JUMP) && (flags & IMF_BJR_REQ_RS) && inst.rs() == 31) {
+        pending = PENDING_RETURN;
+        pending_pc = pc;
+    }
+}
+
+void CallGraph::cycle() {
+    if (position == nullptr) {
+        return;
+    }
+    position->cycles++;
+    sum.cycles++;
+    if (program != nullptr) {
+        uint32_t misses = program->get_miss_count();
+        // Decrease is caused by statistics reset, it is not a miss
+        if (misses > program_misses) {
+            position->icache_misses += misses - program_misses;
+            sum.icache_misses += misses - program_misses;
+        }
+        program_misses = misses;
+    }
+    if (data != nullptr) {
+        uint32_t misses = data->get_miss_count();
+        if (misses > data_misses) {
+            position->dcache_misses += misses - data_misses;
+            sum.dcache_misses += misses - data_misses;
+        }
+        data_misses = misses;
+    }
+}
+
+void CallGraph::reset() {
+    funcs.clear();
+    stack.clear();
+    sum = Cost();
+    position = nullptr;
+    pending = PENDING_NONE;
+    set_caches(program, data);
+}
+
+void CallGraph::enter(Address call_site, Address target) {
+    // Call target is the function entry even inside of a bigger symbol
+    stack.push_back({ target, call_site, sum });
+    funcs[target.get_raw()].called++;
+}
+
+void CallGraph::leave() {
+    Frame frame = stack.back();
+    stack.pop_back();
+    Cost inclusive = sum - frame.entry_total;
+    // Recursive calls are already included in the outer invocation
+    bool recursive = std::any_of(stack.begin(), stack.end(), [&](const Frame &f) {
+        return f.function == frame.function;
+    });
+    if (!recursive) {
+        funcs[frame.function.get_raw()].inclusive += inclusive;
+    }
+    if (!stack.empty()) {
+        Call &call = funcs[stack.back().function.get_raw()]
+                         .calls[{ frame.call_site.get_raw(), frame.function.get_raw() }];
+        call.count++;
+        call.inclusive += inclusive;
+    }
+}
+
+void CallGraph::unwind() {
+    while (!stack.empty()) {
+        leave();
+    }
+}
+
+Address CallGraph::function_of(Address pc) const {
+    QString name;
+    SymbolValue offset;
+    if (symtab != nullptr && symtab->location_to_name(name, offset, pc.get_raw())) {
+        return pc - offset;
+    }
+    return pc;
+}
+
+QString CallGraph::function_name(Address function) const {
+    QString name;
+    SymbolValue offset;
+    if (symtab != nullptr && symtab->location_to_name(name, offset, function.get_raw())) {
+        if (offset == 0) {
+            return name;
+        }
+        return QString("%1+0x%2").arg(name).arg(offset, 0, 16);
+    }
+    return QString("0x%1").arg(function.get_raw(), 8, 16, QChar('0'));
+}
+
+std::vector<CallGraph::FunctionCost> CallGraph::functions() const {
+    CallGraph finished(*this);
+    finished.position = nullptr;
+    finished.unwind();
+    std::vector<FunctionCost> result;
+    for (const auto &entry : finished.funcs) {
+        FunctionCost fc;
+        fc.entry = Address(entry.first);
+        fc.name = function_name(fc.entry);
+        fc.calls = entry.second.called;
+        for (const auto &self : entry.second.self) {
+            fc.exclusive += self.second;
+        }
+        fc.inclusive = entry.second.inclusive;
+        result.push_back(fc);
+    }
+    std::sort(result.begin(), result.end(), [](const FunctionCost &a, const FunctionCost &b) {
+        if (a.inclusive.cycles != b.inclusive.cycles) {
+            return a.inclusive.cycles > b.inclusive.cycles;
+        }
+        return a.entry < b.entry;
+    });
+    return result;
+}
+
+CallGraph::Cost CallGraph::total() const {
+    return sum;
+}
+
+static void write_costs(std::ostream &out, uint64_t position, const CallGraph::Cost &cost) {
+    out << "0x" << std::hex << position << std::dec << ' ' << cost.instructions << ' '
+        << cost.cycles << ' ' << cost.icache_misses << ' ' << cost.dcache_misses << '\n';
+}
+
+void CallGraph::write_callgrind(std::ostream &out, const QString &command) const {
+    CallGraph finished(*this);
+    finished.position = nullptr;
+    finished.unwind();
+    // Output is ordered by address to be reproducible
+    std::map<uint64_t, const Function *> ordered;
+    for (const auto &entry : finished.funcs) {
+        ordered[entry.first] = &entry.second;
+    }
+
+    out << "# callgrind format\n"
+        << "version: 1\n"
+        << "creator: qtmips\n"
+        << "cmd: " << command.toStdString() << '\n'
+        << "positions: instr\n"
+        << "event: Ir : Instructions Retired\n"
+        << "event: Cycles : Core Cycles\n"
+        << "event: I1miss : L1 Program Cache Miss\n"
+        << "event: D1miss : L1 Data Cache Miss\n"
+        << "events: Ir Cycles I1miss D1miss\n"
+        << "summary: " << sum.instructions << ' ' << sum.cycles << ' ' << sum.icache_misses
+        << ' ' << sum.dcache_misses << "\n\n"
+        << "ob=" << command.toStdString() << '\n'
+        << "fl=" << command.toStdString() << '\n';
+    for (const auto &entry : ordered) {
+        out << "\nfn=" << function_name(Address(entry.first)).toStdString() << '\n';
+        for (const auto &self : entry.second->self) {
+            write_costs(out, self.first, self.second);
+        }
+        for (const auto &call : entry.second->calls) {
+            out << "cfn=" << function_name(Address(call.first.second)).toStdString() << '\n'
+                << "calls=" << call.second.count << " 0x" << std::hex << call.first.second
+                << std::dec << '\n';
+            write_costs(out, call.first.first, call.second.inclusive);
+        }
+    }
+}
+
+} // namespace machine
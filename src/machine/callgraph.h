@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*******************************************************************************
+ * QtMips - MIPS 32-bit Architecture Subset Simulator
+ *
+ * Implemented to support following courses:
+ *
+ *   B35APO - Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b35apo
+ *
+ *   B4M35PAP - Advanced Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b4m35pap/start
+ *
+ * Copyright (c) 2017-2019 Karel Koci<cynerd@email.cz>
+ * Copyright (c) 2019      Pavel Pisa <pisa@cmp.felk.cvut.cz>
+ *
+ * Faculty of Electrical Engineering (http://www.fel.cvut.cz)
+ * Czech Technical University        (http://www.cvut.cz/)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+#ifndef CALLGRAPH_H
+#define CALLGRAPH_H
+
+#include "instruction.h"
+#include "memory/address.h"
+#include "symboltable.h"
+
+#include <QString>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace machine {
+
+class Cache;
+
+/**
+ * Call graph profile collected by core.
+ *
+ * Calls (JAL, JALR, branch and link) and returns (JR $ra) are tracked on
+ * a shadow stack when they retire, the switch to the callee or caller takes
+ * place with the first retired instruction behind the delay slot. Cost of
+ * each cycle is charged to the function on the top of the stack and to the
+ * last retired instruction. Functions are identified by the start of the
+ * enclosing symbol, by the call target when there is none.
+ */
+class CallGraph {
+public:
+    struct Cost {
+        uint64_t instructions = 0;  // Retired instructions
+        uint64_t cycles = 0;        // Core cycles
+        uint64_t icache_misses = 0; // L1 instruction cache misses
+        uint64_t dcache_misses = 0; // L1 data cache misses
+
+        Cost &operator+=(const Cost &other);
+        Cost operator-(const Cost &other) const;
+    };
+    struct FunctionCost {
+        Address entry;
+        QString name;
+        uint64_t calls;  // Number of times function was called
+        Cost exclusive;  // Spent in the function itself
+        Cost inclusive;  // Including called functions
+    };
+
+    explicit CallGraph(const SymbolTable *symtab = nullptr);
+
+    /**
+     * Misses recorded by given caches (either can be nullptr) are charged
+     * along with cycles.
+     */
+    void set_caches(const Cache *program, const Cache *data);
+
+    void retired(Address pc, const Instruction &inst);
+    // Called after each core cycle, cycles before the first retired
+    // instruction are not counted
+    void cycle();
+    void reset();
+
+    // Costs of all functions, calls still in progress are counted as
+    // returned at this point; ordered by inclusive cycles (highest first)
+    std::vector<FunctionCost> functions() const;
+    Cost total() const;
+    // Profile in callgrind format (readable by KCachegrind)
+    void write_callgrind(std::ostream &out, const QString &command) const;
+
+private:
+    struct Frame {
+        Address function;
+        Address call_site;
+        Cost entry_total; // Total cost when function was entered
+    };
+    struct Call {
+        uint64_t count = 0;
+        Cost inclusive;
+    };
+    struct Function {
+        std::map<uint64_t, Cost> self; // Indexed by instruction address
+        // Indexed by call site and callee
+        std::map<std::pair<uint64_t, uint64_t>, Call> calls;
+        uint64_t called = 0;
+        Cost inclusive;
+    };
+    enum Pending { PENDING_NONE, PENDING_CALL, PENDING_RETURN };
+
+    Address function_of(Address pc) const;
+    QString function_name(Address function) const;
+    void enter(Address call_site, Address target);
+    void leave();
+    void unwind(); // Leave all frames
+
+    const SymbolTable *symtab;
+    std::unordered_map<uint64_t, Function> funcs;
+    std::vector<Frame> stack;
+    Cost sum;
+    Cost *position = nullptr; // Self cost of last retired instruction
+    enum Pending pending = PENDING_NONE;
+    Address pending_pc;
+
+    const Cache *program = nullptr;
+    const Cache *data = nullptr;
+    uint32_t program_misses = 0;
+    uint32_t data_misses = 0;
+};
+
+} // namespace machine
+
+#endif // CALLGRAPH_H
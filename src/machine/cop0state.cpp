@@ -42,10 +42,14 @@
 using namespace machine;
 
 #define COUNTER_IRQ_LEVEL 7
+// Overflow interrupt (IE bit) is not implemented
+#define PERF_CTL_WRITE_MASK                                                    \
+    (Cop0State::PerfCtl_Event | Cop0State::PerfCtl_U | Cop0State::PerfCtl_S     \
+     | Cop0State::PerfCtl_K | Cop0State::PerfCtl_EXL)
 
 // sorry, unimplemented: non-trivial designated initializers not supported
 
-static enum Cop0State::Cop0Registers cop0reg_map[32][8] = {
+static const enum Cop0State::Cop0Registers cop0reg_map[32][8] = {
     /*0*/ {},
     /*1*/ {},
     /*2*/ {},
@@ -71,7 +75,7 @@ static enum Cop0State::Cop0Registers cop0reg_map[32][8] = {
     /*22*/ {},
     /*23*/ {},
     /*24*/ {},
-    /*25*/ {},
+    /*25*/ { Cop0State::PerfCtl0, Cop0State::PerfCnt0, Cop0State::PerfCtl1, Cop0State::PerfCnt1 },
     /*26*/ {},
     /*27*/ {},
     /*28*/ {},
@@ -114,6 +118,18 @@ const Cop0State::cop0reg_desc_t Cop0State::cop0reg_desc[Cop0State::COP0REGS_CNT]
           [Cop0State::Config] = { "Config", 0x00000000, 0x00000000,
                                   &Cop0State::read_cop0reg_default,
                                   &Cop0State::write_cop0reg_default },
+          [Cop0State::PerfCtl0] = { "PerfCtl0", PERF_CTL_WRITE_MASK, PerfCtl_M,
+                                    &Cop0State::read_cop0reg_default,
+                                    &Cop0State::write_cop0reg_perf },
+          [Cop0State::PerfCnt0] = { "PerfCnt0", 0xffffffff, 0x00000000,
+                                    &Cop0State::read_cop0reg_default,
+                                    &Cop0State::write_cop0reg_perf },
+          [Cop0State::PerfCtl1] = { "PerfCtl1", PERF_CTL_WRITE_MASK, 0x00000000,
+                                    &Cop0State::read_cop0reg_default,
+                                    &Cop0State::write_cop0reg_perf },
+          [Cop0State::PerfCnt1] = { "PerfCnt1", 0xffffffff, 0x00000000,
+                                    &Cop0State::read_cop0reg_default,
+                                    &Cop0State::write_cop0reg_perf },
       };
 
 Cop0State::Cop0State(Core *core) : QObject() {
@@ -124,7 +140,14 @@ Cop0State::Cop0State(Core *core) : QObject() {
 Cop0State::Cop0State(const Cop0State &orig) : QObject() {
     this->core = orig.core;
     for (int i = 0; i < COP0REGS_CNT; i++) {
-        this->cop0reg[i] = orig.read_cop0reg((enum Cop0Registers)i);
+        this->cop0reg[i] = orig.cop0reg[i];
+    }
+    this->last_core_cycles = orig.last_core_cycles;
+    for (int i = 0; i < PERF_EVENT_CNT; i++) {
+        this->perf_source[i] = orig.perf_source[i];
+    }
+    for (int i = 0; i < PERF_COUNTER_CNT; i++) {
+        this->perf_last[i] = orig.perf_last[i];
     }
 }
 
@@ -211,6 +234,20 @@ void Cop0State::reset() {
         emit cop0reg_update((enum Cop0Registers)i, cop0reg[i]);
     }
     last_core_cycles = 0;
+    for (int i = 0; i < PERF_COUNTER_CNT; i++) {
+        perf_last[i] = perf_event_value(i);
+    }
+}
+
+void Cop0State::restore(const Cop0State &orig) {
+    for (int i = 1; i < COP0REGS_CNT; i++) {
+        this->cop0reg[i] = orig.cop0reg[i];
+        emit cop0reg_update((enum Cop0Registers)i, cop0reg[i]);
+    }
+    last_core_cycles = orig.last_core_cycles;
+    for (int i = 0; i < PERF_COUNTER_CNT; i++) {
+        perf_last[i] = orig.perf_last[i];
+    }
 }
 
 void Cop0State::update_execption_cause(enum ExceptionCause excause, bool in_delay_slot) {
@@ -244,6 +281,7 @@ bool Cop0State::core_interrupt_request() {
     uint32_t irqs;
 
     update_count_and_compare_irq();
+    update_perf_counters();
 
     irqs = cop0reg[(int)Status];
     irqs &= cop0reg[(int)Cause];
@@ -298,3 +336,57 @@ void Cop0State::write_cop0reg_user_local(enum Cop0Registers reg, uint32_t value)
         core->set_c0_userlocal(value);
     }
 }
+
+void Cop0State::set_perf_event_source(
+    enum PerfEvent event,
+    std::function<uint32_t()> source) {
+    update_perf_counters();
+    perf_source[(int)event] = std::move(source);
+    for (int i = 0; i < PERF_COUNTER_CNT; i++) {
+        perf_last[i] = perf_event_value(i);
+    }
+}
+
+bool Cop0State::perf_counting() const {
+    uint32_t enable = PerfCtl_EXL | PerfCtl_K | PerfCtl_S | PerfCtl_U;
+    return ((cop0reg[(int)PerfCtl0] | cop0reg[(int)PerfCtl1]) & enable) != 0;
+}
+
+uint32_t Cop0State::perf_event_value(int counter) const {
+    uint32_t ctl = cop0reg[(int)PerfCtl0 + 2 * counter];
+    uint32_t event = (ctl & PerfCtl_Event) >> PerfCtl_EventShift;
+    if (event >= PERF_EVENT_CNT || !perf_source[event]) {
+        return 0;
+    }
+    return perf_source[event]();
+}
+
+void Cop0State::update_perf_counters() {
+    // Simulated code always runs in kernel mode, K, S and U bits are not
+    // distinguished
+    bool exl = cop0reg[(int)Status] & (Status_EXL | Status_ERL);
+    uint32_t enable = exl ? PerfCtl_EXL : (PerfCtl_K | PerfCtl_S | PerfCtl_U);
+    for (int i = 0; i < PERF_COUNTER_CNT; i++) {
+        uint32_t ctl = cop0reg[(int)PerfCtl0 + 2 * i];
+        if (!(ctl & (PerfCtl_EXL | PerfCtl_K | PerfCtl_S | PerfCtl_U))) {
+            continue;
+        }
+        uint32_t value = perf_event_value(i);
+        uint32_t increase = value - perf_last[i];
+        perf_last[i] = value;
+        // Decrease is caused by reset of the event origin statistics
+        if ((ctl & enable) && (int32_t)increase > 0) {
+            int reg = (int)PerfCnt0 + 2 * i;
+            cop0reg[reg] += increase;
+            emit cop0reg_update((enum Cop0Registers)reg, cop0reg[reg]);
+        }
+    }
+}
+
+void Cop0State::write_cop0reg_perf(enum Cop0Registers reg, uint32_t value) {
+    // Events till now are counted with the previous setting
+    update_perf_counters();
+    write_cop0reg_default(reg, value);
+    int counter = ((int)reg - (int)PerfCtl0) / 2;
+    perf_last[counter] = perf_event_value(counter);
+}
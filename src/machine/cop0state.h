@@ -43,6 +43,7 @@
 #include <QObject>
 #include <QString>
 #include <cstdint>
+#include <functional>
 
 namespace machine {
 
@@ -65,6 +66,10 @@ public:
         EPC,      // Program counter at last exception
         EBase,    // Exception vector base register
         Config,   // Configuration registers
+        PerfCtl0, // Performance counter 0 control
+        PerfCnt0, // Performance counter 0
+        PerfCtl1, // Performance counter 1 control
+        PerfCnt1, // Performance counter 1
         COP0REGS_CNT,
     };
 
@@ -76,6 +81,29 @@ public:
         Status_Int0 = 0x00000100,
     };
 
+    enum PerfCtlReg {
+        PerfCtl_EXL = 0x00000001, // Count in exception level (EXL or ERL)
+        PerfCtl_K = 0x00000002,   // Count in kernel mode
+        PerfCtl_S = 0x00000004,   // Count in supervisor mode
+        PerfCtl_U = 0x00000008,   // Count in user mode
+        PerfCtl_Event = 0x00000fe0,
+        PerfCtl_M = 0x80000000, // Next counter is implemented
+    };
+    static constexpr int PerfCtl_EventShift = 5;
+    static constexpr int PERF_COUNTER_CNT = 2;
+
+    // Events selected by Event field of PerfCtl registers
+    enum PerfEvent {
+        PERF_CYCLES,
+        PERF_INSTRUCTIONS,    // Retired instructions
+        PERF_BRANCHES,        // Retired branches and jumps
+        PERF_DCACHE_MISSES,   // L1 data cache misses
+        PERF_ICACHE_MISSES,   // L1 program cache misses
+        PERF_STALL_CYCLES,    // Cycles of pipeline stall
+        PERF_LOAD_USE_STALLS, // Stall cycles caused by load-use hazard
+        PERF_EVENT_CNT,
+    };
+
     Cop0State(Core *core = nullptr);
     Cop0State(const Cop0State &);
 
@@ -93,10 +121,16 @@ public:
     bool operator!=(const Cop0State &c) const;
 
     void reset(); // Reset all values to zero
+    void restore(const Cop0State &); // Set all values from other state
 
     bool core_interrupt_request();
     Address exception_pc_address();
 
+    // Source of event count since reset of its origin, performance counters
+    // accumulate its increase. Events without source do not count.
+    void set_perf_event_source(enum PerfEvent event, std::function<uint32_t()> source);
+    bool perf_counting() const; // Some performance counter is enabled
+
 signals:
     void cop0reg_update(enum Cop0Registers reg, uint32_t val);
     void cop0reg_read(enum Cop0Registers reg, uint32_t val) const;
@@ -109,6 +143,7 @@ protected:
     void setup_core(Core *core);
     void update_execption_cause(enum ExceptionCause excause, bool in_delay_slot);
     void update_count_and_compare_irq();
+    void update_perf_counters();
 
 private:
     typedef uint32_t (Cop0State::*reg_read_t)(enum Cop0Registers reg) const;
@@ -130,9 +165,13 @@ private:
     void write_cop0reg_default(enum Cop0Registers reg, uint32_t value);
     void write_cop0reg_count_compare(enum Cop0Registers reg, uint32_t value);
     void write_cop0reg_user_local(enum Cop0Registers reg, uint32_t value);
+    void write_cop0reg_perf(enum Cop0Registers reg, uint32_t value);
+    uint32_t perf_event_value(int counter) const;
     Core *core;
     uint32_t cop0reg[COP0REGS_CNT] {}; // coprocessor 0 registers
     uint32_t last_core_cycles {};
+    std::function<uint32_t()> perf_source[PERF_EVENT_CNT];
+    uint32_t perf_last[PERF_COUNTER_CNT] {}; // Event values already counted
 };
 
 } // namespace machine
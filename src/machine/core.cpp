@@ -38,8 +38,19 @@
 #include "programloader.h"
 #include "utils.h"
 
+#include <algorithm>
+#include <cstring>
+
 using namespace machine;
 
+// Number of address bits used to index the predecoded instruction cache
+#define DECODE_CACHE_BITS 12
+// Maximal number of instructions translated into single fast path block
+#define FAST_BLOCK_MAX_OPS 64
+// Number of block entries by interpreter before it is translated to native
+// code
+#define JIT_HOT_THRESHOLD 16
+
 Core::Core(
     Registers *regs,
     FrontendMemory *mem_program,
@@ -47,9 +58,13 @@ Core::Core(
     unsigned int min_cache_row_size,
     Cop0State *cop0state)
     : ex_handlers()
-    , hw_breaks() {
+    , hw_breaks()
+    , decode_cache(1U << DECODE_CACHE_BITS) {
     cycle_c = 0;
     stall_c = 0;
+    retired_c = 0;
+    branch_c = 0;
+    load_use_c = 0;
     this->regs = regs;
     this->cop0state = cop0state;
     this->mem_program = mem_program;
@@ -65,24 +80,119 @@ Core::Core(
         step_over_exception[i] = true;
     }
     step_over_exception[EXCAUSE_INT] = false;
+    observed = false;
 }
 
 Core::~Core() {
     delete ex_default_handler;
 }
 
+void Core::connectNotify(const QMetaMethod &signal) {
+    // Pipeline visualization signals are emitted only after somebody
+    // connects to them. Headless runs (CLI, tests) skip the dispatch.
+    if (signal != QMetaMethod::fromSignal(&Core::stop_on_exception_reached)) {
+        observed = true;
+    }
+    QObject::connectNotify(signal);
+}
+
 void Core::step(bool skip_break) {
     cycle_c++;
-    emit cycle_c_value(cycle_c);
-    do_step(skip_break);
+    if (observed) {
+        emit cycle_c_value(cycle_c);
+    }
+    if (profiler == nullptr) {
+        do_step(skip_break);
+    } else {
+        Address fetch_pc = regs->read_pc();
+        do_step(skip_break);
+        profiler->cycle(fetch_pc, memory_access_pc);
+    }
+    if (call_graph != nullptr) {
+        call_graph->cycle();
+    }
+}
+
+unsigned int Core::step_block(unsigned int max_cycles, Address end_addr) {
+    unsigned int cycles = 0;
+    bool irq_enabled = false;
+    if (cop0state != nullptr) {
+        uint32_t status = cop0state->read_cop0reg(Cop0State::Status);
+        irq_enabled = (status & Cop0State::Status_IntMask)
+                      && !(status & (Cop0State::Status_EXL | Cop0State::Status_ERL));
+    }
+    // Branches are not counted by block execution
+    bool perf_counting = cop0state != nullptr && cop0state->perf_counting();
+    if (!observed && !irq_enabled && !perf_counting && hw_breaks.isEmpty()
+        && profiler == nullptr && call_graph == nullptr) {
+        cycles = do_step_block(max_cycles, end_addr);
+    }
+    if (cycles == 0) {
+        step();
+        return 1;
+    }
+    cycle_c += cycles;
+    retired_c += cycles; // Every cycle of a block retires an instruction
+    return cycles;
+}
+
+unsigned int Core::do_step_block(unsigned int max_cycles, Address end_addr) {
+    UNUSED(max_cycles)
+    UNUSED(end_addr)
+    return 0;
 }
 
 void Core::reset() {
     cycle_c = 0;
     stall_c = 0;
+    mem_stall_c = 0;
+    flush_c = 0;
+    retired_c = 0;
+    branch_c = 0;
+    load_use_c = 0;
+    if (branch_unit != nullptr) {
+        branch_unit->reset();
+    }
+    for (auto &di : decode_cache) {
+        di.valid = false;
+    }
     do_reset();
 }
 
+Core::State Core::save_state() const {
+    State state {};
+    state.cycle_c = cycle_c;
+    state.stall_c = stall_c;
+    state.mem_stall_c = mem_stall_c;
+    state.flush_c = flush_c;
+    state.retired_c = retired_c;
+    state.branch_c = branch_c;
+    state.load_use_c = load_use_c;
+    if (branch_unit != nullptr) {
+        state.branch_unit = std::make_shared<const BranchPredictionUnit>(*branch_unit);
+    }
+    state.hwr_userlocal = hwr_userlocal;
+    do_save_state(state);
+    return state;
+}
+
+void Core::restore_state(const State &state) {
+    cycle_c = state.cycle_c;
+    stall_c = state.stall_c;
+    mem_stall_c = state.mem_stall_c;
+    flush_c = state.flush_c;
+    retired_c = state.retired_c;
+    branch_c = state.branch_c;
+    load_use_c = state.load_use_c;
+    if (branch_unit != nullptr && state.branch_unit != nullptr) {
+        branch_unit = std::make_unique<BranchPredictionUnit>(*state.branch_unit);
+    }
+    hwr_userlocal = state.hwr_userlocal;
+    do_restore_state(state);
+    emit cycle_c_value(cycle_c);
+    emit stall_c_value(stall_c);
+}
+
 unsigned Core::get_cycle_count() const {
     return cycle_c;
 }
@@ -91,6 +201,50 @@ unsigned Core::get_stall_count() const {
     return stall_c;
 }
 
+unsigned Core::get_memory_stall_count() const {
+    return mem_stall_c;
+}
+
+unsigned Core::get_retired_count() const {
+    return retired_c;
+}
+
+unsigned Core::get_branch_count() const {
+    return branch_c;
+}
+
+unsigned Core::get_external_count() const {
+    return external_c;
+}
+
+unsigned Core::get_load_use_stall_count() const {
+    return load_use_c;
+}
+
+void Core::set_memory_stall_source(std::function<unsigned()> source) {
+    memory_stall_source = std::move(source);
+}
+
+void Core::set_branch_predictor(std::unique_ptr<BranchPredictionUnit> unit) {
+    branch_unit = std::move(unit);
+}
+
+const BranchPredictionUnit *Core::get_branch_predictor() const {
+    return branch_unit.get();
+}
+
+unsigned Core::get_mispredict_stall_count() const {
+    return flush_c;
+}
+
+void Core::set_profiler(Profiler *profiler) {
+    this->profiler = profiler;
+}
+
+void Core::set_call_graph(CallGraph *call_graph) {
+    this->call_graph = call_graph;
+}
+
 Registers *Core::get_regs() {
     return regs;
 }
@@ -107,6 +261,10 @@ FrontendMemory *Core::get_mem_program() {
     return mem_program;
 }
 
+Address Core::get_memory_access_pc() const {
+    return memory_access_pc;
+}
+
 Core::hwBreak::hwBreak(Address addr) : addr(addr) {
     flags = 0;
     count = 0;
@@ -126,6 +284,14 @@ bool Core::is_hwbreak(Address address) {
     return hwbrk != nullptr;
 }
 
+bool Core::has_hwbreaks() const {
+    return !hw_breaks.isEmpty();
+}
+
+void Core::set_hwbreak_log(std::vector<HwBreakHit> *log) {
+    hwbreak_log = log;
+}
+
 void Core::set_stop_on_exception(enum ExceptionCause excause, bool value) {
     stop_on_exception[excause] = value;
 }
@@ -165,6 +331,9 @@ bool Core::handle_exception(
     bool in_delay_slot,
     Address mem_ref_addr) {
     bool ret = false;
+    if (profiler != nullptr && excause != EXCAUSE_HWBREAK) {
+        profiler->exception(inst_addr);
+    }
     if (excause == EXCAUSE_HWBREAK) {
         if (in_delay_slot) {
             regs->pc_abs_jmp(jump_branch_pc);
@@ -188,6 +357,9 @@ bool Core::handle_exception(
     }
 
     ExceptionHandler *exhandler = ex_handlers.value(excause);
+    if (exhandler != nullptr || excause == EXCAUSE_INT) {
+        external_c++;
+    }
     if (exhandler != nullptr) {
         ret = exhandler->handle_exception(
             core, regs, excause, inst_addr, next_addr, jump_branch_pc, in_delay_slot, mem_ref_addr);
@@ -320,6 +492,9 @@ struct Core::dtFetch Core::fetch(bool skip_break) {
         hwBreak *brk = hw_breaks.value(inst_addr);
         if (brk != nullptr) {
             excause = EXCAUSE_HWBREAK;
+            if (hwbreak_log != nullptr) {
+                hwbreak_log->push_back({ .cycle = cycle_c, .addr = inst_addr });
+            }
         }
     }
     if (cop0state != nullptr && excause == EXCAUSE_NONE) {
@@ -328,8 +503,10 @@ struct Core::dtFetch Core::fetch(bool skip_break) {
         }
     }
 
-    emit fetch_inst_addr_value(inst_addr);
-    emit instruction_fetched(inst, inst_addr, excause, true);
+    if (observed) {
+        emit fetch_inst_addr_value(inst_addr);
+        emit instruction_fetched(inst, inst_addr, excause, true);
+    }
     return {
         .inst = inst,
         .inst_addr = inst_addr,
@@ -339,27 +516,53 @@ struct Core::dtFetch Core::fetch(bool skip_break) {
     };
 }
 
-struct Core::dtDecode Core::decode(const struct dtFetch &dt) {
-    uint8_t rwrite;
-    enum InstructionFlags flags;
-    enum AluOp alu_op;
-    enum AccessControl mem_ctl;
-    enum ExceptionCause excause = dt.excause;
+const struct Core::DecodedInstruction &
+Core::predecode(const Instruction &inst, Address inst_addr) {
+    struct DecodedInstruction &di
+        = decode_cache[(inst_addr.get_raw() >> 2) & ((1U << DECODE_CACHE_BITS) - 1)];
+    // The fetched word is compared as well, therefore code modified by
+    // program (or debugger) is decoded again on its next execution.
+    if (di.valid && di.inst_data == inst.data() && di.inst_addr == inst_addr) {
+        return di;
+    }
 
-    dt.inst.flags_alu_op_mem_ctl(flags, alu_op, mem_ctl);
+    di.valid = false;
+    inst.flags_alu_op_mem_ctl(di.flags, di.alu_op, di.mem_ctl);
 
-    if (!(flags & IMF_SUPPORTED)) {
+    if (!(di.flags & IMF_SUPPORTED)) {
         throw SIMULATOR_EXCEPTION(
             UnsupportedInstruction, "Instruction with following encoding is not supported",
-            QString::number(dt.inst.data(), 16));
+            QString::number(inst.data(), 16));
+    }
+
+    di.inst_addr = inst_addr;
+    di.inst_data = inst.data();
+    di.num_rs = inst.rs();
+    di.num_rt = inst.rt();
+    di.num_rd = inst.rd();
+    if (di.flags & IMF_ZERO_EXTEND) {
+        di.immediate_val = inst.immediate();
+    } else {
+        di.immediate_val = sign_extend(inst.immediate());
     }
+    di.excause = (di.flags & IMF_EXCEPTION) ? inst.encoded_exception() : EXCAUSE_NONE;
+    di.rwrite = (di.flags & IMF_PC_TO_R31) ? 31 : (di.flags & IMF_REGD) ? di.num_rd : di.num_rt;
+    di.valid = true;
+    return di;
+}
 
-    uint8_t num_rs = dt.inst.rs();
-    uint8_t num_rt = dt.inst.rt();
-    uint8_t num_rd = dt.inst.rd();
+struct Core::dtDecode Core::decode(const struct dtFetch &dt) {
+    enum ExceptionCause excause = dt.excause;
+
+    const struct DecodedInstruction &di = predecode(dt.inst, dt.inst_addr);
+    const enum InstructionFlags flags = di.flags;
+
+    uint8_t num_rs = di.num_rs;
+    uint8_t num_rt = di.num_rt;
+    uint8_t num_rd = di.num_rd;
     RegisterValue val_rs = regs->read_gp(num_rs);
     RegisterValue val_rt = regs->read_gp(num_rt);
-    uint32_t immediate_val;
+    uint32_t immediate_val = di.immediate_val;
     bool regwrite = flags & IMF_REGWRITE;
     bool regd = flags & IMF_REGD;
     bool regd31 = flags & IMF_PC_TO_R31;
@@ -370,37 +573,29 @@ struct Core::dtDecode Core::decode(const struct dtFetch &dt) {
     // requires rt for beq, bne
     bool bjr_req_rt = flags & IMF_BJR_REQ_RT;
 
-    if (flags & IMF_ZERO_EXTEND) {
-        immediate_val = dt.inst.immediate();
-    } else {
-        immediate_val = sign_extend(dt.inst.immediate());
-    }
-
-    if ((flags & IMF_EXCEPTION) && (excause == EXCAUSE_NONE)) {
-        excause = dt.inst.encoded_exception();
-    }
-
-    emit decode_inst_addr_value(dt.is_valid ? dt.inst_addr : STAGEADDR_NONE);
-    emit instruction_decoded(dt.inst, dt.inst_addr, excause, dt.is_valid);
-    emit decode_instruction_value(dt.inst.data());
-    emit decode_reg1_value(val_rs.as_u32());
-    emit decode_reg2_value(val_rt.as_u32());
-    emit decode_immediate_value(immediate_val);
-    emit decode_regw_value((bool)(flags & IMF_REGWRITE));
-    emit decode_memtoreg_value((bool)(flags & IMF_MEMREAD));
-    emit decode_memwrite_value((bool)(flags & IMF_MEMWRITE));
-    emit decode_memread_value((bool)(flags & IMF_MEMREAD));
-    emit decode_alusrc_value((bool)(flags & IMF_ALUSRC));
-    emit decode_regdest_value((bool)(flags & IMF_REGD));
-    emit decode_rs_num_value(num_rs);
-    emit decode_rt_num_value(num_rt);
-    emit decode_rd_num_value(num_rd);
-    emit decode_regd31_value(regd31);
+    if (excause == EXCAUSE_NONE) { excause = di.excause; }
+
+    if (observed) {
+        emit decode_inst_addr_value(dt.is_valid ? dt.inst_addr : STAGEADDR_NONE);
+        emit instruction_decoded(dt.inst, dt.inst_addr, excause, dt.is_valid);
+        emit decode_instruction_value(dt.inst.data());
+        emit decode_reg1_value(val_rs.as_u32());
+        emit decode_reg2_value(val_rt.as_u32());
+        emit decode_immediate_value(immediate_val);
+        emit decode_regw_value((bool)(flags & IMF_REGWRITE));
+        emit decode_memtoreg_value((bool)(flags & IMF_MEMREAD));
+        emit decode_memwrite_value((bool)(flags & IMF_MEMWRITE));
+        emit decode_memread_value((bool)(flags & IMF_MEMREAD));
+        emit decode_alusrc_value((bool)(flags & IMF_ALUSRC));
+        emit decode_regdest_value((bool)(flags & IMF_REGD));
+        emit decode_rs_num_value(num_rs);
+        emit decode_rt_num_value(num_rt);
+        emit decode_rd_num_value(num_rd);
+        emit decode_regd31_value(regd31);
+    }
 
     if (regd31) { val_rt = (dt.inst_addr + 8).get_raw(); }
 
-    rwrite = regd31 ? 31 : regd ? num_rd : num_rt;
-
     return {
         .inst = dt.inst,
         .memread = !!(flags & IMF_MEMREAD),
@@ -420,15 +615,15 @@ struct Core::dtDecode Core::decode(const struct dtFetch &dt) {
         .nb_skip_ds = !!(flags & IMF_NB_SKIP_DS),
         .forward_m_d_rs = false,
         .forward_m_d_rt = false,
-        .aluop = alu_op,
-        .memctl = mem_ctl,
+        .aluop = di.alu_op,
+        .memctl = di.mem_ctl,
         .num_rs = num_rs,
         .num_rt = num_rt,
         .num_rd = num_rd,
         .val_rs = val_rs,
         .val_rt = val_rt,
         .immediate_val = immediate_val,
-        .rwrite = rwrite,
+        .rwrite = di.rwrite,
         .ff_rs = FORWARD_NONE,
         .ff_rt = FORWARD_NONE,
         .inst_addr = dt.inst_addr,
@@ -514,30 +709,32 @@ struct Core::dtExecute Core::execute(const struct dtDecode &dt) {
         }
     }
 
-    emit execute_inst_addr_value(dt.is_valid ? dt.inst_addr : STAGEADDR_NONE);
-    emit instruction_executed(dt.inst, dt.inst_addr, excause, dt.is_valid);
-    emit execute_alu_value(alu_val.as_u32());
-    emit execute_reg1_value(dt.val_rs.as_u32());
-    emit execute_reg2_value(dt.val_rt.as_u32());
-    emit execute_reg1_ff_value(dt.ff_rs);
-    emit execute_reg2_ff_value(dt.ff_rt);
-    emit execute_immediate_value(dt.immediate_val);
-    emit execute_regw_value(dt.regwrite);
-    emit execute_memtoreg_value(dt.memread);
-    emit execute_memread_value(dt.memread);
-    emit execute_memwrite_value(dt.memwrite);
-    emit execute_alusrc_value(dt.alusrc);
-    emit execute_regdest_value(dt.regd);
-    emit execute_regw_num_value(dt.rwrite);
-    emit execute_rs_num_value(dt.num_rs);
-    emit execute_rt_num_value(dt.num_rt);
-    emit execute_rd_num_value(dt.num_rd);
-    if (dt.stall) {
-        emit execute_stall_forward_value(1);
-    } else if (dt.ff_rs != FORWARD_NONE || dt.ff_rt != FORWARD_NONE) {
-        emit execute_stall_forward_value(2);
-    } else {
-        emit execute_stall_forward_value(0);
+    if (observed) {
+        emit execute_inst_addr_value(dt.is_valid ? dt.inst_addr : STAGEADDR_NONE);
+        emit instruction_executed(dt.inst, dt.inst_addr, excause, dt.is_valid);
+        emit execute_alu_value(alu_val.as_u32());
+        emit execute_reg1_value(dt.val_rs.as_u32());
+        emit execute_reg2_value(dt.val_rt.as_u32());
+        emit execute_reg1_ff_value(dt.ff_rs);
+        emit execute_reg2_ff_value(dt.ff_rt);
+        emit execute_immediate_value(dt.immediate_val);
+        emit execute_regw_value(dt.regwrite);
+        emit execute_memtoreg_value(dt.memread);
+        emit execute_memread_value(dt.memread);
+        emit execute_memwrite_value(dt.memwrite);
+        emit execute_alusrc_value(dt.alusrc);
+        emit execute_regdest_value(dt.regd);
+        emit execute_regw_num_value(dt.rwrite);
+        emit execute_rs_num_value(dt.num_rs);
+        emit execute_rt_num_value(dt.num_rt);
+        emit execute_rd_num_value(dt.num_rd);
+        if (dt.stall) {
+            emit execute_stall_forward_value(1);
+        } else if (dt.ff_rs != FORWARD_NONE || dt.ff_rt != FORWARD_NONE) {
+            emit execute_stall_forward_value(2);
+        } else {
+            emit execute_stall_forward_value(0);
+        }
     }
 
     return {
@@ -546,6 +743,7 @@ struct Core::dtExecute Core::execute(const struct dtDecode &dt) {
         .memwrite = dt.memwrite,
         .regwrite = regwrite,
         .memctl = dt.memctl,
+        .branch = dt.branch || dt.jump,
         .val_rt = dt.val_rt,
         .rwrite = dt.rwrite,
         .alu_val = alu_val,
@@ -565,6 +763,7 @@ struct Core::dtMemory Core::memory(const struct dtExecute &dt) {
     bool regwrite = dt.regwrite;
 
     enum ExceptionCause excause = dt.excause;
+    memory_access_pc = dt.inst_addr;
     if (excause == EXCAUSE_NONE) {
         if (is_special_access(dt.memctl)) {
             excause = memory_special(
@@ -589,22 +788,25 @@ struct Core::dtMemory Core::memory(const struct dtExecute &dt) {
         regwrite = false;
     }
 
-    emit memory_inst_addr_value(dt.is_valid ? dt.inst_addr : STAGEADDR_NONE);
-    emit instruction_memory(dt.inst, dt.inst_addr, dt.excause, dt.is_valid);
-    emit memory_alu_value(dt.alu_val.as_u32());
-    emit memory_rt_value(dt.val_rt.as_u32());
-    emit memory_mem_value(memread ? towrite_val.as_u32() : 0);
-    emit memory_regw_value(regwrite);
-    emit memory_memtoreg_value(dt.memread);
-    emit memory_memread_value(dt.memread);
-    emit memory_memwrite_value(memwrite);
-    emit memory_regw_num_value(dt.rwrite);
-    emit memory_excause_value(excause);
+    if (observed) {
+        emit memory_inst_addr_value(dt.is_valid ? dt.inst_addr : STAGEADDR_NONE);
+        emit instruction_memory(dt.inst, dt.inst_addr, dt.excause, dt.is_valid);
+        emit memory_alu_value(dt.alu_val.as_u32());
+        emit memory_rt_value(dt.val_rt.as_u32());
+        emit memory_mem_value(memread ? towrite_val.as_u32() : 0);
+        emit memory_regw_value(regwrite);
+        emit memory_memtoreg_value(dt.memread);
+        emit memory_memread_value(dt.memread);
+        emit memory_memwrite_value(memwrite);
+        emit memory_regw_num_value(dt.rwrite);
+        emit memory_excause_value(excause);
+    }
 
     return {
         .inst = dt.inst,
         .memtoreg = memread,
         .regwrite = regwrite,
+        .branch = dt.branch,
         .rwrite = dt.rwrite,
         .towrite_val = towrite_val,
         .mem_addr = mem_addr,
@@ -617,31 +819,53 @@ struct Core::dtMemory Core::memory(const struct dtExecute &dt) {
 }
 
 void Core::writeback(const struct dtMemory &dt) {
-    emit writeback_inst_addr_value(dt.is_valid ? dt.inst_addr : STAGEADDR_NONE);
-    emit instruction_writeback(dt.inst, dt.inst_addr, dt.excause, dt.is_valid);
-    emit writeback_value(dt.towrite_val.as_u32());
-    emit writeback_memtoreg_value(dt.memtoreg);
-    emit writeback_regw_value(dt.regwrite);
-    emit writeback_regw_num_value(dt.rwrite);
+    if (observed) {
+        emit writeback_inst_addr_value(dt.is_valid ? dt.inst_addr : STAGEADDR_NONE);
+        emit instruction_writeback(dt.inst, dt.inst_addr, dt.excause, dt.is_valid);
+        emit writeback_value(dt.towrite_val.as_u32());
+        emit writeback_memtoreg_value(dt.memtoreg);
+        emit writeback_regw_value(dt.regwrite);
+        emit writeback_regw_num_value(dt.rwrite);
+    }
     if (dt.regwrite) { regs->write_gp(dt.rwrite, dt.towrite_val); }
+    if (dt.is_valid && dt.excause == EXCAUSE_NONE) {
+        retired_c++;
+        if (dt.branch) {
+            branch_c++;
+        }
+        if (profiler != nullptr) {
+            profiler->retired(dt.inst_addr);
+        }
+        if (call_graph != nullptr) {
+            call_graph->retired(dt.inst_addr, dt.inst);
+        }
+    }
 }
 
 bool Core::handle_pc(const struct dtDecode &dt) {
     bool branch = false;
-    emit instruction_program_counter(
-        dt.inst, dt.inst_addr, EXCAUSE_NONE, dt.is_valid);
+    if (observed) {
+        emit instruction_program_counter(
+            dt.inst, dt.inst_addr, EXCAUSE_NONE, dt.is_valid);
+    }
 
     if (dt.jump) {
         if (!dt.bjr_req_rs) {
             regs->pc_abs_jmp_28(dt.inst.address() << 2);
-            emit fetch_jump_value(true);
-            emit fetch_jump_reg_value(false);
+            if (observed) {
+                emit fetch_jump_value(true);
+                emit fetch_jump_reg_value(false);
+            }
         } else {
             regs->pc_abs_jmp(Address(dt.val_rs.as_u32()));
-            emit fetch_jump_value(false);
-            emit fetch_jump_reg_value(true);
+            if (observed) {
+                emit fetch_jump_value(false);
+                emit fetch_jump_reg_value(true);
+            }
+        }
+        if (observed) {
+            emit fetch_branch_value(false);
         }
-        emit fetch_branch_value(false);
         return true;
     }
 
@@ -657,9 +881,11 @@ bool Core::handle_pc(const struct dtDecode &dt) {
         if (dt.bj_not) { branch = !branch; }
     }
 
-    emit fetch_jump_value(false);
-    emit fetch_jump_reg_value(false);
-    emit fetch_branch_value(branch);
+    if (observed) {
+        emit fetch_jump_value(false);
+        emit fetch_jump_reg_value(false);
+        emit fetch_branch_value(branch);
+    }
 
     if (branch) {
         int32_t rel_offset = dt.inst.immediate() << 2;
@@ -718,6 +944,7 @@ void Core::dtExecuteInit(struct dtExecute &dt) {
     dt.memwrite = false;
     dt.regwrite = false;
     dt.memctl = AC_NONE;
+    dt.branch = false;
     dt.val_rt = 0;
     dt.rwrite = 0;
     dt.alu_val = 0;
@@ -731,6 +958,7 @@ void Core::dtMemoryInit(struct dtMemory &dt) {
     dt.inst = Instruction(0x00);
     dt.memtoreg = false;
     dt.regwrite = false;
+    dt.branch = false;
     dt.rwrite = false;
     dt.towrite_val = 0;
     dt.mem_addr = 0x0_addr;
@@ -758,10 +986,23 @@ CoreSingle::CoreSingle(
 
 CoreSingle::~CoreSingle() {
     delete dt_f;
+    delete jit;
+}
+
+void CoreSingle::set_jit(bool enable) {
+    jit_blocks.clear();
+    delete jit;
+    jit = nullptr;
+    if (enable && JitX86_64::available()) {
+        jit = new JitX86_64(dt_f != nullptr, mem_data->simulated_machine_endian);
+    }
 }
 
 void CoreSingle::do_step(bool skip_break) {
     struct dtFetch f = fetch(skip_break);
+    if (!observed && fast_step(f)) {
+        return;
+    }
     if (dt_f != nullptr) {
         struct dtFetch f_swap = *dt_f;
         *dt_f = f;
@@ -776,8 +1017,10 @@ void CoreSingle::do_step(bool skip_break) {
 
     if ((m.stop_if || (m.excause != EXCAUSE_NONE)) && dt_f != nullptr) {
         dtFetchInit(*dt_f);
-        emit instruction_fetched(dt_f->inst, dt_f->inst_addr, dt_f->excause, dt_f->is_valid);
-        emit fetch_inst_addr_value(STAGEADDR_NONE);
+        if (observed) {
+            emit instruction_fetched(dt_f->inst, dt_f->inst_addr, dt_f->excause, dt_f->is_valid);
+            emit fetch_inst_addr_value(STAGEADDR_NONE);
+        }
     } else {
         bool branch_taken = handle_pc(d);
         if (dt_f != nullptr) {
@@ -807,6 +1050,623 @@ void CoreSingle::do_reset() {
         dt_f->inst_addr = Address::null();
     }
     prev_inst_addr = Address::null();
+    blocks.clear();
+    fast_block = nullptr;
+    fast_index = 0;
+    jit_blocks.clear();
+    if (jit != nullptr) {
+        jit->flush();
+    }
+}
+
+void CoreSingle::do_save_state(State &state) const {
+    if (dt_f != nullptr) {
+        state.f = *dt_f;
+    }
+    state.prev_inst_addr = prev_inst_addr;
+}
+
+void CoreSingle::do_restore_state(const State &state) {
+    if (dt_f != nullptr) {
+        *dt_f = state.f;
+    }
+    prev_inst_addr = state.prev_inst_addr;
+    fast_block = nullptr;
+    fast_index = 0;
+}
+
+// Execute the instruction which leaves the fetch stage (or the delay slot
+// register) without building stage structures. Returns false when the
+// instruction has to be processed by the full path, no state is changed
+// in such case.
+bool CoreSingle::fast_step(const struct dtFetch &f) {
+    const struct dtFetch &dt = (dt_f != nullptr) ? *dt_f : f;
+    if (!dt.is_valid || dt.excause != EXCAUSE_NONE) {
+        return false;
+    }
+    const struct BlockOp &op = fast_op(dt);
+    fast_index++;
+    if (op.handler == nullptr) {
+        return false;
+    }
+    memory_access_pc = dt.inst_addr;
+    enum FastResult res = op.handler(this, op);
+    if (res == FAST_FALLBACK) {
+        return false;
+    }
+
+    prev_inst_addr = dt.inst_addr;
+    retired_c++;
+    if (op.flags & (IMF_BRANCH | IMF_JUMP)) {
+        branch_c++;
+    }
+    if (profiler != nullptr) {
+        profiler->retired(dt.inst_addr);
+    }
+    if (call_graph != nullptr) {
+        call_graph->retired(dt.inst_addr, dt.inst);
+    }
+    if (dt_f != nullptr) {
+        *dt_f = f;
+        dt_f->in_delay_slot = res == FAST_TAKEN;
+        if ((op.flags & IMF_NB_SKIP_DS) && res != FAST_TAKEN) {
+            dtFetchInit(*dt_f);
+        }
+    }
+    return true;
+}
+
+const struct CoreSingle::BlockOp &CoreSingle::fast_op(const struct dtFetch &dt) {
+    if (fast_block == nullptr || fast_index >= fast_block->ops.size()
+        || fast_block->ops[fast_index].inst_addr != dt.inst_addr) {
+        if (fast_block == nullptr || fast_block->closed || fast_index != fast_block->ops.size()
+            || fast_block->start + 4 * fast_index != dt.inst_addr) {
+            fast_block = &blocks[dt.inst_addr.get_raw()];
+            fast_block->start = dt.inst_addr;
+            fast_index = 0;
+        }
+        if (fast_index >= fast_block->ops.size()) {
+            // Block is extended by instructions as they are reached
+            std::vector<struct BlockOp> &ops = fast_block->ops;
+            ops.emplace_back();
+            fast_translate(ops.back(), dt.inst, dt.inst_addr);
+            size_t ds = (dt_f != nullptr) ? 1 : 0;
+            if (ops.size() > ds) {
+                const struct BlockOp &last = ops[ops.size() - 1 - ds];
+                fast_block->closed = last.handler == nullptr
+                                     || (last.flags & (IMF_JUMP | IMF_BRANCH));
+            }
+            if (ops.size() >= FAST_BLOCK_MAX_OPS) {
+                fast_block->closed = true;
+            }
+        }
+    }
+    struct BlockOp &op = fast_block->ops[fast_index];
+    if (op.inst_data != dt.inst.data()) {
+        // Code has been modified
+        fast_translate(op, dt.inst, dt.inst_addr);
+    }
+    return op;
+}
+
+// Helpers for handlers of the simplest ALU operations
+namespace {
+struct FastAddu {
+    static RegisterValue apply(uint32_t s, uint32_t t) { return s + t; }
+};
+struct FastSubu {
+    static RegisterValue apply(uint32_t s, uint32_t t) { return s - t; }
+};
+struct FastAnd {
+    static RegisterValue apply(uint32_t s, uint32_t t) { return s & t; }
+};
+struct FastOr {
+    static RegisterValue apply(uint32_t s, uint32_t t) { return s | t; }
+};
+struct FastXor {
+    static RegisterValue apply(uint32_t s, uint32_t t) { return s ^ t; }
+};
+struct FastNor {
+    static RegisterValue apply(uint32_t s, uint32_t t) { return ~(s | t); }
+};
+struct FastSlt {
+    static RegisterValue apply(uint32_t s, uint32_t t) { return (int32_t)s < (int32_t)t ? 1 : 0; }
+};
+struct FastSltu {
+    static RegisterValue apply(uint32_t s, uint32_t t) { return s < t ? 1 : 0; }
+};
+struct FastLui {
+    static RegisterValue apply(uint32_t, uint32_t t) { return t << 16U; }
+};
+struct FastSll {
+    static RegisterValue apply(uint32_t t, uint32_t sa) { return t << sa; }
+};
+struct FastSrl {
+    static RegisterValue apply(uint32_t t, uint32_t sa) { return t >> sa; }
+};
+struct FastSra {
+    static RegisterValue apply(uint32_t t, uint32_t sa) { return (int32_t)t >> sa; }
+};
+} // namespace
+
+void CoreSingle::fast_translate(struct BlockOp &op, const Instruction &inst, Address inst_addr) {
+    inst.flags_alu_op_mem_ctl(op.flags, op.alu_op, op.mem_ctl);
+    op.inst_addr = inst_addr;
+    op.inst_data = inst.data();
+    op.num_rs = inst.rs();
+    op.num_rt = inst.rt();
+    op.num_rd = inst.rd();
+    op.shamt = inst.shamt();
+    if (op.flags & IMF_ZERO_EXTEND) {
+        op.immediate_val = inst.immediate();
+    } else {
+        op.immediate_val = sign_extend(inst.immediate());
+    }
+    op.rwrite = (op.flags & IMF_PC_TO_R31) ? 31 : (op.flags & IMF_REGD) ? op.num_rd : op.num_rt;
+    if (op.flags & IMF_JUMP) {
+        op.target = inst.address() << 2;
+    } else {
+        int32_t rel_offset = inst.immediate() << 2;
+        if (rel_offset & (1 << 17)) { rel_offset -= 1 << 18; }
+        op.target = inst_addr + rel_offset + 4;
+    }
+    op.handler = nullptr;
+
+    const enum InstructionFlags flags = op.flags;
+    if (!(flags & IMF_SUPPORTED) || (flags & (IMF_EXCEPTION | IMF_STOP_IF))
+        || is_special_access(op.mem_ctl)) {
+        return;
+    }
+    switch (op.alu_op) {
+    case ALU_OP_RDHWR:
+    case ALU_OP_MTC0:
+    case ALU_OP_MFC0:
+    case ALU_OP_MFMC0:
+    case ALU_OP_ERET: return;
+    default: break;
+    }
+    op.handler = &CoreSingle::op_generic;
+
+    const bool reg_res = (flags & IMF_REGWRITE) && !(flags & (IMF_PC_TO_R31 | IMF_PC8_TO_RT));
+    if (flags & (IMF_MEMREAD | IMF_MEMWRITE)) {
+        if (op.alu_op == ALU_OP_ADDU && (flags & IMF_ALUSRC) && is_regular_access(op.mem_ctl)) {
+            if ((flags & IMF_MEMREAD) && !(flags & IMF_MEMWRITE) && reg_res) {
+                op.handler = &CoreSingle::op_load;
+            } else if ((flags & IMF_MEMWRITE) && !(flags & (IMF_MEMREAD | IMF_REGWRITE))) {
+                op.handler = &CoreSingle::op_store;
+            }
+        }
+    } else if (flags & IMF_JUMP) {
+        if (!(flags & IMF_REGWRITE)) {
+            if (flags & IMF_BJR_REQ_RS) {
+                op.handler = &CoreSingle::op_jump_reg;
+            } else {
+                op.handler = &CoreSingle::op_jump;
+            }
+        }
+    } else if (flags & IMF_BRANCH) {
+        if ((flags & IMF_BJR_REQ_RT) && !(flags & IMF_REGWRITE)) {
+            if (flags & IMF_BJ_NOT) {
+                op.handler = &CoreSingle::op_branch_eq<true>;
+            } else {
+                op.handler = &CoreSingle::op_branch_eq<false>;
+            }
+        }
+    } else if (reg_res && (flags & IMF_ALUSRC)) {
+        switch (op.alu_op) {
+        case ALU_OP_ADDU: op.handler = &CoreSingle::op_alu_imm<FastAddu>; break;
+        case ALU_OP_AND: op.handler = &CoreSingle::op_alu_imm<FastAnd>; break;
+        case ALU_OP_OR: op.handler = &CoreSingle::op_alu_imm<FastOr>; break;
+        case ALU_OP_XOR: op.handler = &CoreSingle::op_alu_imm<FastXor>; break;
+        case ALU_OP_SLT: op.handler = &CoreSingle::op_alu_imm<FastSlt>; break;
+        case ALU_OP_SLTU: op.handler = &CoreSingle::op_alu_imm<FastSltu>; break;
+        case ALU_OP_LUI: op.handler = &CoreSingle::op_alu_imm<FastLui>; break;
+        default: break;
+        }
+    } else if (reg_res) {
+        switch (op.alu_op) {
+        case ALU_OP_ADDU: op.handler = &CoreSingle::op_alu_reg<FastAddu>; break;
+        case ALU_OP_SUBU: op.handler = &CoreSingle::op_alu_reg<FastSubu>; break;
+        case ALU_OP_AND: op.handler = &CoreSingle::op_alu_reg<FastAnd>; break;
+        case ALU_OP_OR: op.handler = &CoreSingle::op_alu_reg<FastOr>; break;
+        case ALU_OP_XOR: op.handler = &CoreSingle::op_alu_reg<FastXor>; break;
+        case ALU_OP_NOR: op.handler = &CoreSingle::op_alu_reg<FastNor>; break;
+        case ALU_OP_SLT: op.handler = &CoreSingle::op_alu_reg<FastSlt>; break;
+        case ALU_OP_SLTU: op.handler = &CoreSingle::op_alu_reg<FastSltu>; break;
+        case ALU_OP_SLL: op.handler = &CoreSingle::op_shift<FastSll>; break;
+        case ALU_OP_SRL: op.handler = &CoreSingle::op_shift<FastSrl>; break;
+        case ALU_OP_SRA: op.handler = &CoreSingle::op_shift<FastSra>; break;
+        default: break;
+        }
+    }
+}
+
+// Same semantics as execute(), memory(), writeback() and handle_pc()
+// for instruction which does not raise exception.
+enum CoreSingle::FastResult CoreSingle::op_generic(CoreSingle *core, const struct BlockOp &op) {
+    Registers *regs = core->regs;
+    const enum InstructionFlags flags = op.flags;
+    RegisterValue val_rs = regs->read_gp(op.num_rs);
+    RegisterValue val_rt;
+    if (flags & (IMF_PC8_TO_RT | IMF_PC_TO_R31)) {
+        val_rt = (op.inst_addr + 8).get_raw();
+    } else {
+        val_rt = regs->read_gp(op.num_rt);
+    }
+    RegisterValue alu_sec = val_rt;
+    if (flags & IMF_ALUSRC) { alu_sec = op.immediate_val; }
+
+    bool discard = false;
+    enum ExceptionCause excause = EXCAUSE_NONE;
+    RegisterValue alu_val = alu_operate(
+        op.alu_op, val_rs, alu_sec, op.shamt, op.num_rd, regs, discard, excause);
+    if (excause != EXCAUSE_NONE) {
+        // Operations raising exception have no side effects
+        return FAST_FALLBACK;
+    }
+
+    if (is_regular_access(op.mem_ctl)) {
+        if (flags & IMF_MEMWRITE) {
+            core->mem_data->write_ctl(op.mem_ctl, Address(alu_val.as_u32()), val_rt);
+        }
+        if (flags & IMF_MEMREAD) {
+            alu_val = core->mem_data->read_ctl(op.mem_ctl, Address(alu_val.as_u32()));
+        }
+    }
+    if ((flags & IMF_REGWRITE) && !discard) { regs->write_gp(op.rwrite, alu_val); }
+
+    if (flags & IMF_JUMP) {
+        if (!(flags & IMF_BJR_REQ_RS)) {
+            regs->pc_abs_jmp_28(op.target);
+        } else {
+            regs->pc_abs_jmp(Address(val_rs.as_u32()));
+        }
+        return FAST_TAKEN;
+    }
+    if (flags & IMF_BRANCH) {
+        bool branch;
+        if (flags & IMF_BJR_REQ_RT) {
+            branch = val_rs.as_u32() == val_rt.as_u32();
+        } else if (!(flags & IMF_BGTZ_BLEZ)) {
+            branch = val_rs.as_i32() < 0;
+        } else {
+            branch = val_rs.as_i32() <= 0;
+        }
+        if (flags & IMF_BJ_NOT) { branch = !branch; }
+        if (branch) {
+            regs->pc_abs_jmp(op.target);
+            return FAST_TAKEN;
+        }
+    }
+    regs->pc_inc();
+    return FAST_NEXT;
+}
+
+template<typename F>
+enum CoreSingle::FastResult CoreSingle::op_alu_reg(CoreSingle *core, const struct BlockOp &op) {
+    Registers *regs = core->regs;
+    regs->write_gp(
+        op.rwrite,
+        F::apply(regs->read_gp(op.num_rs).as_u32(), regs->read_gp(op.num_rt).as_u32()));
+    regs->pc_inc();
+    return FAST_NEXT;
+}
+
+template<typename F>
+enum CoreSingle::FastResult CoreSingle::op_alu_imm(CoreSingle *core, const struct BlockOp &op) {
+    Registers *regs = core->regs;
+    regs->write_gp(op.rwrite, F::apply(regs->read_gp(op.num_rs).as_u32(), op.immediate_val));
+    regs->pc_inc();
+    return FAST_NEXT;
+}
+
+template<typename F>
+enum CoreSingle::FastResult CoreSingle::op_shift(CoreSingle *core, const struct BlockOp &op) {
+    Registers *regs = core->regs;
+    regs->write_gp(op.rwrite, F::apply(regs->read_gp(op.num_rt).as_u32(), op.shamt));
+    regs->pc_inc();
+    return FAST_NEXT;
+}
+
+enum CoreSingle::FastResult CoreSingle::op_load(CoreSingle *core, const struct BlockOp &op) {
+    Registers *regs = core->regs;
+    Address mem_addr = Address(regs->read_gp(op.num_rs).as_u32() + op.immediate_val);
+    regs->write_gp(op.rwrite, core->mem_data->read_ctl(op.mem_ctl, mem_addr));
+    regs->pc_inc();
+    return FAST_NEXT;
+}
+
+enum CoreSingle::FastResult CoreSingle::op_store(CoreSingle *core, const struct BlockOp &op) {
+    Registers *regs = core->regs;
+    Address mem_addr = Address(regs->read_gp(op.num_rs).as_u32() + op.immediate_val);
+    core->mem_data->write_ctl(op.mem_ctl, mem_addr, regs->read_gp(op.num_rt));
+    regs->pc_inc();
+    return FAST_NEXT;
+}
+
+template<bool bj_not>
+enum CoreSingle::FastResult
+CoreSingle::op_branch_eq(CoreSingle *core, const struct BlockOp &op) {
+    Registers *regs = core->regs;
+    bool branch = regs->read_gp(op.num_rs).as_u32() == regs->read_gp(op.num_rt).as_u32();
+    if (branch != bj_not) {
+        regs->pc_abs_jmp(op.target);
+        return FAST_TAKEN;
+    }
+    regs->pc_inc();
+    return FAST_NEXT;
+}
+
+enum CoreSingle::FastResult CoreSingle::op_jump(CoreSingle *core, const struct BlockOp &op) {
+    core->regs->pc_abs_jmp_28(op.target);
+    return FAST_TAKEN;
+}
+
+enum CoreSingle::FastResult CoreSingle::op_jump_reg(CoreSingle *core, const struct BlockOp &op) {
+    Registers *regs = core->regs;
+    regs->pc_abs_jmp(Address(regs->read_gp(op.num_rs).as_u32()));
+    return FAST_TAKEN;
+}
+
+// Runs translated blocks while the next one is available. Instructions which
+// are not translated and exceptions are left to the regular step.
+unsigned int CoreSingle::do_step_block(unsigned int max_cycles, Address end_addr) {
+    if (jit == nullptr) {
+        return run_blocks(max_cycles, end_addr);
+    }
+    if (regs->signals_observed()) {
+        return 0;
+    }
+    Address next;
+    if (dt_f != nullptr) {
+        if (!dt_f->is_valid || dt_f->excause != EXCAUSE_NONE || dt_f->in_delay_slot
+            || regs->read_pc() != dt_f->inst_addr + 4) {
+            return 0;
+        }
+        next = dt_f->inst_addr;
+    } else {
+        next = regs->read_pc();
+    }
+
+    JitContext &ctx = jit->context();
+    ctx.gp = regs->gp_storage();
+    ctx.hi = regs->hi_lo_storage(true);
+    ctx.lo = regs->hi_lo_storage(false);
+    ctx.mem_data = mem_data;
+    ctx.jump_limit = std::min(end_addr.get_raw() - 4, (uint64_t)0xffffffff);
+    ctx.stores = 0;
+    // Host pointers are valid only while no other code runs
+    jit->tlb_flush();
+
+    unsigned int cycles = 0;
+    bool in_delay_slot = false;
+    while (cycles < max_cycles) {
+        struct JitBlock *block = jit_block(next, cycles == 0);
+        if (block == nullptr || block->length > max_cycles - cycles
+            || next + 4 * block->length + 4 >= end_addr) {
+            break;
+        }
+        if (cycles == 0 && dt_f != nullptr) {
+            // Instruction in delay slot register could be fetched
+            // before its modification
+            uint32_t word;
+            memcpy(&word, block->words.data(), 4);
+            if (byteswap_if(word, mem_program->simulated_machine_endian != NATIVE_ENDIAN)
+                != dt_f->inst.data()) {
+                break;
+            }
+        }
+        jit->run(*block);
+        unsigned int executed = ctx.executed;
+        if (executed == 0) {
+            break;
+        }
+        cycles += executed;
+        prev_inst_addr = next + 4 * (executed - 1);
+        if (block->branch >= 0 && executed == (unsigned)block->branch + 1 && dt_f != nullptr) {
+            // Stopped before delay slot
+            in_delay_slot = true;
+            next = next + 4 * executed;
+            break;
+        }
+        if (executed != block->length) {
+            next = next + 4 * executed;
+            break;
+        }
+        next = block->branch >= 0 ? Address(ctx.jump_addr) : next + 4 * executed;
+    }
+    if (ctx.stores) {
+        mem_data->direct_write_done();
+    }
+    if (cycles == 0) {
+        return 0;
+    }
+
+    if (dt_f != nullptr) {
+        *dt_f = {
+            .inst = Instruction(mem_program->read_u32(next)),
+            .inst_addr = next,
+            .excause = EXCAUSE_NONE,
+            .in_delay_slot = in_delay_slot && ctx.taken,
+            .is_valid = true,
+        };
+        regs->pc_abs_jmp(in_delay_slot ? Address(ctx.jump_addr) : next + 4);
+    } else {
+        regs->pc_abs_jmp(next);
+    }
+    return cycles;
+}
+
+// Handlers of translated instructions are chained directly, the fetch stage
+// is replaced by comparison of the translated word with program memory
+// accessed through host pointer the same way as native code does. Program
+// memory behind enabled cache has no direct access, it is left to the
+// regular step which keeps cache statistics exact. The read only pointer
+// does not unshare program image, it is looked up again after every memory
+// access instruction, which can copy the section.
+unsigned int CoreSingle::run_blocks(unsigned int max_cycles, Address end_addr) {
+    struct Block *block = fast_block;
+    size_t index = fast_index - 1; // Position of the last executed instruction
+    const byte *page = nullptr;
+    uint32_t page_addr = 1; // Not aligned, no page accessed yet
+    unsigned int cycles = 0;
+
+    if (dt_f == nullptr) {
+        while (cycles < max_cycles) {
+            const struct BlockOp *op
+                = run_blocks_op(regs->read_pc(), block, index, page, page_addr);
+            if (op == nullptr) {
+                break;
+            }
+            memory_access_pc = op->inst_addr;
+            if (op->handler(this, *op) == FAST_FALLBACK) {
+                break;
+            }
+            if (op->flags & IMF_MEM) {
+                page_addr = 1;
+            }
+            prev_inst_addr = op->inst_addr;
+            fast_block = block;
+            fast_index = index + 1;
+            cycles++;
+            if (regs->read_pc() >= end_addr) {
+                break;
+            }
+        }
+        return cycles;
+    }
+
+    // Instruction in delay slot register is executed while the one at PC
+    // is fetched. The former could be fetched before its modification.
+    if (!dt_f->is_valid || dt_f->excause != EXCAUSE_NONE) {
+        return 0;
+    }
+    const struct BlockOp *op = run_blocks_op(dt_f->inst_addr, block, index, page, page_addr);
+    if (op == nullptr || op->inst_data != dt_f->inst.data()) {
+        return 0;
+    }
+    struct Block *op_block = block;
+    size_t op_index = index;
+    bool in_delay_slot = dt_f->in_delay_slot;
+    while (cycles < max_cycles) {
+        const struct BlockOp *next
+            = run_blocks_op(regs->read_pc(), block, index, page, page_addr);
+        if (next == nullptr) {
+            break;
+        }
+        memory_access_pc = op->inst_addr;
+        enum FastResult res = op->handler(this, *op);
+        if (res == FAST_FALLBACK) {
+            break;
+        }
+        if (op->flags & IMF_MEM) {
+            page_addr = 1;
+        }
+        prev_inst_addr = op->inst_addr;
+        cycles++;
+        if ((op->flags & IMF_NB_SKIP_DS) && res != FAST_TAKEN) {
+            // Fetched instruction is discarded, the regular step
+            // processes the bubble
+            dtFetchInit(*dt_f);
+            fast_block = block;
+            fast_index = index + 1;
+            return cycles;
+        }
+        in_delay_slot = res == FAST_TAKEN;
+        op = next;
+        op_block = block;
+        op_index = index;
+        if (regs->read_pc() >= end_addr) {
+            break;
+        }
+    }
+    fast_block = op_block;
+    fast_index = op_index;
+    if (cycles != 0) {
+        *dt_f = {
+            .inst = Instruction(op->inst_data),
+            .inst_addr = op->inst_addr,
+            .excause = EXCAUSE_NONE,
+            .in_delay_slot = in_delay_slot,
+            .is_valid = true,
+        };
+    }
+    return cycles;
+}
+
+// Returns translated instruction at the address if it is still the same as
+// the one in program memory. Block and index are advanced to its position.
+const struct CoreSingle::BlockOp *CoreSingle::run_blocks_op(
+    Address addr,
+    struct Block *&block,
+    size_t &index,
+    const byte *&page,
+    uint32_t &page_addr) {
+    if (block == nullptr || index + 1 >= block->ops.size()
+        || block->ops[index + 1].inst_addr != addr) {
+        auto it = blocks.find(addr.get_raw());
+        if (it == blocks.end() || it->second.ops.empty()) {
+            return nullptr;
+        }
+        block = &it->second;
+        index = 0;
+    } else {
+        index++;
+    }
+    const struct BlockOp &op = block->ops[index];
+    if (op.handler == nullptr) {
+        return nullptr;
+    }
+    uint32_t offset = addr.get_raw() & (JIT_PAGE_SIZE - 1);
+    if (addr.get_raw() - offset != page_addr) {
+        page_addr = addr.get_raw() - offset;
+        page = mem_program->direct_read(Address(page_addr), JIT_PAGE_SIZE);
+    }
+    if (page == nullptr) {
+        return nullptr;
+    }
+    uint32_t word;
+    memcpy(&word, page + offset, 4);
+    if (byteswap_if(word, mem_program->simulated_machine_endian != NATIVE_ENDIAN)
+        != op.inst_data) {
+        return nullptr;
+    }
+    return &op;
+}
+
+struct JitBlock *CoreSingle::jit_block(Address start, bool cold_entry) {
+    const byte *code = jit->code_access(mem_program, start);
+    if (code == nullptr) {
+        return nullptr;
+    }
+    auto it = jit_blocks.find(start.get_raw());
+    if (it == jit_blocks.end()) {
+        if (!cold_entry) {
+            return nullptr;
+        }
+        it = jit_blocks.emplace(start.get_raw(), JitBlock()).first;
+    }
+    struct JitBlock &block = it->second;
+    if (block.code == nullptr && !block.failed) {
+        if (!cold_entry || ++block.hotness < JIT_HOT_THRESHOLD) {
+            return nullptr;
+        }
+    } else if (memcmp(block.words.data(), code, block.words.size()) == 0) {
+        return block.failed ? nullptr : &block;
+    }
+
+    // Not translated yet or code has been modified
+    size_t max_insts = (JIT_PAGE_SIZE - (start.get_raw() & (JIT_PAGE_SIZE - 1))) / 4;
+    if (!jit->compile(block, start, code, max_insts)) {
+        jit->flush();
+        for (auto &b : jit_blocks) {
+            b.second.code = nullptr;
+        }
+        if (!jit->compile(block, start, code, max_insts)) {
+            block.failed = true;
+        }
+    }
+    return block.code != nullptr ? &block : nullptr;
 }
 
 CorePipelined::CorePipelined(
@@ -822,8 +1682,46 @@ CorePipelined::CorePipelined(
 }
 
 void CorePipelined::do_step(bool skip_break) {
+    if (mem_stall_pending > 0 || flush_pending > 0) {
+        // Whole pipeline waits until memory access of some earlier cycle is
+        // finished (accesses done in the same cycle are serialized) or until
+        // instructions fetched from mispredicted path are flushed.
+        if (mem_stall_pending > 0) {
+            mem_stall_pending--;
+            mem_stall_c++;
+            if (profiler != nullptr) {
+                profiler->stalled(memory_access_pc);
+            }
+        } else {
+            flush_pending--;
+            flush_c++;
+            if (profiler != nullptr) {
+                // Mispredicted control transfer is held in decode latch
+                profiler->stalled(dt_d.inst_addr);
+            }
+        }
+        stall_c++;
+        if (observed) {
+            emit hu_stall_value(true);
+            emit stall_c_value(stall_c);
+        }
+        return;
+    }
+    if (!memory_stall_source) {
+        step_stages(skip_break);
+        return;
+    }
+    unsigned waited = memory_stall_source();
+    step_stages(skip_break);
+    waited = memory_stall_source() - waited;
+    // Ignore decrease caused by statistics reset during the cycle
+    mem_stall_pending = (int)waited > 0 ? waited : 0;
+}
+
+void CorePipelined::step_stages(bool skip_break) {
     bool stall = false;
     bool branch_stall = false;
+    bool load_use = false; // Stall waits for value loaded from memory
     bool excpt_in_progress;
     Address jump_branch_pc = dt_m.inst_addr;
 
@@ -837,20 +1735,26 @@ void CorePipelined::do_step(bool skip_break) {
     excpt_in_progress = dt_m.excause != EXCAUSE_NONE;
     if (excpt_in_progress) {
         dtExecuteInit(dt_e);
-        emit instruction_executed(dt_e.inst, dt_e.inst_addr, dt_e.excause, dt_e.is_valid);
-        emit execute_inst_addr_value(STAGEADDR_NONE);
+        if (observed) {
+            emit instruction_executed(dt_e.inst, dt_e.inst_addr, dt_e.excause, dt_e.is_valid);
+            emit execute_inst_addr_value(STAGEADDR_NONE);
+        }
     }
     excpt_in_progress = excpt_in_progress || dt_e.excause != EXCAUSE_NONE;
     if (excpt_in_progress) {
         dtDecodeInit(dt_d);
-        emit instruction_decoded(dt_d.inst, dt_d.inst_addr, dt_d.excause, dt_d.is_valid);
-        emit decode_inst_addr_value(STAGEADDR_NONE);
+        if (observed) {
+            emit instruction_decoded(dt_d.inst, dt_d.inst_addr, dt_d.excause, dt_d.is_valid);
+            emit decode_inst_addr_value(STAGEADDR_NONE);
+        }
     }
     excpt_in_progress = excpt_in_progress || dt_e.excause != EXCAUSE_NONE;
     if (excpt_in_progress) {
         dtFetchInit(dt_f);
-        emit instruction_fetched(dt_f.inst, dt_f.inst_addr, dt_f.excause, dt_f.is_valid);
-        emit fetch_inst_addr_value(STAGEADDR_NONE);
+        if (observed) {
+            emit instruction_fetched(dt_f.inst, dt_f.inst_addr, dt_f.excause, dt_f.is_valid);
+            emit fetch_inst_addr_value(STAGEADDR_NONE);
+        }
         if (dt_m.excause != EXCAUSE_NONE) {
             regs->pc_abs_jmp(dt_e.inst_addr);
             handle_exception(
@@ -897,6 +1801,7 @@ void CorePipelined::do_step(bool skip_break) {
             if (hazard_unit == MachineConfig::HU_STALL_FORWARD) {
                 if (dt_e.memread) {
                     stall = true;
+                    load_use = true;
                 } else {
                     // Forward result value
                     if (dt_d.alu_req_rs && dt_e.rwrite == dt_d.num_rs) {
@@ -918,12 +1823,14 @@ void CorePipelined::do_step(bool skip_break) {
                 || (dt_d.bjr_req_rt && dt_d.num_rt == dt_e.rwrite))) {
             stall = true;
             branch_stall = true;
+            load_use = load_use || dt_e.memread;
         } else {
             if (hazard_unit != MachineConfig::HU_STALL_FORWARD || dt_m.memtoreg) {
                 if (dt_m.rwrite != 0 && dt_m.regwrite
                     && ((dt_d.bjr_req_rs && dt_d.num_rs == dt_m.rwrite)
                         || (dt_d.bjr_req_rt && dt_d.num_rt == dt_m.rwrite))) {
                     stall = true;
+                    load_use = load_use || dt_m.memtoreg;
                 }
             } else {
                 if (dt_m.rwrite != 0 && dt_m.regwrite && dt_d.bjr_req_rs
@@ -938,10 +1845,14 @@ void CorePipelined::do_step(bool skip_break) {
                 }
             }
         }
-        emit forward_m_d_rs_value(dt_d.forward_m_d_rs);
-        emit forward_m_d_rt_value(dt_d.forward_m_d_rt);
+        if (observed) {
+            emit forward_m_d_rs_value(dt_d.forward_m_d_rs);
+            emit forward_m_d_rt_value(dt_d.forward_m_d_rt);
+        }
+    }
+    if (observed) {
+        emit branch_forward_value((dt_d.forward_m_d_rs || dt_d.forward_m_d_rt) ? 2 : branch_stall);
     }
-    emit branch_forward_value((dt_d.forward_m_d_rs || dt_d.forward_m_d_rt) ? 2 : branch_stall);
 #if 0
     if (stall)
         printf("STALL\n");
@@ -959,19 +1870,27 @@ void CorePipelined::do_step(bool skip_break) {
 
     if (dt_e.stop_if || dt_m.stop_if) { stall = true; }
 
-    emit hu_stall_value(stall);
+    if (observed) {
+        emit hu_stall_value(stall);
+    }
 
     // Now process program counter (loop connections from decode stage)
     if (!stall && !dt_d.stop_if) {
         dt_d.stall = false;
         dt_f = fetch(skip_break);
-        if (handle_pc(dt_d)) {
+        const bool taken = handle_pc(dt_d);
+        if (branch_unit != nullptr && (dt_d.branch || dt_d.jump)) {
+            resolve_control_transfer(dt_d, taken);
+        }
+        if (taken) {
             dt_f.in_delay_slot = true;
         } else {
             if (dt_d.nb_skip_ds) {
                 dtFetchInit(dt_f);
-                emit instruction_fetched(dt_f.inst, dt_f.inst_addr, dt_f.excause, dt_f.is_valid);
-                emit fetch_inst_addr_value(STAGEADDR_NONE);
+                if (observed) {
+                    emit instruction_fetched(dt_f.inst, dt_f.inst_addr, dt_f.excause, dt_f.is_valid);
+                    emit fetch_inst_addr_value(STAGEADDR_NONE);
+                }
             }
         }
     } else {
@@ -989,7 +1908,33 @@ void CorePipelined::do_step(bool skip_break) {
     }
     if (stall || dt_d.stop_if) {
         stall_c++;
-        emit stall_c_value(stall_c);
+        if (load_use) {
+            load_use_c++;
+        }
+        if (profiler != nullptr) {
+            // Charged to instruction which waits for decode
+            profiler->stalled(dt_d.stop_if ? dt_d.inst_addr : dt_f.inst_addr);
+        }
+        if (observed) {
+            emit stall_c_value(stall_c);
+        }
+    }
+}
+
+void CorePipelined::resolve_control_transfer(const struct dtDecode &dt, bool taken) {
+    // Fetch of the delay slot is already on its way, prediction decides
+    // where fetch continues after it
+    const bool call = dt.regwrite && dt.rwrite == 31;
+    const BranchPredictionUnit::ControlTransfer ct = {
+        .inst_addr = dt.inst_addr,
+        .next_addr = Address(regs->read_pc()),
+        .conditional = dt.branch,
+        .taken = taken,
+        .call = call,
+        .ret = dt.jump && dt.bjr_req_rs && dt.num_rs == 31 && !call,
+    };
+    if (branch_unit->resolve(ct)) {
+        flush_pending += branch_unit->get_mispredict_penalty();
     }
 }
 
@@ -1002,6 +1947,26 @@ void CorePipelined::do_reset() {
     dt_e.inst_addr = 0x0_addr;
     dtMemoryInit(dt_m);
     dt_m.inst_addr = 0x0_addr;
+    mem_stall_pending = 0;
+    flush_pending = 0;
+}
+
+void CorePipelined::do_save_state(State &state) const {
+    state.f = dt_f;
+    state.d = dt_d;
+    state.e = dt_e;
+    state.m = dt_m;
+    state.mem_stall_pending = mem_stall_pending;
+    state.flush_pending = flush_pending;
+}
+
+void CorePipelined::do_restore_state(const State &state) {
+    dt_f = state.f;
+    dt_d = state.d;
+    dt_e = state.e;
+    dt_m = state.m;
+    mem_stall_pending = state.mem_stall_pending;
+    flush_pending = state.flush_pending;
 }
 
 bool StopExceptionHandler::handle_exception(
@@ -37,16 +37,25 @@
 #define CORE_H
 
 #include "alu.h"
+#include "branch_predictor.h"
+#include "callgraph.h"
 #include "cop0state.h"
 #include "instruction.h"
+#include "jit/jit_x86_64.h"
 #include "machineconfig.h"
 #include "memory/address.h"
 #include "memory/frontend_memory.h"
+#include "profiler.h"
 #include "register_value.h"
 #include "registers.h"
 #include "simulator_exception.h"
 
+#include <QMetaMethod>
 #include <QObject>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace machine {
 
@@ -93,23 +102,63 @@ public:
     ~Core() override;
 
     void step(bool skip_break = false); // Do single step
+    // Run up to max_cycles without leaving address range below end_addr.
+    // Stops at instruction which can raise exception, hit breakpoint or
+    // accept interrupt. Executes at least single step, returns number of
+    // executed cycles.
+    unsigned int step_block(unsigned int max_cycles, Address end_addr);
     void reset(); // Reset core (only core, memory and registers has to be
                   // reseted separately)
 
     unsigned get_cycle_count() const; // Returns number of executed
                                       // get_cycle_count
     unsigned get_stall_count() const; // Returns number of stall get_cycle_count
+    unsigned get_memory_stall_count() const; // Returns number of stall cycles
+                                             // spent waiting for memory
+    unsigned get_retired_count() const; // Returns number of retired instructions
+    unsigned get_branch_count() const;  // Returns number of retired branches
+                                        // and jumps
+    unsigned get_load_use_stall_count() const; // Returns number of stall cycles
+                                               // caused by load-use hazards
+    // Returns number of exceptions with effects coming from outside of the
+    // simulated machine (interrupts, registered handlers as OS emulation),
+    // it is not reset
+    unsigned get_external_count() const;
+    // Source of the number of cycles memory hierarchy spent waiting on misses
+    // and uncached accesses since its reset. Pipelined core stalls for every
+    // increase observed during a cycle. Empty source disables the model.
+    void set_memory_stall_source(std::function<unsigned()> source);
+    // Fetch stage prediction of control transfers used by pipelined core,
+    // nullptr disables the model
+    void set_branch_predictor(std::unique_ptr<BranchPredictionUnit> unit);
+    const BranchPredictionUnit *get_branch_predictor() const;
+    unsigned get_mispredict_stall_count() const; // Returns number of cycles
+                                                 // lost by mispredictions
+    // Per instruction profile collector (owned by caller), nullptr disables
+    // profiling. Block execution is not used while profiling.
+    void set_profiler(Profiler *profiler);
+    // Call graph collector (owned by caller), nullptr disables it
+    void set_call_graph(CallGraph *call_graph);
 
     Registers *get_regs();
     Cop0State *get_cop0state();
     FrontendMemory *get_mem_data();
     FrontendMemory *get_mem_program();
+    // Address of instruction in memory stage (the one accessing data memory)
+    Address get_memory_access_pc() const;
     void register_exception_handler(
         ExceptionCause excause,
         ExceptionHandler *exhandler);
     void insert_hwbreak(Address address);
     void remove_hwbreak(Address address);
     bool is_hwbreak(Address address);
+    bool has_hwbreaks() const;
+    struct HwBreakHit {
+        unsigned int cycle;
+        Address addr;
+    };
+    // Append every hardware breakpoint hit in fetch to log (nullptr stops logging)
+    void set_hwbreak_log(std::vector<HwBreakHit> *log);
     void set_stop_on_exception(enum ExceptionCause excause, bool value);
     bool get_stop_on_exception(enum ExceptionCause excause) const;
     void set_step_over_exception(enum ExceptionCause excause, bool value);
@@ -221,6 +270,10 @@ signals:
 protected:
     virtual void do_step(bool skip_break = false) = 0;
     virtual void do_reset() = 0;
+    // Returns zero when the block run is not possible in current state
+    virtual unsigned int do_step_block(unsigned int max_cycles, Address end_addr);
+
+    void connectNotify(const QMetaMethod &signal) override;
 
     bool handle_exception(
         Core *core,
@@ -292,6 +345,7 @@ protected:
         bool memwrite;
         bool regwrite;
         enum AccessControl memctl;
+        bool branch; // Branch or jump
         RegisterValue val_rt;
         uint8_t rwrite;
         // Writeback register (multiplexed between rt and rd according to regd)
@@ -306,6 +360,7 @@ protected:
         Instruction inst;
         bool memtoreg;
         bool regwrite;
+        bool branch;
         uint8_t rwrite;
         RegisterValue towrite_val;
         Address mem_addr;  // Address used to access memory
@@ -316,6 +371,27 @@ protected:
         bool is_valid;
     };
 
+    // Control information which depends only on the instruction word.
+    // It is kept per instruction address so that repeated execution of the
+    // same code does not walk the instruction map again.
+    struct DecodedInstruction {
+        Address inst_addr;          // Address the entry belongs to
+        uint32_t inst_data;         // Instruction word the entry was decoded from
+        bool valid;
+        enum InstructionFlags flags;
+        enum AluOp alu_op;
+        enum AccessControl mem_ctl;
+        enum ExceptionCause excause; // Exception encoded in instruction (syscall, break)
+        uint8_t num_rs;
+        uint8_t num_rt;
+        uint8_t num_rd;
+        uint8_t rwrite;
+        uint32_t immediate_val; // zero or sign-extended immediate value
+    };
+
+    const struct DecodedInstruction &
+    predecode(const Instruction &inst, Address inst_addr);
+
     struct dtFetch fetch(bool skip_break = false);
     struct dtDecode decode(const struct dtFetch &);
     struct dtExecute execute(const struct dtDecode &);
@@ -338,8 +414,47 @@ protected:
     static void dtExecuteInit(struct dtExecute &dt);
     static void dtMemoryInit(struct dtMemory &dt);
 
+public:
+    // Copy of core internal state (counters and stage latches) used by
+    // checkpoints. Latches not present in given core kind are not used.
+    struct State {
+        unsigned int cycle_c;
+        unsigned int stall_c;
+        unsigned int mem_stall_c;
+        unsigned int mem_stall_pending;
+        unsigned int flush_c;
+        unsigned int flush_pending;
+        unsigned int retired_c;
+        unsigned int branch_c;
+        unsigned int load_use_c;
+        std::shared_ptr<const BranchPredictionUnit> branch_unit;
+        uint32_t hwr_userlocal;
+        struct dtFetch f;
+        struct dtDecode d;
+        struct dtExecute e;
+        struct dtMemory m;
+        Address prev_inst_addr;
+    };
+    State save_state() const;
+    // State has to be saved from core of the same kind and configuration
+    void restore_state(const State &);
+
 protected:
+    virtual void do_save_state(State &state) const = 0;
+    virtual void do_restore_state(const State &state) = 0;
+
     unsigned int stall_c;
+    Address memory_access_pc; // Set by stage or fast path accessing data
+    unsigned int mem_stall_c;
+    std::function<unsigned()> memory_stall_source;
+    unsigned int flush_c;
+    unsigned int retired_c;
+    unsigned int branch_c;
+    unsigned int load_use_c;
+    std::unique_ptr<BranchPredictionUnit> branch_unit;
+    Profiler *profiler = nullptr;
+    CallGraph *call_graph = nullptr;
+    bool observed; // Some stage signal is connected (visualization is active)
 
 private:
     struct hwBreak {
@@ -349,9 +464,12 @@ private:
         unsigned int count;
     };
     unsigned int cycle_c;
+    unsigned int external_c = 0;
     unsigned int min_cache_row_size;
     uint32_t hwr_userlocal;
     QMap<Address, hwBreak *> hw_breaks;
+    std::vector<HwBreakHit> *hwbreak_log = nullptr;
+    std::vector<struct DecodedInstruction> decode_cache;
     bool stop_on_exception[EXCAUSE_COUNT] {};
     bool step_over_exception[EXCAUSE_COUNT] {};
 };
@@ -367,13 +485,88 @@ public:
         Cop0State *cop0state = nullptr);
     ~CoreSingle() override;
 
+    // Enable native code translation of hot blocks (if host supports it)
+    void set_jit(bool enable);
+
 protected:
     void do_step(bool skip_break = false) override;
     void do_reset() override;
+    unsigned int do_step_block(unsigned int max_cycles, Address end_addr) override;
+    void do_save_state(State &state) const override;
+    void do_restore_state(const State &state) override;
 
 private:
     struct Core::dtFetch *dt_f;
     Address prev_inst_addr {};
+
+    // Fast path used when no stage signal is observed. Code is translated
+    // into basic blocks of instructions with pre-resolved handlers.
+    // Instruction which can raise exception or touches Cop0 has no handler
+    // and it is processed by full fetch/decode/execute/memory/writeback path.
+    enum FastResult {
+        FAST_FALLBACK, // Nothing done, use full path
+        FAST_NEXT,     // PC incremented
+        FAST_TAKEN,    // Jump or taken branch
+    };
+    struct BlockOp;
+    typedef enum FastResult (*BlockOpHandler)(CoreSingle *core, const struct BlockOp &op);
+    struct BlockOp {
+        BlockOpHandler handler; // nullptr if full path has to be used
+        Address inst_addr;
+        uint32_t inst_data;
+        enum InstructionFlags flags;
+        enum AluOp alu_op;
+        enum AccessControl mem_ctl;
+        uint8_t num_rs;
+        uint8_t num_rt;
+        uint8_t num_rd;
+        uint8_t rwrite;
+        uint8_t shamt;
+        uint32_t immediate_val;
+        Address target; // Branch target or J/JAL target before PC region merge
+    };
+    struct Block {
+        Address start;
+        std::vector<struct BlockOp> ops;
+        bool closed = false; // Block ends with control transfer (and delay slot)
+    };
+
+    bool fast_step(const struct dtFetch &f);
+    const struct BlockOp &fast_op(const struct dtFetch &dt);
+    static void fast_translate(struct BlockOp &op, const Instruction &inst, Address inst_addr);
+
+    static enum FastResult op_generic(CoreSingle *core, const struct BlockOp &op);
+    template<typename F>
+    static enum FastResult op_alu_reg(CoreSingle *core, const struct BlockOp &op);
+    template<typename F>
+    static enum FastResult op_alu_imm(CoreSingle *core, const struct BlockOp &op);
+    template<typename F>
+    static enum FastResult op_shift(CoreSingle *core, const struct BlockOp &op);
+    static enum FastResult op_load(CoreSingle *core, const struct BlockOp &op);
+    static enum FastResult op_store(CoreSingle *core, const struct BlockOp &op);
+    template<bool bj_not>
+    static enum FastResult op_branch_eq(CoreSingle *core, const struct BlockOp &op);
+    static enum FastResult op_jump(CoreSingle *core, const struct BlockOp &op);
+    static enum FastResult op_jump_reg(CoreSingle *core, const struct BlockOp &op);
+
+    std::unordered_map<uint32_t, struct Block> blocks;
+    struct Block *fast_block = nullptr; // Block and index of expected
+    size_t fast_index = 0;              // next instruction
+
+    // Threaded dispatch of translated blocks by step_block() without JIT
+    unsigned int run_blocks(unsigned int max_cycles, Address end_addr);
+    const struct BlockOp *run_blocks_op(
+        Address addr,
+        struct Block *&block,
+        size_t &index,
+        const byte *&page,
+        uint32_t &page_addr);
+
+    // Native code of blocks entered by step_block() often enough
+    struct JitBlock *jit_block(Address start, bool cold_entry);
+
+    JitX86_64 *jit = nullptr;
+    std::unordered_map<uint32_t, struct JitBlock> jit_blocks;
 };
 
 class CorePipelined : public Core {
@@ -390,14 +583,22 @@ public:
 protected:
     void do_step(bool skip_break = false) override;
     void do_reset() override;
+    void do_save_state(State &state) const override;
+    void do_restore_state(const State &state) override;
 
 private:
+    void step_stages(bool skip_break);
+    void resolve_control_transfer(const struct dtDecode &dt, bool taken);
+
     struct Core::dtFetch dt_f;
     struct Core::dtDecode dt_d;
     struct Core::dtExecute dt_e;
     struct Core::dtMemory dt_m;
 
     enum MachineConfig::HazardUnit hazard_unit;
+    unsigned int mem_stall_pending; // Cycles left until memory access is done
+    unsigned int flush_pending;     // Cycles left until mispredicted fetch
+                                    // is redirected
 };
 
 } // namespace machine
@@ -45,10 +45,11 @@
 #include <cctype>
 #include <cstring>
 #include <utility>
+#include <vector>
 
 using namespace machine;
 
-bool Instruction::symbolic_registers_fl = false;
+std::atomic<bool> Instruction::symbolic_registers_fl { false };
 
 #define IMF_SUB_ENCODE(bits, shift) (((bits) << 8) | (shift))
 #define IMF_SUB_GET_BITS(subcode) (((subcode) >> 8) & 0xff)
@@ -176,17 +177,21 @@ static const ArgumentDesc argdeslist[] = {
     ArgumentDesc('z', 'n', FIELD_IGNORE, 0, 0, 0),               // must be zero register
 };
 
-static const ArgumentDesc *argdesbycode[(int)('z' + 1)];
-
-static bool fill_argdesbycode() {
-    uint i;
-    for (i = 0; i < sizeof(argdeslist) / sizeof(*argdeslist); i++) {
-        argdesbycode[(uint)argdeslist[i].name] = &argdeslist[i];
+struct ArgumentDescTable {
+    ArgumentDescTable() {
+        for (const ArgumentDesc &desc : argdeslist) {
+            bycode[(uint)desc.name] = &desc;
+        }
     }
-    return true;
-}
+    const ArgumentDesc *bycode[(int)('z' + 1)] {};
+};
 
-bool argdesbycode_filled = fill_argdesbycode();
+static const ArgumentDesc *argdesbycode(uint code) {
+    // Function local static is initialized exactly once even when machines
+    // are simulated in parallel threads, the table is read only then.
+    static const ArgumentDescTable table;
+    return code < sizeof(table.bycode) / sizeof(*table.bycode) ? table.bycode[code] : nullptr;
+}
 
 struct RegisterDesc {
     int kind;
@@ -1770,7 +1775,7 @@ static const struct InstructionMap instruction_map[] = {
 
 #undef IM_UNKNOWN
 
-static inline const struct InstructionMap &InstructionMapFind(uint32_t code) {
+static inline const struct InstructionMap &InstructionMapFindTree(uint32_t code) {
     const struct InstructionMap *im = instruction_map;
     uint32_t flags = instruction_map_opcode_field;
     do {
@@ -1783,6 +1788,106 @@ static inline const struct InstructionMap &InstructionMapFind(uint32_t code) {
     } while (true);
 }
 
+// Flattened form of instruction_map used for decoding.
+// The subtree of each opcode is expanded into one direct mapped block of
+// instruction_decode_table indexed by all selector fields used in that
+// subtree. Selector bits of any subtree form at most two continuous runs
+// (funct and RS for COP0), both are extracted by shift and mask.
+// Entries carry copy of the fields needed by decode, so the common queries
+// are answered by single table load without touching InstructionMap.
+struct InstructionDecodeDesc {
+    unsigned int flags;
+    uint32_t code;
+    uint32_t mask;
+    enum AluOp alu;
+    enum AccessControl mem_ctl;
+    const struct InstructionMap *im;
+};
+
+struct InstructionDecodeOpcode {
+    const struct InstructionDecodeDesc *table;
+    uint32_t mask_lo;
+    uint32_t mask_hi;
+    uint8_t shift_lo;
+    uint8_t shift_hi;
+    uint8_t bits_lo;
+};
+
+static struct InstructionDecodeOpcode instruction_decode_opcode[64];
+static std::vector<struct InstructionDecodeDesc> instruction_decode_table;
+
+static uint32_t instruction_map_selector_mask(const struct InstructionMap *im, unsigned int flags) {
+    unsigned int bits = IMF_SUB_GET_BITS(flags);
+    unsigned int shift = IMF_SUB_GET_SHIFT(flags);
+    uint32_t mask = ((1U << bits) - 1) << shift;
+    for (unsigned int i = 0; i < 1U << bits; i++) {
+        if (im[i].subclass != nullptr) {
+            mask |= instruction_map_selector_mask(im[i].subclass, im[i].flags);
+        }
+    }
+    return mask;
+}
+
+static bool fill_instruction_decode_table() {
+    size_t base[64];
+    for (uint32_t opcode = 0; opcode < 64; opcode++) {
+        struct InstructionDecodeOpcode &dop = instruction_decode_opcode[opcode];
+        const struct InstructionMap &im = instruction_map[opcode];
+        uint32_t mask = 0;
+        if (im.subclass != nullptr) { mask = instruction_map_selector_mask(im.subclass, im.flags); }
+
+        unsigned int shift_lo = 0, bits_lo = 0, shift_hi = 0, bits_hi = 0;
+        if (mask != 0) {
+            while (!(mask & (1U << shift_lo))) { shift_lo++; }
+            while (shift_lo + bits_lo < 32 && (mask & (1U << (shift_lo + bits_lo)))) { bits_lo++; }
+            uint32_t rest = mask & ~(((1U << bits_lo) - 1) << shift_lo);
+            if (rest != 0) {
+                shift_hi = shift_lo + bits_lo;
+                while (!(rest & (1U << shift_hi))) { shift_hi++; }
+                while (shift_hi + bits_hi < 32 && (rest & (1U << (shift_hi + bits_hi)))) {
+                    bits_hi++;
+                }
+                SANITY_ASSERT(
+                    rest == (((1U << bits_hi) - 1) << shift_hi),
+                    "Instruction map selectors do not form at most two bit runs");
+            }
+        }
+
+        dop.mask_lo = (1U << bits_lo) - 1;
+        dop.mask_hi = (1U << bits_hi) - 1;
+        dop.shift_lo = shift_lo;
+        dop.shift_hi = shift_hi;
+        dop.bits_lo = bits_lo;
+        base[opcode] = instruction_decode_table.size();
+
+        for (uint32_t i = 0; i < 1U << (bits_lo + bits_hi); i++) {
+            uint32_t code
+                = (opcode << 26) | ((i & dop.mask_lo) << shift_lo) | ((i >> bits_lo) << shift_hi);
+            const struct InstructionMap &leaf = InstructionMapFindTree(code);
+            instruction_decode_table.push_back(
+                { leaf.flags, leaf.code, leaf.mask, leaf.alu, leaf.mem_ctl, &leaf });
+        }
+    }
+    // Table is complete, pointers into it are stable now
+    for (uint32_t opcode = 0; opcode < 64; opcode++) {
+        instruction_decode_opcode[opcode].table = instruction_decode_table.data() + base[opcode];
+    }
+    return true;
+}
+
+bool instruction_decode_table_filled = fill_instruction_decode_table();
+
+static inline const struct InstructionDecodeDesc &InstructionDecodeFind(uint32_t code) {
+    const struct InstructionDecodeOpcode &dop = instruction_decode_opcode[code >> 26];
+    return dop.table
+        [((code >> dop.shift_lo) & dop.mask_lo)
+         | (((code >> dop.shift_hi) & dop.mask_hi) << dop.bits_lo)];
+}
+
+static inline const struct InstructionMap &InstructionMapFind(uint32_t code) {
+    return *InstructionDecodeFind(code).im;
+}
+
 Instruction::Instruction() {
     this->dt = 0;
 }
@@ -1873,32 +1978,42 @@ enum Instruction::Type Instruction::type() const {
 }
 
 enum InstructionFlags Instruction::flags() const {
-    const struct InstructionMap &im = InstructionMapFind(dt);
-    return (enum InstructionFlags)im.flags;
+    return (enum InstructionFlags)InstructionDecodeFind(dt).flags;
 }
 enum AluOp Instruction::alu_op() const {
-    const struct InstructionMap &im = InstructionMapFind(dt);
-    return im.alu;
+    return InstructionDecodeFind(dt).alu;
 }
 
 enum AccessControl Instruction::mem_ctl() const {
-    const struct InstructionMap &im = InstructionMapFind(dt);
-    return im.mem_ctl;
+    return InstructionDecodeFind(dt).mem_ctl;
 }
 
 void Instruction::flags_alu_op_mem_ctl(
     enum InstructionFlags &flags,
     enum AluOp &alu_op,
     enum AccessControl &mem_ctl) const {
-    const struct InstructionMap &im = InstructionMapFind(dt);
+    const struct InstructionDecodeDesc &desc = InstructionDecodeFind(dt);
+    flags = (enum InstructionFlags)desc.flags;
+    alu_op = desc.alu;
+    mem_ctl = desc.mem_ctl;
+#if 1
+    if ((dt ^ desc.code) & (desc.mask)) {
+        flags = (enum InstructionFlags)(flags & ~IMF_SUPPORTED);
+    }
+#endif
+}
+
+void Instruction::flags_alu_op_mem_ctl_tree_walk(
+    enum InstructionFlags &flags,
+    enum AluOp &alu_op,
+    enum AccessControl &mem_ctl) const {
+    const struct InstructionMap &im = InstructionMapFindTree(dt);
     flags = (enum InstructionFlags)im.flags;
     alu_op = im.alu;
     mem_ctl = im.mem_ctl;
-#if 1
     if ((dt ^ im.code) & (im.mask)) {
         flags = (enum InstructionFlags)(flags & ~IMF_SUPPORTED);
     }
-#endif
 }
 
 enum ExceptionCause Instruction::encoded_exception() const {
@@ -1936,7 +2051,6 @@ QString Instruction::to_str(Address inst_addr) const {
     // TODO there are exception where some fields are zero and such so we should
     // not print them in such case
     if (dt == 0) { return QString("NOP"); }
-    SANITY_ASSERT(argdesbycode_filled, QString("argdesbycode_filled not initialized"));
     QString res;
     QString next_delim = " ";
     if (im.type == T_UNKNOWN) { return QString("UNKNOWN"); }
@@ -1950,7 +2064,7 @@ QString Instruction::to_str(Address inst_addr) const {
             if (!a) {
                 continue;
             }
-            const ArgumentDesc *adesc = argdesbycode[a];
+            const ArgumentDesc *adesc = argdesbycode(a);
             if (adesc == nullptr) {
                 res += ao;
                 continue;
@@ -1991,26 +2105,21 @@ QString Instruction::to_str(Address inst_addr) const {
     return res;
 }
 
-QMultiMap<QString, uint32_t> str_to_instruction_code_map;
-
-void instruction_from_string_build_base(
-    const InstructionMap *im = nullptr,
-    unsigned int flags = 0,
-    uint32_t base_code = 0) {
+static void instruction_from_string_build_base(
+    QMultiMap<QString, uint32_t> &str_to_instruction_code_map,
+    const InstructionMap *im,
+    unsigned int flags,
+    uint32_t base_code) {
     uint32_t code;
 
-    if (im == nullptr) {
-        im = instruction_map;
-        flags = instruction_map_opcode_field;
-        base_code = 0;
-    }
     unsigned int bits = IMF_SUB_GET_BITS(flags);
     unsigned int shift = IMF_SUB_GET_SHIFT(flags);
 
     for (unsigned int i = 0; i < 1U << bits; i++, im++) {
         code = base_code | (i << shift);
         if (im->subclass) {
-            instruction_from_string_build_base(im->subclass, im->flags, code);
+            instruction_from_string_build_base(
+                str_to_instruction_code_map, im->subclass, im->flags, code);
             continue;
         }
         if (!(im->flags & IMF_SUPPORTED)) {
@@ -2031,6 +2140,15 @@ void instruction_from_string_build_base(
 #endif
 }
 
+static const QMultiMap<QString, uint32_t> &str_to_instruction_code_map() {
+    static const QMultiMap<QString, uint32_t> map = []() {
+        QMultiMap<QString, uint32_t> map;
+        instruction_from_string_build_base(map, instruction_map, instruction_map_opcode_field, 0);
+        return map;
+    }();
+    return map;
+}
+
 static int parse_reg_from_string(QString str, uint *chars_taken = nullptr) {
     int res;
     int i;
@@ -2120,15 +2238,13 @@ ssize_t Instruction::code_from_string(
     bool pseudo_opt,
     int options) {
     const char *err = "unknown instruction";
-    if (str_to_instruction_code_map.isEmpty()) {
-        instruction_from_string_build_base();
-    }
+    const QMultiMap<QString, uint32_t> &code_map = str_to_instruction_code_map();
 
     int field = 0;
     uint32_t inst_code = 0;
-    auto i = str_to_instruction_code_map.lowerBound(inst_base);
+    auto i = code_map.lowerBound(inst_base);
     for (;; i++) {
-        if (i == str_to_instruction_code_map.end()) {
+        if (i == code_map.end()) {
             break;
         }
         if (i.key() != inst_base) {
@@ -2154,7 +2270,7 @@ ssize_t Instruction::code_from_string(
                     continue;
                 }
                 fl = fl.trimmed();
-                const ArgumentDesc *adesc = argdesbycode[a];
+                const ArgumentDesc *adesc = argdesbycode(a);
                 if (adesc == nullptr) {
                     if (!fl.count()) {
                         err = "empty argument encountered";
@@ -2419,11 +2535,7 @@ bool Instruction::update(int64_t val, RelocExpression *relocexp) {
 }
 
 void Instruction::append_recognized_instructions(QStringList &list) {
-    if (str_to_instruction_code_map.isEmpty()) {
-        instruction_from_string_build_base();
-    }
-
-    foreach (const QString &str, str_to_instruction_code_map.keys())
+    foreach (const QString &str, str_to_instruction_code_map().keys())
         list.append(str);
     list.append("LA");
     list.append("LI");
@@ -42,6 +42,7 @@
 #include <QString>
 #include <QStringList>
 #include <QVector>
+#include <atomic>
 #include <utility>
 
 namespace machine {
@@ -165,6 +166,12 @@ public:
         enum InstructionFlags &flags,
         enum AluOp &alu_op,
         enum AccessControl &mem_ctl) const;
+    // Same as flags_alu_op_mem_ctl but walks instruction map tree instead
+    // of the flattened decode table. Reference for tests and benchmarks.
+    void flags_alu_op_mem_ctl_tree_walk(
+        enum InstructionFlags &flags,
+        enum AluOp &alu_op,
+        enum AccessControl &mem_ctl) const;
 
     bool is_break() const;
 
@@ -207,7 +214,8 @@ public:
 
 private:
     uint32_t dt;
-    static bool symbolic_registers_fl;
+    // Written by GUI, read by disassembly running in any thread
+    static std::atomic<bool> symbolic_registers_fl;
 };
 
 } // namespace machine
@@ -0,0 +1,1007 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*******************************************************************************
+ * QtMips - MIPS 32-bit Architecture Subset Simulator
+ *
+ * Implemented to support following courses:
+ *
+ *   B35APO - Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b35apo
+ *
+ *   B4M35PAP - Advanced Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b4m35pap/start
+ *
+ * Copyright (c) 2017-2019 Karel Koci<cynerd@email.cz>
+ * Copyright (c) 2019      Pavel Pisa <pisa@cmp.felk.cvut.cz>
+ *
+ * Faculty of Electrical Engineering (http://www.fel.cvut.cz)
+ * Czech Technical University        (http://www.cvut.cz/)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+#include "jit/jit_x86_64.h"
+
+#include "instruction.h"
+#include "memory/frontend_memory.h"
+
+#include <cstring>
+
+#if JIT_X86_64_ENABLED
+    #include <sys/mman.h>
+#endif
+
+using namespace machine;
+
+static_assert(sizeof(JitTlbEntry) == 16, "Generated code indexes TLB by shift");
+
+#if JIT_X86_64_ENABLED
+
+// Size of memory reserved for generated code
+    #define JIT_CODE_SIZE (4U << 20U)
+
+namespace {
+
+enum HostReg {
+    RAX = 0,
+    RCX = 1,
+    RDX = 2,
+    RBX = 3,
+    RSP = 4,
+    RSI = 6,
+    RDI = 7,
+    R12 = 12,
+    R13 = 13,
+    R14 = 14,
+    R15 = 15,
+};
+
+enum HostCond {
+    CC_O = 0x0,
+    CC_B = 0x2,
+    CC_AE = 0x3,
+    CC_E = 0x4,
+    CC_NE = 0x5,
+    CC_L = 0xc,
+    CC_GE = 0xd,
+    CC_LE = 0xe,
+    CC_G = 0xf,
+};
+
+// Opcode extensions (ModRM reg field) of group instructions
+enum HostAluOp {
+    ALU_ADD = 0,
+    ALU_OR = 1,
+    ALU_AND = 4,
+    ALU_SUB = 5,
+    ALU_XOR = 6,
+    ALU_CMP = 7,
+};
+enum HostShiftOp {
+    SHIFT_ROL = 0,
+    SHIFT_SHL = 4,
+    SHIFT_SHR = 5,
+    SHIFT_SAR = 7,
+};
+
+// Registers holding the state during execution of generated code
+constexpr int REG_GP = RBX;
+constexpr int REG_CTX = R12;
+constexpr int REG_TLB = R13;
+
+// Minimal x86-64 encoder covering instruction forms used by translator
+class Assembler {
+public:
+    std::vector<uint8_t> code;
+
+    int new_label() {
+        labels.push_back(-1);
+        return (int)labels.size() - 1;
+    }
+    void bind(int label) { labels[label] = (int)code.size(); }
+    void jcc(enum HostCond cc, int label) {
+        b(0x0f);
+        b(0x80 | cc);
+        fixup(label);
+    }
+    void jmp(int label) {
+        b(0xe9);
+        fixup(label);
+    }
+    void resolve() {
+        for (const auto &f : fixups) {
+            int32_t rel = labels[f.label] - (int32_t)(f.pos + 4);
+            memcpy(&code[f.pos], &rel, 4);
+        }
+    }
+
+    void b(uint8_t v) { code.push_back(v); }
+    void d32(uint32_t v) {
+        for (int i = 0; i < 4; i++) {
+            b((v >> (8 * i)) & 0xff);
+        }
+    }
+    void d64(uint64_t v) {
+        d32((uint32_t)v);
+        d32((uint32_t)(v >> 32U));
+    }
+
+    // Register operand
+    void op_r(std::initializer_list<uint8_t> op, bool w, int reg, int rm) {
+        rex(w, reg, 0, rm);
+        for (uint8_t o : op) {
+            b(o);
+        }
+        b(0xc0 | ((reg & 7) << 3) | (rm & 7));
+    }
+    // Memory operand [base + disp32]
+    void op_m(std::initializer_list<uint8_t> op, bool w, int reg, int base, int32_t disp) {
+        rex(w, reg, 0, base);
+        for (uint8_t o : op) {
+            b(o);
+        }
+        b(0x80 | ((reg & 7) << 3) | (base & 7));
+        if ((base & 7) == RSP) {
+            b(0x24);
+        }
+        d32(disp);
+    }
+    // Memory operand [base + index + disp8]
+    void op_mi(
+        std::initializer_list<uint8_t> op,
+        bool w,
+        int reg,
+        int base,
+        int index,
+        int8_t disp = 0) {
+        rex(w, reg, index, base);
+        for (uint8_t o : op) {
+            b(o);
+        }
+        b(0x44 | ((reg & 7) << 3));
+        b(((index & 7) << 3) | (base & 7));
+        b(disp);
+    }
+
+    void mov_r_m32(int r, int base, int32_t disp) { op_m({ 0x8b }, false, r, base, disp); }
+    void mov_r_m64(int r, int base, int32_t disp) { op_m({ 0x8b }, true, r, base, disp); }
+    void mov_m_r32(int base, int32_t disp, int r) { op_m({ 0x89 }, false, r, base, disp); }
+    void mov_m_r64(int base, int32_t disp, int r) { op_m({ 0x89 }, true, r, base, disp); }
+    void mov_m_imm32(int base, int32_t disp, uint32_t imm) {
+        op_m({ 0xc7 }, false, 0, base, disp);
+        d32(imm);
+    }
+    void mov_r_imm32(int r, uint32_t imm) {
+        rex(false, 0, 0, r);
+        b(0xb8 + (r & 7));
+        d32(imm);
+    }
+    void mov_r_imm64(int r, uint64_t imm) {
+        rex(true, 0, 0, r);
+        b(0xb8 + (r & 7));
+        d64(imm);
+    }
+    void mov_rr32(int dst, int src) { op_r({ 0x89 }, false, src, dst); }
+    void mov_rr64(int dst, int src) { op_r({ 0x89 }, true, src, dst); }
+    // add, or, and, sub, xor, cmp of two registers
+    void alu_rr(enum HostAluOp op, int dst, int src) {
+        op_r({ (uint8_t)((op << 3) | 0x01) }, false, src, dst);
+    }
+    void alu_ri(enum HostAluOp op, int dst, uint32_t imm) {
+        op_r({ 0x81 }, false, op, dst);
+        d32(imm);
+    }
+    void alu_r_m32(enum HostAluOp op, int dst, int base, int32_t disp) {
+        op_m({ (uint8_t)((op << 3) | 0x03) }, false, dst, base, disp);
+    }
+    void test_rr(int a, int b_reg) { op_r({ 0x85 }, false, b_reg, a); }
+    void test_ri(int r, uint32_t imm) {
+        op_r({ 0xf7 }, false, 0, r);
+        d32(imm);
+    }
+    void not_r(int r) { op_r({ 0xf7 }, false, 2, r); }
+    void shift_ri(enum HostShiftOp op, int r, uint8_t sa, bool w = false) {
+        op_r({ 0xc1 }, w, op, r);
+        b(sa);
+    }
+    void shift_rcl(enum HostShiftOp op, int r) { op_r({ 0xd3 }, false, op, r); }
+    void imul_rr(int dst, int src, bool w) { op_r({ 0x0f, 0xaf }, w, dst, src); }
+    void movsxd_rr(int dst, int src) { op_r({ 0x63 }, true, dst, src); }
+    void setcc(enum HostCond cc, int r) { op_r({ 0x0f, (uint8_t)(0x90 | cc) }, false, 0, r); }
+    void movzx_r8(int dst, int src) { op_r({ 0x0f, 0xb6 }, false, dst, src); }
+    void cmov(enum HostCond cc, int dst, int src) {
+        op_r({ 0x0f, (uint8_t)(0x40 | cc) }, false, dst, src);
+    }
+    void bswap(int r) {
+        rex(false, 0, 0, r);
+        b(0x0f);
+        b(0xc8 + (r & 7));
+    }
+    void rol16_8(int r) {
+        b(0x66);
+        shift_ri(SHIFT_ROL, r, 8);
+    }
+    void push(int r) {
+        rex(false, 0, 0, r);
+        b(0x50 + (r & 7));
+    }
+    void pop(int r) {
+        rex(false, 0, 0, r);
+        b(0x58 + (r & 7));
+    }
+    void call(const void *fn) {
+        mov_r_imm64(RAX, (uint64_t)fn);
+        op_r({ 0xff }, false, 2, RAX);
+    }
+    void ret() { b(0xc3); }
+
+private:
+    struct Fixup {
+        size_t pos;
+        int label;
+    };
+    std::vector<int> labels;
+    std::vector<Fixup> fixups;
+
+    void rex(bool w, int reg, int index, int base) {
+        uint8_t r = 0x40 | (w ? 8 : 0) | ((reg & 8) ? 4 : 0) | ((index & 8) ? 2 : 0)
+                    | ((base & 8) ? 1 : 0);
+        if (r != 0x40) {
+            b(r);
+        }
+    }
+    void fixup(int label) {
+        fixups.push_back({ code.size(), label });
+        d32(0);
+    }
+};
+
+enum JitKind {
+    JK_NONE, // Not translated
+    JK_NOP,
+    JK_ALU,
+    JK_LOAD,
+    JK_STORE,
+    JK_BRANCH,
+    JK_JUMP,
+};
+
+struct JitInst {
+    enum JitKind kind;
+    enum InstructionFlags flags;
+    enum AluOp alu_op;
+    enum AccessControl mem_ctl;
+    uint32_t addr;
+    uint8_t rs, rt, rwrite, shamt;
+    uint32_t immediate;
+    uint32_t target; // Branch target or instruction index of jump
+};
+
+unsigned access_size(enum AccessControl ctl) {
+    switch (ctl) {
+    case AC_I8:
+    case AC_U8: return 1;
+    case AC_I16:
+    case AC_U16: return 2;
+    case AC_I32:
+    case AC_U32: return 4;
+    default: return 0;
+    }
+}
+
+bool access_signed(enum AccessControl ctl) {
+    return ctl == AC_I8 || ctl == AC_I16 || ctl == AC_I32;
+}
+
+void jit_decode(struct JitInst &in, uint32_t word, uint32_t addr) {
+    Instruction inst(word);
+    inst.flags_alu_op_mem_ctl(in.flags, in.alu_op, in.mem_ctl);
+    const enum InstructionFlags flags = in.flags;
+    in.kind = JK_NONE;
+    in.addr = addr;
+    in.rs = inst.rs();
+    in.rt = inst.rt();
+    in.shamt = inst.shamt();
+    in.immediate = (flags & IMF_ZERO_EXTEND) ? inst.immediate() : sign_extend(inst.immediate());
+    in.rwrite = (flags & IMF_PC_TO_R31) ? 31 : (flags & IMF_REGD) ? inst.rd() : inst.rt();
+    if (!(flags & IMF_REGWRITE)) {
+        in.rwrite = 0;
+    }
+    if (flags & IMF_JUMP) {
+        in.target = inst.address().get_raw() << 2;
+    } else {
+        int32_t rel_offset = inst.immediate() << 2;
+        if (rel_offset & (1 << 17)) { rel_offset -= 1 << 18; }
+        in.target = addr + rel_offset + 4;
+    }
+
+    if (!(flags & IMF_SUPPORTED) || (flags & (IMF_EXCEPTION | IMF_STOP_IF | IMF_NB_SKIP_DS))) {
+        return;
+    }
+    if (flags & (IMF_MEMREAD | IMF_MEMWRITE)) {
+        if (in.alu_op != ALU_OP_ADDU || !(flags & IMF_ALUSRC) || access_size(in.mem_ctl) == 0) {
+            return;
+        }
+        if ((flags & IMF_MEMREAD) && !(flags & IMF_MEMWRITE) && (flags & IMF_REGWRITE)) {
+            in.kind = JK_LOAD;
+        } else if ((flags & IMF_MEMWRITE) && !(flags & (IMF_MEMREAD | IMF_REGWRITE))) {
+            in.kind = JK_STORE;
+        }
+        return;
+    }
+    if (in.mem_ctl != AC_NONE) {
+        return;
+    }
+    if (flags & IMF_JUMP) {
+        if (!(flags & IMF_REGWRITE) || (flags & (IMF_PC_TO_R31 | IMF_PC8_TO_RT))) {
+            in.kind = JK_JUMP;
+        }
+        return;
+    }
+    if (flags & IMF_BRANCH) {
+        if (!(flags & IMF_REGWRITE) || (flags & IMF_PC_TO_R31)) {
+            in.kind = JK_BRANCH;
+        }
+        return;
+    }
+    if (flags & (IMF_PC_TO_R31 | IMF_PC8_TO_RT)) {
+        return;
+    }
+    if (!(flags & IMF_REGWRITE)) {
+        switch (in.alu_op) {
+        case ALU_OP_NOP:
+        case ALU_OP_SLL:
+            if (!(flags & (IMF_READ_HILO | IMF_WRITE_HILO))) {
+                in.kind = JK_NOP;
+            }
+            break;
+        case ALU_OP_MTHI:
+        case ALU_OP_MTLO:
+        case ALU_OP_MULT:
+        case ALU_OP_MULTU: in.kind = JK_ALU; break;
+        default: break;
+        }
+        return;
+    }
+    if (flags & IMF_ALUSRC) {
+        switch (in.alu_op) {
+        case ALU_OP_ADDU:
+        case ALU_OP_ADD:
+        case ALU_OP_AND:
+        case ALU_OP_OR:
+        case ALU_OP_XOR:
+        case ALU_OP_SLT:
+        case ALU_OP_SLTU:
+        case ALU_OP_LUI: in.kind = JK_ALU; break;
+        default: break;
+        }
+        return;
+    }
+    switch (in.alu_op) {
+    case ALU_OP_ADDU:
+    case ALU_OP_ADD:
+    case ALU_OP_SUBU:
+    case ALU_OP_SUB:
+    case ALU_OP_AND:
+    case ALU_OP_OR:
+    case ALU_OP_XOR:
+    case ALU_OP_NOR:
+    case ALU_OP_SLT:
+    case ALU_OP_SLTU:
+    case ALU_OP_SLL:
+    case ALU_OP_SRL:
+    case ALU_OP_SRA:
+    case ALU_OP_SLLV:
+    case ALU_OP_SRLV:
+    case ALU_OP_SRAV:
+    case ALU_OP_MUL:
+    case ALU_OP_MFHI:
+    case ALU_OP_MFLO: in.kind = JK_ALU; break;
+    default: break;
+    }
+}
+
+// Call-outs used when access cannot be processed through TLB
+uint64_t jit_load(JitContext *ctx, uint32_t address, uint32_t ctl) {
+    try {
+        RegisterValue val = ctx->mem_data->read_ctl((enum AccessControl)ctl, Address(address));
+        ctx->jit->tlb_fill(address);
+        return val.as_u64();
+    } catch (...) {
+        // Instruction is repeated by interpreter which reports the error
+        ctx->fault = 1;
+        return 0;
+    }
+}
+
+void jit_store(JitContext *ctx, uint32_t address, uint32_t ctl, uint32_t val) {
+    try {
+        ctx->mem_data->write_ctl((enum AccessControl)ctl, Address(address), val);
+        ctx->jit->tlb_fill(address);
+    } catch (...) {
+        ctx->fault = 1;
+    }
+}
+
+    #define CTX(FIELD) ((int32_t)offsetof(JitContext, FIELD))
+
+class Translator {
+public:
+    Translator(
+        const std::vector<struct JitInst> &insts,
+        int branch,
+        bool delay_slot,
+        bool swap)
+        : insts(insts)
+        , branch(branch)
+        , delay_slot(delay_slot)
+        , swap(swap)
+        , exits(insts.size() + 1, -1) {}
+
+    std::vector<uint8_t> &generate() {
+        as.push(RBX);
+        as.push(R12);
+        as.push(R13);
+        as.push(R14);
+        as.push(R15); // Keeps stack aligned for call-outs
+        as.mov_rr64(REG_CTX, RDI);
+        as.mov_r_m64(REG_GP, REG_CTX, CTX(gp));
+        as.mov_r_m64(REG_TLB, REG_CTX, CTX(tlb));
+        for (size_t i = 0; i < insts.size(); i++) {
+            gen_inst(i);
+            if ((int)i == branch && delay_slot) {
+                // Program end can be reached by the control transfer
+                as.mov_r_m32(RAX, REG_CTX, CTX(jump_addr));
+                as.alu_r_m32(ALU_CMP, RAX, REG_CTX, CTX(jump_limit));
+                as.jcc(CC_AE, exit(i + 1));
+            }
+        }
+        as.mov_m_imm32(REG_CTX, CTX(executed), insts.size());
+        int epilogue = as.new_label();
+        as.bind(epilogue);
+        as.pop(R15);
+        as.pop(R14);
+        as.pop(R13);
+        as.pop(R12);
+        as.pop(RBX);
+        as.ret();
+        for (const auto &s : slow_paths) {
+            gen_slow_path(s);
+        }
+        for (size_t i = 0; i < exits.size(); i++) {
+            if (exits[i] >= 0) {
+                as.bind(exits[i]);
+                as.mov_m_imm32(REG_CTX, CTX(executed), i);
+                as.jmp(epilogue);
+            }
+        }
+        as.resolve();
+        return as.code;
+    }
+
+private:
+    struct SlowPath {
+        size_t index;
+        int entry, done;
+    };
+
+    const std::vector<struct JitInst> &insts;
+    const int branch;
+    const bool delay_slot, swap;
+    Assembler as;
+    std::vector<int> exits;
+    std::vector<struct SlowPath> slow_paths;
+
+    // Leave block before instruction of given index
+    int exit(size_t index) {
+        if (exits[index] < 0) {
+            exits[index] = as.new_label();
+        }
+        return exits[index];
+    }
+
+    void load_gp(int r, uint8_t num, bool w = false) {
+        if (num == 0) {
+            as.alu_rr(ALU_XOR, r, r);
+        } else if (w) {
+            as.mov_r_m64(r, REG_GP, 8 * num);
+        } else {
+            as.mov_r_m32(r, REG_GP, 8 * num);
+        }
+    }
+    void store_gp(uint8_t num, int r) {
+        if (num != 0) {
+            as.mov_m_r64(REG_GP, 8 * num, r);
+        }
+    }
+
+    // Computes address to RAX and passes RDX = page base, RCX = offset
+    // when the access hits in TLB.
+    void gen_tlb_lookup(unsigned size, int slow) {
+        if (size > 1) {
+            as.test_ri(RAX, size - 1);
+            as.jcc(CC_NE, slow);
+        }
+        as.mov_rr32(RCX, RAX);
+        as.shift_ri(SHIFT_SHR, RCX, JIT_PAGE_BITS);
+        as.alu_ri(ALU_AND, RCX, JIT_TLB_SIZE - 1);
+        as.shift_ri(SHIFT_SHL, RCX, 4);
+        as.mov_rr32(RDX, RAX);
+        as.alu_ri(ALU_AND, RDX, ~(uint32_t)(JIT_PAGE_SIZE - 1));
+        as.op_mi({ 0x3b }, false, RDX, REG_TLB, RCX); // cmp edx, tag
+        as.jcc(CC_NE, slow);
+        as.op_mi({ 0x8b }, true, RDX, REG_TLB, RCX, 8); // mov rdx, base
+        as.movzx_r8(RCX, RAX);
+    }
+
+    void gen_inst(size_t i) {
+        const struct JitInst &in = insts[i];
+        switch (in.kind) {
+        case JK_NOP: break;
+        case JK_ALU: gen_alu(i, in); break;
+        case JK_LOAD: gen_load(i, in); break;
+        case JK_STORE: gen_store(i, in); break;
+        case JK_BRANCH: gen_branch(in); break;
+        case JK_JUMP: gen_jump(i, in); break;
+        case JK_NONE: break;
+        }
+    }
+
+    void gen_alu(size_t i, const struct JitInst &in) {
+        const bool imm = in.flags & IMF_ALUSRC;
+        const bool traps = in.alu_op == ALU_OP_ADD || in.alu_op == ALU_OP_SUB;
+        if (in.rwrite == 0 && (in.flags & IMF_REGWRITE) && !traps) {
+            return; // Result is discarded
+        }
+        switch (in.alu_op) {
+        case ALU_OP_MFHI:
+        case ALU_OP_MFLO:
+            as.mov_r_m64(RDX, REG_CTX, in.alu_op == ALU_OP_MFHI ? CTX(hi) : CTX(lo));
+            as.mov_r_m64(RAX, RDX, 0);
+            store_gp(in.rwrite, RAX);
+            return;
+        case ALU_OP_MTHI:
+        case ALU_OP_MTLO:
+            load_gp(RAX, in.rs, true);
+            as.mov_r_m64(RDX, REG_CTX, in.alu_op == ALU_OP_MTHI ? CTX(hi) : CTX(lo));
+            as.mov_m_r64(RDX, 0, RAX);
+            return;
+        case ALU_OP_MULT:
+        case ALU_OP_MULTU:
+            load_gp(RAX, in.rs);
+            load_gp(RCX, in.rt);
+            if (in.alu_op == ALU_OP_MULT) {
+                as.movsxd_rr(RAX, RAX);
+                as.movsxd_rr(RCX, RCX);
+            }
+            as.imul_rr(RAX, RCX, true);
+            as.mov_rr64(RCX, RAX);
+            as.shift_ri(SHIFT_SHR, RCX, 32, true);
+            as.mov_rr32(RAX, RAX);
+            as.mov_r_m64(RDX, REG_CTX, CTX(lo));
+            as.mov_m_r64(RDX, 0, RAX);
+            as.mov_r_m64(RDX, REG_CTX, CTX(hi));
+            as.mov_m_r64(RDX, 0, RCX);
+            return;
+        case ALU_OP_SLL:
+        case ALU_OP_SRL:
+        case ALU_OP_SRA: {
+            enum HostShiftOp op = in.alu_op == ALU_OP_SLL   ? SHIFT_SHL
+                                  : in.alu_op == ALU_OP_SRL ? SHIFT_SHR
+                                                            : SHIFT_SAR;
+            load_gp(RAX, in.rt);
+            as.shift_ri(op, RAX, in.shamt);
+            if (op == SHIFT_SAR) {
+                as.movsxd_rr(RAX, RAX);
+            }
+            store_gp(in.rwrite, RAX);
+            return;
+        }
+        case ALU_OP_SLLV:
+        case ALU_OP_SRLV:
+        case ALU_OP_SRAV: {
+            enum HostShiftOp op = in.alu_op == ALU_OP_SLLV   ? SHIFT_SHL
+                                  : in.alu_op == ALU_OP_SRLV ? SHIFT_SHR
+                                                             : SHIFT_SAR;
+            load_gp(RAX, in.rt);
+            load_gp(RCX, in.rs);
+            as.shift_rcl(op, RAX);
+            if (op == SHIFT_SAR) {
+                as.movsxd_rr(RAX, RAX);
+            }
+            store_gp(in.rwrite, RAX);
+            return;
+        }
+        case ALU_OP_LUI:
+            as.mov_r_imm32(RAX, in.immediate << 16U);
+            store_gp(in.rwrite, RAX);
+            return;
+        default: break;
+        }
+
+        // Binary operations, second operand is in RCX
+        load_gp(RAX, in.rs);
+        if (imm) {
+            as.mov_r_imm32(RCX, in.immediate);
+        } else {
+            load_gp(RCX, in.rt);
+        }
+        switch (in.alu_op) {
+        case ALU_OP_ADD:
+        case ALU_OP_ADDU:
+            as.alu_rr(ALU_ADD, RAX, RCX);
+            if (traps) {
+                as.jcc(CC_O, exit(i));
+            }
+            break;
+        case ALU_OP_SUB:
+        case ALU_OP_SUBU:
+            as.alu_rr(ALU_SUB, RAX, RCX);
+            if (traps) {
+                as.jcc(CC_O, exit(i));
+            }
+            break;
+        case ALU_OP_AND: as.alu_rr(ALU_AND, RAX, RCX); break;
+        case ALU_OP_OR: as.alu_rr(ALU_OR, RAX, RCX); break;
+        case ALU_OP_XOR: as.alu_rr(ALU_XOR, RAX, RCX); break;
+        case ALU_OP_NOR:
+            as.alu_rr(ALU_OR, RAX, RCX);
+            as.not_r(RAX);
+            break;
+        case ALU_OP_SLT:
+        case ALU_OP_SLTU:
+            as.alu_rr(ALU_CMP, RAX, RCX);
+            as.setcc(in.alu_op == ALU_OP_SLT ? CC_L : CC_B, RAX);
+            as.movzx_r8(RAX, RAX);
+            break;
+        case ALU_OP_MUL: as.imul_rr(RAX, RCX, false); break;
+        default: break;
+        }
+        store_gp(in.rwrite, RAX);
+    }
+
+    void gen_address(const struct JitInst &in) {
+        load_gp(RAX, in.rs);
+        if (in.immediate != 0) {
+            as.alu_ri(ALU_ADD, RAX, in.immediate);
+        }
+    }
+
+    void gen_load(size_t i, const struct JitInst &in) {
+        const unsigned size = access_size(in.mem_ctl);
+        int slow = as.new_label();
+        int done = as.new_label();
+        gen_address(in);
+        gen_tlb_lookup(size, slow);
+        switch (size) {
+        case 1:
+            if (access_signed(in.mem_ctl)) {
+                as.op_mi({ 0x0f, 0xbe }, true, RAX, RDX, RCX);
+            } else {
+                as.op_mi({ 0x0f, 0xb6 }, false, RAX, RDX, RCX);
+            }
+            break;
+        case 2:
+            as.op_mi({ 0x0f, 0xb7 }, false, RAX, RDX, RCX);
+            if (swap) {
+                as.rol16_8(RAX);
+            }
+            if (access_signed(in.mem_ctl)) {
+                as.op_r({ 0x0f, 0xbf }, true, RAX, RAX);
+            }
+            break;
+        default:
+            as.op_mi({ 0x8b }, false, RAX, RDX, RCX);
+            if (swap) {
+                as.bswap(RAX);
+            }
+            if (access_signed(in.mem_ctl)) {
+                as.movsxd_rr(RAX, RAX);
+            }
+            break;
+        }
+        as.bind(done);
+        store_gp(in.rwrite, RAX);
+        slow_paths.push_back({ i, slow, done });
+    }
+
+    void gen_store(size_t i, const struct JitInst &in) {
+        const unsigned size = access_size(in.mem_ctl);
+        int slow = as.new_label();
+        int done = as.new_label();
+        gen_address(in);
+        // Store to the code of this block (or to the instruction which has
+        // been already fetched in delay slot mode) is left to interpreter
+        const uint32_t code_start = insts.front().addr;
+        const uint32_t code_end = insts.back().addr + 8;
+        as.mov_rr32(RCX, RAX);
+        as.alu_ri(ALU_SUB, RCX, code_start - size + 1);
+        as.alu_ri(ALU_CMP, RCX, code_end - code_start + size - 1);
+        as.jcc(CC_B, exit(i));
+        if (delay_slot && (int)i == branch + 1 && branch >= 0) {
+            as.mov_rr32(RCX, RAX);
+            as.alu_r_m32(ALU_SUB, RCX, REG_CTX, CTX(jump_addr));
+            as.alu_ri(ALU_ADD, RCX, size - 1);
+            as.alu_ri(ALU_CMP, RCX, size + 3);
+            as.jcc(CC_B, exit(i));
+        }
+        gen_tlb_lookup(size, slow);
+        load_gp(RAX, in.rt);
+        switch (size) {
+        case 1: as.op_mi({ 0x88 }, false, RAX, RDX, RCX); break;
+        case 2:
+            if (swap) {
+                as.rol16_8(RAX);
+            }
+            as.b(0x66);
+            as.op_mi({ 0x89 }, false, RAX, RDX, RCX);
+            break;
+        default:
+            if (swap) {
+                as.bswap(RAX);
+            }
+            as.op_mi({ 0x89 }, false, RAX, RDX, RCX);
+            break;
+        }
+        as.mov_m_imm32(REG_CTX, CTX(stores), 1);
+        as.bind(done);
+        slow_paths.push_back({ i, slow, done });
+    }
+
+    void gen_slow_path(const struct SlowPath &s) {
+        const struct JitInst &in = insts[s.index];
+        as.bind(s.entry);
+        as.mov_rr64(RDI, REG_CTX);
+        as.mov_rr32(RSI, RAX);
+        as.mov_r_imm32(RDX, in.mem_ctl);
+        if (in.kind == JK_LOAD) {
+            as.call((const void *)&jit_load);
+        } else {
+            load_gp(RCX, in.rt);
+            as.call((const void *)&jit_store);
+        }
+        as.op_m({ 0x83 }, false, ALU_CMP, REG_CTX, CTX(fault)); // cmp fault, 0
+        as.b(0);
+        as.jcc(CC_NE, exit(s.index));
+        as.jmp(s.done);
+    }
+
+    void gen_link(const struct JitInst &in) {
+        if (in.rwrite != 0) {
+            as.mov_r_imm32(RCX, in.addr + 8);
+            store_gp(in.rwrite, RCX);
+        }
+    }
+
+    void gen_branch(const struct JitInst &in) {
+        enum HostCond cc;
+        load_gp(RAX, in.rs);
+        if (in.flags & IMF_BJR_REQ_RT) {
+            load_gp(RCX, in.rt);
+            as.alu_rr(ALU_CMP, RAX, RCX);
+            cc = (in.flags & IMF_BJ_NOT) ? CC_NE : CC_E;
+        } else if (in.flags & IMF_BGTZ_BLEZ) {
+            as.test_rr(RAX, RAX);
+            cc = (in.flags & IMF_BJ_NOT) ? CC_G : CC_LE;
+        } else {
+            as.test_rr(RAX, RAX);
+            cc = (in.flags & IMF_BJ_NOT) ? CC_GE : CC_L;
+        }
+        as.setcc(cc, RDX);
+        as.movzx_r8(RDX, RDX);
+        gen_link(in);
+        as.mov_m_r32(REG_CTX, CTX(taken), RDX);
+        as.mov_r_imm32(RAX, in.addr + (delay_slot ? 8 : 4));
+        as.mov_r_imm32(RCX, in.target);
+        as.test_rr(RDX, RDX);
+        as.cmov(CC_NE, RAX, RCX);
+        as.mov_m_r32(REG_CTX, CTX(jump_addr), RAX);
+    }
+
+    void gen_jump(size_t i, const struct JitInst &in) {
+        if (in.flags & IMF_BJR_REQ_RS) {
+            load_gp(RAX, in.rs);
+            as.test_ri(RAX, 3);
+            as.jcc(CC_NE, exit(i)); // Unaligned jump is reported by interpreter
+            gen_link(in);
+            as.mov_m_r32(REG_CTX, CTX(jump_addr), RAX);
+        } else {
+            // Region is given by PC at the time of the jump execution
+            uint32_t pc = in.addr + (delay_slot ? 4 : 0);
+            gen_link(in);
+            as.mov_m_imm32(
+                REG_CTX, CTX(jump_addr), (pc & 0xf0000000) | (in.target & 0x0fffffff));
+        }
+        as.mov_m_imm32(REG_CTX, CTX(taken), 1);
+    }
+};
+
+    #undef CTX
+
+} // namespace
+
+JitX86_64::JitX86_64(bool delay_slot, Endian simulated_endian)
+    : delay_slot(delay_slot)
+    , simulated_endian(simulated_endian) {
+    void *mem = mmap(
+        nullptr, JIT_CODE_SIZE, PROT_READ | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem != MAP_FAILED) {
+        code_buffer = (byte *)mem;
+    }
+    ctx.tlb = data_tlb.entries;
+    ctx.jit = this;
+    for (auto &e : data_tlb.entries) {
+        e.tag = 1;
+    }
+    for (auto &e : code_tlb.entries) {
+        e.tag = 1;
+    }
+}
+
+JitX86_64::~JitX86_64() {
+    if (code_buffer != nullptr) {
+        munmap(code_buffer, JIT_CODE_SIZE);
+    }
+}
+
+bool JitX86_64::available() {
+    return true;
+}
+
+bool JitX86_64::compile(JitBlock &block, Address start, const byte *code, size_t max_insts) {
+    const uint32_t start_addr = start.get_raw();
+    std::vector<struct JitInst> insts;
+    int branch = -1;
+    for (size_t i = 0; i < max_insts; i++) {
+        uint32_t word;
+        memcpy(&word, code + 4 * i, 4);
+        word = byteswap_if(word, simulated_endian != NATIVE_ENDIAN);
+        struct JitInst in {};
+        jit_decode(in, word, start_addr + 4 * i);
+        if (in.kind == JK_NONE) {
+            break;
+        }
+        const bool control = in.kind == JK_BRANCH || in.kind == JK_JUMP;
+        if (branch >= 0) {
+            if (!control) {
+                insts.push_back(in);
+            }
+            break;
+        }
+        insts.push_back(in);
+        if (control) {
+            branch = (int)i;
+            if (!delay_slot) {
+                break;
+            }
+        }
+    }
+    if (delay_slot && branch >= 0 && insts.size() == (size_t)branch + 1) {
+        // Delay slot cannot be translated, interpreter handles both
+        insts.pop_back();
+        branch = -1;
+    }
+
+    block.length = insts.size();
+    block.branch = branch;
+    block.words.assign(code, code + 4 * (block.length > 0 ? block.length : 1));
+    block.code = nullptr;
+    block.failed = block.length == 0 || code_buffer == nullptr;
+    if (block.failed) {
+        return true;
+    }
+
+    Translator tr(insts, branch, delay_slot, simulated_endian != NATIVE_ENDIAN);
+    const std::vector<uint8_t> &native = tr.generate();
+    if (code_used + native.size() > JIT_CODE_SIZE) {
+        return false;
+    }
+    byte *dst = code_buffer + code_used;
+    mprotect(code_buffer, JIT_CODE_SIZE, PROT_READ | PROT_WRITE);
+    memcpy(dst, native.data(), native.size());
+    mprotect(code_buffer, JIT_CODE_SIZE, PROT_READ | PROT_EXEC);
+    code_used += (native.size() + 15) & ~(size_t)15;
+    block.code = (JitCode)dst;
+    return true;
+}
+
+void JitX86_64::flush() {
+    code_used = 0;
+}
+
+#else // !JIT_X86_64_ENABLED
+
+JitX86_64::JitX86_64(bool delay_slot, Endian simulated_endian)
+    : delay_slot(delay_slot)
+    , simulated_endian(simulated_endian) {
+    ctx.tlb = data_tlb.entries;
+    ctx.jit = this;
+}
+
+JitX86_64::~JitX86_64() = default;
+
+bool JitX86_64::available() {
+    return false;
+}
+
+bool JitX86_64::compile(JitBlock &block, Address start, const byte *code, size_t max_insts) {
+    UNUSED(start)
+    UNUSED(max_insts)
+    block.length = 0;
+    block.words.assign(code, code + 4);
+    block.code = nullptr;
+    block.failed = true;
+    return true;
+}
+
+void JitX86_64::flush() {}
+
+#endif // JIT_X86_64_ENABLED
+
+JitContext &JitX86_64::context() {
+    return ctx;
+}
+
+void JitX86_64::run(const JitBlock &block) {
+    ctx.executed = 0;
+    ctx.fault = 0;
+    block.code(&ctx);
+}
+
+byte *JitX86_64::tlb_lookup(Tlb &tlb, FrontendMemory *mem, uint32_t address, bool write) {
+    const uint32_t page = address & ~(uint32_t)(JIT_PAGE_SIZE - 1);
+    const size_t index = (address >> JIT_PAGE_BITS) & (JIT_TLB_SIZE - 1);
+    JitTlbEntry &e = tlb.entries[index];
+    if (e.tag != page) {
+        // Code is never written through its TLB, it stays shared with
+        // program image and snapshots
+        byte *base = write ? mem->direct_access(Address(page), JIT_PAGE_SIZE)
+                           : const_cast<byte *>(mem->direct_read(Address(page), JIT_PAGE_SIZE));
+        if (base == nullptr) {
+            return nullptr;
+        }
+        if (e.tag & (JIT_PAGE_SIZE - 1)) {
+            tlb.used.push_back(index);
+        }
+        e.tag = page;
+        e.base = base;
+    }
+    return e.base;
+}
+
+const byte *JitX86_64::code_access(FrontendMemory *mem_program, Address address) {
+    const uint32_t addr = address.get_raw();
+    const byte *base = tlb_lookup(code_tlb, mem_program, addr, false);
+    return base == nullptr ? nullptr : base + (addr & (JIT_PAGE_SIZE - 1));
+}
+
+void JitX86_64::tlb_clear(Tlb &tlb) {
+    for (uint16_t index : tlb.used) {
+        tlb.entries[index].tag = 1;
+    }
+    tlb.used.clear();
+}
+
+void JitX86_64::tlb_flush() {
+    tlb_clear(data_tlb);
+    tlb_clear(code_tlb);
+}
+
+void JitX86_64::tlb_fill(uint32_t address) {
+    // Access or the fill could copy shared section holding the code
+    tlb_clear(code_tlb);
+    tlb_lookup(data_tlb, ctx.mem_data, address, true);
+}
@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*******************************************************************************
+ * QtMips - MIPS 32-bit Architecture Subset Simulator
+ *
+ * Implemented to support following courses:
+ *
+ *   B35APO - Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b35apo
+ *
+ *   B4M35PAP - Advanced Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b4m35pap/start
+ *
+ * Copyright (c) 2017-2019 Karel Koci<cynerd@email.cz>
+ * Copyright (c) 2019      Pavel Pisa <pisa@cmp.felk.cvut.cz>
+ *
+ * Faculty of Electrical Engineering (http://www.fel.cvut.cz)
+ * Czech Technical University        (http://www.cvut.cz/)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+#ifndef JIT_X86_64_H
+#define JIT_X86_64_H
+
+#include "common/endian.h"
+#include "memory/address.h"
+#include "register_value.h"
+#include "utils.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__x86_64__) && defined(__unix__)
+    #define JIT_X86_64_ENABLED 1
+#else
+    #define JIT_X86_64_ENABLED 0
+#endif
+
+namespace machine {
+
+class FrontendMemory;
+class JitX86_64;
+
+// Number of bits of address translated by single entry of JIT TLB
+constexpr size_t JIT_PAGE_BITS = 8;
+constexpr size_t JIT_PAGE_SIZE = (1u << JIT_PAGE_BITS);
+// Number of entries of JIT TLB (direct mapped)
+constexpr size_t JIT_TLB_BITS = 10;
+constexpr size_t JIT_TLB_SIZE = (1u << JIT_TLB_BITS);
+
+/**
+ * Translation of simulated page to the host pointer into plain memory.
+ * Invalid entry has tag with nonzero offset bits.
+ */
+struct JitTlbEntry {
+    uint32_t tag;
+    uint32_t reserved;
+    byte *base;
+};
+
+/**
+ * State shared between the core and the generated code.
+ * Generated code addresses fields by offsetof(), keep it standard layout.
+ */
+struct JitContext {
+    RegisterValue *gp;        // Registers storage, $0 included
+    RegisterValue *hi;
+    RegisterValue *lo;
+    JitTlbEntry *tlb;         // Data accesses
+    FrontendMemory *mem_data; // Used when TLB misses
+    JitX86_64 *jit;
+    uint32_t jump_limit; // Exit before delay slot if jump_addr >= limit
+    uint32_t jump_addr;  // Address following control transfer (and its
+                         // delay slot)
+    uint32_t taken;      // Control transfer has been taken
+    uint32_t executed;   // Number of executed instructions of the block
+    uint32_t fault;      // Memory access raised exception, set by call-outs
+    uint32_t stores;     // Memory modified through TLB
+};
+
+typedef void (*JitCode)(JitContext *ctx);
+
+/**
+ * Compiled basic block. Instructions are executed from the start up to
+ * the first unsupported one or the control transfer (including the delay
+ * slot).
+ *
+ * Execution leaves the block before an instruction which would raise an
+ * exception or when memory accessed by store holds translated code. Such
+ * instruction is then executed by the interpreter, which keeps exact
+ * exception semantics.
+ */
+struct JitBlock {
+    unsigned hotness = 0;    // Number of entries by the interpreter
+    JitCode code = nullptr;  // nullptr until block is compiled
+    std::vector<byte> words; // Translated code in simulated endian
+    unsigned length = 0;     // Number of translated instructions
+    int branch = -1;         // Index of control transfer instruction
+    bool failed = false;     // First instruction cannot be translated
+};
+
+/**
+ * Translation of MIPS basic blocks to x86-64 native code.
+ *
+ * Only functional state (registers and memory) is simulated by generated
+ * code. Data accesses to plain memory are processed inline through JIT
+ * TLB filled from FrontendMemory::direct_access(), other accesses are
+ * passed to the data memory frontend. Code is read through
+ * FrontendMemory::direct_read().
+ */
+class JitX86_64 {
+public:
+    JitX86_64(bool delay_slot, Endian simulated_endian);
+    ~JitX86_64();
+
+    // Native code generation is supported on this host
+    static bool available();
+
+    /**
+     * Translate up to max_insts instructions stored at code.
+     * Returns false when space for generated code is exhausted, flush()
+     * has to be called and all blocks compiled again.
+     */
+    bool compile(JitBlock &block, Address start, const byte *code, size_t max_insts);
+    void flush(); // Release all generated code
+
+    JitContext &context();
+    void run(const JitBlock &block);
+
+    // Host pointer to the instruction code at given address
+    const byte *code_access(FrontendMemory *mem_program, Address address);
+    // Drop all translations of TLBs, has to be called whenever pointers
+    // provided by memory could have been invalidated
+    void tlb_flush();
+    // Fill data TLB entry for given address and drop code TLB, used by
+    // call-outs
+    void tlb_fill(uint32_t address);
+
+private:
+    struct Tlb {
+        JitTlbEntry entries[JIT_TLB_SIZE];
+        std::vector<uint16_t> used;
+    };
+    // Data TLB (write) takes private copy of shared memory, code TLB not
+    static byte *tlb_lookup(Tlb &tlb, FrontendMemory *mem, uint32_t address, bool write);
+    static void tlb_clear(Tlb &tlb);
+
+    const bool delay_slot;
+    const Endian simulated_endian;
+    JitContext ctx {};
+    Tlb data_tlb, code_tlb;
+    byte *code_buffer = nullptr;
+    size_t code_used = 0;
+};
+
+} // namespace machine
+
+#endif // JIT_X86_64_H
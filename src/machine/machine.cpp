@@ -38,10 +38,15 @@
 #include "programloader.h"
 
 #include <QTime>
+#include <algorithm>
 #include <utility>
 
 using namespace machine;
 
+// Bus range of the main memory, peripherals are mapped above it
+static constexpr Address RAM_RANGE_START = 0x00000000_addr;
+static constexpr Address RAM_RANGE_LAST = 0xefffffff_addr;
+
 Machine::Machine(MachineConfig config, bool load_symtab, bool load_executable)
     : machine_config(std::move(config))
     , stat(ST_READY) {
@@ -50,39 +55,47 @@ Machine::Machine(MachineConfig config, bool load_symtab, bool load_executable)
     if (load_executable) {
         ProgramLoader program(machine_config.elf());
         this->machine_config.set_simulated_endian(program.get_endian());
-        mem_program_only = new Memory(machine_config.get_simulated_endian());
-        program.to_memory(mem_program_only);
+        // Machines loading the same executable share its pristine image
+        mem_program_only = MemoryImageCache::image(
+            program.content_hash(), machine_config.get_simulated_endian(),
+            [&program](Memory *image) { program.to_memory(image); });
 
         if (load_symtab) {
             symtab = program.get_symbol_table();
         }
+        program_begin = program.begin();
         program_end = program.end();
         if (program.get_executable_entry() != 0x0_addr) {
             regs->pc_abs_jmp(program.get_executable_entry());
         }
-        mem = new Memory(*mem_program_only);
+    }
+
+    BackendMemory *ram;
+    if (machine_config.mapped_ram()) {
+        mapped_ram = new MappedRam(
+            machine_config.get_simulated_endian(),
+            RAM_RANGE_LAST.get_raw() - RAM_RANGE_START.get_raw() + 1);
+        if (mem_program_only != nullptr) {
+            mapped_ram->reset(*mem_program_only);
+        }
+        ram = mapped_ram;
     } else {
-        mem = new Memory(machine_config.get_simulated_endian());
+        if (mem_program_only != nullptr) {
+            mem = new Memory(*mem_program_only);
+        } else {
+            mem = new Memory(machine_config.get_simulated_endian());
+        }
+        ram = mem;
     }
 
     data_bus = new MemoryDataBus(machine_config.get_simulated_endian());
-    data_bus->insert_device_to_range(
-        mem, 0x00000000_addr, 0xefffffff_addr, false);
+    data_bus->insert_device_to_range(ram, RAM_RANGE_START, RAM_RANGE_LAST, false);
 
     setup_serial_port();
     setup_perip_spi_led();
     setup_lcd_display();
 
-    cch_program = new Cache(
-        data_bus, &machine_config.cache_program(),
-        machine_config.memory_access_time_read(),
-        machine_config.memory_access_time_write(),
-        machine_config.memory_access_time_burst());
-    cch_data = new Cache(
-        data_bus, &machine_config.cache_data(),
-        machine_config.memory_access_time_read(),
-        machine_config.memory_access_time_write(),
-        machine_config.memory_access_time_burst());
+    setup_cache_hierarchy();
 
     unsigned int min_cache_row_size = 16;
     if (machine_config.cache_data().enabled()) {
@@ -99,13 +112,46 @@ Machine::Machine(MachineConfig config, bool load_symtab, bool load_executable)
     if (machine_config.pipelined()) {
         cr = new CorePipelined(
             regs, cch_program, cch_data, machine_config.hazard_unit(), min_cache_row_size, cop0st);
+        if (machine_config.memory_stalls()) {
+            // Penalties of each level cover the path to the level below it
+            cr->set_memory_stall_source([this]() {
+                return cch_program->get_stall_count() + cch_data->get_stall_count()
+                       + cch_level2->get_stall_count() + cch_level3->get_stall_count();
+            });
+        }
+        if (machine_config.branch_predictor() != MachineConfig::BP_NONE) {
+            cr->set_branch_predictor(std::make_unique<BranchPredictionUnit>(machine_config));
+        }
     } else {
-        cr = new CoreSingle(
+        auto *core = new CoreSingle(
             regs, cch_program, cch_data, machine_config.delay_slot(), min_cache_row_size, cop0st);
+        core->set_jit(machine_config.jit());
+        cr = core;
     }
+    // Instruction fetches are their own PC, PC indexed prefetchers of program
+    // cache use global history
+    cch_data->set_pc_source([this]() { return cr->get_memory_access_pc(); });
+    // Events counted by guest visible performance counters
+    cop0st->set_perf_event_source(
+        Cop0State::PERF_CYCLES, [this]() { return cr->get_cycle_count(); });
+    cop0st->set_perf_event_source(
+        Cop0State::PERF_INSTRUCTIONS, [this]() { return cr->get_retired_count(); });
+    cop0st->set_perf_event_source(
+        Cop0State::PERF_BRANCHES, [this]() { return cr->get_branch_count(); });
+    cop0st->set_perf_event_source(
+        Cop0State::PERF_DCACHE_MISSES, [this]() { return cch_data->get_miss_count(); });
+    cop0st->set_perf_event_source(
+        Cop0State::PERF_ICACHE_MISSES, [this]() { return cch_program->get_miss_count(); });
+    cop0st->set_perf_event_source(
+        Cop0State::PERF_STALL_CYCLES, [this]() { return cr->get_stall_count(); });
+    cop0st->set_perf_event_source(
+        Cop0State::PERF_LOAD_USE_STALLS, [this]() { return cr->get_load_use_stall_count(); });
     connect(
         this, &Machine::set_interrupt_signal, cop0st,
         &Cop0State::set_interrupt_signal);
+    connect(
+        cr, &Core::stop_on_exception_reached, this,
+        &Machine::core_stop_request);
 
     run_t = new QTimer(this);
     set_speed(0); // In default run as fast as possible
@@ -142,6 +188,85 @@ void Machine::setup_serial_port() {
         &Machine::set_interrupt_signal);
 }
 
+void Machine::setup_cache_hierarchy() {
+    const CacheConfig &l2_config = machine_config.cache_level2();
+    const CacheConfig &l3_config = machine_config.cache_level3();
+    const unsigned l2_time = machine_config.cache_level2_access_time();
+    const unsigned l3_time = machine_config.cache_level3_access_time();
+    const auto inclusion = machine_config.cache_inclusion();
+
+    if (inclusion == MachineConfig::CI_INCLUSIVE) {
+        // Back-invalidation of an outer block has to cover whole inner blocks
+        const auto check_nesting = [](const CacheConfig &outer, const CacheConfig &inner) {
+            if (inner.enabled() && outer.block_size() % inner.block_size() != 0) {
+                throw SIMULATOR_EXCEPTION(
+                    Input,
+                    "Block size of inclusive cache level has to be a multiple "
+                    "of block size of inner levels",
+                    QString("%1 and %2").arg(outer.block_size()).arg(inner.block_size()));
+            }
+        };
+        for (const CacheConfig *outer : { &l2_config, &l3_config }) {
+            if (!outer->enabled()) {
+                continue;
+            }
+            check_nesting(*outer, machine_config.cache_program());
+            check_nesting(*outer, machine_config.cache_data());
+            if (outer == &l3_config && l2_config.enabled()) {
+                check_nesting(l3_config, l2_config);
+            }
+        }
+    }
+
+    // Shared levels are always present (for the visualization), disabled ones
+    // are just not part of the access path. Penalties of a cache placed above
+    // other cache level are its access time, burst transfer takes a cycle.
+    cch_level3 = new Cache(
+        data_bus, &l3_config, machine_config.memory_access_time_read(),
+        machine_config.memory_access_time_write(),
+        machine_config.memory_access_time_burst());
+    FrontendMemory *l2_backing = data_bus;
+    if (l3_config.enabled()) {
+        cch_level2 = new Cache(cch_level3, &l2_config, l3_time, l3_time, 1);
+        l2_backing = cch_level3;
+    } else {
+        cch_level2 = new Cache(
+            data_bus, &l2_config, machine_config.memory_access_time_read(),
+            machine_config.memory_access_time_write(),
+            machine_config.memory_access_time_burst());
+    }
+
+    if (l2_config.enabled() || l3_config.enabled()) {
+        FrontendMemory *l1_backing = l2_config.enabled() ? cch_level2 : l2_backing;
+        const unsigned l1_time = l2_config.enabled() ? l2_time : l3_time;
+        cch_program = new Cache(
+            l1_backing, &machine_config.cache_program(), l1_time, l1_time, 1);
+        cch_data = new Cache(
+            l1_backing, &machine_config.cache_data(), l1_time, l1_time, 1);
+    } else {
+        cch_program = new Cache(
+            data_bus, &machine_config.cache_program(),
+            machine_config.memory_access_time_read(),
+            machine_config.memory_access_time_write(),
+            machine_config.memory_access_time_burst());
+        cch_data = new Cache(
+            data_bus, &machine_config.cache_data(),
+            machine_config.memory_access_time_read(),
+            machine_config.memory_access_time_write(),
+            machine_config.memory_access_time_burst());
+    }
+
+    const std::vector<Cache *> l1_caches = { cch_program, cch_data };
+    if (l2_config.enabled()) {
+        cch_level2->set_inner_levels(l1_caches, inclusion);
+    }
+    if (l3_config.enabled()) {
+        cch_level3->set_inner_levels(
+            l2_config.enabled() ? std::vector<Cache *> { cch_level2 } : l1_caches,
+            inclusion);
+    }
+}
+
 Machine::~Machine() {
     delete run_t;
     run_t = nullptr;
@@ -153,14 +278,19 @@ Machine::~Machine() {
     regs = nullptr;
     delete mem;
     mem = nullptr;
+    delete mapped_ram;
+    mapped_ram = nullptr;
     delete cch_program;
     cch_program = nullptr;
     delete cch_data;
     cch_data = nullptr;
+    delete cch_level2;
+    cch_level2 = nullptr;
+    delete cch_level3;
+    cch_level3 = nullptr;
     delete data_bus;
     data_bus = nullptr;
-    delete mem_program_only;
-    mem_program_only = nullptr;
+    mem_program_only.reset();
     delete symtab;
     symtab = nullptr;
 }
@@ -174,6 +304,10 @@ void Machine::set_speed(unsigned int ips, unsigned int time_chunk) {
     run_t->setInterval(ips);
 }
 
+void Machine::set_run_batch(unsigned int cycles) {
+    run_batch = cycles;
+}
+
 const Registers *Machine::registers() {
     return regs;
 }
@@ -198,10 +332,30 @@ const Cache *Machine::cache_data() {
     return cch_data;
 }
 
+Cache *Machine::cache_program_rw() {
+    return cch_program;
+}
+
 Cache *Machine::cache_data_rw() {
     return cch_data;
 }
 
+const Cache *Machine::cache_level2() {
+    return cch_level2;
+}
+
+const Cache *Machine::cache_level3() {
+    return cch_level3;
+}
+
+Cache *Machine::cache_level2_rw() {
+    return cch_level2;
+}
+
+Cache *Machine::cache_level3_rw() {
+    return cch_level3;
+}
+
 void Machine::cache_sync() {
     if (cch_program != nullptr) {
         cch_program->sync();
@@ -209,6 +363,13 @@ void Machine::cache_sync() {
     if (cch_data != nullptr) {
         cch_data->sync();
     }
+    // Inner levels write their dirty blocks to outer ones first
+    if (cch_level2 != nullptr) {
+        cch_level2->sync();
+    }
+    if (cch_level3 != nullptr) {
+        cch_level3->sync();
+    }
 }
 
 const MemoryDataBus *Machine::memory_data_bus() {
@@ -309,6 +470,7 @@ void Machine::step_internal(bool skip_break) {
     try {
         QTime start_time = QTime::currentTime();
         do {
+            history_record();
             cr->step(skip_break);
         } while (time_chunk != 0 && stat == ST_BUSY && !skip_break
                  && start_time.msecsTo(QTime::currentTime()) < (int)time_chunk);
@@ -330,26 +492,402 @@ void Machine::step_internal(bool skip_break) {
     emit post_tick();
 }
 
+unsigned int Machine::run_internal(
+    unsigned int max_cycles,
+    bool skip_break,
+    const std::function<bool()> &predicate) {
+    if (exited() || stat == ST_BUSY || max_cycles == 0) {
+        return 0;
+    }
+    enum Status stat_prev = stat;
+    unsigned int cycles = 0;
+    set_status(ST_BUSY);
+    emit tick();
+    stop_requested = false;
+    try {
+        do {
+            // Break on the current instruction is skipped only for the first
+            // step, the same way as for single step.
+            history_record();
+            if ((skip_break && cycles == 0) || predicate) {
+                cr->step(skip_break && cycles == 0);
+                cycles++;
+            } else {
+                cycles += cr->step_block(
+                    std::min(max_cycles - cycles, history_budget()), program_end);
+            }
+        } while (cycles < max_cycles && stat == ST_BUSY && !stop_requested
+                 && regs->read_pc() < program_end && !(predicate && predicate()));
+    } catch (SimulatorException &e) {
+        run_t->stop();
+        set_status(ST_TRAPPED);
+        emit program_trap(e);
+        return cycles;
+    }
+    if (regs->read_pc() >= program_end) {
+        run_t->stop();
+        set_status(ST_EXIT);
+        emit program_exit();
+    } else if (stop_requested && stat == ST_BUSY) {
+        run_t->stop();
+        set_status(ST_READY);
+    } else if (stat == ST_BUSY) {
+        set_status(stat_prev);
+    }
+    emit post_tick();
+    return cycles;
+}
+
+unsigned int Machine::run_for(unsigned int max_cycles) {
+    return run_internal(max_cycles, false, nullptr);
+}
+
+unsigned int
+Machine::run_until(const std::function<bool()> &predicate, unsigned int max_cycles) {
+    return run_internal(max_cycles, false, predicate);
+}
+
 void Machine::step() {
     step_internal(true);
 }
 
 void Machine::step_timer() {
-    step_internal();
+    if (run_batch > 1) {
+        run_internal(run_batch, false, nullptr);
+    } else {
+        step_internal();
+    }
+}
+
+void Machine::core_stop_request() {
+    // Only recorded here, batch run checks it after each step
+    stop_requested = true;
 }
 
 void Machine::restart() {
     pause();
     regs->reset();
-    if (mem_program_only != nullptr) {
+    if (mapped_ram != nullptr) {
+        if (mem_program_only != nullptr) {
+            mapped_ram->reset(*mem_program_only);
+        } else {
+            mapped_ram->reset();
+        }
+    } else if (mem_program_only != nullptr) {
         mem->reset(*mem_program_only);
     }
     cch_program->reset();
     cch_data->reset();
+    cch_level2->reset();
+    cch_level3->reset();
     cr->reset();
+    history_clear();
+    if (prof != nullptr) {
+        prof->reset();
+    }
+    if (calls != nullptr) {
+        calls->reset();
+    }
     set_status(ST_READY);
 }
 
+std::unique_ptr<MachineCheckpoint> Machine::checkpoint() const {
+    if (!checkpoint_supported()) {
+        throw SIMULATOR_EXCEPTION(
+            Runtime, "Checkpoint is not supported with mapped RAM", "");
+    }
+    return std::unique_ptr<MachineCheckpoint>(new MachineCheckpoint {
+        .regs = *regs,
+        .cop0 = *cop0st,
+        .core = cr->save_state(),
+        .cache_program = cch_program->save_state(),
+        .cache_data = cch_data->save_state(),
+        .cache_level2 = cch_level2->save_state(),
+        .cache_level3 = cch_level3->save_state(),
+        .mem = *mem,
+        .stat = stat,
+        .peripheral_reads = history_peripherals.position(),
+    });
+}
+
+bool Machine::checkpoint_supported() const {
+    return mem != nullptr;
+}
+
+void Machine::restore(const MachineCheckpoint &checkpoint) {
+    // History of other timeline is not valid anymore
+    history_clear();
+    restore_internal(checkpoint);
+}
+
+void Machine::restore_internal(const MachineCheckpoint &checkpoint) {
+    pause();
+    regs->pc_abs_jmp(checkpoint.regs.read_pc());
+    for (int i = 1; i < 32; i++) {
+        regs->write_gp(i, checkpoint.regs.read_gp(i));
+    }
+    regs->write_hi_lo(false, checkpoint.regs.read_hi_lo(false));
+    regs->write_hi_lo(true, checkpoint.regs.read_hi_lo(true));
+    cop0st->restore(checkpoint.cop0);
+    mem->reset(checkpoint.mem);
+    cch_program->restore_state(checkpoint.cache_program);
+    cch_data->restore_state(checkpoint.cache_data);
+    cch_level2->restore_state(checkpoint.cache_level2);
+    cch_level3->restore_state(checkpoint.cache_level3);
+    cr->restore_state(checkpoint.core);
+    if (checkpoint.stat == ST_RUNNING || checkpoint.stat == ST_BUSY) {
+        set_status(ST_READY);
+    } else {
+        set_status(checkpoint.stat);
+    }
+}
+
+void Machine::set_history(unsigned int interval, unsigned int max_snapshots) {
+    history_period = interval;
+    history_max = std::max(max_snapshots, 2U);
+    history_clear();
+    // Breakpoint hits are repeated by the replay even if removed meanwhile
+    cr->set_hwbreak_log(interval != 0 ? &history_breaks : nullptr);
+    data_bus->set_peripheral_log(interval != 0 ? &history_peripherals : nullptr, mem);
+}
+
+void Machine::history_clear() {
+    history.clear();
+    history_breaks.clear();
+    history_peripherals.clear();
+    history_external = cr->get_external_count();
+    history_next = 0;
+}
+
+void Machine::history_record() {
+    if (history_period == 0 || mem == nullptr) {
+        return;
+    }
+    if (cr->get_external_count() != history_external) {
+        // Effects of interrupt or OS emulation cannot be repeated, history
+        // restarts after them
+        history_clear();
+    }
+    unsigned int cycle = cr->get_cycle_count();
+    if (!history.empty() && cycle < history_next) {
+        return;
+    }
+    history.push_back(checkpoint());
+    if (history.size() > history_max) {
+        // The oldest snapshot leaves the window together with logs which
+        // only its replay needs
+        history.erase(history.begin());
+        const MachineCheckpoint &oldest = *history.front();
+        history_breaks.erase(
+            history_breaks.begin(),
+            std::lower_bound(
+                history_breaks.begin(), history_breaks.end(), oldest.core.cycle_c,
+                [](const Core::HwBreakHit &hit, unsigned int c) { return hit.cycle < c; }));
+        history_peripherals.discard(oldest.peripheral_reads);
+    }
+    unsigned int last = history.back()->core.cycle_c;
+    history_next = last + std::min(history_period, UINT_MAX - last);
+}
+
+unsigned int Machine::history_budget() const {
+    if (history_period == 0 || history.empty()) {
+        return UINT_MAX;
+    }
+    unsigned int cycle = cr->get_cycle_count();
+    return history_next > cycle ? history_next - cycle : 1;
+}
+
+static bool hit_before(unsigned int cycle, const Core::HwBreakHit &hit) {
+    return cycle < hit.cycle;
+}
+
+bool Machine::history_replay(unsigned int cycle, const std::function<void()> &visit) {
+    auto brk = std::upper_bound(
+        history_breaks.begin(), history_breaks.end(), cr->get_cycle_count(), hit_before);
+    auto brk_end = history_breaks.end();
+    // Replay does not extend the log, the hits are already there
+    cr->set_hwbreak_log(nullptr);
+    cr->set_profiler(nullptr);
+    cr->set_call_graph(nullptr);
+    history_peripherals.replaying = true;
+    auto replay_done = [this]() {
+        history_peripherals.replaying = false;
+        cr->set_hwbreak_log(&history_breaks);
+        if (prof != nullptr) {
+            // Misses of replayed cycles are not charged
+            prof->set_caches(cch_program, cch_data);
+            cr->set_profiler(prof.get());
+        }
+        if (calls != nullptr) {
+            calls->set_caches(cch_program, cch_data);
+            cr->set_call_graph(calls.get());
+        }
+    };
+    try {
+        while (cr->get_cycle_count() < cycle) {
+            unsigned int now = cr->get_cycle_count();
+            if (visit) {
+                visit();
+            }
+            if (brk != brk_end && brk->cycle == now + 1) {
+                // Logged hit is repeated even for meanwhile removed breakpoint
+                Address addr = brk->addr;
+                bool present = cr->is_hwbreak(addr);
+                if (!present) {
+                    cr->insert_hwbreak(addr);
+                }
+                cr->step(false);
+                if (!present) {
+                    cr->remove_hwbreak(addr);
+                }
+                ++brk;
+            } else if (!visit && !cr->has_hwbreaks()) {
+                unsigned int limit = cycle - now;
+                if (brk != brk_end) {
+                    limit = std::min(limit, brk->cycle - 1 - now);
+                }
+                cr->step_block(limit, program_end);
+            } else {
+                cr->step(true);
+            }
+        }
+    } catch (SimulatorException &e) {
+        replay_done();
+        set_status(ST_TRAPPED);
+        emit program_trap(e);
+        return false;
+    }
+    replay_done();
+    return true;
+}
+
+bool Machine::history_seek(unsigned int cycle) {
+    // Latest snapshot not after requested cycle, the oldest one otherwise
+    auto snap = std::upper_bound(
+        history.begin() + 1, history.end(), cycle,
+        [](unsigned int c, const std::unique_ptr<MachineCheckpoint> &cp) {
+            return c < cp->core.cycle_c;
+        });
+    --snap;
+    cycle = std::max(cycle, (*snap)->core.cycle_c);
+    restore_internal(**snap);
+    history_peripherals.seek((*snap)->peripheral_reads);
+    if (!history_replay(cycle, nullptr)) {
+        return false;
+    }
+    history.erase(snap + 1, history.end());
+    history_peripherals.truncate();
+    history_breaks.erase(
+        std::upper_bound(history_breaks.begin(), history_breaks.end(), cycle, hit_before),
+        history_breaks.end());
+    unsigned int last = history.back()->core.cycle_c;
+    history_next = last + std::min(history_period, UINT_MAX - last);
+    emit post_tick();
+    return true;
+}
+
+bool Machine::step_back(unsigned int cycles) {
+    if (history.empty() || stat == ST_BUSY) {
+        return false;
+    }
+    history_record(); // Restarts history after the last external effect
+    unsigned int now = cr->get_cycle_count();
+    return history_seek(cycles < now ? now - cycles : 0);
+}
+
+bool Machine::run_back() {
+    if (history.empty() || stat == ST_BUSY) {
+        return false;
+    }
+    history_record(); // Restarts history after the last external effect
+    const unsigned int none = UINT_MAX;
+    unsigned int now = cr->get_cycle_count();
+    unsigned int found = none;
+    auto logged_hit = [this](unsigned int cycle) {
+        auto hit = std::upper_bound(
+            history_breaks.begin(), history_breaks.end(), cycle, hit_before);
+        return hit != history_breaks.begin() && (hit - 1)->cycle == cycle;
+    };
+    // Segments between snapshots are executed again from the latest one.
+    // Stop is placed at the first state of each run of states with PC at
+    // a breakpoint. State before logged hit is skipped, the forward run
+    // stopped only after the hit. Run reaching current state is excluded.
+    for (size_t i = history.size(); i-- > 0 && found == none;) {
+        unsigned int start = history[i]->core.cycle_c;
+        if (start >= now) {
+            continue;
+        }
+        unsigned int end = now;
+        if (i + 1 < history.size()) {
+            end = std::min(end, history[i + 1]->core.cycle_c);
+        }
+        restore_internal(*history[i]);
+        history_peripherals.seek(history[i]->peripheral_reads);
+        Address run_pc = regs->read_pc();
+        unsigned int candidate = none;
+        auto visit = [&]() {
+            Address pc = regs->read_pc();
+            unsigned int cycle = cr->get_cycle_count();
+            if (cycle == start || pc != run_pc || logged_hit(cycle)) {
+                if (candidate != none) {
+                    found = candidate;
+                }
+                run_pc = pc;
+                candidate = cr->is_hwbreak(pc) ? cycle : none;
+            }
+            if (logged_hit(cycle + 1)) {
+                candidate = none;
+            }
+        };
+        if (!history_replay(end, visit)) {
+            return false;
+        }
+        if (candidate != none && (regs->read_pc() != run_pc || logged_hit(end))) {
+            found = candidate;
+        }
+    }
+    if (found == none) {
+        history_seek(0);
+        return false;
+    }
+    return history_seek(found);
+}
+
+void Machine::set_profiling(bool enable) {
+    if (!enable) {
+        cr->set_profiler(nullptr);
+        prof.reset();
+        return;
+    }
+    if (prof == nullptr) {
+        prof.reset(new Profiler(program_begin));
+        prof->set_caches(cch_program, cch_data);
+        cr->set_profiler(prof.get());
+    }
+}
+
+const Profiler *Machine::profiler() const {
+    return prof.get();
+}
+
+void Machine::set_call_graph(bool enable) {
+    if (!enable) {
+        cr->set_call_graph(nullptr);
+        calls.reset();
+        return;
+    }
+    if (calls == nullptr) {
+        // Symbols can be added later by the integrated assembler
+        calls.reset(new CallGraph(symbol_table(true)));
+        calls->set_caches(cch_program, cch_data);
+        cr->set_call_graph(calls.get());
+    }
+}
+
+const CallGraph *Machine::call_graph() const {
+    return calls.get();
+}
+
 void Machine::set_status(enum Status st) {
     bool change = st != stat;
     stat = st;
@@ -36,24 +36,38 @@
 #ifndef MACHINE_H
 #define MACHINE_H
 
+#include "callgraph.h"
 #include "core.h"
 #include "machineconfig.h"
 #include "memory/backend/lcddisplay.h"
+#include "memory/backend/mappedram.h"
 #include "memory/backend/peripheral.h"
 #include "memory/backend/peripspiled.h"
 #include "memory/backend/serialport.h"
 #include "memory/cache/cache.h"
 #include "memory/memory_bus.h"
+#include "profiler.h"
 #include "registers.h"
 #include "simulator_exception.h"
 #include "symboltable.h"
 
 #include <QObject>
 #include <QTimer>
+#include <climits>
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
 
 namespace machine {
 
+/** Default snapshot period of reverse execution history (in cycles). */
+constexpr unsigned int HISTORY_INTERVAL_DEFAULT = 1000;
+/** Default number of snapshots kept by reverse execution history. */
+constexpr unsigned int HISTORY_SNAPSHOTS_DEFAULT = 256;
+
+struct MachineCheckpoint;
+
 class Machine : public QObject {
     Q_OBJECT
 public:
@@ -65,14 +79,45 @@ public:
 
     const MachineConfig &config();
     void set_speed(unsigned int ips, unsigned int time_chunk = 0);
+    /**
+     * Number of cycles executed synchronously in one run timer tick.
+     *
+     * Values above one switch play() to batch mode (see run_for), the event
+     * loop and tick/post_tick are then serviced only once per batch.
+     */
+    void set_run_batch(unsigned int cycles);
+
+    /**
+     * Executes up to max_cycles core steps without returning to the event
+     * loop. Run ends early (exactly after the causing step) when the program
+     * exits or traps, when the core reports stop on exception (including
+     * hardware breakpoint) or when the machine is paused.
+     *
+     * @return number of executed cycles
+     */
+    unsigned int run_for(unsigned int max_cycles);
+    /**
+     * Same as run_for, but the predicate is evaluated after each step and
+     * the run stops once it returns true.
+     */
+    unsigned int run_until(
+        const std::function<bool()> &predicate,
+        unsigned int max_cycles = UINT_MAX);
 
     const Registers *registers();
     const Cop0State *cop0state();
+    // Tree based RAM, nullptr when mapped RAM is configured
     const Memory *memory();
     Memory *memory_rw();
     const Cache *cache_program();
     const Cache *cache_data();
+    Cache *cache_program_rw();
     Cache *cache_data_rw();
+    // Shared levels, disabled when not configured
+    const Cache *cache_level2();
+    const Cache *cache_level3();
+    Cache *cache_level2_rw();
+    Cache *cache_level3_rw();
     void cache_sync();
     const MemoryDataBus *memory_data_bus();
     MemoryDataBus *memory_data_bus_rw();
@@ -120,6 +165,73 @@ public:
     bool get_step_over_exception(enum ExceptionCause excause) const;
     enum ExceptionCause get_exception_cause() const;
 
+    /**
+     * Capture simulated state: registers, Cop0, core latches, all cache
+     * levels (including replacement policy) and memory. Memory sections are shared
+     * with the running machine and copied on first write, so checkpoints are
+     * cheap even for large memory images. State of peripherals and of the
+     * OS emulation is not captured. Mapped RAM is not supported.
+     */
+    std::unique_ptr<MachineCheckpoint> checkpoint() const;
+    // Checkpoints (and therefore history) need tree based RAM
+    bool checkpoint_supported() const;
+    // Return to state captured by checkpoint() of this machine
+    void restore(const MachineCheckpoint &checkpoint);
+
+    /**
+     * Enable history for reverse execution (zero interval disables it).
+     *
+     * While running forward, checkpoint is taken every interval cycles.
+     * When more than max_snapshots are held, the oldest one is dropped
+     * together with the logs recorded before the next one, therefore history
+     * covers last interval * max_snapshots cycles and its memory is bounded.
+     * States between snapshots are reached by repeated execution, hardware
+     * breakpoint hits are logged to be repeated faithfully.
+     * Values read from peripherals are logged too, repeated execution gets
+     * them from the log and its writes to peripherals are dropped, so
+     * output is not duplicated. Peripherals stay in their present state.
+     * Interrupts and exceptions handled outside of the machine (OS
+     * emulation) cannot be repeated, history restarts after them. User
+     * edits of the state are not part of the history. Mapped RAM is not
+     * supported.
+     */
+    void set_history(unsigned int interval, unsigned int max_snapshots);
+    /**
+     * Return to state cycles back. When such state precedes recorded history
+     * the machine returns to the oldest recorded state. Recorded future is
+     * discarded, forward execution creates a new one.
+     *
+     * @return false when there is no history to return to
+     */
+    bool step_back(unsigned int cycles = 1);
+    /**
+     * Run backwards to the latest earlier state with PC at a hardware
+     * breakpoint or to the oldest recorded state when there is none.
+     *
+     * @return true when a breakpoint was reached
+     */
+    bool run_back();
+
+    /**
+     * Collect per instruction profile (execution counts, stall cycles, L1
+     * cache misses and exceptions) from now on. Profile is cleared by
+     * restart and when profiling is disabled. Cycles repeated by reverse
+     * execution are not counted, cycles executed again after return to
+     * an earlier state are.
+     */
+    void set_profiling(bool enable);
+    // Collected profile, nullptr when profiling is disabled
+    const Profiler *profiler() const;
+    /**
+     * Collect call graph (calls by JAL, JALR or branch and link, returns by
+     * JR $ra) with inclusive and exclusive costs of functions. Functions
+     * are delimited by the symbol table. Cleared by restart and when
+     * disabled.
+     */
+    void set_call_graph(bool enable);
+    // Collected call graph, nullptr when disabled
+    const CallGraph *call_graph() const;
+
 public slots:
     void play();
     void pause();
@@ -136,38 +248,81 @@ signals:
 
 private slots:
     void step_timer();
+    void core_stop_request();
 
 private:
     void step_internal(bool skip_break = false);
+    unsigned int run_internal(
+        unsigned int max_cycles,
+        bool skip_break,
+        const std::function<bool()> &predicate);
+    void restore_internal(const MachineCheckpoint &checkpoint);
+    void history_clear();
+    void history_record();
+    unsigned int history_budget() const;
+    bool history_seek(unsigned int cycle);
+    bool history_replay(unsigned int cycle, const std::function<void()> &visit);
     MachineConfig machine_config;
 
     Registers *regs = nullptr;
     Memory *mem = nullptr;
+    MappedRam *mapped_ram = nullptr;
     /**
      * Memory with loaded program only.
      * It is not used for execution, only for quick
      * simulation reset without repeated ELF file loading.
+     * Shared by all machines loaded with the same content.
      */
-    Memory *mem_program_only = nullptr;
+    std::shared_ptr<const Memory> mem_program_only;
     MemoryDataBus *data_bus = nullptr;
     SerialPort *ser_port = nullptr;
     PeripSpiLed *perip_spi_led = nullptr;
     LcdDisplay *perip_lcd_display = nullptr;
     Cache *cch_program = nullptr;
     Cache *cch_data = nullptr;
+    Cache *cch_level2 = nullptr;
+    Cache *cch_level3 = nullptr;
     Cop0State *cop0st = nullptr;
     Core *cr = nullptr;
 
     QTimer *run_t = nullptr;
     unsigned int time_chunk = { 0 };
+    unsigned int run_batch = { 0 };
+    bool stop_requested = false;
+
+    unsigned int history_period = 0;
+    unsigned int history_max = 0;
+    unsigned int history_next = 0;
+    std::vector<std::unique_ptr<MachineCheckpoint>> history;
+    std::vector<Core::HwBreakHit> history_breaks;
+    PeripheralLog history_peripherals;
+    unsigned int history_external = 0; // Core external count at restart
+
+    std::unique_ptr<Profiler> prof;
+    std::unique_ptr<CallGraph> calls;
 
     SymbolTable *symtab = nullptr;
+    Address program_begin = 0x80020000_addr; // Base of profiled code
     Address program_end = 0xffff0000_addr;
     enum Status stat = ST_READY;
     void set_status(enum Status st);
     void setup_serial_port();
     void setup_perip_spi_led();
     void setup_lcd_display();
+    void setup_cache_hierarchy();
+};
+
+struct MachineCheckpoint {
+    Registers regs;
+    Cop0State cop0;
+    Core::State core;
+    Cache::State cache_program;
+    Cache::State cache_data;
+    Cache::State cache_level2;
+    Cache::State cache_level3;
+    Memory mem;
+    enum Machine::Status stat;
+    uint64_t peripheral_reads; // Position in peripheral log of history
 };
 
 } // namespace machine
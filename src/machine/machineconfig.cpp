@@ -47,12 +47,23 @@ using namespace machine;
 #define DF_PIPELINE false
 #define DF_DELAYSLOT true
 #define DF_HUNIT HU_STALL_FORWARD
+#define DF_BPRED BP_NONE
+#define DF_BPRED_BITS 8
+#define DF_BTB 64
+#define DF_RAS 8
+#define DF_MISPREDICT_PENALTY 2
 #define DF_EXEC_PROTEC false
 #define DF_WRITE_PROTEC false
 #define DF_MEM_ACC_READ 10
 #define DF_MEM_ACC_WRITE 10
 #define DF_MEM_ACC_BURST 0
+#define DF_MEM_STALLS false
 #define DF_ELF QString("")
+#define DF_JIT false
+#define DF_MAPPED_RAM false
+#define DF_LEVEL2_ACC 4
+#define DF_LEVEL3_ACC 8
+#define DF_INCLUSION CI_NON_INCLUSIVE
 //////////////////////////////////////////////////////////////////////////////
 /// Default config of CacheConfig
 #define DFC_EN false
@@ -61,6 +72,9 @@ using namespace machine;
 #define DFC_ASSOC 1
 #define DFC_REPLAC RP_RAND
 #define DFC_WRITE WP_THROUGH_NOALLOC
+#define DFC_PREFETCH PF_NONE
+#define DFC_PF_DEGREE 1
+#define DFC_PF_DISTANCE 1
 //////////////////////////////////////////////////////////////////////////////
 
 CacheConfig::CacheConfig() {
@@ -70,6 +84,9 @@ CacheConfig::CacheConfig() {
     d_associativity = DFC_ASSOC;
     replac_pol = DFC_REPLAC;
     write_pol = DFC_WRITE;
+    prefetch = DFC_PREFETCH;
+    pf_degree = DFC_PF_DEGREE;
+    pf_distance = DFC_PF_DISTANCE;
 }
 
 CacheConfig::CacheConfig(const CacheConfig *cc) {
@@ -79,6 +96,9 @@ CacheConfig::CacheConfig(const CacheConfig *cc) {
     d_associativity = cc->associativity();
     replac_pol = cc->replacement_policy();
     write_pol = cc->write_policy();
+    prefetch = cc->prefetcher();
+    pf_degree = cc->prefetch_degree();
+    pf_distance = cc->prefetch_distance();
 }
 
 #define N(STR) (prefix + QString(STR))
@@ -92,6 +112,9 @@ CacheConfig::CacheConfig(const QSettings *sts, const QString &prefix) {
         = (enum ReplacementPolicy)sts->value(N("Replacement"), DFC_REPLAC)
               .toUInt();
     write_pol = (enum WritePolicy)sts->value(N("Write"), DFC_WRITE).toUInt();
+    prefetch = (enum Prefetcher)sts->value(N("Prefetcher"), DFC_PREFETCH).toUInt();
+    pf_degree = sts->value(N("PrefetchDegree"), DFC_PF_DEGREE).toUInt();
+    pf_distance = sts->value(N("PrefetchDistance"), DFC_PF_DISTANCE).toUInt();
 }
 
 void CacheConfig::store(QSettings *sts, const QString &prefix) const {
@@ -101,6 +124,9 @@ void CacheConfig::store(QSettings *sts, const QString &prefix) const {
     sts->setValue(N("Associativity"), associativity());
     sts->setValue(N("Replacement"), (unsigned)replacement_policy());
     sts->setValue(N("Write"), (unsigned)write_policy());
+    sts->setValue(N("Prefetcher"), (unsigned)prefetcher());
+    sts->setValue(N("PrefetchDegree"), prefetch_degree());
+    sts->setValue(N("PrefetchDistance"), prefetch_distance());
 }
 
 #undef N
@@ -145,6 +171,18 @@ void CacheConfig::set_write_policy(enum WritePolicy v) {
     write_pol = v;
 }
 
+void CacheConfig::set_prefetcher(enum Prefetcher v) {
+    prefetch = v;
+}
+
+void CacheConfig::set_prefetch_degree(unsigned v) {
+    pf_degree = v > 0 ? v : 1;
+}
+
+void CacheConfig::set_prefetch_distance(unsigned v) {
+    pf_distance = v > 0 ? v : 1;
+}
+
 bool CacheConfig::enabled() const {
     return en;
 }
@@ -169,11 +207,24 @@ enum CacheConfig::WritePolicy CacheConfig::write_policy() const {
     return write_pol;
 }
 
+enum CacheConfig::Prefetcher CacheConfig::prefetcher() const {
+    return prefetch;
+}
+
+unsigned CacheConfig::prefetch_degree() const {
+    return pf_degree;
+}
+
+unsigned CacheConfig::prefetch_distance() const {
+    return pf_distance;
+}
+
 bool CacheConfig::operator==(const CacheConfig &c) const {
 #define CMP(GETTER) (GETTER)() == (c.GETTER)()
     return CMP(enabled) && CMP(set_count) && CMP(block_size)
            && CMP(associativity) && CMP(replacement_policy)
-           && CMP(write_policy);
+           && CMP(write_policy) && CMP(prefetcher) && CMP(prefetch_degree)
+           && CMP(prefetch_distance);
 #undef CMP
 }
 
@@ -185,11 +236,17 @@ MachineConfig::MachineConfig() {
     pipeline = DF_PIPELINE;
     delayslot = DF_DELAYSLOT;
     hunit = DF_HUNIT;
+    bpred = DF_BPRED;
+    bpred_bits = DF_BPRED_BITS;
+    btb_entries = DF_BTB;
+    ras_depth = DF_RAS;
+    mispredict_penalty = DF_MISPREDICT_PENALTY;
     exec_protect = DF_EXEC_PROTEC;
     write_protect = DF_WRITE_PROTEC;
     mem_acc_read = DF_MEM_ACC_READ;
     mem_acc_write = DF_MEM_ACC_WRITE;
     mem_acc_burst = DF_MEM_ACC_BURST;
+    mem_stalls = DF_MEM_STALLS;
     osem_enable = true;
     osem_known_syscall_stop = true;
     osem_unknown_syscall_stop = true;
@@ -198,19 +255,32 @@ MachineConfig::MachineConfig() {
     osem_fs_root = "";
     res_at_compile = true;
     elf_path = DF_ELF;
+    jit_enable = DF_JIT;
+    mapped_ram_enable = DF_MAPPED_RAM;
     cch_program = CacheConfig();
     cch_data = CacheConfig();
+    cch_level2 = CacheConfig();
+    cch_level3 = CacheConfig();
+    level2_acc = DF_LEVEL2_ACC;
+    level3_acc = DF_LEVEL3_ACC;
+    inclusion = DF_INCLUSION;
 }
 
 MachineConfig::MachineConfig(const MachineConfig *config) {
     pipeline = config->pipelined();
     delayslot = config->delay_slot();
     hunit = config->hazard_unit();
+    bpred = config->branch_predictor();
+    bpred_bits = config->branch_predictor_bits();
+    btb_entries = config->branch_target_buffer();
+    ras_depth = config->return_address_stack();
+    mispredict_penalty = config->branch_mispredict_penalty();
     exec_protect = config->memory_execute_protection();
     write_protect = config->memory_write_protection();
     mem_acc_read = config->memory_access_time_read();
     mem_acc_write = config->memory_access_time_write();
     mem_acc_burst = config->memory_access_time_burst();
+    mem_stalls = config->memory_stalls();
     osem_enable = config->osemu_enable();
     osem_known_syscall_stop = config->osemu_known_syscall_stop();
     osem_unknown_syscall_stop = config->osemu_unknown_syscall_stop();
@@ -219,8 +289,15 @@ MachineConfig::MachineConfig(const MachineConfig *config) {
     osem_fs_root = config->osemu_fs_root();
     res_at_compile = config->reset_at_compile();
     elf_path = config->elf();
+    jit_enable = config->jit();
+    mapped_ram_enable = config->mapped_ram();
     cch_program = config->cache_program();
     cch_data = config->cache_data();
+    cch_level2 = config->cache_level2();
+    cch_level3 = config->cache_level3();
+    level2_acc = config->cache_level2_access_time();
+    level3_acc = config->cache_level3_access_time();
+    inclusion = config->cache_inclusion();
 }
 
 #define N(STR) (prefix + QString(STR))
@@ -229,6 +306,12 @@ MachineConfig::MachineConfig(const QSettings *sts, const QString &prefix) {
     pipeline = sts->value(N("Pipelined"), DF_PIPELINE).toBool();
     delayslot = sts->value(N("DelaySlot"), DF_DELAYSLOT).toBool();
     hunit = (enum HazardUnit)sts->value(N("HazardUnit"), DF_HUNIT).toUInt();
+    bpred = (enum BranchPredictor)sts->value(N("BranchPredictor"), DF_BPRED).toUInt();
+    set_branch_predictor_bits(sts->value(N("BranchPredictorBits"), DF_BPRED_BITS).toUInt());
+    btb_entries = sts->value(N("BranchTargetBuffer"), DF_BTB).toUInt();
+    ras_depth = sts->value(N("ReturnAddressStack"), DF_RAS).toUInt();
+    mispredict_penalty
+        = sts->value(N("BranchMispredictPenalty"), DF_MISPREDICT_PENALTY).toUInt();
     exec_protect
         = sts->value(N("MemoryExecuteProtection"), DF_EXEC_PROTEC).toBool();
     write_protect
@@ -236,6 +319,7 @@ MachineConfig::MachineConfig(const QSettings *sts, const QString &prefix) {
     mem_acc_read = sts->value(N("MemoryRead"), DF_MEM_ACC_READ).toUInt();
     mem_acc_write = sts->value(N("MemoryWrite"), DF_MEM_ACC_WRITE).toUInt();
     mem_acc_burst = sts->value(N("MemoryBurts"), DF_MEM_ACC_BURST).toUInt();
+    mem_stalls = sts->value(N("MemoryStalls"), DF_MEM_STALLS).toBool();
     osem_enable = sts->value(N("OsemuEnable"), true).toBool();
     osem_known_syscall_stop
         = sts->value(N("OsemuKnownSyscallStop"), true).toBool();
@@ -246,17 +330,30 @@ MachineConfig::MachineConfig(const QSettings *sts, const QString &prefix) {
     osem_fs_root = sts->value(N("OsemuFilesystemRoot"), "").toString();
     res_at_compile = sts->value(N("ResetAtCompile"), true).toBool();
     elf_path = sts->value(N("Elf"), DF_ELF).toString();
+    jit_enable = sts->value(N("Jit"), DF_JIT).toBool();
+    mapped_ram_enable = sts->value(N("MappedRam"), DF_MAPPED_RAM).toBool();
     cch_program = CacheConfig(sts, N("ProgramCache_"));
     cch_data = CacheConfig(sts, N("DataCache_"));
+    cch_level2 = CacheConfig(sts, N("Level2Cache_"));
+    cch_level3 = CacheConfig(sts, N("Level3Cache_"));
+    level2_acc = sts->value(N("Level2AccessTime"), DF_LEVEL2_ACC).toUInt();
+    level3_acc = sts->value(N("Level3AccessTime"), DF_LEVEL3_ACC).toUInt();
+    inclusion = (enum CacheInclusion)sts->value(N("CacheInclusion"), DF_INCLUSION).toUInt();
 }
 
 void MachineConfig::store(QSettings *sts, const QString &prefix) {
     sts->setValue(N("Pipelined"), pipelined());
     sts->setValue(N("DelaySlot"), delay_slot());
     sts->setValue(N("HazardUnit"), (unsigned)hazard_unit());
+    sts->setValue(N("BranchPredictor"), (unsigned)branch_predictor());
+    sts->setValue(N("BranchPredictorBits"), branch_predictor_bits());
+    sts->setValue(N("BranchTargetBuffer"), branch_target_buffer());
+    sts->setValue(N("ReturnAddressStack"), return_address_stack());
+    sts->setValue(N("BranchMispredictPenalty"), branch_mispredict_penalty());
     sts->setValue(N("MemoryRead"), memory_access_time_read());
     sts->setValue(N("MemoryWrite"), memory_access_time_write());
     sts->setValue(N("MemoryBurts"), memory_access_time_burst());
+    sts->setValue(N("MemoryStalls"), memory_stalls());
     sts->setValue(N("OsemuEnable"), osemu_enable());
     sts->setValue(N("OsemuKnownSyscallStop"), osemu_known_syscall_stop());
     sts->setValue(N("OsemuUnknownSyscallStop"), osemu_unknown_syscall_stop());
@@ -265,8 +362,15 @@ void MachineConfig::store(QSettings *sts, const QString &prefix) {
     sts->setValue(N("OsemuFilesystemRoot"), osemu_fs_root());
     sts->setValue(N("ResetAtCompile"), reset_at_compile());
     sts->setValue(N("Elf"), elf_path);
+    sts->setValue(N("Jit"), jit());
+    sts->setValue(N("MappedRam"), mapped_ram());
     cch_program.store(sts, N("ProgramCache_"));
     cch_data.store(sts, N("DataCache_"));
+    cch_level2.store(sts, N("Level2Cache_"));
+    cch_level3.store(sts, N("Level3Cache_"));
+    sts->setValue(N("Level2AccessTime"), cache_level2_access_time());
+    sts->setValue(N("Level3AccessTime"), cache_level3_access_time());
+    sts->setValue(N("CacheInclusion"), (unsigned)cache_inclusion());
 }
 
 #undef N
@@ -295,9 +399,14 @@ void MachineConfig::preset(enum ConfigPresets p) {
     set_memory_access_time_read(DF_MEM_ACC_READ);
     set_memory_access_time_write(DF_MEM_ACC_WRITE);
     set_memory_access_time_burst(DF_MEM_ACC_BURST);
+    set_memory_stalls(DF_MEM_STALLS);
+    set_branch_predictor(DF_BPRED);
 
     access_cache_program()->preset(p);
     access_cache_data()->preset(p);
+    // Presets model single level hierarchy only
+    access_cache_level2()->set_enabled(false);
+    access_cache_level3()->set_enabled(false);
 }
 
 void MachineConfig::set_pipelined(bool v) {
@@ -313,7 +422,7 @@ void MachineConfig::set_hazard_unit(enum MachineConfig::HazardUnit hu) {
 }
 
 bool MachineConfig::set_hazard_unit(const QString &hukind) {
-    static QMap<QString, enum HazardUnit> hukind_map = {
+    static const QMap<QString, enum HazardUnit> hukind_map = {
         { "none", HU_NONE },
         { "stall", HU_STALL },
         { "forward", HU_STALL_FORWARD },
@@ -326,6 +435,43 @@ bool MachineConfig::set_hazard_unit(const QString &hukind) {
     return true;
 }
 
+void MachineConfig::set_branch_predictor(enum MachineConfig::BranchPredictor bp) {
+    bpred = bp;
+}
+
+bool MachineConfig::set_branch_predictor(const QString &bpkind) {
+    static const QMap<QString, enum BranchPredictor> bpkind_map = {
+        { "none", BP_NONE },
+        { "not-taken", BP_STATIC_NOT_TAKEN },
+        { "static", BP_STATIC_NOT_TAKEN },
+        { "bimodal", BP_BIMODAL },
+        { "gshare", BP_GSHARE },
+        { "tournament", BP_TOURNAMENT },
+    };
+    if (!bpkind_map.contains(bpkind)) {
+        return false;
+    }
+    set_branch_predictor(bpkind_map.value(bpkind));
+    return true;
+}
+
+void MachineConfig::set_branch_predictor_bits(unsigned v) {
+    // Tables are allocated in full, keep them reasonably small
+    bpred_bits = v < 1 ? 1 : v > 20 ? 20 : v;
+}
+
+void MachineConfig::set_branch_target_buffer(unsigned v) {
+    btb_entries = v;
+}
+
+void MachineConfig::set_return_address_stack(unsigned v) {
+    ras_depth = v;
+}
+
+void MachineConfig::set_branch_mispredict_penalty(unsigned v) {
+    mispredict_penalty = v;
+}
+
 void MachineConfig::set_memory_execute_protection(bool v) {
     exec_protect = v;
 }
@@ -346,6 +492,10 @@ void MachineConfig::set_memory_access_time_burst(unsigned v) {
     mem_acc_burst = v;
 }
 
+void MachineConfig::set_memory_stalls(bool v) {
+    mem_stalls = v;
+}
+
 void MachineConfig::set_osemu_enable(bool v) {
     osem_enable = v;
 }
@@ -378,6 +528,14 @@ void MachineConfig::set_elf(QString path) {
     elf_path = std::move(path);
 }
 
+void MachineConfig::set_jit(bool v) {
+    jit_enable = v;
+}
+
+void MachineConfig::set_mapped_ram(bool v) {
+    mapped_ram_enable = v;
+}
+
 void MachineConfig::set_cache_program(const CacheConfig &c) {
     cch_program = c;
 }
@@ -386,6 +544,26 @@ void MachineConfig::set_cache_data(const CacheConfig &c) {
     cch_data = c;
 }
 
+void MachineConfig::set_cache_level2(const CacheConfig &c) {
+    cch_level2 = c;
+}
+
+void MachineConfig::set_cache_level3(const CacheConfig &c) {
+    cch_level3 = c;
+}
+
+void MachineConfig::set_cache_level2_access_time(unsigned v) {
+    level2_acc = v;
+}
+
+void MachineConfig::set_cache_level3_access_time(unsigned v) {
+    level3_acc = v;
+}
+
+void MachineConfig::set_cache_inclusion(enum CacheInclusion v) {
+    inclusion = v;
+}
+
 void MachineConfig::set_simulated_endian(Endian endian) {
     MachineConfig::simulated_endian = endian;
 }
@@ -404,6 +582,27 @@ enum MachineConfig::HazardUnit MachineConfig::hazard_unit() const {
     return pipeline ? hunit : machine::MachineConfig::HU_NONE;
 }
 
+enum MachineConfig::BranchPredictor MachineConfig::branch_predictor() const {
+    // Only pipelined core fetches ahead of branch resolution
+    return pipeline ? bpred : machine::MachineConfig::BP_NONE;
+}
+
+unsigned MachineConfig::branch_predictor_bits() const {
+    return bpred_bits;
+}
+
+unsigned MachineConfig::branch_target_buffer() const {
+    return btb_entries;
+}
+
+unsigned MachineConfig::return_address_stack() const {
+    return ras_depth;
+}
+
+unsigned MachineConfig::branch_mispredict_penalty() const {
+    return mispredict_penalty;
+}
+
 bool MachineConfig::memory_execute_protection() const {
     return exec_protect;
 }
@@ -424,6 +623,10 @@ unsigned MachineConfig::memory_access_time_burst() const {
     return mem_acc_burst;
 }
 
+bool MachineConfig::memory_stalls() const {
+    return mem_stalls;
+}
+
 bool MachineConfig::osemu_enable() const {
     return osem_enable;
 }
@@ -452,6 +655,14 @@ QString MachineConfig::elf() const {
     return elf_path;
 }
 
+bool MachineConfig::jit() const {
+    return jit_enable;
+}
+
+bool MachineConfig::mapped_ram() const {
+    return mapped_ram_enable;
+}
+
 const CacheConfig &MachineConfig::cache_program() const {
     return cch_program;
 }
@@ -460,6 +671,26 @@ const CacheConfig &MachineConfig::cache_data() const {
     return cch_data;
 }
 
+const CacheConfig &MachineConfig::cache_level2() const {
+    return cch_level2;
+}
+
+const CacheConfig &MachineConfig::cache_level3() const {
+    return cch_level3;
+}
+
+unsigned MachineConfig::cache_level2_access_time() const {
+    return level2_acc > 1 ? level2_acc : 1;
+}
+
+unsigned MachineConfig::cache_level3_access_time() const {
+    return level3_acc > 1 ? level3_acc : 1;
+}
+
+enum MachineConfig::CacheInclusion MachineConfig::cache_inclusion() const {
+    return inclusion;
+}
+
 CacheConfig *MachineConfig::access_cache_program() {
     return &cch_program;
 }
@@ -468,17 +699,30 @@ CacheConfig *MachineConfig::access_cache_data() {
     return &cch_data;
 }
 
+CacheConfig *MachineConfig::access_cache_level2() {
+    return &cch_level2;
+}
+
+CacheConfig *MachineConfig::access_cache_level3() {
+    return &cch_level3;
+}
+
 Endian MachineConfig::get_simulated_endian() const {
     return simulated_endian;
 }
 
 bool MachineConfig::operator==(const MachineConfig &c) const {
 #define CMP(GETTER) (GETTER)() == (c.GETTER)()
-    return CMP(pipelined) && CMP(delay_slot) && CMP(hazard_unit)
+    return CMP(pipelined) && CMP(delay_slot) && CMP(hazard_unit) && CMP(branch_predictor)
+           && CMP(branch_predictor_bits) && CMP(branch_target_buffer)
+           && CMP(return_address_stack) && CMP(branch_mispredict_penalty)
            && CMP(memory_execute_protection) && CMP(memory_write_protection)
            && CMP(memory_access_time_read) && CMP(memory_access_time_write)
-           && CMP(memory_access_time_burst) && CMP(elf) && CMP(cache_program)
-           && CMP(cache_data);
+           && CMP(memory_access_time_burst) && CMP(memory_stalls) && CMP(elf) && CMP(jit)
+           && CMP(mapped_ram) && CMP(cache_program) && CMP(cache_data)
+           && CMP(cache_level2) && CMP(cache_level3)
+           && CMP(cache_level2_access_time) && CMP(cache_level3_access_time)
+           && CMP(cache_inclusion);
 #undef CMP
 }
 
@@ -61,9 +61,13 @@ public:
     void preset(enum ConfigPresets);
 
     enum ReplacementPolicy {
-        RP_RAND, // Random
-        RP_LRU,  // Least recently used
-        RP_LFU   // Least frequently used
+        RP_RAND,  // Random
+        RP_LRU,   // Least recently used
+        RP_LFU,   // Least frequently used
+        RP_PLRU,  // Tree pseudo least recently used
+        RP_NRU,   // Not recently used
+        RP_SRRIP, // Static re-reference interval prediction
+        RP_BRRIP  // Bimodal re-reference interval prediction
     };
 
     enum WritePolicy {
@@ -72,6 +76,13 @@ public:
         WP_BACK             // Write back
     };
 
+    enum Prefetcher {
+        PF_NONE,      // Demand fetch only
+        PF_NEXT_LINE, // Blocks following a missed (or prefetched) one
+        PF_STRIDE,    // Reference prediction table indexed by PC
+        PF_STREAM     // Sequential streams detected from misses
+    };
+
     // If cache should be used or not
     void set_enabled(bool);
     void set_set_count(unsigned);     // Number of sets
@@ -80,6 +91,9 @@ public:
                                       // ways)
     void set_replacement_policy(enum ReplacementPolicy);
     void set_write_policy(enum WritePolicy);
+    void set_prefetcher(enum Prefetcher);
+    void set_prefetch_degree(unsigned);   // Blocks prefetched per trigger
+    void set_prefetch_distance(unsigned); // Blocks ahead of the access
 
     bool enabled() const;
     unsigned set_count() const;
@@ -87,6 +101,9 @@ public:
     unsigned associativity() const;
     enum ReplacementPolicy replacement_policy() const;
     enum WritePolicy write_policy() const;
+    enum Prefetcher prefetcher() const;
+    unsigned prefetch_degree() const;
+    unsigned prefetch_distance() const;
 
     bool operator==(const CacheConfig &c) const;
     bool operator!=(const CacheConfig &c) const;
@@ -96,6 +113,8 @@ private:
     unsigned n_sets, n_blocks, d_associativity;
     enum ReplacementPolicy replac_pol;
     enum WritePolicy write_pol;
+    enum Prefetcher prefetch;
+    unsigned pf_degree, pf_distance;
 };
 
 class MachineConfig {
@@ -110,6 +129,20 @@ public:
 
     enum HazardUnit { HU_NONE, HU_STALL, HU_STALL_FORWARD };
 
+    enum CacheInclusion {
+        CI_NON_INCLUSIVE, // Levels are managed independently
+        CI_INCLUSIVE,     // Outer level holds all blocks of inner levels
+        CI_EXCLUSIVE      // Outer level holds only blocks evicted from inner
+    };
+
+    enum BranchPredictor {
+        BP_NONE,             // Control transfers are not predicted
+        BP_STATIC_NOT_TAKEN, // Conditional branches always fall through
+        BP_BIMODAL,          // Two bit counters indexed by PC
+        BP_GSHARE,           // Counters indexed by PC xor global history
+        BP_TOURNAMENT        // Bimodal or gshare chosen per PC
+    };
+
     // Configure if CPU is pipelined
     // In default disabled.
     void set_pipelined(bool);
@@ -120,6 +153,18 @@ public:
     // Hazard unit
     void set_hazard_unit(enum HazardUnit);
     bool set_hazard_unit(const QString &hukind);
+    // Fetch stage prediction of pipelined core. Prediction does not change
+    // executed instructions, every misprediction stalls the pipeline for
+    // mispredict penalty cycles. In default disabled.
+    void set_branch_predictor(enum BranchPredictor);
+    bool set_branch_predictor(const QString &bpkind);
+    // Log2 of number of counters in predictor tables (and of history bits)
+    void set_branch_predictor_bits(unsigned);
+    // Number of branch target buffer entries (zero leaves taken control
+    // transfers without predicted target)
+    void set_branch_target_buffer(unsigned);
+    void set_return_address_stack(unsigned); // Depth (zero disables)
+    void set_branch_mispredict_penalty(unsigned);
     // Protect data memory from execution. Only program sections can be
     // executed.
     void set_memory_execute_protection(bool);
@@ -129,6 +174,10 @@ public:
     void set_memory_access_time_read(unsigned);
     void set_memory_access_time_write(unsigned);
     void set_memory_access_time_burst(unsigned);
+    // Stall pipelined core for the memory access time of cache misses and
+    // uncached accesses. In default disabled, misses then cost no cycles and
+    // penalties are used for cache statistics only.
+    void set_memory_stalls(bool);
     // Operating system and exceptions setup
     void set_osemu_enable(bool);
     void set_osemu_known_syscall_stop(bool);
@@ -141,19 +190,42 @@ public:
     // Set path to source elf file. This has to be set before core is
     // initialized.
     void set_elf(QString path);
+    // Execute hot code of non-pipelined core by native code generated at
+    // runtime. Only functional state is simulated for such code (memory
+    // access statistics are not updated). In default disabled.
+    void set_jit(bool);
+    // Back RAM by one contiguous host memory mapping instead of the tree of
+    // small sections. Suitable for programs with large heaps. In default
+    // disabled.
+    void set_mapped_ram(bool);
     // Configure cache
     void set_cache_program(const CacheConfig &);
     void set_cache_data(const CacheConfig &);
+    // Shared second and third level caches between L1 caches and memory.
+    // In default disabled.
+    void set_cache_level2(const CacheConfig &);
+    void set_cache_level3(const CacheConfig &);
+    // Access time of shared cache level (in cycles), the penalty of misses in
+    // the level above it
+    void set_cache_level2_access_time(unsigned);
+    void set_cache_level3_access_time(unsigned);
+    void set_cache_inclusion(enum CacheInclusion);
     void set_simulated_endian(Endian endian);
 
     bool pipelined() const;
     bool delay_slot() const;
     enum HazardUnit hazard_unit() const;
+    enum BranchPredictor branch_predictor() const;
+    unsigned branch_predictor_bits() const;
+    unsigned branch_target_buffer() const;
+    unsigned return_address_stack() const;
+    unsigned branch_mispredict_penalty() const;
     bool memory_execute_protection() const;
     bool memory_write_protection() const;
     unsigned memory_access_time_read() const;
     unsigned memory_access_time_write() const;
     unsigned memory_access_time_burst() const;
+    bool memory_stalls() const;
     bool osemu_enable() const;
     bool osemu_known_syscall_stop() const;
     bool osemu_unknown_syscall_stop() const;
@@ -162,12 +234,21 @@ public:
     QString osemu_fs_root() const;
     bool reset_at_compile() const;
     QString elf() const;
+    bool jit() const;
+    bool mapped_ram() const;
     const CacheConfig &cache_program() const;
     const CacheConfig &cache_data() const;
+    const CacheConfig &cache_level2() const;
+    const CacheConfig &cache_level3() const;
+    unsigned cache_level2_access_time() const;
+    unsigned cache_level3_access_time() const;
+    enum CacheInclusion cache_inclusion() const;
     Endian get_simulated_endian() const;
 
     CacheConfig *access_cache_program();
     CacheConfig *access_cache_data();
+    CacheConfig *access_cache_level2();
+    CacheConfig *access_cache_level3();
 
     bool operator==(const MachineConfig &c) const;
     bool operator!=(const MachineConfig &c) const;
@@ -175,14 +256,21 @@ public:
 private:
     bool pipeline, delayslot;
     enum HazardUnit hunit;
+    enum BranchPredictor bpred;
+    unsigned bpred_bits, btb_entries, ras_depth, mispredict_penalty;
     bool exec_protect, write_protect;
     unsigned mem_acc_read, mem_acc_write, mem_acc_burst;
+    bool mem_stalls;
     bool osem_enable, osem_known_syscall_stop, osem_unknown_syscall_stop;
     bool osem_interrupt_stop, osem_exception_stop;
     bool res_at_compile;
     QString osem_fs_root;
     QString elf_path;
-    CacheConfig cch_program, cch_data;
+    bool jit_enable;
+    bool mapped_ram_enable;
+    CacheConfig cch_program, cch_data, cch_level2, cch_level3;
+    unsigned level2_acc, level3_acc;
+    enum CacheInclusion inclusion;
     Endian simulated_endian = BIG;
 };
 
@@ -131,6 +131,24 @@ public:
      */
     virtual enum LocationStatus location_status(Offset offset) const = 0;
 
+    /**
+     * Host pointer to plain memory backing given range.
+     *
+     * Pointer returned for range of whole bus page (`BUS_PAGE_SIZE`) or
+     * larger has to stay valid as long as the device exists, memory bus
+     * keeps such pointers for direct accesses.
+     *
+     * @see FrontendMemory::direct_access
+     * @return  nullptr if the device is not plain memory (default)
+     */
+    virtual byte *direct_access(Offset offset, size_t size);
+
+    /**
+     * @see FrontendMemory::direct_read
+     * @return  nullptr if the device is not plain memory (default)
+     */
+    virtual const byte *direct_read(Offset offset, size_t size) const;
+
     /**
      * Endian of the simulated CPU/memory system.
      * @see BackendMemory docs
@@ -156,6 +174,18 @@ signals:
 inline BackendMemory::BackendMemory(Endian simulated_machine_endian)
     : simulated_machine_endian(simulated_machine_endian) {}
 
+inline byte *BackendMemory::direct_access(Offset offset, size_t size) {
+    (void)offset;
+    (void)size;
+    return nullptr;
+}
+
+inline const byte *BackendMemory::direct_read(Offset offset, size_t size) const {
+    (void)offset;
+    (void)size;
+    return nullptr;
+}
+
 } // namespace machine
 
 #endif // BACKEND_MEMORY_H
@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*******************************************************************************
+ * QtMips - MIPS 32-bit Architecture Subset Simulator
+ *
+ * Implemented to support following courses:
+ *
+ *   B35APO - Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b35apo
+ *
+ *   B4M35PAP - Advanced Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b4m35pap/start
+ *
+ * Copyright (c) 2017-2019 Karel Koci<cynerd@email.cz>
+ * Copyright (c) 2019      Pavel Pisa <pisa@cmp.felk.cvut.cz>
+ *
+ * Faculty of Electrical Engineering (http://www.fel.cvut.cz)
+ * Czech Technical University        (http://www.cvut.cz/)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+#include "memory/backend/mappedram.h"
+
+#include <cstring>
+
+#ifdef __unix__
+    #include <sys/mman.h>
+#endif
+
+using namespace machine;
+
+#ifdef __unix__
+/**
+ * Map fresh zero filled anonymous range, optionally replacing existing one.
+ */
+static byte *map_anonymous(void *address, size_t size) {
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    #ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+    #endif
+    if (address != nullptr) {
+        flags |= MAP_FIXED;
+    }
+    void *p = mmap(address, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    return p == MAP_FAILED ? nullptr : static_cast<byte *>(p);
+}
+#endif
+
+MappedRam::MappedRam(Endian simulated_machine_endian, size_t size)
+    : BackendMemory(simulated_machine_endian)
+    , dt_size(size) {
+#ifdef __unix__
+    dt = map_anonymous(nullptr, dt_size);
+    if (dt == nullptr) {
+        throw SIMULATOR_EXCEPTION(
+            OutOfMemoryAccess, "Unable to reserve host memory for RAM",
+            QString("Requested size: ") + QString::number(dt_size));
+    }
+#else
+    // Without lazily committed anonymous mapping the whole range would have
+    // to be allocated eagerly (gigabytes for the full RAM range)
+    throw SIMULATOR_EXCEPTION(
+        Input, "Mapped RAM is supported only on Unix hosts",
+        QString("Requested size: ") + QString::number(dt_size));
+#endif
+}
+
+MappedRam::~MappedRam() {
+#ifdef __unix__
+    munmap(dt, dt_size);
+#endif
+}
+
+void MappedRam::reset() {
+#ifdef __unix__
+    // Replacing the mapping releases all touched pages at once
+    if (map_anonymous(dt, dt_size) == dt) {
+        return;
+    }
+#endif
+    memset(dt, 0, dt_size);
+}
+
+void MappedRam::reset(const Memory &m) {
+    reset();
+    copy_section_tree(m.get_memory_tree_root(), 0, 0);
+}
+
+void MappedRam::copy_section_tree(
+    const union MemoryTree *mt,
+    size_t depth,
+    Offset base) {
+    const size_t row_bit_offset = 32 - MEMORY_TREE_BITS * (depth + 1);
+    for (size_t i = 0; i < MEMORY_TREE_ROW_SIZE; i++) {
+        Offset offset = base | (i << row_bit_offset);
+        if (depth < (MEMORY_TREE_DEPTH - 1)) { // Following level is memory tree
+            if (mt[i].subtree != nullptr) {
+                copy_section_tree(mt[i].subtree, depth + 1, offset);
+            }
+        } else if (mt[i].sec != nullptr && offset < dt_size) {
+            write(offset, mt[i].sec->data(), mt[i].sec->length(), {});
+        }
+    }
+}
+
+WriteResult MappedRam::write(
+    Offset destination,
+    const void *source,
+    size_t size,
+    WriteOptions options) {
+    UNUSED(options)
+
+    if (destination >= dt_size) {
+        throw SIMULATOR_EXCEPTION(
+            OutOfMemoryAccess, "Trying to write outside of the mapped RAM",
+            QString("Accessing using offset: ") + QString::number(destination));
+    }
+
+    const size_t available_size
+        = std::min(destination + size, dt_size) - destination;
+
+    bool changed = memcmp(source, dt + destination, available_size) != 0;
+    if (changed) {
+        memcpy(dt + destination, source, available_size);
+    }
+
+    return { .n_bytes = available_size, .changed = changed };
+}
+
+ReadResult MappedRam::read(
+    void *destination,
+    Offset source,
+    size_t size,
+    ReadOptions options) const {
+    UNUSED(options)
+
+    if (source >= dt_size) {
+        throw SIMULATOR_EXCEPTION(
+            OutOfMemoryAccess, "Trying to read outside of the mapped RAM",
+            QString("Accessing using offset: ") + QString::number(source));
+    }
+
+    size = std::min(source + size, dt_size) - source;
+    memcpy(destination, dt + source, size);
+
+    return { .n_bytes = size };
+}
+
+LocationStatus MappedRam::location_status(Offset offset) const {
+    UNUSED(offset)
+    return LOCSTAT_NONE;
+}
+
+byte *MappedRam::direct_access(Offset offset, size_t size) {
+    if (size == 0 || offset >= dt_size || size > dt_size - offset) {
+        return nullptr;
+    }
+    return dt + offset;
+}
+
+const byte *MappedRam::direct_read(Offset offset, size_t size) const {
+    if (size == 0 || offset >= dt_size || size > dt_size - offset) {
+        return nullptr;
+    }
+    return dt + offset;
+}
+
+size_t MappedRam::length() const {
+    return dt_size;
+}
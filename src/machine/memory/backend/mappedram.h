@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*******************************************************************************
+ * QtMips - MIPS 32-bit Architecture Subset Simulator
+ *
+ * Implemented to support following courses:
+ *
+ *   B35APO - Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b35apo
+ *
+ *   B4M35PAP - Advanced Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b4m35pap/start
+ *
+ * Copyright (c) 2017-2019 Karel Koci<cynerd@email.cz>
+ * Copyright (c) 2019      Pavel Pisa <pisa@cmp.felk.cvut.cz>
+ *
+ * Faculty of Electrical Engineering (http://www.fel.cvut.cz)
+ * Czech Technical University        (http://www.cvut.cz/)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+#ifndef MACHINE_MAPPEDRAM_H
+#define MACHINE_MAPPEDRAM_H
+
+#include "common/endian.h"
+#include "machinedefs.h"
+#include "memory/backend/backend_memory.h"
+#include "memory/backend/memory.h"
+#include "memory/memory_utils.h"
+#include "simulator_exception.h"
+
+#include <cstdint>
+
+namespace machine {
+
+/**
+ * Plain RAM stored in one contiguous host mapping.
+ *
+ * Whole range is reserved by a single anonymous mapping and host OS commits
+ * zero filled pages lazily on first touch. Compared to `Memory` there is no
+ * tree walk and accesses of any size are single memcpy. Content is stored
+ * in simulated machine endian, same as in `Memory`.
+ */
+class MappedRam final : public BackendMemory {
+    Q_OBJECT
+public:
+    /**
+     * @param simulated_machine_endian  endian of the simulated machine
+     * @param size                      number of bytes of reserved range
+     */
+    MappedRam(Endian simulated_machine_endian, size_t size);
+    ~MappedRam() override;
+
+    // Clear whole content (pages are returned to the OS)
+    void reset();
+    // Clear content and fill it with data of sections present in tree memory
+    void reset(const Memory &);
+
+    WriteResult write(
+        Offset destination,
+        const void *source,
+        size_t size,
+        WriteOptions options) override;
+
+    ReadResult read(
+        void *destination,
+        Offset source,
+        size_t size,
+        ReadOptions options) const override;
+
+    LocationStatus location_status(Offset offset) const override;
+
+    byte *direct_access(Offset offset, size_t size) override;
+    const byte *direct_read(Offset offset, size_t size) const override;
+
+    size_t length() const;
+
+private:
+    byte *dt;
+    size_t dt_size;
+    void copy_section_tree(const union MemoryTree *, size_t depth, Offset base);
+};
+
+} // namespace machine
+
+#endif // MACHINE_MAPPEDRAM_H
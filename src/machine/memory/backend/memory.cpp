@@ -40,7 +40,9 @@
 #include "common/endian.h"
 #include "simulator_exception.h"
 
+#include <QHash>
 #include <memory>
+#include <mutex>
 
 namespace machine {
 
@@ -117,6 +119,25 @@ const byte *MemorySection::data() const {
     return this->dt.data();
 }
 
+byte *MemorySection::data() {
+    return this->dt.data();
+}
+
+MemorySection *MemorySection::share() const {
+    refs.fetch_add(1, std::memory_order_relaxed);
+    return const_cast<MemorySection *>(this);
+}
+
+bool MemorySection::shared() const {
+    return refs.load(std::memory_order_acquire) > 1;
+}
+
+void MemorySection::release(MemorySection *section) {
+    if (section != nullptr && section->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete section;
+    }
+}
+
 bool MemorySection::operator==(const MemorySection &other) const {
     return this->dt == other.dt;
 }
@@ -169,16 +190,19 @@ constexpr size_t get_tree_row(size_t offset, size_t i) {
 Memory::Memory() : BackendMemory(BIG) {
     // This is dummy constructor for qt internal uses only.
     this->mt_root = nullptr;
+    section_cache_flush();
 }
 
 Memory::Memory(Endian simulated_machine_endian)
     : BackendMemory(simulated_machine_endian) {
     this->mt_root = allocate_section_tree();
+    section_cache_flush();
 }
 
 Memory::Memory(const Memory &other)
     : BackendMemory(other.simulated_machine_endian) {
     this->mt_root = copy_section_tree(other.get_memory_tree_root(), 0);
+    section_cache_flush();
 }
 
 Memory::~Memory() {
@@ -190,14 +214,33 @@ void Memory::reset() {
     free_section_tree(this->mt_root, 0);
     delete[] this->mt_root;
     this->mt_root = allocate_section_tree();
+    section_cache_flush();
 }
 
 void Memory::reset(const Memory &m) {
-    free_section_tree(this->mt_root, 0);
-    this->mt_root = copy_section_tree(m.get_memory_tree_root(), 0);
+    // Only sections differing from the other memory are released
+    sync_section_tree(this->mt_root, m.get_memory_tree_root(), 0);
+    section_cache_flush();
+}
+
+void Memory::section_cache_flush() {
+    for (auto &entry : section_cache) {
+        entry = { .tag = UINT64_MAX, .sec = nullptr };
+    }
 }
 
 MemorySection *Memory::get_section(size_t offset, bool create) const {
+    return walk_section_tree(offset, create, create);
+}
+
+MemorySection *
+Memory::walk_section_tree(size_t offset, bool create, bool unshare) const {
+    uint64_t tag = offset >> MEMORY_SECTION_BITS;
+    SectionCacheEntry &entry
+        = section_cache[tag & (MEMORY_SECTION_CACHE_SIZE - 1)];
+    if (entry.tag == tag && !(unshare && entry.sec->shared())) {
+        return entry.sec;
+    }
     union MemoryTree *w = this->mt_root;
     size_t row_num;
     // Walk memory tree branch from root to leaf and create new nodes when
@@ -221,7 +264,13 @@ MemorySection *Memory::get_section(size_t offset, bool create) const {
         }
         w[row_num].sec
             = new MemorySection(MEMORY_SECTION_SIZE, simulated_machine_endian);
+    } else if (unshare && w[row_num].sec->shared()) {
+        // Copy on write
+        MemorySection *copy = new MemorySection(*w[row_num].sec);
+        MemorySection::release(w[row_num].sec);
+        w[row_num].sec = copy;
     }
+    entry = { .tag = tag, .sec = w[row_num].sec };
     return w[row_num].sec;
 }
 
@@ -250,6 +299,17 @@ ReadResult Memory::read(
     Offset source,
     size_t size,
     ReadOptions options) const {
+    // Aligned accesses never cross section boundary, serve them directly.
+    size_t section_offset = get_section_offset_mask(source);
+    if (section_offset + size <= MEMORY_SECTION_SIZE) {
+        const MemorySection *section = this->get_section(source, false);
+        if (section == nullptr) {
+            memset(destination, 0, size);
+        } else {
+            memcpy(destination, section->data() + section_offset, size);
+        }
+        return { .n_bytes = size };
+    }
     return repeat_access_until_completed<ReadResult>(
         destination, source, size, options,
         [this](
@@ -268,6 +328,31 @@ ReadResult Memory::read(
         });
 }
 
+byte *Memory::direct_access(Offset offset, size_t size) {
+    size_t section_offset = get_section_offset_mask(offset);
+    if (size == 0 || section_offset + size > MEMORY_SECTION_SIZE) {
+        return nullptr;
+    }
+    // Pointer may be used for writes, shared section has to be copied
+    MemorySection *section = this->walk_section_tree(offset, false, true);
+    if (section == nullptr) {
+        return nullptr;
+    }
+    return section->data() + section_offset;
+}
+
+const byte *Memory::direct_read(Offset offset, size_t size) const {
+    size_t section_offset = get_section_offset_mask(offset);
+    if (size == 0 || section_offset + size > MEMORY_SECTION_SIZE) {
+        return nullptr;
+    }
+    const MemorySection *section = this->walk_section_tree(offset, false, false);
+    if (section == nullptr) {
+        return nullptr;
+    }
+    return section->data() + section_offset;
+}
+
 uint32_t Memory::get_change_counter() const {
     return change_counter;
 }
@@ -300,7 +385,7 @@ void Memory::free_section_tree(union MemoryTree *mt, size_t depth) {
         }
     } else { // Following level is memory section
         for (size_t i = 0; i < MEMORY_TREE_ROW_SIZE; i++) {
-            delete mt[i].sec;
+            MemorySection::release(mt[i].sec);
         }
     }
 }
@@ -324,7 +409,7 @@ bool Memory::compare_section_tree(
             if (((mt1[i].sec == nullptr || mt2[i].sec == nullptr)
                  && mt1[i].sec != mt2[i].sec)
                 || (mt1[i].sec != nullptr && mt2[i].sec != nullptr
-                    && *mt1[i].sec != *mt2[i].sec)) {
+                    && mt1[i].sec != mt2[i].sec && *mt1[i].sec != *mt2[i].sec)) {
                 return false;
             }
         }
@@ -344,16 +429,78 @@ Memory::copy_section_tree(const union MemoryTree *mt, size_t depth) {
     } else { // Following level is memory section
         for (size_t i = 0; i < MEMORY_TREE_ROW_SIZE; i++) {
             if (mt[i].sec != nullptr) {
-                nmt[i].sec = new MemorySection(*mt[i].sec);
+                nmt[i].sec = mt[i].sec->share();
             }
         }
     }
     return nmt;
 }
+
+void Memory::sync_section_tree(
+    union MemoryTree *dst,
+    const union MemoryTree *src,
+    size_t depth) {
+    if (depth < (MEMORY_TREE_DEPTH - 1)) { // Following level is memory tree
+        for (size_t i = 0; i < MEMORY_TREE_ROW_SIZE; i++) {
+            if (src[i].subtree == nullptr) {
+                if (dst[i].subtree != nullptr) {
+                    free_section_tree(dst[i].subtree, depth + 1);
+                    delete[] dst[i].subtree;
+                    dst[i].subtree = nullptr;
+                }
+            } else if (dst[i].subtree == nullptr) {
+                dst[i].subtree = copy_section_tree(src[i].subtree, depth + 1);
+            } else {
+                sync_section_tree(dst[i].subtree, src[i].subtree, depth + 1);
+            }
+        }
+    } else { // Following level is memory section
+        for (size_t i = 0; i < MEMORY_TREE_ROW_SIZE; i++) {
+            if (dst[i].sec != src[i].sec) {
+                MemorySection::release(dst[i].sec);
+                dst[i].sec = src[i].sec != nullptr ? src[i].sec->share() : nullptr;
+            }
+        }
+    }
+}
 LocationStatus Memory::location_status(Offset offset) const {
     UNUSED(offset)
     // Lazy allocation of memory is only internal implementation detail.
     return LOCSTAT_NONE;
 }
 
+namespace {
+std::mutex image_cache_mutex;
+QHash<QByteArray, std::weak_ptr<const Memory>> image_cache;
+} // namespace
+
+std::shared_ptr<const Memory>
+MemoryImageCache::image(const QByteArray &content_hash, Endian endian, const Loader &load) {
+    QByteArray key = content_hash;
+    key.append((char)endian);
+    {
+        std::lock_guard<std::mutex> lock(image_cache_mutex);
+        std::shared_ptr<const Memory> image = image_cache.value(key).lock();
+        if (image != nullptr) {
+            return image;
+        }
+    }
+    // Loaded outside of the lock, concurrent first loads of the same
+    // content only build the image more than once
+    auto *image = new Memory(endian);
+    load(image);
+    std::shared_ptr<const Memory> shared(image);
+    std::lock_guard<std::mutex> lock(image_cache_mutex);
+    // Drop entries of released images, the cache holds only live ones
+    for (auto it = image_cache.begin(); it != image_cache.end();) {
+        if (it.value().expired()) {
+            it = image_cache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    image_cache.insert(key, shared);
+    return shared;
+}
+
 } // namespace machine
@@ -46,8 +46,12 @@
 #include "simulator_exception.h"
 #include "utils.h"
 
+#include <QByteArray>
 #include <QObject>
+#include <atomic>
 #include <cstdint>
+#include <functional>
+#include <memory>
 
 namespace machine {
 
@@ -77,12 +81,22 @@ public:
 
     size_t length() const;
     const byte *data() const;
+    byte *data();
+
+    /*
+     * Sections are shared by copies of the Memory and copied on the first
+     * write. Reference is taken by share() and returned by release().
+     */
+    MemorySection *share() const;
+    bool shared() const;
+    static void release(MemorySection *);
 
     bool operator==(const MemorySection &) const;
     bool operator!=(const MemorySection &) const;
 
 private:
     std::vector<byte> dt;
+    mutable std::atomic<uint32_t> refs { 1 };
 };
 
 //////////////////////////////////////////////////////////////////////////////
@@ -91,6 +105,8 @@ private:
 constexpr size_t MEMORY_SECTION_BITS = 8;
 // How big one row of lookup tree will be in bits (2^4=16)
 constexpr size_t MEMORY_TREE_BITS = 4;
+// How many recently used sections are remembered in bits (2^6=64)
+constexpr size_t MEMORY_SECTION_CACHE_BITS = 6;
 //////////////////////////////////////////////////////////////////////////////
 // Size of one section
 constexpr size_t MEMORY_SECTION_SIZE = (1u << MEMORY_SECTION_BITS);
@@ -99,6 +115,8 @@ constexpr size_t MEMORY_TREE_ROW_SIZE = (1u << MEMORY_TREE_BITS);
 // Depth of tree
 constexpr size_t MEMORY_TREE_DEPTH
     = ((32 - MEMORY_SECTION_BITS) / MEMORY_TREE_BITS);
+// Number of entries of recently used sections cache
+constexpr size_t MEMORY_SECTION_CACHE_SIZE = (1u << MEMORY_SECTION_CACHE_BITS);
 
 union MemoryTree {
     union MemoryTree *subtree;
@@ -121,7 +139,8 @@ public:
                   // new one)
     void reset(const Memory &);
 
-    // returns section containing given address
+    // returns section containing given address, section is private to this
+    // memory (can be written) only when `create` is set
     MemorySection *get_section(size_t offset, bool create) const;
 
     WriteResult write(
@@ -138,14 +157,32 @@ public:
 
     LocationStatus location_status(Offset offset) const override;
 
+    // Only range inside of already allocated section is provided
+    byte *direct_access(Offset offset, size_t size) override;
+    // Shared section is not copied
+    const byte *direct_read(Offset offset, size_t size) const override;
+
     bool operator==(const Memory &) const;
     bool operator!=(const Memory &) const;
 
     const union MemoryTree *get_memory_tree_root() const;
 
 private:
+    /**
+     * Direct mapped cache (software TLB) of sections found by tree walk.
+     * Only existing sections are recorded, entries are invalidated whenever
+     * the tree is freed.
+     */
+    struct SectionCacheEntry {
+        uint64_t tag;
+        MemorySection *sec;
+    };
+
     union MemoryTree *mt_root;
+    mutable SectionCacheEntry section_cache[MEMORY_SECTION_CACHE_SIZE];
     uint32_t change_counter = 0;
+    void section_cache_flush();
+    MemorySection *walk_section_tree(size_t offset, bool create, bool unshare) const;
     static union MemoryTree *allocate_section_tree();
     static void free_section_tree(union MemoryTree *, size_t depth);
     static bool compare_section_tree(
@@ -154,8 +191,35 @@ private:
         size_t depth);
     static union MemoryTree *
     copy_section_tree(const union MemoryTree *, size_t depth);
+    static void sync_section_tree(
+        union MemoryTree *,
+        const union MemoryTree *,
+        size_t depth);
     uint32_t get_change_counter() const;
 };
+
+/**
+ * Process wide cache of pristine program images.
+ *
+ * Image is identified by hash of the loaded content (see
+ * `ProgramLoader::content_hash`). Memories copied from the image share all
+ * sections with it and copy them on the first write, therefore every machine
+ * loaded from the same executable holds only sections it dirtied. The cache
+ * does not own images, an image is released together with its last user.
+ * All methods are thread safe.
+ */
+class MemoryImageCache {
+public:
+    using Loader = std::function<void(Memory *)>;
+
+    /**
+     * Return image with given content hash. When no such image is alive,
+     * load fills a fresh one which is then served to following requests.
+     */
+    static std::shared_ptr<const Memory>
+    image(const QByteArray &content_hash, Endian endian, const Loader &load);
+};
+
 } // namespace machine
 
 Q_DECLARE_METATYPE(machine::Memory);
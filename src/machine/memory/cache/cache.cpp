@@ -39,11 +39,19 @@
 
 #include "memory/cache/cache_types.h"
 
+#include <algorithm>
+
+#ifdef __SSE2__
+    #include <emmintrin.h>
+#endif
+
 using ae = machine::AccessEffects; // For enum values, type is obvious from
                                    // context.
 
 namespace machine {
 
+constexpr uint64_t CacheStorage::INVALID_TAG;
+
 Cache::Cache(
     FrontendMemory *memory,
     const CacheConfig *config,
@@ -53,25 +61,24 @@ Cache::Cache(
     : FrontendMemory(memory->simulated_machine_endian)
     , cache_config(config)
     , mem(memory)
-    , uncached_start(0xf0000000_addr)
-    , uncached_last(0xfffffffe_addr)
     , access_pen_r(memory_access_penalty_r)
     , access_pen_w(memory_access_penalty_w)
     , access_pen_b(memory_access_penalty_b)
-    , replacement_policy(CachePolicy::get_policy_instance(config)) {
+    , replacement_policy(CachePolicy::get_policy_instance(config))
+    , prefetcher(CachePrefetcher::get_prefetcher_instance(config)) {
     // Skip memory allocation if cache is disabled
     if (!config->enabled()) {
         return;
     }
 
-    dt.resize(
-        config->associativity(),
-        std::vector<CacheLine>(
-            config->set_count(),
-            { .valid = false,
-              .dirty = false,
-              .tag = 0,
-              .data = std::vector<uint32_t>(config->block_size()) }));
+    const size_t lines = config->associativity() * config->set_count();
+    storage.tags.resize(lines, CacheStorage::INVALID_TAG);
+    storage.dirty.resize(lines, false);
+    storage.prefetched.resize(lines, false);
+    storage.data.resize(lines * config->block_size());
+    if (prefetcher != nullptr) {
+        pollution_filter.resize(lines, CacheStorage::INVALID_TAG);
+    }
 }
 
 Cache::~Cache() = default;
@@ -81,6 +88,9 @@ WriteResult Cache::write(
     const void *source,
     size_t size,
     WriteOptions options) {
+    if (access_sink != nullptr && options.type != ae::INTERNAL) {
+        access_sink->cache_access(destination, size, WRITE);
+    }
     if (!cache_config.enabled() || is_in_uncached_area(destination)
         || is_in_uncached_area(destination + size)) {
         mem_writes++;
@@ -89,17 +99,36 @@ WriteResult Cache::write(
         return mem->write(destination, source, size, options);
     }
 
+    // Only evictions allocate in exclusive level, other writes update the
+    // block when it is present and go to memory otherwise
+    if (exclusive && !options.cache_eviction && !is_cached(destination)
+        && !is_cached(destination + size - 1)) {
+        miss_write++;
+        mem_writes++;
+        emit miss_update(get_miss_count());
+        emit memory_writes_update(mem_writes);
+        update_all_statistics();
+        return mem->write(destination, source, size, { .type = options.type });
+    }
+
     // FIXME: Get rid of the cast
     // access is mostly the same for read and write but one needs to write
     // to the address
-    const bool changed
-        = access(destination, const_cast<void *>(source), size, WRITE);
+    const uint32_t misses = get_miss_count(), useful = prefetch_useful;
+    const bool changed = access(
+        destination, const_cast<void *>(source), size, WRITE,
+        options.cache_eviction);
+    if (prefetcher != nullptr && !options.cache_eviction) {
+        run_prefetcher(
+            destination, get_miss_count() != misses, prefetch_useful != useful);
+    }
 
     if (cache_config.write_policy() != CacheConfig::WP_BACK) {
         mem_writes++;
         emit memory_writes_update(mem_writes);
         update_all_statistics();
-        return mem->write(destination, source, size, options);
+        // Block stays in this level, outer level sees just a write through
+        return mem->write(destination, source, size, { .type = options.type });
     }
 
     return { .n_bytes = size, .changed = changed };
@@ -110,6 +139,9 @@ ReadResult Cache::read(
     Address source,
     size_t size,
     ReadOptions options) const {
+    if (access_sink != nullptr && options.type != ae::INTERNAL) {
+        access_sink->cache_access(source, size, READ);
+    }
     if (!cache_config.enabled() || is_in_uncached_area(source)
         || is_in_uncached_area(source + size)) {
         mem_reads++;
@@ -127,12 +159,21 @@ ReadResult Cache::read(
         return {};
     }
 
+    if (exclusive && options.cache_fill) {
+        exclusive_fill(source, destination, size);
+        return {};
+    }
+
+    const uint32_t misses = get_miss_count(), useful = prefetch_useful;
     access(source, destination, size, READ);
+    if (prefetcher != nullptr) {
+        run_prefetcher(source, get_miss_count() != misses, prefetch_useful != useful);
+    }
 
     return {};
 }
-bool Cache::is_in_uncached_area(Address source) const {
-    return (source >= uncached_start && source <= uncached_last);
+bool Cache::is_in_uncached_area(Address source) {
+    return (source >= 0xf0000000_addr && source <= 0xfffffffe_addr);
 }
 
 void Cache::flush() {
@@ -144,7 +185,8 @@ void Cache::flush() {
          assoc_index += 1) {
         for (size_t set_index = 0; set_index < cache_config.set_count();
              set_index += 1) {
-            if (dt[assoc_index][set_index].valid) {
+            if (storage.tags[line_index(assoc_index, set_index)]
+                != CacheStorage::INVALID_TAG) {
                 kick(assoc_index, set_index);
                 emit cache_update(
                     assoc_index, set_index, 0, false, false, 0, nullptr, false);
@@ -159,14 +201,49 @@ void Cache::sync() {
     flush();
 }
 
+void Cache::set_inner_levels(
+    const std::vector<Cache *> &inner,
+    enum MachineConfig::CacheInclusion inclusion) {
+    inner_levels.clear();
+    exclusive = false;
+    switch (inclusion) {
+    case MachineConfig::CI_INCLUSIVE: inner_levels = inner; break;
+    case MachineConfig::CI_EXCLUSIVE:
+        exclusive = true;
+        for (Cache *cache : inner) {
+            cache->evict_clean = true;
+        }
+        break;
+    case MachineConfig::CI_NON_INCLUSIVE: break;
+    }
+}
+
+void Cache::invalidate_range(Address start, size_t size) {
+    if (!cache_config.enabled() || size == 0) {
+        return;
+    }
+    const size_t block_bytes = cache_config.block_size() * BLOCK_ITEM_SIZE;
+    const uint64_t end = start.get_raw() + size;
+    for (uint64_t addr = start.get_raw() - start.get_raw() % block_bytes;
+         addr < end; addr += block_bytes) {
+        const CacheLocation loc = compute_location(Address(addr));
+        const size_t way = find_block_index(loc);
+        if (way < cache_config.associativity()) {
+            kick(way, loc.row);
+            emit cache_update(way, loc.row, 0, false, false, 0, nullptr, false);
+        }
+    }
+    update_all_statistics();
+}
+
 void Cache::reset() {
     // Set all cells to invalid
     if (cache_config.enabled()) {
-        for (auto &set : dt) {
-            for (auto &block : set) {
-                block.valid = false;
-            }
-        }
+        std::fill(storage.tags.begin(), storage.tags.end(), CacheStorage::INVALID_TAG);
+        std::fill(storage.dirty.begin(), storage.dirty.end(), false);
+        std::fill(storage.prefetched.begin(), storage.prefetched.end(), false);
+        std::fill(pollution_filter.begin(), pollution_filter.end(), CacheStorage::INVALID_TAG);
+        prefetcher = CachePrefetcher::get_prefetcher_instance(&cache_config);
         // Note: We don't have to zero replacement policy data as those are
         // zeroed when first used on invalid cell.
     }
@@ -179,6 +256,9 @@ void Cache::reset() {
     mem_writes = 0;
     burst_reads = 0;
     burst_writes = 0;
+    prefetch_issued = 0;
+    prefetch_useful = 0;
+    prefetch_pollution = 0;
 
     emit hit_update(get_hit_count());
     emit miss_update(get_miss_count());
@@ -198,18 +278,70 @@ void Cache::reset() {
     }
 }
 
+Cache::State Cache::save_state() const {
+    return { .storage = storage,
+             .replacement_policy = replacement_policy ? replacement_policy->clone() : nullptr,
+             .prefetcher = prefetcher ? prefetcher->clone() : nullptr,
+             .pollution_filter = pollution_filter,
+             .hit_read = hit_read,
+             .miss_read = miss_read,
+             .hit_write = hit_write,
+             .miss_write = miss_write,
+             .mem_reads = mem_reads,
+             .mem_writes = mem_writes,
+             .burst_reads = burst_reads,
+             .burst_writes = burst_writes,
+             .prefetch_issued = prefetch_issued,
+             .prefetch_useful = prefetch_useful,
+             .prefetch_pollution = prefetch_pollution };
+}
+
+void Cache::restore_state(const State &state) {
+    storage = state.storage;
+    replacement_policy = state.replacement_policy ? state.replacement_policy->clone() : nullptr;
+    prefetcher = state.prefetcher ? state.prefetcher->clone() : nullptr;
+    pollution_filter = state.pollution_filter;
+    hit_read = state.hit_read;
+    miss_read = state.miss_read;
+    hit_write = state.hit_write;
+    miss_write = state.miss_write;
+    mem_reads = state.mem_reads;
+    mem_writes = state.mem_writes;
+    burst_reads = state.burst_reads;
+    burst_writes = state.burst_writes;
+    prefetch_issued = state.prefetch_issued;
+    prefetch_useful = state.prefetch_useful;
+    prefetch_pollution = state.prefetch_pollution;
+    change_counter++;
+
+    emit hit_update(get_hit_count());
+    emit miss_update(get_miss_count());
+    emit memory_reads_update(get_read_count());
+    emit memory_writes_update(get_write_count());
+    update_all_statistics();
+
+    if (!cache_config.enabled()) {
+        return;
+    }
+    for (size_t assoc_index = 0; assoc_index < cache_config.associativity(); assoc_index++) {
+        for (size_t set_index = 0; set_index < cache_config.set_count(); set_index++) {
+            const size_t index = line_index(assoc_index, set_index);
+            const bool valid = storage.tags[index] != CacheStorage::INVALID_TAG;
+            for (size_t col = 0; col < cache_config.block_size(); col++) {
+                emit cache_update(
+                    assoc_index, set_index, col, valid, storage.dirty[index],
+                    valid ? storage.tags[index] : 0, block_data(assoc_index, set_index), false);
+            }
+        }
+    }
+}
+
 void Cache::internal_read(Address source, void *destination, size_t size) const {
     CacheLocation loc = compute_location(source);
-    for (size_t assoc_index = 0; assoc_index < cache_config.associativity();
-         assoc_index++) {
-        if (dt[assoc_index][loc.row].valid
-            && dt[assoc_index][loc.row].tag == loc.tag) {
-            memcpy(
-                destination,
-                (byte *)&dt[assoc_index][loc.row].data[loc.col] + loc.byte,
-                size);
-            return;
-        }
+    size_t way = find_block_index(loc);
+    if (way < cache_config.associativity()) {
+        memcpy(destination, (byte *)&block_data(way, loc.row)[loc.col] + loc.byte, size);
+        return;
     }
     memset(destination, 0, size); // TODO is this correct
 }
@@ -218,7 +350,8 @@ bool Cache::access(
     Address address,
     void *buffer,
     size_t size,
-    AccessType access_type) const {
+    AccessType access_type,
+    bool eviction) const {
     const CacheLocation loc = compute_location(address);
     size_t way = find_block_index(loc);
 
@@ -234,6 +367,7 @@ bool Cache::access(
         if (access_type == WRITE
             && cache_config.write_policy() == CacheConfig::WP_THROUGH_NOALLOC) {
             miss_write++;
+            note_demand_miss(loc);
             emit miss_update(get_miss_count());
             update_all_statistics();
 
@@ -244,7 +378,7 @@ bool Cache::access(
                 return access(
                     address + size_within_block,
                     (byte *)buffer + size_within_block, size_overflow,
-                    access_type);
+                    access_type, eviction);
             } else {
                 return false;
             }
@@ -258,15 +392,22 @@ bool Cache::access(
             "Probably unimplemented replacement policy");
     }
 
-    struct CacheLine &cd = dt[way][loc.row];
+    const size_t index = line_index(way, loc.row);
+    uint64_t &tag = storage.tags[index];
+    uint8_t &dirty = storage.dirty[index];
+    uint32_t *data = block_data(way, loc.row);
 
     // Update statistics and otherwise read from memory
-    if (cd.valid) {
+    if (tag != CacheStorage::INVALID_TAG) {
         if (access_type == WRITE) {
             hit_write++;
         } else {
             hit_read++;
         }
+        if (storage.prefetched[index]) {
+            storage.prefetched[index] = false;
+            prefetch_useful++;
+        }
         emit hit_update(get_hit_count());
         update_all_statistics();
     } else {
@@ -275,25 +416,29 @@ bool Cache::access(
         } else {
             miss_read++;
         }
+        note_demand_miss(loc);
         emit miss_update(get_miss_count());
 
-        mem->read(
-            cd.data.data(), calc_base_address(loc.tag, loc.row),
-            cache_config.block_size() * BLOCK_ITEM_SIZE,
-            { .type = ae::REGULAR });
+        const size_t block_bytes = cache_config.block_size() * BLOCK_ITEM_SIZE;
+        const bool overwritten = eviction && loc.col == 0 && loc.byte == 0
+                                 && size >= block_bytes;
+        if (!overwritten) {
+            mem->read(
+                data, calc_base_address(loc.tag, loc.row), block_bytes,
+                { .type = ae::REGULAR, .cache_fill = true });
+            mem_reads += cache_config.block_size();
+            burst_reads += cache_config.block_size() - 1;
+            emit memory_reads_update(mem_reads);
+        }
 
-        cd.valid = true;
-        cd.dirty = false;
-        cd.tag = loc.tag;
+        dirty = false;
+        tag = loc.tag;
 
         change_counter += cache_config.block_size();
-        mem_reads += cache_config.block_size();
-        burst_reads += cache_config.block_size() - 1;
-        emit memory_reads_update(mem_reads);
         update_all_statistics();
     }
 
-    replacement_policy->update_stats(way, loc.row, cd.valid);
+    replacement_policy->update_stats(way, loc.row, true);
 
     const size_t size_overflow = calculate_overflow_to_next_blocks(size, loc);
     const size_t size_within_block = size - size_overflow;
@@ -301,16 +446,16 @@ bool Cache::access(
     bool changed = false;
 
     if (access_type == READ) {
-        memcpy(buffer, (byte *)&cd.data[loc.col] + loc.byte, size_within_block);
+        memcpy(buffer, (byte *)&data[loc.col] + loc.byte, size_within_block);
     } else if (access_type == WRITE) {
-        cd.dirty = true;
+        dirty = true;
         changed = memcmp(
-                      (byte *)&cd.data[loc.col] + loc.byte, buffer,
+                      (byte *)&data[loc.col] + loc.byte, buffer,
                       size_within_block)
                   != 0;
         if (changed) {
             memcpy(
-                ((byte *)&cd.data[loc.col]) + loc.byte, buffer,
+                ((byte *)&data[loc.col]) + loc.byte, buffer,
                 size_within_block);
             change_counter++;
         }
@@ -318,20 +463,123 @@ bool Cache::access(
     const auto last_affected_col
         = (loc.col * BLOCK_ITEM_SIZE + loc.byte + size_within_block - 1) / BLOCK_ITEM_SIZE;
     for (auto col = loc.col; col <= last_affected_col; col++) {
-        emit cache_update(
-            way, loc.row, col, cd.valid, cd.dirty, cd.tag, cd.data.data(),
-            access_type);
+        emit cache_update(way, loc.row, col, true, dirty, tag, data, access_type);
     }
 
     if (size_overflow > 0) {
         // If access overlaps single cache row, perform access to next row.
         changed |= access(
             address + size_within_block, (byte *)buffer + size_within_block,
-            size_overflow, access_type);
+            size_overflow, access_type, eviction);
     }
 
     return changed;
 }
+
+void Cache::exclusive_fill(Address source, void *destination, size_t size) const {
+    if (size == 0) {
+        return;
+    }
+    const CacheLocation loc = compute_location(source);
+    const size_t way = find_block_index(loc);
+    const size_t size_overflow = calculate_overflow_to_next_blocks(size, loc);
+    const size_t size_within_block = size - size_overflow;
+
+    if (way < cache_config.associativity()) {
+        hit_read++;
+        memcpy(
+            destination, (byte *)&block_data(way, loc.row)[loc.col] + loc.byte,
+            size_within_block);
+        kick(way, loc.row, true);
+        emit hit_update(get_hit_count());
+        emit cache_update(way, loc.row, 0, false, false, 0, nullptr, false);
+    } else {
+        // Read through, block is allocated by the inner level only
+        const size_t words
+            = (size_within_block + BLOCK_ITEM_SIZE - 1) / BLOCK_ITEM_SIZE;
+        miss_read++;
+        mem->read(
+            destination, source, size_within_block,
+            { .type = ae::REGULAR, .cache_fill = true });
+        mem_reads += words;
+        burst_reads += words - 1;
+        emit miss_update(get_miss_count());
+        emit memory_reads_update(mem_reads);
+    }
+    update_all_statistics();
+
+    if (size_overflow > 0) {
+        exclusive_fill(
+            source + size_within_block, (byte *)destination + size_within_block,
+            size_overflow);
+    }
+}
+
+void Cache::run_prefetcher(Address address, bool miss, bool prefetch_hit) const {
+    const uint64_t block_bytes = cache_config.block_size() * BLOCK_ITEM_SIZE;
+    prefetch_queue.clear();
+    prefetcher->access(
+        address.get_raw() / block_bytes, pc_source ? pc_source() : Address::null(),
+        miss, prefetch_hit, prefetch_queue);
+    for (uint64_t block : prefetch_queue) {
+        prefetch_block(block);
+    }
+}
+
+void Cache::prefetch_block(uint64_t block) const {
+    const uint64_t block_bytes = cache_config.block_size() * BLOCK_ITEM_SIZE;
+    // Simulated address space is 32-bit
+    if (block >= ((uint64_t)1 << 32) / block_bytes) {
+        return;
+    }
+    const Address base(block * block_bytes);
+    if (is_in_uncached_area(base) || is_in_uncached_area(base + block_bytes - 1)) {
+        return;
+    }
+    const CacheLocation loc = compute_location(base);
+    if (find_block_index(loc) < cache_config.associativity()) {
+        return;
+    }
+
+    const size_t way = replacement_policy->select_way_to_evict(loc.row);
+    const size_t index = line_index(way, loc.row);
+    if (storage.tags[index] != CacheStorage::INVALID_TAG) {
+        const uint64_t victim = storage.tags[index] * cache_config.set_count() + loc.row;
+        pollution_filter[victim % pollution_filter.size()] = victim;
+    }
+    kick(way, loc.row);
+
+    uint32_t *data = block_data(way, loc.row);
+    mem->read(data, base, block_bytes, { .type = ae::REGULAR, .cache_fill = true });
+    storage.tags[index] = loc.tag;
+    storage.dirty[index] = false;
+    storage.prefetched[index] = true;
+    replacement_policy->update_stats(way, loc.row, true);
+
+    prefetch_issued++;
+    change_counter += cache_config.block_size();
+    for (size_t col = 0; col < cache_config.block_size(); col++) {
+        emit cache_update(way, loc.row, col, true, false, loc.tag, data, false);
+    }
+    update_all_statistics();
+}
+
+void Cache::note_demand_miss(const CacheLocation &loc) const {
+    if (pollution_filter.empty()) {
+        return;
+    }
+    const uint64_t block = loc.tag * cache_config.set_count() + loc.row;
+    uint64_t &evicted = pollution_filter[block % pollution_filter.size()];
+    if (evicted == block) {
+        prefetch_pollution++;
+        evicted = CacheStorage::INVALID_TAG;
+    }
+}
+
+bool Cache::is_cached(Address address) const {
+    return find_block_index(compute_location(address))
+           < cache_config.associativity();
+}
 size_t Cache::calculate_overflow_to_next_blocks(
     size_t access_size,
     const CacheLocation &loc) const {
@@ -342,27 +590,72 @@ size_t Cache::calculate_overflow_to_next_blocks(
 }
 
 size_t Cache::find_block_index(const CacheLocation &loc) const {
-    uint32_t index = 0;
-    while (
-        index < cache_config.associativity()
-        and (!dt[index][loc.row].valid or dt[index][loc.row].tag != loc.tag)) {
-        index++;
+    // Invalid lines never match, their tag is out of range of addresses
+    const size_t associativity = cache_config.associativity();
+    const uint64_t *set = &storage.tags[line_index(0, loc.row)];
+    size_t way = 0;
+#ifdef __SSE2__
+    // SSE2 lacks 64-bit compare, lane matches when both its halves match
+    const __m128i key = _mm_set1_epi64x((long long)loc.tag);
+    for (; way + 4 <= associativity; way += 4) {
+        __m128i eq_lo = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(set + way)), key);
+        __m128i eq_hi = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(set + way + 2)), key);
+        eq_lo = _mm_and_si128(eq_lo, _mm_shuffle_epi32(eq_lo, _MM_SHUFFLE(2, 3, 0, 1)));
+        eq_hi = _mm_and_si128(eq_hi, _mm_shuffle_epi32(eq_hi, _MM_SHUFFLE(2, 3, 0, 1)));
+        const int mask = _mm_movemask_pd(_mm_castsi128_pd(eq_lo))
+                         | _mm_movemask_pd(_mm_castsi128_pd(eq_hi)) << 2;
+        if (mask != 0) {
+            return way + __builtin_ctz(mask);
+        }
     }
-    return index;
+#endif
+    while (way < associativity && set[way] != loc.tag) {
+        way++;
+    }
+    return way;
+}
+
+size_t Cache::line_index(size_t way, size_t row) const {
+    return row * cache_config.associativity() + way;
+}
+
+uint32_t *Cache::block_data(size_t way, size_t row) const {
+    return &storage.data[line_index(way, row) * cache_config.block_size()];
 }
 
-void Cache::kick(size_t way, size_t row) const {
-    struct CacheLine &cd = dt[way][row];
-    if (cd.dirty && cache_config.write_policy() == CacheConfig::WP_BACK) {
+void Cache::kick(size_t way, size_t row, bool handover) const {
+    const size_t index = line_index(way, row);
+    const size_t block_bytes = cache_config.block_size() * BLOCK_ITEM_SIZE;
+    const bool valid = storage.tags[index] != CacheStorage::INVALID_TAG;
+    const Address base = valid ? calc_base_address(storage.tags[index], row)
+                               : Address::null();
+
+    // Inner levels write dirty data back into this line, it has to stay
+    // valid until they are done
+    if (valid) {
+        for (Cache *inner : inner_levels) {
+            inner->invalidate_range(base, block_bytes);
+        }
+    }
+    const bool write_back
+        = valid
+          && ((evict_clean && !handover)
+              || (storage.dirty[index]
+                  && cache_config.write_policy() == CacheConfig::WP_BACK));
+    // Invalidated before the write back, outer inclusive level must not find
+    // it when it back-invalidates
+    storage.tags[index] = CacheStorage::INVALID_TAG;
+    storage.dirty[index] = false;
+    storage.prefetched[index] = false;
+
+    if (write_back) {
         mem->write(
-            calc_base_address(cd.tag, row), cd.data.data(),
-            cache_config.block_size() * BLOCK_ITEM_SIZE, {});
+            base, block_data(way, row), block_bytes,
+            { .type = ae::REGULAR, .cache_eviction = !handover });
         mem_writes += cache_config.block_size();
         burst_writes += cache_config.block_size() - 1;
         emit memory_writes_update(mem_writes);
     }
-    cd.valid = false;
-    cd.dirty = false;
 
     change_counter++;
 
@@ -372,6 +665,11 @@ void Cache::kick(size_t way, size_t row) const {
 void Cache::update_all_statistics() const {
     emit statistics_update(
         get_stall_count(), get_speed_improvement(), get_hit_rate());
+    if (prefetcher != nullptr) {
+        emit prefetch_update(
+            get_prefetch_count(), get_prefetch_accuracy(), get_prefetch_coverage(),
+            get_prefetch_pollution());
+    }
 }
 
 Address Cache::calc_base_address(size_t tag, size_t row) const {
@@ -403,27 +701,51 @@ enum LocationStatus Cache::location_status(Address address) const {
     const CacheLocation loc = compute_location(address);
 
     if (cache_config.enabled()) {
-        for (auto const &set : dt) {
-            auto const &block = set[loc.row];
-
-            if (block.valid && block.tag == loc.tag) {
-                if (block.dirty
-                    && cache_config.write_policy() == CacheConfig::WP_BACK) {
-                    return (enum LocationStatus)(
-                        LOCSTAT_CACHED | LOCSTAT_DIRTY);
-                } else {
-                    return LOCSTAT_CACHED;
-                }
+        const size_t way = find_block_index(loc);
+        if (way < cache_config.associativity()) {
+            if (storage.dirty[line_index(way, loc.row)]
+                && cache_config.write_policy() == CacheConfig::WP_BACK) {
+                return (enum LocationStatus)(LOCSTAT_CACHED | LOCSTAT_DIRTY);
+            } else {
+                return LOCSTAT_CACHED;
             }
         }
     }
     return mem->location_status(address);
 }
 
+byte *Cache::direct_access(Address address, size_t size) {
+    if (cache_config.enabled() || access_sink != nullptr) {
+        return nullptr;
+    }
+    return mem->direct_access(address, size);
+}
+
+const byte *Cache::direct_read(Address address, size_t size) const {
+    if (cache_config.enabled() || access_sink != nullptr) {
+        return nullptr;
+    }
+    return mem->direct_read(address, size);
+}
+
+void Cache::direct_write_done() {
+    if (!cache_config.enabled()) {
+        mem->direct_write_done();
+    }
+}
+
 const CacheConfig &Cache::get_config() const {
     return cache_config;
 }
 
+void Cache::set_access_sink(CacheAccessSink *sink) {
+    access_sink = sink;
+}
+
+void Cache::set_pc_source(std::function<Address()> source) {
+    pc_source = std::move(source);
+}
+
 uint32_t Cache::get_change_counter() const {
     return change_counter;
 }
@@ -445,9 +767,64 @@ uint32_t Cache::get_write_count() const {
 }
 
 uint32_t Cache::get_stall_count() const {
+    return get_statistics().stall_count(cache_config, access_pen_r, access_pen_w, access_pen_b);
+}
+
+double Cache::get_speed_improvement() const {
+    return get_statistics().speed_improvement(
+        cache_config, access_pen_r, access_pen_w, access_pen_b);
+}
+
+double Cache::get_hit_rate() const {
+    return get_statistics().hit_rate();
+}
+
+uint32_t Cache::get_prefetch_count() const {
+    return prefetch_issued;
+}
+
+uint32_t Cache::get_prefetch_useful_count() const {
+    return prefetch_useful;
+}
+
+double Cache::get_prefetch_accuracy() const {
+    if (prefetch_issued == 0) {
+        return 0.0;
+    }
+    return (double)prefetch_useful / (double)prefetch_issued * 100.0;
+}
+
+double Cache::get_prefetch_coverage() const {
+    const uint32_t comp = prefetch_useful + get_miss_count();
+    if (comp == 0) {
+        return 0.0;
+    }
+    return (double)prefetch_useful / (double)comp * 100.0;
+}
+
+uint32_t Cache::get_prefetch_pollution() const {
+    return prefetch_pollution;
+}
+
+CacheStatistics Cache::get_statistics() const {
+    return { .hit_read = hit_read,
+             .miss_read = miss_read,
+             .hit_write = hit_write,
+             .miss_write = miss_write,
+             .mem_reads = mem_reads,
+             .mem_writes = mem_writes,
+             .burst_reads = burst_reads,
+             .burst_writes = burst_writes };
+}
+
+uint32_t CacheStatistics::stall_count(
+    const CacheConfig &config,
+    uint32_t access_pen_r,
+    uint32_t access_pen_w,
+    uint32_t access_pen_b) const {
     uint32_t st_cycles
         = mem_reads * (access_pen_r - 1) + mem_writes * (access_pen_w - 1);
-    st_cycles += (miss_read + miss_write) * cache_config.block_size();
+    st_cycles += (miss_read + miss_write) * config.block_size();
     if (access_pen_b != 0) {
         st_cycles -= burst_reads * (access_pen_r - access_pen_b)
                      + burst_writes * (access_pen_w - access_pen_b);
@@ -455,7 +832,11 @@ uint32_t Cache::get_stall_count() const {
     return st_cycles;
 }
 
-double Cache::get_speed_improvement() const {
+double CacheStatistics::speed_improvement(
+    const CacheConfig &config,
+    uint32_t access_pen_r,
+    uint32_t access_pen_w,
+    uint32_t access_pen_b) const {
     uint32_t lookup_time;
     uint32_t mem_access_time;
     uint32_t comp = hit_read + hit_write + miss_read + miss_write;
@@ -463,7 +844,7 @@ double Cache::get_speed_improvement() const {
         return 100.0;
     }
     lookup_time = hit_read + miss_read;
-    if (cache_config.write_policy() == CacheConfig::WP_BACK) {
+    if (config.write_policy() == CacheConfig::WP_BACK) {
         lookup_time += hit_write + miss_write;
     }
     mem_access_time = mem_reads * access_pen_r + mem_writes * access_pen_w;
@@ -476,7 +857,7 @@ double Cache::get_speed_improvement() const {
         / (double)(lookup_time + mem_access_time) * 100);
 }
 
-double Cache::get_hit_rate() const {
+double CacheStatistics::hit_rate() const {
     uint32_t comp = hit_read + hit_write + miss_read + miss_write;
     if (comp == 0) {
         return 0.0;
@@ -40,16 +40,52 @@
 
 #include "machineconfig.h"
 #include "memory/cache/cache_policy.h"
+#include "memory/cache/cache_prefetcher.h"
 #include "memory/cache/cache_types.h"
 #include "memory/frontend_memory.h"
 
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <vector>
 
 namespace machine {
 
 constexpr size_t BLOCK_ITEM_SIZE = sizeof(uint32_t);
 
+/**
+ * Hit/miss and backing memory traffic counters of a cache.
+ *
+ * Derived statistics are computed from counters the same way for simulated
+ * cache and for other models of the same configuration (see `CacheSweep`).
+ */
+struct CacheStatistics {
+    uint32_t hit_read = 0, miss_read = 0, hit_write = 0, miss_write = 0,
+             mem_reads = 0, mem_writes = 0, burst_reads = 0, burst_writes = 0;
+
+    uint32_t stall_count(
+        const CacheConfig &config,
+        uint32_t access_pen_r,
+        uint32_t access_pen_w,
+        uint32_t access_pen_b) const;
+    double speed_improvement(
+        const CacheConfig &config,
+        uint32_t access_pen_r,
+        uint32_t access_pen_w,
+        uint32_t access_pen_b) const;
+    double hit_rate() const;
+};
+
+/**
+ * Receives accesses requested from a cache (before they are resolved by the
+ * cache itself), used to feed other cache models or to record traces.
+ */
+class CacheAccessSink {
+public:
+    virtual ~CacheAccessSink() = default;
+    virtual void cache_access(Address address, size_t size, AccessType type) = 0;
+};
+
 /**
  * NOTE ON TERMINOLOGY:
  * N-way set associative cache consist of N ways (where N is degree
@@ -76,14 +112,14 @@ public:
      * @param simulated_endian          endian of the simulated CPU/memory
      * system
      * @param config                    cache configuration struct
-     * @param memory_access_penalty_r   cycles to perform read (stats only)
-     * @param memory_access_penalty_w   cycles to perform write (stats only)
-     * @param memory_access_penalty_b   cycles to perform burst access (stats
-     *                                  only)
+     * @param memory_access_penalty_r   cycles to perform read
+     * @param memory_access_penalty_w   cycles to perform write
+     * @param memory_access_penalty_b   cycles to perform burst access
      *
-     * NOTE: Memory access penalties apply only to statistics and are not taken
-     * into account during simulation itself. There is no point in doing so
-     * without superscalar execution.
+     * NOTE: Memory access penalties are used by statistics. Simulation takes
+     * them into account only when pipelined core is configured to stall on
+     * memory access (MachineConfig::set_memory_stalls), the core then waits
+     * for the increase of stall count (get_stall_count) caused by each cycle.
      */
     Cache(
         FrontendMemory *memory,
@@ -120,13 +156,73 @@ public:
     double get_speed_improvement() const; // Speed improvement in percents in
                                           // comare with no used cache
     double get_hit_rate() const;          // Usage efficiency in percents
+    CacheStatistics get_statistics() const;
+
+    uint32_t get_prefetch_count() const;  // Number of prefetched blocks
+    uint32_t get_prefetch_useful_count() const; // Prefetched blocks used by
+                                                // demand access
+    double get_prefetch_accuracy() const; // Useful prefetches in percents
+    double get_prefetch_coverage() const; // Misses removed by prefetch in
+                                          // percents
+    uint32_t get_prefetch_pollution() const; // Misses on blocks evicted by
+                                             // prefetch
 
     void reset(); // Reset whole state of cache
 
+    // Content, replacement policy state and statistics of the cache
+    struct State {
+        CacheStorage storage;
+        std::unique_ptr<CachePolicy> replacement_policy;
+        std::unique_ptr<CachePrefetcher> prefetcher;
+        std::vector<uint64_t> pollution_filter;
+        uint32_t hit_read, miss_read, hit_write, miss_write, mem_reads,
+            mem_writes, burst_reads, burst_writes, prefetch_issued,
+            prefetch_useful, prefetch_pollution;
+    };
+    State save_state() const;
+    // State has to be saved from cache of the same configuration
+    void restore_state(const State &);
+
     const CacheConfig &get_config() const;
 
+    /**
+     * Passes all regular (not debug) accesses to the sink. Direct access is
+     * refused while a sink is set, so no access can bypass it.
+     */
+    void set_access_sink(CacheAccessSink *sink);
+
+    /**
+     * Provides address of instruction performing data access for PC indexed
+     * prefetchers. All accesses are attributed to a single (null) PC when
+     * not set, which suits instruction fetches.
+     */
+    void set_pc_source(std::function<Address()> source);
+
+    /**
+     * Declares caches placed between the core and this (shared) level.
+     *
+     * Inclusive level invalidates blocks in inner levels when it evicts them,
+     * so it always holds a superset of their content. Exclusive level is
+     * filled only by blocks evicted from inner levels (those evict clean
+     * blocks too) and gives the block up when an inner level loads it.
+     */
+    void set_inner_levels(
+        const std::vector<Cache *> &inner,
+        enum MachineConfig::CacheInclusion inclusion);
+
+    // Drops all blocks overlapping the range (dirty ones are written back)
+    void invalidate_range(Address start, size_t size);
+
+    // Peripherals area, accesses go directly to the backing memory
+    static bool is_in_uncached_area(Address source);
+
     enum LocationStatus location_status(Address address) const override;
 
+    // Passed to the backing memory only when cache is disabled
+    byte *direct_access(Address address, size_t size) override;
+    const byte *direct_read(Address address, size_t size) const override;
+    void direct_write_done() override;
+
 signals:
     void hit_update(uint32_t) const;
     void miss_update(uint32_t) const;
@@ -145,30 +241,67 @@ signals:
         bool write) const;
     void memory_writes_update(uint32_t) const;
     void memory_reads_update(uint32_t) const;
+    void prefetch_update(
+        uint32_t prefetches,
+        double accuracy,
+        double coverage,
+        uint32_t pollution) const;
 
 private:
     const CacheConfig cache_config;
     FrontendMemory *const mem = nullptr;
-    const Address uncached_start;
-    const Address uncached_last;
+    CacheAccessSink *access_sink = nullptr;
     const uint32_t access_pen_r, access_pen_w, access_pen_b;
-    const std::unique_ptr<CachePolicy> replacement_policy;
+    std::unique_ptr<CachePolicy> replacement_policy;
+    std::unique_ptr<CachePrefetcher> prefetcher;
+    std::function<Address()> pc_source;
+    mutable std::vector<uint64_t> prefetch_queue;
+    // Recently evicted by prefetch, direct mapped by block number
+    mutable std::vector<uint64_t> pollution_filter;
+    // Inner levels back-invalidated on eviction (inclusive hierarchy only)
+    std::vector<Cache *> inner_levels;
+    bool exclusive = false;   // Allocated only by evictions from inner levels
+    bool evict_clean = false; // Outer level is exclusive
 
-    mutable std::vector<std::vector<CacheLine>> dt;
+    mutable CacheStorage storage;
 
     mutable uint32_t hit_read = 0, miss_read = 0, hit_write = 0, miss_write = 0,
                      mem_reads = 0, mem_writes = 0, burst_reads = 0,
-                     burst_writes = 0, change_counter = 0;
+                     burst_writes = 0, change_counter = 0,
+                     prefetch_issued = 0, prefetch_useful = 0,
+                     prefetch_pollution = 0;
 
     void internal_read(Address source, void *destination, size_t size) const;
 
+    /**
+     * @param eviction  write of a block evicted from inner level, whole block
+     *                  overwrite does not need to load it from memory
+     */
     bool access(
         Address address,
         void *buffer,
         size_t size,
-        AccessType access_type) const;
+        AccessType access_type,
+        bool eviction = false) const;
+
+    // Inner level loads the block from exclusive level, which gives it up
+    void exclusive_fill(Address source, void *destination, size_t size) const;
 
-    void kick(size_t way, size_t row) const;
+    bool is_cached(Address address) const;
+
+    // Feeds demand access to prefetcher and loads proposed blocks
+    void run_prefetcher(Address address, bool miss, bool prefetch_hit) const;
+    void prefetch_block(uint64_t block) const;
+    // Demand miss accounting shared by allocating and non-allocating misses
+    void note_demand_miss(const CacheLocation &loc) const;
+
+    // Handed over block is still held by inner level, only dirty data are
+    // written back and without allocation in exclusive outer level
+    void kick(size_t way, size_t row, bool handover = false) const;
+
+    // Index of the line in `storage`
+    size_t line_index(size_t way, size_t row) const;
+    uint32_t *block_data(size_t way, size_t row) const;
 
     Address calc_base_address(size_t tag, size_t row) const;
 
@@ -177,7 +310,8 @@ private:
     CacheLocation compute_location(Address address) const;
 
     /**
-     * Searches for given tag in a set
+     * Searches for given tag in a set, ways are compared in parallel where
+     * SIMD instructions are available
      *
      * @param loc       requested location in cache
      * @return          associativity index of found block, max index + 1 if not
@@ -185,8 +319,6 @@ private:
      */
     size_t find_block_index(const CacheLocation &loc) const;
 
-    bool is_in_uncached_area(Address source) const;
-
     /**
      * RW access to cache may span multiple blocks but it needs to be
      * performed per block.
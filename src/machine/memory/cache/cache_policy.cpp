@@ -40,6 +40,8 @@
 #include "simulator_exception.h"
 #include "utils.h"
 
+#include <algorithm>
+
 namespace machine {
 
 std::unique_ptr<CachePolicy>
@@ -54,6 +56,18 @@ CachePolicy::get_policy_instance(const CacheConfig *config) {
         case CacheConfig::RP_LFU:
             return std::make_unique<CachePolicyLFU>(
                 config->associativity(), config->set_count());
+        case CacheConfig::RP_PLRU:
+            return std::make_unique<CachePolicyPLRU>(
+                config->associativity(), config->set_count());
+        case CacheConfig::RP_NRU:
+            return std::make_unique<CachePolicyNRU>(
+                config->associativity(), config->set_count());
+        case CacheConfig::RP_SRRIP:
+            return std::make_unique<CachePolicyRRIP>(
+                config->associativity(), config->set_count(), false);
+        case CacheConfig::RP_BRRIP:
+            return std::make_unique<CachePolicyRRIP>(
+                config->associativity(), config->set_count(), true);
         }
     } else {
         // Disabled cache will never use it.
@@ -104,6 +118,10 @@ void CachePolicyLRU::update_stats(size_t way, size_t row, bool is_valid) {
     }
 }
 
+std::unique_ptr<CachePolicy> CachePolicyLRU::clone() const {
+    return std::make_unique<CachePolicyLRU>(*this);
+}
+
 size_t CachePolicyLRU::select_way_to_evict(size_t row) const {
     return stats.at(row).at(0);
 }
@@ -122,6 +140,10 @@ void CachePolicyLFU::update_stats(size_t way, size_t row, bool is_valid) {
     }
 }
 
+std::unique_ptr<CachePolicy> CachePolicyLFU::clone() const {
+    return std::make_unique<CachePolicyLFU>(*this);
+}
+
 size_t CachePolicyLFU::select_way_to_evict(size_t row) const {
     size_t index = 0;
     try {
@@ -146,12 +168,11 @@ size_t CachePolicyLFU::select_way_to_evict(size_t row) const {
 }
 
 CachePolicyRAND::CachePolicyRAND(size_t associativity)
-    : associativity(associativity) {
-    // Reset random generator to make result reproducible.
-    // Random is by default seeded by 1 (by cpp standard), so this makes it
-    // consistent across multiple runs.
-    // NOTE: Reproducibility applies only on the same execution environment.
-    std::srand(1); // NOLINT(cert-msc51-cpp)
+    : associativity(associativity)
+    , generator(1) {
+    // Each cache owns its generator with fixed seed. Results are
+    // reproducible and independent of other machines simulated in
+    // parallel, checkpoint copies continue the same sequence.
 }
 
 void CachePolicyRAND::update_stats(size_t way, size_t row, bool is_valid) {
@@ -159,8 +180,185 @@ void CachePolicyRAND::update_stats(size_t way, size_t row, bool is_valid) {
     // NOP
 }
 
+std::unique_ptr<CachePolicy> CachePolicyRAND::clone() const {
+    return std::make_unique<CachePolicyRAND>(*this);
+}
+
 size_t CachePolicyRAND::select_way_to_evict(size_t row) const {
     UNUSED(row)
-    return std::rand() % associativity; // NOLINT(cert-msc50-cpp)
+    return generator() % associativity;
+}
+
+// Mask of bits of existing ways in given word of per way bitmap
+static uint64_t way_mask(size_t associativity, size_t word) {
+    size_t ways = associativity - word * 64;
+    return ways >= 64 ? ~(uint64_t)0 : ((uint64_t)1 << ways) - 1;
+}
+
+CachePolicyPLRU::CachePolicyPLRU(size_t associativity, size_t set_count)
+    : associativity(associativity) {
+    // Nodes are numbered from one, bit zero is unused
+    size_t nodes = 1;
+    while (nodes < associativity) {
+        nodes <<= 1;
+    }
+    words_per_set = (nodes + 63) / 64;
+    bits.resize(set_count * words_per_set, 0);
+}
+
+void CachePolicyPLRU::update_stats(size_t way, size_t row, bool is_valid) {
+    uint64_t *set = &bits[row * words_per_set];
+    size_t node = 1, first_way = 0, ways = associativity;
+    while (ways > 1) {
+        const size_t left_ways = (ways + 1) / 2;
+        const bool in_right = way >= first_way + left_ways;
+        // Set bit points to the right subtree
+        if (is_valid != in_right) {
+            set[node / 64] |= (uint64_t)1 << (node % 64);
+        } else {
+            set[node / 64] &= ~((uint64_t)1 << (node % 64));
+        }
+        node = 2 * node + in_right;
+        if (in_right) {
+            first_way += left_ways;
+            ways -= left_ways;
+        } else {
+            ways = left_ways;
+        }
+    }
+}
+
+std::unique_ptr<CachePolicy> CachePolicyPLRU::clone() const {
+    return std::make_unique<CachePolicyPLRU>(*this);
+}
+
+size_t CachePolicyPLRU::select_way_to_evict(size_t row) const {
+    const uint64_t *set = &bits[row * words_per_set];
+    size_t node = 1, first_way = 0, ways = associativity;
+    while (ways > 1) {
+        const size_t left_ways = (ways + 1) / 2;
+        const bool right = set[node / 64] >> (node % 64) & 1;
+        node = 2 * node + right;
+        if (right) {
+            first_way += left_ways;
+            ways -= left_ways;
+        } else {
+            ways = left_ways;
+        }
+    }
+    return first_way;
+}
+
+CachePolicyNRU::CachePolicyNRU(size_t associativity, size_t set_count)
+    : associativity(associativity) {
+    words_per_set = (associativity + 63) / 64;
+    used.resize(set_count * words_per_set, 0);
+}
+
+void CachePolicyNRU::update_stats(size_t way, size_t row, bool is_valid) {
+    uint64_t *set = &used[row * words_per_set];
+    const uint64_t bit = (uint64_t)1 << (way % 64);
+    if (!is_valid) {
+        set[way / 64] &= ~bit;
+        return;
+    }
+    set[way / 64] |= bit;
+    for (size_t i = 0; i < words_per_set; i++) {
+        if (set[i] != way_mask(associativity, i)) {
+            return;
+        }
+    }
+    std::fill(set, set + words_per_set, 0);
+    set[way / 64] = bit;
+}
+
+std::unique_ptr<CachePolicy> CachePolicyNRU::clone() const {
+    return std::make_unique<CachePolicyNRU>(*this);
+}
+
+size_t CachePolicyNRU::select_way_to_evict(size_t row) const {
+    const uint64_t *set = &used[row * words_per_set];
+    for (size_t i = 0; i < words_per_set; i++) {
+        uint64_t unused = ~set[i] & way_mask(associativity, i);
+        if (unused != 0) {
+            return i * 64 + __builtin_ctzll(unused);
+        }
+    }
+    // Only way of direct mapped cache is always marked
+    return 0;
+}
+
+constexpr unsigned RRPV_BITS = 2;
+constexpr unsigned RRPV_DISTANT = (1u << RRPV_BITS) - 1;
+constexpr unsigned RRPV_LONG = RRPV_DISTANT - 1;
+constexpr unsigned RRPV_PER_WORD = 64 / RRPV_BITS;
+// BRRIP inserts one of this number of blocks with long prediction
+constexpr unsigned BRRIP_LONG_INTERVAL = 32;
+
+CachePolicyRRIP::CachePolicyRRIP(size_t associativity, size_t set_count, bool bimodal)
+    : associativity(associativity)
+    , bimodal(bimodal)
+    , generator(1) {
+    words_per_set = (associativity + RRPV_PER_WORD - 1) / RRPV_PER_WORD;
+    valid_words_per_set = (associativity + 63) / 64;
+    rrpv.resize(set_count * words_per_set, ~(uint64_t)0);
+    valid.resize(set_count * valid_words_per_set, 0);
+}
+
+unsigned CachePolicyRRIP::get_rrpv(size_t way, size_t row) const {
+    const uint64_t word = rrpv[row * words_per_set + way / RRPV_PER_WORD];
+    return (word >> (way % RRPV_PER_WORD * RRPV_BITS)) & RRPV_DISTANT;
+}
+
+void CachePolicyRRIP::set_rrpv(size_t way, size_t row, unsigned value) const {
+    uint64_t &word = rrpv[row * words_per_set + way / RRPV_PER_WORD];
+    const unsigned shift = way % RRPV_PER_WORD * RRPV_BITS;
+    word = (word & ~((uint64_t)RRPV_DISTANT << shift)) | (uint64_t)value << shift;
+}
+
+void CachePolicyRRIP::update_stats(size_t way, size_t row, bool is_valid) {
+    uint64_t &valid_word = valid[row * valid_words_per_set + way / 64];
+    const uint64_t bit = (uint64_t)1 << (way % 64);
+    if (!is_valid) {
+        valid_word &= ~bit;
+        set_rrpv(way, row, RRPV_DISTANT);
+    } else if (!(valid_word & bit)) {
+        // Block was just inserted
+        valid_word |= bit;
+        bool distant = bimodal && generator() % BRRIP_LONG_INTERVAL != 0;
+        set_rrpv(way, row, distant ? RRPV_DISTANT : RRPV_LONG);
+    } else {
+        set_rrpv(way, row, 0);
+    }
+}
+
+std::unique_ptr<CachePolicy> CachePolicyRRIP::clone() const {
+    return std::make_unique<CachePolicyRRIP>(*this);
+}
+
+size_t CachePolicyRRIP::select_way_to_evict(size_t row) const {
+    const uint64_t *set_valid = &valid[row * valid_words_per_set];
+    for (size_t i = 0; i < valid_words_per_set; i++) {
+        uint64_t invalid = ~set_valid[i] & way_mask(associativity, i);
+        if (invalid != 0) {
+            return i * 64 + __builtin_ctzll(invalid);
+        }
+    }
+    size_t victim = 0;
+    unsigned oldest = 0;
+    for (size_t way = 0; way < associativity && oldest < RRPV_DISTANT; way++) {
+        unsigned value = get_rrpv(way, row);
+        if (value > oldest) {
+            oldest = value;
+            victim = way;
+        }
+    }
+    // Age the set until the victim has distant prediction
+    if (oldest < RRPV_DISTANT) {
+        for (size_t way = 0; way < associativity; way++) {
+            set_rrpv(way, row, get_rrpv(way, row) + RRPV_DISTANT - oldest);
+        }
+    }
+    return victim;
 }
 } // namespace machine
@@ -44,6 +44,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <memory>
+#include <random>
 
 using std::size_t;
 
@@ -69,6 +70,9 @@ public:
 
     virtual ~CachePolicy() = default;
 
+    // Independent copy including current replacement state
+    virtual std::unique_ptr<CachePolicy> clone() const = 0;
+
     static std::unique_ptr<CachePolicy>
     get_policy_instance(const CacheConfig *config);
 };
@@ -93,6 +97,8 @@ public:
 
     void update_stats(size_t way, size_t row, bool is_valid) final;
 
+    std::unique_ptr<CachePolicy> clone() const final;
+
 private:
     /**
      * Last access order queues for each cache set (row)
@@ -120,6 +126,8 @@ public:
 
     void update_stats(size_t way, size_t row, bool is_valid) final;
 
+    std::unique_ptr<CachePolicy> clone() const final;
+
 private:
     std::vector<std::vector<uint32_t>> stats;
 };
@@ -135,8 +143,109 @@ public:
 
     void update_stats(size_t way, size_t row, bool is_valid) final;
 
+    std::unique_ptr<CachePolicy> clone() const final;
+
 private:
     size_t associativity;
+    mutable std::minstd_rand generator;
+};
+
+/**
+ * Tree pseudo least recently used policy
+ *
+ *  Each set keeps binary tree of associativity - 1 bits, ways of a node are
+ *  split in halves (the left one is larger for odd count). Bit of a node
+ *  points to the subtree which was not accessed recently. Access turns bits
+ *  on the path to the way away from it, invalidation turns them towards it.
+ */
+class CachePolicyPLRU final : public CachePolicy {
+public:
+    /**
+     * @param associativity     degree of assiciaivity
+     * @param set_count         number of blocks / rows in a way (or sets in
+     * cache)
+     */
+    CachePolicyPLRU(size_t associativity, size_t set_count);
+
+    size_t select_way_to_evict(size_t row) const final;
+
+    void update_stats(size_t way, size_t row, bool is_valid) final;
+
+    std::unique_ptr<CachePolicy> clone() const final;
+
+private:
+    const size_t associativity;
+    size_t words_per_set;
+    // Tree node n (root is 1, children of n are 2n and 2n + 1) is bit n
+    std::vector<uint64_t> bits;
+};
+
+/**
+ * Not recently used policy
+ *
+ *  Each set keeps a bit per way marking recently accessed ways. When all
+ *  ways are marked, marks of all but the accessed one are cleared. First
+ *  unmarked way is evicted.
+ */
+class CachePolicyNRU final : public CachePolicy {
+public:
+    /**
+     * @param associativity     degree of assiciaivity
+     * @param set_count         number of blocks / rows in a way (or sets in
+     * cache)
+     */
+    CachePolicyNRU(size_t associativity, size_t set_count);
+
+    size_t select_way_to_evict(size_t row) const final;
+
+    void update_stats(size_t way, size_t row, bool is_valid) final;
+
+    std::unique_ptr<CachePolicy> clone() const final;
+
+private:
+    const size_t associativity;
+    size_t words_per_set;
+    std::vector<uint64_t> used;
+};
+
+/**
+ * Re-reference interval prediction policies (SRRIP and BRRIP)
+ *
+ *  Each way keeps 2-bit re-reference prediction value (RRPV). Hit predicts
+ *  near re-reference (zero), new block is inserted with long prediction
+ *  (SRRIP) or mostly with distant one (BRRIP, resistant to scans). Way with
+ *  distant prediction is evicted, if there is none, all ways of the set are
+ *  aged first. Invalid ways are evicted before any valid one.
+ */
+class CachePolicyRRIP final : public CachePolicy {
+public:
+    /**
+     * @param associativity     degree of assiciaivity
+     * @param set_count         number of blocks / rows in a way (or sets in
+     * cache)
+     * @param bimodal           insert with distant prediction (BRRIP)
+     */
+    CachePolicyRRIP(size_t associativity, size_t set_count, bool bimodal);
+
+    size_t select_way_to_evict(size_t row) const final;
+
+    void update_stats(size_t way, size_t row, bool is_valid) final;
+
+    std::unique_ptr<CachePolicy> clone() const final;
+
+private:
+    const size_t associativity;
+    const bool bimodal;
+    size_t words_per_set;       // Of RRPV values, 32 ways per word
+    size_t valid_words_per_set; // Of valid bits, 64 ways per word
+    // Aging on eviction does not change the order of ways, it is part of
+    // victim selection
+    mutable std::vector<uint64_t> rrpv;
+    std::vector<uint64_t> valid;
+    std::minstd_rand generator;
+
+    unsigned get_rrpv(size_t way, size_t row) const;
+    void set_rrpv(size_t way, size_t row, unsigned value) const;
 };
 
 } // namespace machine
@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*******************************************************************************
+ * QtMips - MIPS 32-bit Architecture Subset Simulator
+ *
+ * Implemented to support following courses:
+ *
+ *   B35APO - Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b35apo
+ *
+ *   B4M35PAP - Advanced Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b4m35pap/start
+ *
+ * Copyright (c) 2017-2019 Karel Koci<cynerd@email.cz>
+ * Copyright (c) 2019      Pavel Pisa <pisa@cmp.felk.cvut.cz>
+ * Copyright (c) 2020      Jakub Dupak <dupak.jakub@gmail.com>
+ * Copyright (c) 2020      Max Hollmann <hollmmax@fel.cvut.cz>
+ *
+ * Faculty of Electrical Engineering (http://www.fel.cvut.cz)
+ * Czech Technical University        (http://www.cvut.cz/)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+#include "memory/cache/cache_prefetcher.h"
+
+#include <algorithm>
+
+namespace machine {
+
+constexpr size_t CachePrefetcherStride::TABLE_SIZE;
+constexpr uint8_t CachePrefetcherStride::CONFIDENCE_MAX;
+constexpr uint8_t CachePrefetcherStride::CONFIDENCE_STEADY;
+constexpr size_t CachePrefetcherStream::STREAM_COUNT;
+
+std::unique_ptr<CachePrefetcher>
+CachePrefetcher::get_prefetcher_instance(const CacheConfig *config) {
+    if (!config->enabled()) {
+        return { nullptr };
+    }
+    switch (config->prefetcher()) {
+    case CacheConfig::PF_NONE: return { nullptr };
+    case CacheConfig::PF_NEXT_LINE:
+        return std::make_unique<CachePrefetcherNextLine>(
+            config->prefetch_degree(), config->prefetch_distance());
+    case CacheConfig::PF_STRIDE:
+        return std::make_unique<CachePrefetcherStride>(
+            config->prefetch_degree(), config->prefetch_distance());
+    case CacheConfig::PF_STREAM:
+        return std::make_unique<CachePrefetcherStream>(
+            config->prefetch_degree(), config->prefetch_distance());
+    }
+    Q_UNREACHABLE();
+}
+
+// Appends `degree` blocks from `distance` steps ahead, stops at address space
+// boundaries
+static void prefetch_ahead(
+    std::vector<uint64_t> &prefetch,
+    uint64_t block,
+    int64_t step,
+    unsigned degree,
+    unsigned distance) {
+    for (unsigned i = 0; i < degree; i++) {
+        const int64_t target = (int64_t)block + step * (int64_t)(distance + i);
+        if (target < 0) {
+            break;
+        }
+        prefetch.push_back((uint64_t)target);
+    }
+}
+
+CachePrefetcherNextLine::CachePrefetcherNextLine(unsigned degree, unsigned distance)
+    : degree(degree)
+    , distance(distance) {}
+
+void CachePrefetcherNextLine::access(
+    uint64_t block,
+    Address pc,
+    bool miss,
+    bool prefetch_hit,
+    std::vector<uint64_t> &prefetch) {
+    (void)pc;
+    if (miss || prefetch_hit) {
+        prefetch_ahead(prefetch, block, 1, degree, distance);
+    }
+}
+
+std::unique_ptr<CachePrefetcher> CachePrefetcherNextLine::clone() const {
+    return std::make_unique<CachePrefetcherNextLine>(*this);
+}
+
+CachePrefetcherStride::CachePrefetcherStride(unsigned degree, unsigned distance)
+    : degree(degree)
+    , distance(distance)
+    , table(TABLE_SIZE) {}
+
+void CachePrefetcherStride::access(
+    uint64_t block,
+    Address pc,
+    bool miss,
+    bool prefetch_hit,
+    std::vector<uint64_t> &prefetch) {
+    (void)miss;
+    (void)prefetch_hit;
+    Entry &entry = table[(pc.get_raw() >> 2) % TABLE_SIZE];
+    if (entry.pc != pc.get_raw()) {
+        entry = { .pc = pc.get_raw(), .last_block = block, .stride = 0, .confidence = 0 };
+        return;
+    }
+    const int64_t stride = (int64_t)(block - entry.last_block);
+    if (stride == 0) {
+        // Another access within the same block
+        return;
+    }
+    if (stride == entry.stride) {
+        entry.confidence = std::min<uint8_t>(entry.confidence + 1, CONFIDENCE_MAX);
+    } else if (entry.confidence > 0) {
+        entry.confidence--;
+    } else {
+        entry.stride = stride;
+    }
+    entry.last_block = block;
+    if (entry.confidence >= CONFIDENCE_STEADY) {
+        prefetch_ahead(prefetch, block, entry.stride, degree, distance);
+    }
+}
+
+std::unique_ptr<CachePrefetcher> CachePrefetcherStride::clone() const {
+    return std::make_unique<CachePrefetcherStride>(*this);
+}
+
+CachePrefetcherStream::CachePrefetcherStream(unsigned degree, unsigned distance)
+    : degree(degree)
+    , distance(distance)
+    , streams(STREAM_COUNT) {}
+
+void CachePrefetcherStream::access(
+    uint64_t block,
+    Address pc,
+    bool miss,
+    bool prefetch_hit,
+    std::vector<uint64_t> &prefetch) {
+    (void)pc;
+    if (!miss && !prefetch_hit) {
+        return;
+    }
+    time++;
+    for (Stream &stream : streams) {
+        if (!stream.active) {
+            continue;
+        }
+        int64_t step = (int64_t)(block - stream.last_block);
+        if (stream.direction != 0 ? step != stream.direction : step != 1 && step != -1) {
+            continue;
+        }
+        // Stream in training takes direction of its second miss
+        stream.direction = step;
+        stream.last_block = block;
+        stream.last_use = time;
+        prefetch_ahead(prefetch, block, step, degree, distance);
+        return;
+    }
+    Stream &victim = *std::min_element(
+        streams.begin(), streams.end(), [](const Stream &a, const Stream &b) {
+            return a.active != b.active ? !a.active : a.last_use < b.last_use;
+        });
+    victim = { .last_block = block, .direction = 0, .last_use = time, .active = true };
+}
+
+std::unique_ptr<CachePrefetcher> CachePrefetcherStream::clone() const {
+    return std::make_unique<CachePrefetcherStream>(*this);
+}
+
+} // namespace machine
@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*******************************************************************************
+ * QtMips - MIPS 32-bit Architecture Subset Simulator
+ *
+ * Implemented to support following courses:
+ *
+ *   B35APO - Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b35apo
+ *
+ *   B4M35PAP - Advanced Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b4m35pap/start
+ *
+ * Copyright (c) 2017-2019 Karel Koci<cynerd@email.cz>
+ * Copyright (c) 2019      Pavel Pisa <pisa@cmp.felk.cvut.cz>
+ * Copyright (c) 2020      Jakub Dupak <dupak.jakub@gmail.com>
+ * Copyright (c) 2020      Max Hollmann <hollmmax@fel.cvut.cz>
+ *
+ * Faculty of Electrical Engineering (http://www.fel.cvut.cz)
+ * Czech Technical University        (http://www.cvut.cz/)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+#ifndef CACHE_PREFETCHER_H
+#define CACHE_PREFETCHER_H
+
+#include "machineconfig.h"
+#include "memory/address.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace machine {
+
+/**
+ * Hardware prefetch engine interface.
+ *
+ * Prefetcher observes demand accesses of a cache and proposes blocks to be
+ * loaded ahead of time. Blocks are identified by block number, that is address
+ * divided by block size in bytes. Cache filters out proposals which are already
+ * present.
+ */
+class CachePrefetcher {
+public:
+    /**
+     * @param block         block number of demand access
+     * @param pc            address of instruction performing the access
+     * @param miss          demand access missed
+     * @param prefetch_hit  first demand hit of block loaded by prefetch
+     * @param prefetch      block numbers to prefetch are appended here
+     */
+    virtual void access(
+        uint64_t block,
+        Address pc,
+        bool miss,
+        bool prefetch_hit,
+        std::vector<uint64_t> &prefetch)
+        = 0;
+
+    virtual ~CachePrefetcher() = default;
+
+    // Independent copy including current prediction state
+    virtual std::unique_ptr<CachePrefetcher> clone() const = 0;
+
+    // Returns nullptr when no prefetching is configured
+    static std::unique_ptr<CachePrefetcher>
+    get_prefetcher_instance(const CacheConfig *config);
+};
+
+/**
+ * Next-line prefetcher (tagged)
+ *
+ *  Missed block and the first hit of a prefetched block trigger prefetch of
+ *  `degree` blocks starting `distance` blocks after it.
+ */
+class CachePrefetcherNextLine final : public CachePrefetcher {
+public:
+    CachePrefetcherNextLine(unsigned degree, unsigned distance);
+
+    void access(
+        uint64_t block,
+        Address pc,
+        bool miss,
+        bool prefetch_hit,
+        std::vector<uint64_t> &prefetch) final;
+
+    std::unique_ptr<CachePrefetcher> clone() const final;
+
+private:
+    const unsigned degree, distance;
+};
+
+/**
+ * Stride prefetcher with reference prediction table
+ *
+ *  Table is indexed by PC of memory instruction and holds its last accessed
+ *  block and stride between last two accesses. When the same stride is seen
+ *  repeatedly, blocks `distance` to `distance + degree - 1` strides ahead are
+ *  prefetched.
+ */
+class CachePrefetcherStride final : public CachePrefetcher {
+public:
+    CachePrefetcherStride(unsigned degree, unsigned distance);
+
+    void access(
+        uint64_t block,
+        Address pc,
+        bool miss,
+        bool prefetch_hit,
+        std::vector<uint64_t> &prefetch) final;
+
+    std::unique_ptr<CachePrefetcher> clone() const final;
+
+private:
+    static constexpr size_t TABLE_SIZE = 64;
+    static constexpr uint8_t CONFIDENCE_MAX = 3;
+    static constexpr uint8_t CONFIDENCE_STEADY = 2;
+
+    struct Entry {
+        uint64_t pc = UINT64_MAX;
+        uint64_t last_block = 0;
+        int64_t stride = 0;
+        uint8_t confidence = 0;
+    };
+
+    const unsigned degree, distance;
+    std::vector<Entry> table;
+};
+
+/**
+ * Stream buffer prefetcher
+ *
+ *  Keeps a small set of streams, each expecting the next sequential block in
+ *  either direction. Miss matching a stream advances it and prefetches `degree`
+ *  blocks `distance` blocks ahead, other misses allocate the least recently
+ *  used stream. Prefetched blocks are placed directly into the cache.
+ */
+class CachePrefetcherStream final : public CachePrefetcher {
+public:
+    CachePrefetcherStream(unsigned degree, unsigned distance);
+
+    void access(
+        uint64_t block,
+        Address pc,
+        bool miss,
+        bool prefetch_hit,
+        std::vector<uint64_t> &prefetch) final;
+
+    std::unique_ptr<CachePrefetcher> clone() const final;
+
+private:
+    static constexpr size_t STREAM_COUNT = 4;
+
+    struct Stream {
+        uint64_t last_block = 0;
+        int64_t direction = 0; // Zero while direction is not known yet
+        uint32_t last_use = 0;
+        bool active = false;
+    };
+
+    const unsigned degree, distance;
+    std::vector<Stream> streams;
+    uint32_t time = 0;
+};
+
+} // namespace machine
+
+#endif // CACHE_PREFETCHER_H
@@ -0,0 +1,381 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*******************************************************************************
+ * QtMips - MIPS 32-bit Architecture Subset Simulator
+ *
+ * Implemented to support following courses:
+ *
+ *   B35APO - Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b35apo
+ *
+ *   B4M35PAP - Advanced Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b4m35pap/start
+ *
+ * Copyright (c) 2017-2019 Karel Koci<cynerd@email.cz>
+ * Copyright (c) 2019      Pavel Pisa <pisa@cmp.felk.cvut.cz>
+ *
+ * Faculty of Electrical Engineering (http://www.fel.cvut.cz)
+ * Czech Technical University        (http://www.cvut.cz/)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+#include "memory/cache/cache_sweep.h"
+
+#include "memorytrace.h"
+
+#include <QRunnable>
+#include <QThreadPool>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <exception>
+#include <map>
+
+namespace machine {
+
+/**
+ * Backing memory of caches evaluated by the sweep, only timing matters.
+ */
+class CacheSweep::NullMemory final : public FrontendMemory {
+public:
+    NullMemory() : FrontendMemory(NATIVE_ENDIAN) {}
+
+    WriteResult write(Address, const void *, size_t size, WriteOptions) override {
+        return { .n_bytes = size, .changed = false };
+    }
+
+    ReadResult read(void *destination, Address, size_t size, ReadOptions) const override {
+        memset(destination, 0, size);
+        return { .n_bytes = size };
+    }
+
+    uint32_t get_change_counter() const override { return 0; }
+};
+
+/**
+ * LRU stacks of all sets for one set count and block size.
+ *
+ * Block at depth d of its set stack is present in every cache with
+ * associativity above d. When a block is moved from depth k to k + 1, it is
+ * evicted from cache with associativity k + 1. Dirty state differs between
+ * associativities, block is clean in caches with associativity up to
+ * `clean_upto` (read reloads it in caches where it missed) and dirty in larger
+ * ones after a write.
+ */
+struct CacheSweep::LruStack {
+    struct Entry {
+        uint64_t tag;
+        uint32_t clean_upto;
+    };
+    static constexpr uint32_t CLEAN = UINT32_MAX;
+
+    const unsigned set_count, block_size, max_associativity;
+    std::vector<std::vector<Entry>> sets;
+    // Hits by stack depth
+    std::vector<uint32_t> read_hits, write_hits;
+    // Evictions of dirty blocks by associativity
+    std::vector<uint32_t> write_backs;
+    uint32_t reads = 0, writes = 0;
+
+    LruStack(unsigned set_count, unsigned block_size, unsigned max_associativity)
+        : set_count(set_count)
+        , block_size(block_size)
+        , max_associativity(max_associativity)
+        , sets(set_count)
+        , read_hits(max_associativity)
+        , write_hits(max_associativity)
+        , write_backs(max_associativity + 1) {}
+
+    void evict(const Entry &entry, size_t associativity) {
+        if (associativity > entry.clean_upto) {
+            write_backs[associativity]++;
+        }
+    }
+
+    void access_block(uint64_t row, uint64_t tag, AccessType type) {
+        std::vector<Entry> &set = sets[row];
+        size_t depth = 0;
+        while (depth < set.size() && set[depth].tag != tag) {
+            depth++;
+        }
+        const bool hit = depth < set.size();
+        if (!hit && set.size() == max_associativity) {
+            evict(set.back(), max_associativity);
+            set.pop_back();
+        }
+        // Blocks above the accessed one move one level down
+        for (size_t k = 0; k < std::min(depth, set.size()); k++) {
+            evict(set[k], k + 1);
+        }
+        if (hit) {
+            std::rotate(set.begin(), set.begin() + depth, set.begin() + depth + 1);
+        } else {
+            set.insert(set.begin(), { .tag = tag, .clean_upto = CLEAN });
+        }
+
+        if (type == WRITE) {
+            writes++;
+            if (hit) {
+                write_hits[depth]++;
+            }
+            set[0].clean_upto = 0;
+        } else {
+            reads++;
+            if (hit) {
+                read_hits[depth]++;
+                if (set[0].clean_upto != CLEAN) {
+                    set[0].clean_upto = std::max(set[0].clean_upto, (uint32_t)depth);
+                }
+            } else {
+                set[0].clean_upto = CLEAN;
+            }
+        }
+    }
+
+    // Splits access to blocks the same way as `Cache`
+    void access(Address address, size_t size, AccessType type) {
+        uint64_t raw = address.get_raw();
+        while (size > 0) {
+            uint64_t word_index = raw / BLOCK_ITEM_SIZE;
+            uint64_t way_size_words = (uint64_t)set_count * block_size;
+            uint64_t index_in_way = word_index % way_size_words;
+            uint64_t in_block
+                = (index_in_way % block_size) * BLOCK_ITEM_SIZE + raw % BLOCK_ITEM_SIZE;
+            size_t within_block = std::min(size, block_size * BLOCK_ITEM_SIZE - in_block);
+            access_block(index_in_way / block_size, word_index / way_size_words, type);
+            raw += within_block;
+            size -= within_block;
+        }
+    }
+};
+
+CacheSweep::CacheSweep(
+    const std::vector<CacheConfig> &configs,
+    uint32_t memory_access_penalty_r,
+    uint32_t memory_access_penalty_w,
+    uint32_t memory_access_penalty_b)
+    : configs(configs)
+    , access_pen_r(memory_access_penalty_r)
+    , access_pen_w(memory_access_penalty_w)
+    , access_pen_b(memory_access_penalty_b)
+    , null_memory(new NullMemory()) {
+    std::map<std::pair<unsigned, unsigned>, unsigned> max_associativity;
+    for (CacheConfig &config : this->configs) {
+        config.set_enabled(true);
+        if (stack_distance_capable(config)) {
+            unsigned &assoc = max_associativity[{ config.set_count(), config.block_size() }];
+            assoc = std::max(assoc, config.associativity());
+        }
+    }
+    std::map<std::pair<unsigned, unsigned>, size_t> stack_index;
+    for (auto &item : max_associativity) {
+        stack_index[item.first] = stacks.size();
+        stacks.emplace_back(new LruStack(item.first.first, item.first.second, item.second));
+    }
+    for (const CacheConfig &config : this->configs) {
+        if (stack_distance_capable(config)) {
+            model_index.push_back(stack_index[{ config.set_count(), config.block_size() }]);
+        } else {
+            model_index.push_back(caches.size());
+            caches.emplace_back(new Cache(
+                null_memory.get(), &config, access_pen_r, access_pen_w, access_pen_b));
+        }
+    }
+}
+
+CacheSweep::~CacheSweep() = default;
+
+bool CacheSweep::stack_distance_capable(const CacheConfig &config) {
+    return config.replacement_policy() == CacheConfig::RP_LRU
+           && config.write_policy() != CacheConfig::WP_THROUGH_NOALLOC;
+}
+
+void CacheSweep::cache_access(Address address, size_t size, AccessType type) {
+    uint64_t buffer[2] = {};
+    for (auto &cache : caches) {
+        for (size_t offset = 0; offset < size; offset += sizeof(buffer)) {
+            size_t chunk = std::min(size - offset, sizeof(buffer));
+            if (type == WRITE) {
+                cache->write(address + offset, buffer, chunk, { .type = ae::REGULAR });
+            } else {
+                cache->read(buffer, address + offset, chunk, { .type = ae::REGULAR });
+            }
+        }
+    }
+    if (Cache::is_in_uncached_area(address) || Cache::is_in_uncached_area(address + size)) {
+        if (type == WRITE) {
+            uncached_writes++;
+        } else {
+            uncached_reads++;
+        }
+        return;
+    }
+    if (type == WRITE) {
+        cached_writes++;
+    }
+    for (auto &stack : stacks) {
+        stack->access(address, size, type);
+    }
+}
+
+void CacheSweep::replay(MemoryTraceReader &trace, bool program) {
+    MemoryTraceRecord rec;
+    while (trace.next(rec)) {
+        if ((rec.kind == MTK_FETCH) == program) {
+            cache_access(rec.address, rec.size, rec.kind == MTK_STORE ? WRITE : READ);
+        }
+    }
+}
+
+std::vector<CacheSweep::Result> CacheSweep::results() const {
+    std::vector<Result> res;
+    for (size_t i = 0; i < configs.size(); i++) {
+        const CacheConfig &config = configs[i];
+        CacheStatistics st;
+        if (stack_distance_capable(config)) {
+            const LruStack &stack = *stacks[model_index[i]];
+            const unsigned block = config.block_size();
+            for (size_t depth = 0; depth < config.associativity(); depth++) {
+                st.hit_read += stack.read_hits[depth];
+                st.hit_write += stack.write_hits[depth];
+            }
+            st.miss_read = stack.reads - st.hit_read;
+            st.miss_write = stack.writes - st.hit_write;
+            st.mem_reads = (st.miss_read + st.miss_write) * block + uncached_reads;
+            st.burst_reads = (st.miss_read + st.miss_write) * (block - 1);
+            if (config.write_policy() == CacheConfig::WP_BACK) {
+                uint32_t write_backs = stack.write_backs[config.associativity()];
+                st.mem_writes = write_backs * block + uncached_writes;
+                st.burst_writes = write_backs * (block - 1);
+            } else {
+                st.mem_writes = cached_writes + uncached_writes;
+            }
+        } else {
+            st = caches[model_index[i]]->get_statistics();
+        }
+        res.push_back(
+            { .config = config,
+              .statistics = st,
+              .stall_count = st.stall_count(config, access_pen_r, access_pen_w, access_pen_b),
+              .speed_improvement
+              = st.speed_improvement(config, access_pen_r, access_pen_w, access_pen_b),
+              .hit_rate = st.hit_rate() });
+    }
+    return res;
+}
+
+namespace {
+
+class SweepReplay final : public QRunnable {
+public:
+    SweepReplay(
+        const std::vector<CacheConfig> &configs,
+        const QString &trace_path,
+        bool program,
+        uint32_t pen_r,
+        uint32_t pen_w,
+        uint32_t pen_b)
+        : sweep(configs, pen_r, pen_w, pen_b)
+        , trace(trace_path)
+        , program(program) {
+        setAutoDelete(false);
+    }
+
+    void run() override {
+        // Exception escaping QRunnable::run would abort the process
+        try {
+            sweep.replay(trace, program);
+        } catch (...) {
+            error = std::current_exception();
+        }
+    }
+
+    CacheSweep sweep;
+    std::exception_ptr error;
+
+private:
+    MemoryTraceReader trace;
+    const bool program;
+};
+
+} // namespace
+
+std::vector<CacheSweep::Result> CacheSweep::replay_parallel(
+    const std::vector<CacheConfig> &configs,
+    const QString &trace_path,
+    bool program,
+    int threads,
+    uint32_t memory_access_penalty_r,
+    uint32_t memory_access_penalty_w,
+    uint32_t memory_access_penalty_b) {
+    // Configurations sharing LRU stacks form one unit of work
+    std::vector<std::vector<size_t>> units;
+    std::map<std::pair<unsigned, unsigned>, size_t> stack_unit;
+    for (size_t i = 0; i < configs.size(); i++) {
+        if (stack_distance_capable(configs[i])) {
+            auto key = std::make_pair(configs[i].set_count(), configs[i].block_size());
+            auto it = stack_unit.find(key);
+            if (it != stack_unit.end()) {
+                units[it->second].push_back(i);
+                continue;
+            }
+            stack_unit[key] = units.size();
+        }
+        units.push_back({ i });
+    }
+
+    threads = std::max(1, std::min(threads, (int)units.size()));
+    std::vector<std::vector<size_t>> parts(threads);
+    for (size_t u = 0; u < units.size(); u++) {
+        auto &part = parts[u % threads];
+        part.insert(part.end(), units[u].begin(), units[u].end());
+    }
+
+    // Trace files are opened (and checked) before any thread starts
+    std::vector<std::unique_ptr<SweepReplay>> jobs;
+    for (const auto &part : parts) {
+        std::vector<CacheConfig> part_configs;
+        for (size_t i : part) {
+            part_configs.push_back(configs[i]);
+        }
+        jobs.emplace_back(new SweepReplay(
+            part_configs, trace_path, program, memory_access_penalty_r,
+            memory_access_penalty_w, memory_access_penalty_b));
+    }
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+    for (auto &job : jobs) {
+        pool.start(job.get());
+    }
+    pool.waitForDone();
+    for (const auto &job : jobs) {
+        if (job->error) {
+            std::rethrow_exception(job->error);
+        }
+    }
+
+    std::vector<Result> res(configs.size());
+    for (size_t p = 0; p < parts.size(); p++) {
+        std::vector<Result> part_res = jobs[p]->sweep.results();
+        for (size_t i = 0; i < parts[p].size(); i++) {
+            res[parts[p][i]] = part_res[i];
+        }
+    }
+    return res;
+}
+
+} // namespace machine
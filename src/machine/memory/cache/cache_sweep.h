@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*******************************************************************************
+ * QtMips - MIPS 32-bit Architecture Subset Simulator
+ *
+ * Implemented to support following courses:
+ *
+ *   B35APO - Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b35apo
+ *
+ *   B4M35PAP - Advanced Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b4m35pap/start
+ *
+ * Copyright (c) 2017-2019 Karel Koci<cynerd@email.cz>
+ * Copyright (c) 2019      Pavel Pisa <pisa@cmp.felk.cvut.cz>
+ *
+ * Faculty of Electrical Engineering (http://www.fel.cvut.cz)
+ * Czech Technical University        (http://www.cvut.cz/)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+#ifndef CACHE_SWEEP_H
+#define CACHE_SWEEP_H
+
+#include "machineconfig.h"
+#include "memory/cache/cache.h"
+#include "memory/cache/cache_types.h"
+
+#include <QString>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace machine {
+
+class MemoryTraceReader;
+
+/**
+ * Evaluates many cache configurations over single access stream.
+ *
+ * Accesses are fed either online (set as access sink of the simulated cache)
+ * or from a trace recorded by `MemoryTraceWriter`. Configurations with LRU replacement and
+ * allocation on write (write back or write through with allocation) sharing
+ * set count and block size are evaluated together by stack distance
+ * algorithm: every set keeps blocks in LRU order and depth of the hit decides
+ * hit or miss for all associativities at once. Remaining configurations are
+ * simulated by their own `Cache` instance without data backing.
+ *
+ * Results are the same as if the program would be run once for each
+ * configuration.
+ */
+class CacheSweep final : public CacheAccessSink {
+public:
+    /**
+     * Configurations are evaluated as enabled, penalties have the same meaning
+     * as for `Cache`.
+     */
+    explicit CacheSweep(
+        const std::vector<CacheConfig> &configs,
+        uint32_t memory_access_penalty_r = 1,
+        uint32_t memory_access_penalty_w = 1,
+        uint32_t memory_access_penalty_b = 0);
+    ~CacheSweep() override;
+
+    void cache_access(Address address, size_t size, AccessType type) override;
+    // Feeds instruction fetches (program) or loads and stores of the trace
+    void replay(MemoryTraceReader &trace, bool program);
+
+    struct Result {
+        CacheConfig config;
+        CacheStatistics statistics;
+        uint32_t stall_count;
+        double speed_improvement;
+        double hit_rate;
+    };
+    // Results in order of configurations passed to constructor
+    std::vector<Result> results() const;
+
+    /**
+     * Replays the memory trace file with configurations spread over given
+     * number of threads, each thread reads the file on its own.
+     * Configurations evaluated together by the stack distance algorithm are
+     * kept in one thread.
+     */
+    static std::vector<Result> replay_parallel(
+        const std::vector<CacheConfig> &configs,
+        const QString &trace_path,
+        bool program,
+        int threads,
+        uint32_t memory_access_penalty_r = 1,
+        uint32_t memory_access_penalty_w = 1,
+        uint32_t memory_access_penalty_b = 0);
+
+    // Configuration can be evaluated by stack distance algorithm
+    static bool stack_distance_capable(const CacheConfig &config);
+
+private:
+    struct LruStack;
+    class NullMemory;
+
+    std::vector<CacheConfig> configs;
+    const uint32_t access_pen_r, access_pen_w, access_pen_b;
+    std::unique_ptr<NullMemory> null_memory;
+    std::vector<std::unique_ptr<LruStack>> stacks;
+    std::vector<std::unique_ptr<Cache>> caches;
+    // For each configuration index into stacks or into caches
+    std::vector<size_t> model_index;
+    // Accesses to uncached area and write requests (for write through)
+    uint32_t uncached_reads = 0, uncached_writes = 0, cached_writes = 0;
+};
+
+} // namespace machine
+
+#endif // CACHE_SWEEP_H
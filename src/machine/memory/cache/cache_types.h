@@ -39,6 +39,7 @@
 #define CACHE_TYPES_H
 
 #include <cstdint>
+#include <vector>
 
 namespace machine {
 
@@ -54,11 +55,19 @@ struct CacheLocation {
 };
 
 /**
- * Single cache line. Appropriate cache block is stored in `data`.
+ * Content of all cache lines, line of `way` in `row` has index
+ * `row * associativity + way`. Tags of all ways of a set are next to each
+ * other so the lookup touches as little host memory as possible. Invalid
+ * line has tag `INVALID_TAG` which never matches any address. Blocks are
+ * stored in `data` in the same order, `block_size` words each. Lines loaded
+ * by prefetcher are marked in `prefetched` until their first demand access.
  */
-struct CacheLine {
-    bool valid, dirty;
-    uint64_t tag;
+struct CacheStorage {
+    static constexpr uint64_t INVALID_TAG = UINT64_MAX;
+
+    std::vector<uint64_t> tags;
+    std::vector<uint8_t> dirty;
+    std::vector<uint8_t> prefetched;
     std::vector<uint32_t> data;
 };
 
@@ -141,6 +141,20 @@ FrontendMemory::read_ctl(enum AccessControl ctl, Address address) const {
 
 void FrontendMemory::sync() {}
 
+byte *FrontendMemory::direct_access(Address address, size_t size) {
+    (void)address;
+    (void)size;
+    return nullptr;
+}
+
+const byte *FrontendMemory::direct_read(Address address, size_t size) const {
+    (void)address;
+    (void)size;
+    return nullptr;
+}
+
+void FrontendMemory::direct_write_done() {}
+
 LocationStatus FrontendMemory::location_status(Address address) const {
     (void)address;
     return LOCSTAT_NONE;
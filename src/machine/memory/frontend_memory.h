@@ -125,6 +125,39 @@ public:
     virtual LocationStatus location_status(Address address) const;
     virtual uint32_t get_change_counter() const = 0;
 
+    /**
+     * Host pointer to plain memory backing given address range.
+     *
+     * Data are stored in the simulated machine endian. Pointer stays valid
+     * until the backing memory is reset or reallocated, therefore users
+     * have to keep it only for a short time. Access through the pointer
+     * bypasses all side effects of the access (caches, statistics), after
+     * write the direct_write_done() has to be called.
+     *
+     * @param address   emulated address of first byte of the range
+     * @param size      length of the range
+     * @return          nullptr if the range is not backed by plain memory
+     *                  as a whole (e.g. it is a peripheral or it is
+     *                  processed by an enabled cache)
+     */
+    virtual byte *direct_access(Address address, size_t size);
+
+    /**
+     * Read only host pointer to plain memory backing given address range.
+     *
+     * Unlike direct_access() the memory shared with snapshots or other
+     * machines is not copied, therefore the pointer is valid only until
+     * the next write to the memory (any access when cache is enabled).
+     *
+     * @see direct_access
+     */
+    virtual const byte *direct_read(Address address, size_t size) const;
+
+    /**
+     * Account writes done through pointer provided by direct_access().
+     */
+    virtual void direct_write_done();
+
     /**
      * Write byte sequence to memory
      *
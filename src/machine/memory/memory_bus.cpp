@@ -38,12 +38,23 @@
 #include "common/endian.h"
 #include "memory/memory_utils.h"
 
+#include <algorithm>
+#include <cstring>
+
 using namespace machine;
 
 MemoryDataBus::MemoryDataBus(Endian simulated_endian)
-    : FrontendMemory(simulated_endian) {};
+    : FrontendMemory(simulated_endian) {
+    for (auto &chunk : chunks) {
+        chunk = { .whole = { .range = nullptr, .host = nullptr, .mixed = false },
+                  .pages = nullptr };
+    }
+};
 
 MemoryDataBus::~MemoryDataBus() {
+    for (auto &chunk : chunks) {
+        delete[] chunk.pages;
+    }
     ranges_by_addr.clear(); // No stored values are owned.
     auto iter = ranges_by_device.begin();
     while (iter != ranges_by_device.end()) {
@@ -72,6 +83,18 @@ WriteResult MemoryDataBus::write_single(
     const void *source,
     size_t size,
     WriteOptions options) {
+    size_t offset, area_size;
+    const PageDesc *area = lookup_area(destination, offset, area_size);
+    if (area != nullptr && area->host != nullptr && offset + size <= area_size) {
+        // Plain memory, same semantic as its write without virtual dispatch
+        byte *dst = area->host + offset;
+        if (memcmp(dst, source, size) == 0) {
+            return { .n_bytes = size, .changed = false };
+        }
+        memcpy(dst, source, size);
+        change_counter++;
+        return { .n_bytes = size, .changed = true };
+    }
     const RangeDesc *range = find_range(Address(destination));
     if (range == nullptr) {
         // Write to unused address range - no devices it present.
@@ -79,6 +102,12 @@ WriteResult MemoryDataBus::write_single(
         // just ignore the write.
         return (WriteResult) { .n_bytes = 0, .changed = false };
     }
+    if (peripheral_log != nullptr && peripheral_log->replaying
+        && range->device != peripheral_log_ram && options.type == ae::REGULAR) {
+        // Peripherals are not returned to the past, the write is done already
+        size_t n_bytes = std::min<uint64_t>(size, range->last_addr - destination + 1);
+        return { .n_bytes = n_bytes, .changed = false };
+    }
     WriteResult result = range->device->write(
         destination - range->start_addr, source, size, options);
 
@@ -105,6 +134,12 @@ ReadResult MemoryDataBus::read_single(
     Address source,
     size_t size,
     ReadOptions options) const {
+    size_t offset, area_size;
+    const PageDesc *area = lookup_area(source, offset, area_size);
+    if (area != nullptr && area->host != nullptr && offset + size <= area_size) {
+        memcpy(destination, area->host + offset, size);
+        return { .n_bytes = size };
+    }
     const RangeDesc *p_range = find_range(Address(source));
     if (p_range == nullptr) {
         // Write to unused address range, no devices it present.
@@ -113,6 +148,22 @@ ReadResult MemoryDataBus::read_single(
         memset(destination, 0, size);
         return (ReadResult) { .n_bytes = size };
     }
+    if (peripheral_log != nullptr && p_range->device != peripheral_log_ram
+        && options.type == ae::REGULAR) {
+        if (peripheral_log->replaying) {
+            size_t n_bytes = peripheral_log->replay(destination, size);
+            if (n_bytes == 0) {
+                throw SIMULATOR_EXCEPTION(
+                    Runtime, "Reverse execution diverged from recorded peripheral reads",
+                    QString("address 0x%1").arg(source.get_raw(), 8, 16, QChar('0')));
+            }
+            return { .n_bytes = n_bytes };
+        }
+        ReadResult result = p_range->device->read(
+            destination, source - p_range->start_addr, size, options);
+        peripheral_log->record(destination, result.n_bytes);
+        return result;
+    }
 
     return p_range->device->read(
         destination, source - p_range->start_addr, size, options);
@@ -130,8 +181,70 @@ enum LocationStatus MemoryDataBus::location_status(Address address) const {
     return range->device->location_status(address - range->start_addr);
 }
 
+byte *MemoryDataBus::direct_access(Address address, size_t size) {
+    size_t offset, area_size;
+    const PageDesc *area = lookup_area(address, offset, area_size);
+    if (area != nullptr && area->host != nullptr && offset + size <= area_size) {
+        return area->host + offset;
+    }
+    const RangeDesc *range = find_range(address);
+    if (range == nullptr || size == 0 || address + (size - 1) > range->last_addr) {
+        return nullptr;
+    }
+    return range->device->direct_access(address - range->start_addr, size);
+}
+
+const byte *MemoryDataBus::direct_read(Address address, size_t size) const {
+    size_t offset, area_size;
+    const PageDesc *area = lookup_area(address, offset, area_size);
+    if (area != nullptr && area->host != nullptr && offset + size <= area_size) {
+        return area->host + offset;
+    }
+    const RangeDesc *range = find_range(address);
+    if (range == nullptr || size == 0 || address + (size - 1) > range->last_addr) {
+        return nullptr;
+    }
+    return range->device->direct_read(address - range->start_addr, size);
+}
+
+void MemoryDataBus::direct_write_done() {
+    change_counter++;
+}
+
+void MemoryDataBus::set_peripheral_log(PeripheralLog *log, const BackendMemory *ram) {
+    peripheral_log = log;
+    peripheral_log_ram = ram;
+}
+
+inline const MemoryDataBus::PageDesc *
+MemoryDataBus::lookup_area(Address address, size_t &offset, size_t &size) const {
+    uint64_t addr = address.get_raw();
+    if ((addr >> 32) != 0) {
+        return nullptr;
+    }
+    const ChunkDesc &chunk = chunks[addr >> BUS_CHUNK_BITS];
+    if (chunk.pages == nullptr) {
+        offset = addr & (BUS_CHUNK_SIZE - 1);
+        size = BUS_CHUNK_SIZE;
+        return &chunk.whole;
+    }
+    offset = addr & (BUS_PAGE_SIZE - 1);
+    size = BUS_PAGE_SIZE;
+    return &chunk.pages[(addr >> BUS_PAGE_BITS) & (BUS_CHUNK_PAGES - 1)];
+}
+
 const MemoryDataBus::RangeDesc *
 MemoryDataBus::find_range(Address address) const {
+    size_t offset, size;
+    const PageDesc *area = lookup_area(address, offset, size);
+    if (area != nullptr && !area->mixed) {
+        return area->range;
+    }
+    return search_range(address);
+}
+
+const MemoryDataBus::RangeDesc *
+MemoryDataBus::search_range(Address address) const {
     // lowerBound finds range what has highest key (which is range->last_addr)
     // less then or equal to address.
     // See comment in insert_device_to_range for description, why this works.
@@ -172,6 +285,7 @@ bool MemoryDataBus::insert_device_to_range(
     // searched address for case that range is not present.
     ranges_by_addr.insert(last_addr, range);
     ranges_by_device.insert(device, range);
+    update_lookup_table(start_addr, last_addr);
     connect(
         device, &BackendMemory::external_backend_change_notify, this,
         &MemoryDataBus::range_backend_external_change);
@@ -185,6 +299,7 @@ bool MemoryDataBus::remove_device(BackendMemory *device) {
     }
 
     ranges_by_addr.remove(range->last_addr);
+    update_lookup_table(range->start_addr, range->last_addr);
     if (range->owns_device) {
         delete range->device;
     }
@@ -194,13 +309,49 @@ bool MemoryDataBus::remove_device(BackendMemory *device) {
 }
 
 void MemoryDataBus::clean_range(Address start_addr, Address last_addr) {
-    for (auto iter = ranges_by_addr.lowerBound(start_addr);
-         iter != ranges_by_addr.end(); iter++) {
-        const RangeDesc *range = iter.value();
-        if (range->start_addr <= last_addr) {
-            remove_device(range->device);
-        } else {
-            break;
+    // Removal invalidates iterators, search again after each one.
+    auto iter = ranges_by_addr.lowerBound(start_addr);
+    while (iter != ranges_by_addr.end() && iter.value()->start_addr <= last_addr) {
+        remove_device(iter.value()->device);
+        iter = ranges_by_addr.lowerBound(start_addr);
+    }
+}
+
+MemoryDataBus::PageDesc
+MemoryDataBus::describe_area(Address start_addr, Address last_addr) const {
+    auto iter = ranges_by_addr.lowerBound(start_addr);
+    if (iter == ranges_by_addr.end() || iter.value()->start_addr > last_addr) {
+        return { .range = nullptr, .host = nullptr, .mixed = false };
+    }
+    const RangeDesc *range = iter.value();
+    if (range->start_addr <= start_addr && range->last_addr >= last_addr) {
+        byte *host = range->device->direct_access(
+            start_addr - range->start_addr, last_addr - start_addr + 1);
+        return { .range = range, .host = host, .mixed = false };
+    }
+    return { .range = nullptr, .host = nullptr, .mixed = true };
+}
+
+void MemoryDataBus::update_lookup_table(Address start_addr, Address last_addr) {
+    if (start_addr.get_raw() > 0xffffffff) {
+        return;
+    }
+    uint64_t last = std::min(last_addr.get_raw(), (uint64_t)0xffffffff);
+    for (uint64_t c = start_addr.get_raw() >> BUS_CHUNK_BITS; c <= last >> BUS_CHUNK_BITS; c++) {
+        ChunkDesc &chunk = chunks[c];
+        Address chunk_start(c << BUS_CHUNK_BITS);
+        chunk.whole = describe_area(chunk_start, chunk_start + (BUS_CHUNK_SIZE - 1));
+        if (!chunk.whole.mixed) {
+            delete[] chunk.pages;
+            chunk.pages = nullptr;
+            continue;
+        }
+        if (chunk.pages == nullptr) {
+            chunk.pages = new PageDesc[BUS_CHUNK_PAGES];
+        }
+        for (size_t p = 0; p < BUS_CHUNK_PAGES; p++) {
+            Address page_start = chunk_start + p * BUS_PAGE_SIZE;
+            chunk.pages[p] = describe_area(page_start, page_start + (BUS_PAGE_SIZE - 1));
         }
     }
 }
@@ -266,3 +417,113 @@ ReadResult TrivialBus::read(
 uint32_t TrivialBus::get_change_counter() const {
     return change_counter;
 }
+
+byte *TrivialBus::direct_access(Address address, size_t size) {
+    return device->direct_access(address.get_raw(), size);
+}
+
+const byte *TrivialBus::direct_read(Address address, size_t size) const {
+    return device->direct_read(address.get_raw(), size);
+}
+
+void TrivialBus::direct_write_done() {
+    change_counter += 1;
+}
+
+uint64_t PeripheralLog::position() const {
+    return pos;
+}
+
+void PeripheralLog::seek(uint64_t position) {
+    // The first entry starting after the position, position past the end
+    // of the log is moved to its end
+    auto it = std::upper_bound(
+        entries.begin(), entries.end(), position,
+        [](uint64_t p, const Entry &e) { return p < e.first; });
+    pos_entry = it - entries.begin();
+    if (pos_entry > 0) {
+        const Entry &e = entries[pos_entry - 1];
+        if (position < e.first + e.count) {
+            pos_entry--;
+        } else {
+            position = e.first + e.count;
+        }
+    } else {
+        position = start;
+    }
+    pos = position;
+}
+
+void PeripheralLog::truncate() {
+    if (pos_entry >= entries.size()) {
+        return;
+    }
+    Entry &e = entries[pos_entry];
+    if (pos > e.first) {
+        e.count = pos - e.first;
+        pos_entry++;
+    }
+    if (pos_entry < entries.size()) {
+        data.resize(entries[pos_entry].data);
+        entries.resize(pos_entry);
+    }
+}
+
+void PeripheralLog::discard(uint64_t position) {
+    // Entry containing the position is kept whole
+    size_t count = 0;
+    while (count < entries.size() && entries[count].first + entries[count].count <= position) {
+        count++;
+    }
+    if (count > 0) {
+        size_t offset = count < entries.size() ? entries[count].data : data.size();
+        data.erase(data.begin(), data.begin() + offset);
+        entries.erase(entries.begin(), entries.begin() + count);
+        for (Entry &e : entries) {
+            e.data -= offset;
+        }
+        pos_entry -= std::min(pos_entry, count);
+    }
+    start = std::max(start, position);
+}
+
+void PeripheralLog::clear() {
+    entries.clear();
+    data.clear();
+    start = 0;
+    pos = 0;
+    pos_entry = 0;
+}
+
+void PeripheralLog::record(const void *value, size_t size) {
+    if (size == 0) {
+        return;
+    }
+    truncate();
+    pos++;
+    pos_entry = entries.size();
+    if (!entries.empty()) {
+        Entry &last = entries.back();
+        if (last.size == size && last.count < UINT32_MAX
+            && memcmp(&data[last.data], value, size) == 0) {
+            last.count++;
+            return;
+        }
+    }
+    entries.push_back({ .first = pos - 1, .count = 1, .size = (uint32_t)size, .data = data.size() });
+    data.insert(data.end(), (const byte *)value, (const byte *)value + size);
+    pos_entry = entries.size();
+}
+
+size_t PeripheralLog::replay(void *value, size_t size) {
+    if (pos_entry >= entries.size() || entries[pos_entry].size > size) {
+        return 0;
+    }
+    const Entry &e = entries[pos_entry];
+    memcpy(value, &data[e.data], e.size);
+    pos++;
+    if (pos == e.first + e.count) {
+        pos_entry++;
+    }
+    return e.size;
+}
@@ -46,9 +46,65 @@
 #include <QMultiMap>
 #include <QObject>
 #include <cstdint>
+#include <vector>
 
 namespace machine {
 
+// Granularity of address to device lookup table (2^12=4 KiB)
+constexpr size_t BUS_PAGE_BITS = 12;
+// Lookup table first level covers chunks of address space (2^22=4 MiB)
+constexpr size_t BUS_CHUNK_BITS = 22;
+constexpr size_t BUS_PAGE_SIZE = (1u << BUS_PAGE_BITS);
+constexpr size_t BUS_CHUNK_SIZE = (1u << BUS_CHUNK_BITS);
+constexpr size_t BUS_CHUNK_COUNT = (1u << (32 - BUS_CHUNK_BITS));
+constexpr size_t BUS_CHUNK_PAGES = (1u << (BUS_CHUNK_BITS - BUS_PAGE_BITS));
+
+/**
+ * Values read from peripherals by the simulated program, in order of reads.
+ *
+ * Reverse execution repeats execution from a snapshot of the machine state.
+ * Peripherals are not part of the snapshot, therefore they are not accessed
+ * again: the recorded values are returned and writes are dropped while the
+ * log is replaying. Repeated reads of the same value (status register
+ * polling) share single entry.
+ */
+class PeripheralLog {
+public:
+    // Number of reads recorded (or replayed) so far
+    uint64_t position() const;
+    // Continue replay (or recording) from given position
+    void seek(uint64_t position);
+    // Discard reads after the current position
+    void truncate();
+    // Discard reads before given position, they cannot be replayed anymore
+    void discard(uint64_t position);
+    void clear();
+
+    void record(const void *data, size_t size);
+    /**
+     * Copy next recorded read.
+     *
+     * @return  size of recorded read, zero when there is none or when it is
+     *          larger than requested size (the replay has diverged)
+     */
+    size_t replay(void *data, size_t size);
+
+    bool replaying = false;
+
+private:
+    struct Entry {
+        uint64_t first; // Position of the first read of the entry
+        uint32_t count; // Number of reads of the same value
+        uint32_t size;
+        size_t data; // Offset of the value in data
+    };
+    std::vector<Entry> entries;
+    std::vector<byte> data;
+    uint64_t start = 0; // Position of the first read kept
+    uint64_t pos = 0;
+    size_t pos_entry = 0; // Entry containing the position (or end)
+};
+
 /**
  * Memory bus serves as last level of frontend memory and interconnects it with
  * backend memory devices, that are subscribed to given address range.
@@ -146,6 +202,20 @@ public:
 
     enum LocationStatus location_status(Address address) const override;
 
+    byte *direct_access(Address address, size_t size) override;
+    const byte *direct_read(Address address, size_t size) const override;
+    void direct_write_done() override;
+
+    /**
+     * Record regular reads of devices other than RAM to the log or serve
+     * them from it when the log is replaying. Writes to the devices are
+     * dropped while replaying.
+     *
+     * @param log   log owned by caller, nullptr disables logging
+     * @param ram   device which is not logged (part of machine state)
+     */
+    void set_peripheral_log(PeripheralLog *log, const BackendMemory *ram);
+
 private slots:
     /**
      * Receive external changes in underlying memory devices.
@@ -165,6 +235,43 @@ private:
      */
     QMap<Address, const RangeDesc *> ranges_by_addr;
     mutable uint32_t change_counter = 0;
+    PeripheralLog *peripheral_log = nullptr;
+    const BackendMemory *peripheral_log_ram = nullptr;
+
+    /**
+     * Lookup table entry describing whole chunk or page of address space.
+     */
+    struct PageDesc {
+        // Range covering whole area, nullptr if there is none
+        const RangeDesc *range;
+        // Host memory of start of the area for plain memory devices
+        byte *host;
+        // Area is covered only partially or by more ranges, search map
+        bool mixed;
+    };
+    struct ChunkDesc {
+        PageDesc whole; // Valid when pages are not allocated
+        PageDesc *pages;
+    };
+    /*
+     * Two level lookup table of ranges for 32-bit address space. Chunks
+     * covered by single range (or empty) do not allocate the second level.
+     */
+    ChunkDesc chunks[BUS_CHUNK_COUNT];
+
+    /**
+     * Rebuild lookup table entries overlapping with given address range.
+     */
+    void update_lookup_table(Address start_addr, Address last_addr);
+    PageDesc describe_area(Address start_addr, Address last_addr) const;
+    /**
+     * Lookup table entry for given address.
+     *
+     * @param offset    filled with offset of the address within the area
+     * @param size      filled with size of the area
+     * @return          nullptr for address outside 32-bit space
+     */
+    inline const PageDesc *lookup_area(Address address, size_t &offset, size_t &size) const;
 
     /**
      * Helper to write into single range. Used by `write`.
@@ -197,6 +304,10 @@ private:
      * Get range (or nullptr) for arbitrary address (not just start or last).
      */
     const MemoryDataBus::RangeDesc *find_range(Address address) const;
+    /**
+     * Search of range map, used for areas shared by more ranges.
+     */
+    const MemoryDataBus::RangeDesc *search_range(Address address) const;
 };
 
 /**
@@ -253,6 +364,10 @@ public:
 
     uint32_t get_change_counter() const override;
 
+    byte *direct_access(Address address, size_t size) override;
+    const byte *direct_read(Address address, size_t size) const override;
+    void direct_write_done() override;
+
 private:
     BackendMemory *const device;
     mutable uint32_t change_counter = 0;
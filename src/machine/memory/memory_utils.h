@@ -67,6 +67,8 @@ enum class AccessEffects {
  */
 struct ReadOptions {
     AccessEffects type;
+    // Whole block is loaded by a cache of the inner level
+    bool cache_fill = false;
 };
 
 /**
@@ -77,6 +79,8 @@ struct ReadOptions {
  */
 struct WriteOptions {
     AccessEffects type;
+    // Block is evicted from a cache of the inner level
+    bool cache_eviction = false;
 };
 
 struct ReadResult {
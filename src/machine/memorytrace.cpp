@@ -0,0 +1,230 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*******************************************************************************
+ * QtMips - MIPS 32-bit Architecture Subset Simulator
+ *
+ * Implemented to support following courses:
+ *
+ *   B35APO - Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b35apo
+ *
+ *   B4M35PAP - Advanced Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b4m35pap/start
+ *
+ * Copyright (c) 2017-2019 Karel Koci<cynerd@email.cz>
+ * Copyright (c) 2019      Pavel Pisa <pisa@cmp.felk.cvut.cz>
+ *
+ * Faculty of Electrical Engineering (http://www.fel.cvut.cz)
+ * Czech Technical University        (http://www.cvut.cz/)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+#include "memorytrace.h"
+
+#include <cstring>
+
+namespace machine {
+
+constexpr char MemoryTraceWriter::MAGIC[8];
+
+// Records are written in blocks of this size
+constexpr size_t TRACE_BUFFER_SIZE = 64 * 1024;
+// Size is encoded in header as log2, this code means explicit varint size
+constexpr uint8_t TRACE_SIZE_EXPLICIT = 7;
+
+static uint64_t zigzag_encode(uint64_t delta) {
+    return (delta << 1) ^ (uint64_t)((int64_t)delta >> 63);
+}
+
+static uint64_t zigzag_decode(uint64_t value) {
+    return (value >> 1) ^ (~(value & 1) + 1);
+}
+
+MemoryTraceWriter::Sink::Sink(MemoryTraceWriter *writer, bool program)
+    : writer(writer)
+    , program(program) {}
+
+void MemoryTraceWriter::Sink::cache_access(Address address, size_t size, AccessType type) {
+    const Core *core = writer->core;
+    if (program) {
+        writer->record({ .kind = MTK_FETCH,
+                         .size = (uint32_t)size,
+                         .pc = address,
+                         .address = address,
+                         .cycle = core->get_cycle_count() });
+    } else {
+        writer->record({ .kind = type == WRITE ? MTK_STORE : MTK_LOAD,
+                         .size = (uint32_t)size,
+                         .pc = core->get_memory_access_pc(),
+                         .address = address,
+                         .cycle = core->get_cycle_count() });
+    }
+}
+
+MemoryTraceWriter::MemoryTraceWriter(const QString &path, const Core *core)
+    : file(path)
+    , core(core)
+    , program_sink(this, true)
+    , data_sink(this, false) {
+    if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+        throw SIMULATOR_EXCEPTION(Input, "Cannot open memory trace for write", path);
+    }
+    buffer.reserve(TRACE_BUFFER_SIZE + 64);
+    buffer.insert(buffer.end(), MAGIC, MAGIC + sizeof(MAGIC));
+}
+
+MemoryTraceWriter::~MemoryTraceWriter() {
+    flush();
+}
+
+void MemoryTraceWriter::attach(Cache *program, Cache *data) {
+    if (program != nullptr) {
+        program->set_access_sink(&program_sink);
+    }
+    if (data != nullptr) {
+        data->set_access_sink(&data_sink);
+    }
+}
+
+void MemoryTraceWriter::put_varint(uint64_t value) {
+    while (value >= 0x80) {
+        buffer.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back((uint8_t)value);
+}
+
+void MemoryTraceWriter::record(const MemoryTraceRecord &rec) {
+    uint8_t size_code = TRACE_SIZE_EXPLICIT;
+    for (uint8_t code = 0; code < TRACE_SIZE_EXPLICIT; code++) {
+        if (rec.size == 1u << code) {
+            size_code = code;
+            break;
+        }
+    }
+    buffer.push_back((uint8_t)(rec.kind | size_code << 2));
+    if (size_code == TRACE_SIZE_EXPLICIT) {
+        put_varint(rec.size);
+    }
+    put_varint(zigzag_encode(rec.pc.get_raw() - last.pc.get_raw()));
+    if (rec.kind != MTK_FETCH) {
+        put_varint(zigzag_encode(rec.address.get_raw() - last_data_address.get_raw()));
+        last_data_address = rec.address;
+    }
+    put_varint(zigzag_encode((uint64_t)rec.cycle - last.cycle));
+    last = rec;
+    record_count++;
+    if (buffer.size() >= TRACE_BUFFER_SIZE) {
+        flush();
+    }
+}
+
+void MemoryTraceWriter::flush() {
+    if (!buffer.empty()) {
+        file.write((const char *)buffer.data(), buffer.size());
+        buffer.clear();
+    }
+    file.flush();
+}
+
+uint64_t MemoryTraceWriter::get_record_count() const {
+    return record_count;
+}
+
+MemoryTraceReader::MemoryTraceReader(const QString &path) : file(path) {
+    char magic[sizeof(MemoryTraceWriter::MAGIC)];
+    if (!file.open(QFile::ReadOnly)) {
+        throw SIMULATOR_EXCEPTION(Input, "Cannot open memory trace for read", path);
+    }
+    if (file.read(magic, sizeof(magic)) != sizeof(magic)
+        || memcmp(magic, MemoryTraceWriter::MAGIC, sizeof(magic)) != 0) {
+        throw SIMULATOR_EXCEPTION(Input, "File is not memory trace", path);
+    }
+}
+
+bool MemoryTraceReader::fill() {
+    buffer.resize(TRACE_BUFFER_SIZE);
+    qint64 len = file.read((char *)buffer.data(), buffer.size());
+    buffer.resize(len > 0 ? len : 0);
+    pos = 0;
+    return !buffer.empty();
+}
+
+bool MemoryTraceReader::get_byte(uint8_t &value) {
+    if (pos >= buffer.size() && !fill()) {
+        return false;
+    }
+    value = buffer[pos++];
+    return true;
+}
+
+uint64_t MemoryTraceReader::get_varint() {
+    uint64_t value = 0;
+    uint8_t byte;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        if (!get_byte(byte)) {
+            throw SIMULATOR_EXCEPTION(Input, "Memory trace is truncated", file.fileName());
+        }
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+    throw SIMULATOR_EXCEPTION(Input, "Memory trace is corrupted", file.fileName());
+}
+
+bool MemoryTraceReader::next(MemoryTraceRecord &rec) {
+    uint8_t header;
+    if (!get_byte(header)) {
+        return false;
+    }
+    rec.kind = (enum MemoryTraceKind)(header & 3);
+    if (rec.kind > MTK_STORE) {
+        throw SIMULATOR_EXCEPTION(Input, "Memory trace is corrupted", file.fileName());
+    }
+    uint8_t size_code = header >> 2;
+    rec.size = size_code == TRACE_SIZE_EXPLICIT ? (uint32_t)get_varint() : 1u << size_code;
+    rec.pc = Address(last.pc.get_raw() + zigzag_decode(get_varint()));
+    if (rec.kind != MTK_FETCH) {
+        rec.address = Address(last_data_address.get_raw() + zigzag_decode(get_varint()));
+        last_data_address = rec.address;
+    } else {
+        rec.address = rec.pc;
+    }
+    rec.cycle = (uint32_t)(last.cycle + zigzag_decode(get_varint()));
+    last = rec;
+    return true;
+}
+
+uint64_t MemoryTraceReader::replay(FrontendMemory *program, FrontendMemory *data) {
+    std::vector<uint8_t> access_data;
+    MemoryTraceRecord rec;
+    uint64_t count = 0;
+    while (next(rec)) {
+        FrontendMemory *mem = rec.kind == MTK_FETCH ? program : data;
+        access_data.resize(rec.size);
+        if (rec.kind == MTK_STORE) {
+            mem->write(rec.address, access_data.data(), rec.size, { .type = ae::REGULAR });
+        } else {
+            mem->read(access_data.data(), rec.address, rec.size, { .type = ae::REGULAR });
+        }
+        count++;
+    }
+    return count;
+}
+
+} // namespace machine
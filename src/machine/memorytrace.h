@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*******************************************************************************
+ * QtMips - MIPS 32-bit Architecture Subset Simulator
+ *
+ * Implemented to support following courses:
+ *
+ *   B35APO - Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b35apo
+ *
+ *   B4M35PAP - Advanced Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b4m35pap/start
+ *
+ * Copyright (c) 2017-2019 Karel Koci<cynerd@email.cz>
+ * Copyright (c) 2019      Pavel Pisa <pisa@cmp.felk.cvut.cz>
+ *
+ * Faculty of Electrical Engineering (http://www.fel.cvut.cz)
+ * Czech Technical University        (http://www.cvut.cz/)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+#ifndef MEMORYTRACE_H
+#define MEMORYTRACE_H
+
+#include "core.h"
+#include "memory/address.h"
+#include "memory/cache/cache.h"
+#include "memory/frontend_memory.h"
+
+#include <QFile>
+#include <QString>
+#include <cstdint>
+#include <vector>
+
+namespace machine {
+
+enum MemoryTraceKind { MTK_FETCH, MTK_LOAD, MTK_STORE };
+
+struct MemoryTraceRecord {
+    enum MemoryTraceKind kind;
+    uint32_t size;
+    Address pc;      // Address of instruction causing the access
+    Address address; // Accessed address (same as pc for fetch)
+    uint32_t cycle;  // Core cycle (counted from 1) in which the access happened
+};
+
+/**
+ * Streams instruction fetches, loads and stores to a compact binary file.
+ *
+ * File starts with `MemoryTraceWriter::MAGIC`, each record follows as
+ * a header byte (kind and size) and varint encoded zig-zag deltas of PC,
+ * address (omitted for fetch, it equals PC) and cycle against the previous
+ * record. Sequential fetch then takes three bytes. Output is buffered and
+ * written in large blocks.
+ */
+class MemoryTraceWriter {
+public:
+    static constexpr char MAGIC[8] = { 'Q', 'T', 'M', 'T', 'R', 'C', '1', '\n' };
+
+    /**
+     * @param core  source of PC of data accesses and of cycle count
+     */
+    MemoryTraceWriter(const QString &path, const Core *core);
+    ~MemoryTraceWriter();
+
+    /**
+     * Records all accesses requested from given caches (either can be
+     * nullptr). Caches have to be destroyed or detached (by setting other
+     * access sink) before the writer.
+     */
+    void attach(Cache *program, Cache *data);
+
+    void record(const MemoryTraceRecord &rec);
+    void flush();
+
+    uint64_t get_record_count() const;
+
+private:
+    class Sink final : public CacheAccessSink {
+    public:
+        Sink(MemoryTraceWriter *writer, bool program);
+        void cache_access(Address address, size_t size, AccessType type) override;
+
+    private:
+        MemoryTraceWriter *const writer;
+        const bool program;
+    };
+
+    void put_varint(uint64_t value);
+
+    QFile file;
+    const Core *const core;
+    Sink program_sink, data_sink;
+    std::vector<uint8_t> buffer;
+    MemoryTraceRecord last {};
+    Address last_data_address;
+    uint64_t record_count = 0;
+};
+
+/**
+ * Reads records written by `MemoryTraceWriter`.
+ */
+class MemoryTraceReader {
+public:
+    explicit MemoryTraceReader(const QString &path);
+
+    // Returns false at the end of the trace
+    bool next(MemoryTraceRecord &rec);
+
+    /**
+     * Performs all traced accesses on given memories (typically caches)
+     * without executing the program. Data are irrelevant, only effects of
+     * accesses (cache state and statistics) are reproduced.
+     *
+     * @return  number of replayed records
+     */
+    uint64_t replay(FrontendMemory *program, FrontendMemory *data);
+
+private:
+    bool fill();
+    bool get_byte(uint8_t &value);
+    uint64_t get_varint();
+
+    QFile file;
+    std::vector<uint8_t> buffer;
+    size_t pos = 0;
+    MemoryTraceRecord last {};
+    Address last_data_address;
+};
+
+} // namespace machine
+
+#endif // MEMORYTRACE_H
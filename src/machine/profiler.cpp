@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*******************************************************************************
+ * QtMips - MIPS 32-bit Architecture Subset Simulator
+ *
+ * Implemented to support following courses:
+ *
+ *   B35APO - Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b35apo
+ *
+ *   B4M35PAP - Advanced Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b4m35pap/start
+ *
+ * Copyright (c) 2017-2019 Karel Koci<cynerd@email.cz>
+ * Copyright (c) 2019      Pavel Pisa <pisa@cmp.felk.cvut.cz>
+ *
+ * Faculty of Electrical Engineering (http://www.fel.cvut.cz)
+ * Czech Technical University        (http://www.cvut.cz/)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+#include "profiler.h"
+
+#include "memory/cache/cache.h"
+
+#include <algorithm>
+
+namespace machine {
+
+// Flat array is enlarged at least by this number of entries
+constexpr size_t PROFILER_FLAT_GROW = 1024;
+
+Profiler::Profiler(Address text_base, size_t capacity)
+    : text_base(text_base)
+    , capacity(capacity) {}
+
+void Profiler::set_caches(const Cache *program, const Cache *data) {
+    this->program = program;
+    this->data = data;
+    program_misses = program != nullptr ? program->get_miss_count() : 0;
+    data_misses = data != nullptr ? data->get_miss_count() : 0;
+}
+
+void Profiler::cycle(Address fetch_pc, Address data_pc) {
+    if (program != nullptr) {
+        uint32_t misses = program->get_miss_count();
+        // Decrease is caused by statistics reset, it is not a miss
+        if (misses > program_misses) {
+            counters(fetch_pc).icache_misses += misses - program_misses;
+        }
+        program_misses = misses;
+    }
+    if (data != nullptr) {
+        uint32_t misses = data->get_miss_count();
+        if (misses > data_misses) {
+            counters(data_pc).dcache_misses += misses - data_misses;
+        }
+        data_misses = misses;
+    }
+}
+
+void Profiler::reset() {
+    flat.clear();
+    other.clear();
+    set_caches(program, data);
+}
+
+Profiler::Counters &Profiler::counters_slow(Address pc) {
+    if (pc >= text_base) {
+        uint64_t index = (uint64_t)(pc - text_base) >> 2;
+        if (index < capacity) {
+            size_t size = std::max<size_t>(index + 1, flat.size() * 2);
+            flat.resize(std::min(std::max(size, PROFILER_FLAT_GROW), capacity));
+            return flat[index];
+        }
+    }
+    return other[pc.get_raw()];
+}
+
+const Profiler::Counters *Profiler::find(Address pc) const {
+    if (pc >= text_base) {
+        uint64_t index = (uint64_t)(pc - text_base) >> 2;
+        if (index < flat.size()) {
+            return &flat[index];
+        }
+    }
+    auto iter = other.find(pc.get_raw());
+    return iter != other.end() ? &iter->second : nullptr;
+}
+
+static bool is_recorded(const Profiler::Counters &c) {
+    return c.executed != 0 || c.stall_cycles != 0 || c.icache_misses != 0
+           || c.dcache_misses != 0 || c.exceptions != 0;
+}
+
+std::vector<Profiler::Sample> Profiler::samples() const {
+    std::vector<Sample> result;
+    for (size_t i = 0; i < flat.size(); i++) {
+        if (is_recorded(flat[i])) {
+            result.push_back({ text_base + 4 * i, flat[i] });
+        }
+    }
+    for (const auto &entry : other) {
+        result.push_back({ Address(entry.first), entry.second });
+    }
+    std::sort(result.begin(), result.end(), [](const Sample &a, const Sample &b) {
+        return a.pc < b.pc;
+    });
+    return result;
+}
+
+Profiler::Counters Profiler::total() const {
+    Counters sum;
+    for (const Sample &s : samples()) {
+        sum.executed += s.counters.executed;
+        sum.stall_cycles += s.counters.stall_cycles;
+        sum.icache_misses += s.counters.icache_misses;
+        sum.dcache_misses += s.counters.dcache_misses;
+        sum.exceptions += s.counters.exceptions;
+    }
+    return sum;
+}
+
+} // namespace machine
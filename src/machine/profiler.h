@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*******************************************************************************
+ * QtMips - MIPS 32-bit Architecture Subset Simulator
+ *
+ * Implemented to support following courses:
+ *
+ *   B35APO - Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b35apo
+ *
+ *   B4M35PAP - Advanced Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b4m35pap/start
+ *
+ * Copyright (c) 2017-2019 Karel Koci<cynerd@email.cz>
+ * Copyright (c) 2019      Pavel Pisa <pisa@cmp.felk.cvut.cz>
+ *
+ * Faculty of Electrical Engineering (http://www.fel.cvut.cz)
+ * Czech Technical University        (http://www.cvut.cz/)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "memory/address.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace machine {
+
+class Cache;
+
+/** Default number of instructions with counters kept in the flat array. */
+constexpr size_t PROFILER_FLAT_CAPACITY = 1 << 20;
+
+/**
+ * Per instruction hot-spot profile collected by core.
+ *
+ * Counters of instructions at text_base and above are stored in a flat array
+ * indexed by `(pc - text_base) >> 2`, which grows up to the capacity. Rare
+ * addresses outside of it (exception handlers, code loaded elsewhere) are
+ * kept in a map.
+ */
+class Profiler {
+public:
+    struct Counters {
+        uint32_t executed = 0;      // Retired instructions
+        uint32_t stall_cycles = 0;  // Core stall cycles charged to instruction
+        uint32_t icache_misses = 0; // Misses of its fetch
+        uint32_t dcache_misses = 0; // Misses of its data access
+        uint32_t exceptions = 0;    // Exceptions and interrupts raised
+    };
+    struct Sample {
+        Address pc;
+        Counters counters;
+    };
+
+    explicit Profiler(
+        Address text_base,
+        size_t capacity = PROFILER_FLAT_CAPACITY);
+
+    /**
+     * Misses recorded by given caches (either can be nullptr) are attributed
+     * to instructions by cycle().
+     */
+    void set_caches(const Cache *program, const Cache *data);
+
+    inline void retired(Address pc) {
+        counters(pc).executed++;
+    }
+    inline void stalled(Address pc) {
+        counters(pc).stall_cycles++;
+    }
+    inline void exception(Address pc) {
+        counters(pc).exceptions++;
+    }
+    // Called after each core cycle. Misses which appeared during the cycle
+    // are charged to the instruction fetched and the one accessing data.
+    void cycle(Address fetch_pc, Address data_pc);
+
+    void reset();
+
+    // Counters of given instruction, nullptr when it has no record
+    const Counters *find(Address pc) const;
+    // All instructions with record ordered by address
+    std::vector<Sample> samples() const;
+    Counters total() const;
+
+private:
+    Counters &counters(Address pc) {
+        if (pc >= text_base) {
+            uint64_t index = (uint64_t)(pc - text_base) >> 2;
+            if (index < flat.size()) {
+                return flat[index];
+            }
+        }
+        return counters_slow(pc);
+    }
+    Counters &counters_slow(Address pc);
+
+    const Address text_base;
+    const size_t capacity;
+    std::vector<Counters> flat;
+    std::unordered_map<uint64_t, Counters> other;
+
+    const Cache *program = nullptr;
+    const Cache *data = nullptr;
+    uint32_t program_misses = 0;
+    uint32_t data_misses = 0;
+};
+
+} // namespace machine
+
+#endif // PROFILER_H
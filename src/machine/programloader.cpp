@@ -38,6 +38,8 @@
 #include "common/endian.h"
 #include "simulator_exception.h"
 
+#include <QCryptographicHash>
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 #include <exception>
@@ -145,6 +147,14 @@ void ProgramLoader::to_memory(Memory *mem) {
     }
 }
 
+Address ProgramLoader::begin() {
+    uint32_t first = UINT32_MAX;
+    for (size_t i : this->map) {
+        first = std::min(first, this->phdrs[i].p_vaddr);
+    }
+    return Address(first != UINT32_MAX ? first : 0);
+}
+
 Address ProgramLoader::end() {
     uint32_t last = 0;
     // Go trough all sections and found out last one
@@ -161,6 +171,18 @@ Address ProgramLoader::get_executable_entry() const {
     return executable_entry;
 }
 
+QByteArray ProgramLoader::content_hash() const {
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    const char *f = elf_rawfile(this->elf, nullptr);
+    for (size_t phdrs_i : this->map) {
+        const Elf32_Phdr &phdr = this->phdrs[phdrs_i];
+        const uint32_t placement[2] = { phdr.p_vaddr, phdr.p_filesz };
+        hash.addData((const char *)placement, sizeof(placement));
+        hash.addData(f + phdr.p_offset, phdr.p_filesz);
+    }
+    return hash.result();
+}
+
 SymbolTable *ProgramLoader::get_symbol_table() {
     auto *p_st = new SymbolTable();
     Elf_Scn *scn = nullptr;
@@ -40,6 +40,7 @@
 #include "memory/backend/memory.h"
 #include "symboltable.h"
 
+#include <QByteArray>
 #include <QFile>
 #include <cstdint>
 #include <gelf.h>
@@ -57,9 +58,12 @@ public:
 
     void to_memory(Memory *mem); // Writes all loaded sections to memory TODO:
                                  // really to memory ???
+    Address begin(); // Return lowest address of loaded sections
     Address end(); // Return address after which there is no more code for
                    // sure
     Address get_executable_entry() const;
+    // Hash of loaded sections and their addresses, identifies the image
+    QByteArray content_hash() const;
     SymbolTable *get_symbol_table();
 
     Endian get_endian() const;
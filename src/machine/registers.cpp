@@ -98,7 +98,9 @@ RegisterValue Registers::read_gp(RegisterId reg) const {
     }
 
     RegisterValue value = this->gp.at(reg.data);
-    emit gp_read(reg, value.as_u32());
+    if (read_observed) {
+        emit gp_read(reg, value.as_u32());
+    }
     return value;
 }
 
@@ -113,7 +115,9 @@ void Registers::write_gp(RegisterId reg, RegisterValue value) {
 
 RegisterValue Registers::read_hi_lo(bool is_hi) const {
     RegisterValue value = is_hi ? hi : lo;
-    emit hi_lo_read(is_hi, value.as_u32());
+    if (read_observed) {
+        emit hi_lo_read(is_hi, value.as_u32());
+    }
     return value;
 }
 
@@ -126,6 +130,31 @@ void Registers::write_hi_lo(bool is_hi, RegisterValue value) {
     emit hi_lo_update(is_hi, value.as_u32());
 }
 
+void Registers::connectNotify(const QMetaMethod &signal) {
+    if (signal == QMetaMethod::fromSignal(&Registers::gp_read)
+        || signal == QMetaMethod::fromSignal(&Registers::hi_lo_read)) {
+        read_observed = true;
+    } else if (
+        signal == QMetaMethod::fromSignal(&Registers::pc_update)
+        || signal == QMetaMethod::fromSignal(&Registers::gp_update)
+        || signal == QMetaMethod::fromSignal(&Registers::hi_lo_update)) {
+        update_observed = true;
+    }
+    QObject::connectNotify(signal);
+}
+
+RegisterValue *Registers::gp_storage() {
+    return gp.data();
+}
+
+RegisterValue *Registers::hi_lo_storage(bool is_hi) {
+    return is_hi ? &hi : &lo;
+}
+
+bool Registers::signals_observed() const {
+    return read_observed || update_observed;
+}
+
 bool Registers::operator==(const Registers &c) const {
     if (read_pc() != c.read_pc()) {
         return false;
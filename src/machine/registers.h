@@ -40,6 +40,7 @@
 #include "register_value.h"
 #include "simulator_exception.h"
 
+#include <QMetaMethod>
 #include <QObject>
 #include <array>
 #include <cstdint>
@@ -103,6 +104,15 @@ public:
     RegisterValue read_hi_lo(bool hi) const; // true - read HI / false - read LO
     void write_hi_lo(bool hi, RegisterValue value);
 
+    /**
+     * Direct access to the register storage for code generated at runtime.
+     * Such writes are not announced by any signal, therefore the storage
+     * may be modified this way only when signals_observed() is false.
+     */
+    RegisterValue *gp_storage();
+    RegisterValue *hi_lo_storage(bool hi);
+    bool signals_observed() const;
+
     bool operator==(const Registers &c) const;
     bool operator!=(const Registers &c) const;
 
@@ -115,7 +125,16 @@ signals:
     void gp_read(RegisterId reg, RegisterValue val) const;
     void hi_lo_read(bool hi, RegisterValue val) const;
 
+protected:
+    void connectNotify(const QMetaMethod &signal) override;
+
 private:
+    /**
+     * Read notifications are emitted only when somebody is connected to them
+     */
+    bool read_observed = false;
+    bool update_observed = false;
+
     /**
      * General purpose registers
      *
@@ -118,6 +118,25 @@ bool SymbolTable::location_to_name(QString &name, SymbolValue value) const {
     return true;
 }
 
+bool SymbolTable::location_to_name(
+    QString &name,
+    SymbolValue &offset,
+    SymbolValue value) const {
+    auto iter = map_value_to_symbol.upperBound(value);
+    while (iter != map_value_to_symbol.begin()) {
+        --iter;
+        const SymbolTableEntry *p_entry = iter.value();
+        if (p_entry->size == 0 || value - p_entry->value < p_entry->size) {
+            name = p_entry->name;
+            offset = value - p_entry->value;
+            return true;
+        }
+    }
+    name = "";
+    offset = 0;
+    return false;
+}
+
 QStringList SymbolTable::names() const {
     return map_name_to_symbol.keys();
 }
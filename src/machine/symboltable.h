@@ -103,6 +103,14 @@ public slots:
      * single location as it is multimap.
      */
     bool location_to_name(QString &name, SymbolValue value) const;
+    /**
+     * Finds the closest symbol at or below the location (symbols with known
+     * size have to contain it) and offset of the location from the symbol.
+     */
+    bool location_to_name(
+        QString &name,
+        SymbolValue &offset,
+        SymbolValue value) const;
 
 private:
     // QString cannot be made const, because it would not fit into QT gui API.
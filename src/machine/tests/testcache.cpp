@@ -37,10 +37,14 @@
 #include "machine/memory/backend/memory.h"
 #include "machine/memory/cache/cache.h"
 #include "machine/memory/cache/cache_policy.h"
+#include "machine/memory/cache/cache_sweep.h"
 #include "machine/memory/memory_bus.h"
+#include "machine/memorytrace.h"
 #include "tests/data/cache_test_performance_data.h"
 #include "tst_machine.h"
 
+#include <QDir>
+#include <random>
 #include <tests/utils/integer_decomposition.h>
 #include <unordered_map>
 
@@ -72,8 +76,10 @@ constexpr array<uint64_t, 1> values { 0x4142434445464748 };
  * Cache configuration parameters for testing
  * (all combinations are tested)
  */
-constexpr array<CacheConfig::ReplacementPolicy, 3> replacement_policies {
-    CacheConfig::RP_RAND, CacheConfig::RP_LFU, CacheConfig::RP_LRU
+constexpr array<CacheConfig::ReplacementPolicy, 7> replacement_policies {
+    CacheConfig::RP_RAND, CacheConfig::RP_LFU,   CacheConfig::RP_LRU,
+    CacheConfig::RP_PLRU, CacheConfig::RP_NRU,   CacheConfig::RP_SRRIP,
+    CacheConfig::RP_BRRIP
 };
 constexpr array<CacheConfig::WritePolicy, 3> write_policies {
     CacheConfig::WP_THROUGH_NOALLOC, // THIS IS BROKEN IN CACHE FOR STRIDE 1
@@ -137,6 +143,10 @@ void MachineTests::cache_data() {
     cache_c.set_set_count(4);
     cache_c.set_block_size(4);
     QTest::newRow("Square") << cache_c << (unsigned)4 << (unsigned)6;
+    cache_c.set_set_count(1);
+    cache_c.set_block_size(1);
+    cache_c.set_associativity(32);
+    QTest::newRow("Fully associative") << cache_c << (unsigned)5 << (unsigned)5;
 }
 
 void MachineTests::cache() {
@@ -285,3 +295,344 @@ void MachineTests::cache_correctness() {
         QCOMPARE(performance, cache_test_performance_data.at(case_number));
     }
 }
+
+static tuple<uint32_t, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t>
+statistics_tuple(const CacheStatistics &st) {
+    return { st.hit_read,  st.miss_read,   st.hit_write,   st.miss_write,
+             st.mem_reads, st.mem_writes, st.burst_reads, st.burst_writes };
+}
+
+void MachineTests::cache_sweep() {
+    // Mix of aligned accesses, accesses crossing blocks and uncached accesses
+    // interleaved with instruction fetches
+    std::minstd_rand rng(7);
+    std::vector<MemoryTraceRecord> trace;
+    uint32_t fetches = 0;
+    for (int i = 0; i < 3000; i++) {
+        uint32_t r = rng();
+        size_t size = (size_t)1 << (r % 3);
+        Address address((r >> 4) % 0x400 & ~(size - 1));
+        if (r % 29 == 0) {
+            address = Address(0x1fe + (r >> 8) % 4);
+            size = 4;
+        } else if (r % 31 == 0) {
+            address = 0xffffc000_addr;
+        }
+        if (r % 5 == 0) {
+            Address pc((r >> 8) % 0x400 & ~3);
+            trace.push_back({ MTK_FETCH, 4, pc, pc, (uint32_t)i });
+            fetches++;
+        }
+        trace.push_back(
+            { (r >> 16) % 3 == 0 ? MTK_STORE : MTK_LOAD, (uint32_t)size, 0x0_addr, address,
+              (uint32_t)i });
+    }
+    QString path = QDir::tempPath() + "/qtmips_test_cache_sweep.bin";
+    {
+        MemoryTraceWriter writer(path, nullptr);
+        for (const MemoryTraceRecord &rec : trace) {
+            writer.record(rec);
+        }
+    }
+
+    std::vector<CacheConfig> configs;
+    for (auto replacement_policy : replacement_policies) {
+        for (auto write_policy : write_policies) {
+            for (auto organization : organizations) {
+                for (unsigned associativity : { 1, 2, 3, 4, 8 }) {
+                    CacheConfig config;
+                    config.set_enabled(true);
+                    config.set_replacement_policy(replacement_policy);
+                    config.set_write_policy(write_policy);
+                    config.set_set_count(organization.first);
+                    config.set_block_size(organization.second);
+                    config.set_associativity(associativity);
+                    configs.push_back(config);
+                }
+            }
+        }
+    }
+
+    // Online sweep fed by simulated cache
+    Memory m(BIG);
+    TrivialBus m_frontend(&m);
+    CacheSweep sweep(configs, 3, 4, 1);
+    Cache fed(&m_frontend, &configs.at(0));
+    uint64_t buffer = 0;
+    fed.set_access_sink(&sweep);
+    for (const MemoryTraceRecord &rec : trace) {
+        if (rec.kind == MTK_FETCH) {
+            continue;
+        }
+        if (rec.kind == MTK_STORE) {
+            fed.write(rec.address, &buffer, rec.size, { .type = ae::REGULAR });
+        } else {
+            fed.read(&buffer, rec.address, rec.size, { .type = ae::REGULAR });
+        }
+        // Debug accesses are not passed to the sink
+        fed.read(&buffer, rec.address, rec.size, { .type = ae::INTERNAL });
+    }
+
+    std::vector<CacheSweep::Result> online = sweep.results();
+    std::vector<CacheSweep::Result> parallel
+        = CacheSweep::replay_parallel(configs, path, false, 3, 3, 4, 1);
+    std::vector<CacheSweep::Result> program
+        = CacheSweep::replay_parallel(configs, path, true, 2, 3, 4, 1);
+    QFile::remove(path);
+    QCOMPARE(online.size(), configs.size());
+    QCOMPARE(parallel.size(), configs.size());
+    QCOMPARE(program.size(), configs.size());
+
+    for (size_t i = 0; i < configs.size(); i++) {
+        Memory ref_m(BIG);
+        TrivialBus ref_frontend(&ref_m);
+        Cache ref(&ref_frontend, &configs[i], 3, 4, 1);
+        for (const MemoryTraceRecord &rec : trace) {
+            if (rec.kind == MTK_STORE) {
+                ref.write(rec.address, &buffer, rec.size, { .type = ae::REGULAR });
+            } else if (rec.kind == MTK_LOAD) {
+                ref.read(&buffer, rec.address, rec.size, { .type = ae::REGULAR });
+            }
+        }
+        QCOMPARE(statistics_tuple(online[i].statistics), statistics_tuple(ref.get_statistics()));
+        QCOMPARE(
+            statistics_tuple(parallel[i].statistics), statistics_tuple(ref.get_statistics()));
+        QCOMPARE(online[i].stall_count, ref.get_stall_count());
+        QCOMPARE(online[i].speed_improvement, ref.get_speed_improvement());
+        QCOMPARE(online[i].hit_rate, ref.get_hit_rate());
+        // Only fetches are replayed for instruction cache
+        QCOMPARE(program[i].statistics.hit_read + program[i].statistics.miss_read, fetches);
+        QCOMPARE(program[i].statistics.hit_write + program[i].statistics.miss_write, 0U);
+    }
+}
+
+void MachineTests::cache_hierarchy_data() {
+    QTest::addColumn<unsigned>("inclusion");
+    QTest::addColumn<CacheConfig>("l1_config");
+    QTest::addColumn<CacheConfig>("l2_config");
+
+    const std::pair<MachineConfig::CacheInclusion, const char *> inclusions[] = {
+        { MachineConfig::CI_NON_INCLUSIVE, "non-inclusive" },
+        { MachineConfig::CI_INCLUSIVE, "inclusive" },
+        { MachineConfig::CI_EXCLUSIVE, "exclusive" },
+    };
+    for (const auto &inclusion : inclusions) {
+        for (auto l1_write_policy : write_policies) {
+            for (auto l2_write_policy : write_policies) {
+                CacheConfig l1_config, l2_config;
+                l1_config.set_enabled(true);
+                l1_config.set_replacement_policy(CacheConfig::RP_LRU);
+                l1_config.set_write_policy(l1_write_policy);
+                l1_config.set_set_count(4);
+                l1_config.set_block_size(2);
+                l1_config.set_associativity(2);
+                l2_config.set_enabled(true);
+                l2_config.set_replacement_policy(CacheConfig::RP_PLRU);
+                l2_config.set_write_policy(l2_write_policy);
+                l2_config.set_set_count(8);
+                l2_config.set_block_size(4);
+                l2_config.set_associativity(3);
+                QTest::addRow(
+                    "%s, l1 wr=%d, l2 wr=%d", inclusion.second, l1_write_policy,
+                    l2_write_policy)
+                    << (unsigned)inclusion.first << l1_config << l2_config;
+            }
+        }
+    }
+}
+
+void MachineTests::cache_hierarchy() {
+    QFETCH(unsigned, inclusion);
+    QFETCH(CacheConfig, l1_config);
+    QFETCH(CacheConfig, l2_config);
+
+    Memory ref(BIG);
+    Memory m(BIG);
+    TrivialBus m_frontend(&m);
+    Cache l2(&m_frontend, &l2_config, 10, 10, 2);
+    Cache l1_program(&l2, &l1_config, 4, 4, 1);
+    Cache l1_data(&l2, &l1_config, 4, 4, 1);
+    l2.set_inner_levels(
+        { &l1_program, &l1_data }, (MachineConfig::CacheInclusion)inclusion);
+
+    // Program and data are kept apart, caches are not coherent
+    for (uint32_t address = 0; address < 0x200; address += 4) {
+        memory_write_u32(&m, address, address * 0x01010101);
+        memory_write_u32(&ref, address, address * 0x01010101);
+    }
+
+    std::minstd_rand rng(3);
+    for (int i = 0; i < 4000; i++) {
+        uint32_t r = rng();
+        size_t size = (size_t)1 << (r % 3);
+        Address address((r >> 4) % 0x200 & ~(size - 1));
+        uint64_t buffer = 0, expected = 0;
+        if (r % 5 == 0) {
+            l1_program.read(&buffer, address, size, { .type = ae::REGULAR });
+            ref.read(&expected, address.get_raw(), size, { .type = ae::REGULAR });
+            QCOMPARE(buffer, expected);
+        } else {
+            address += 0x200;
+            if ((r >> 16) % 3 == 0) {
+                buffer = rng();
+                l1_data.write(address, &buffer, size, { .type = ae::REGULAR });
+                ref.write(address.get_raw(), &buffer, size, { .type = ae::REGULAR });
+            } else {
+                l1_data.read(&buffer, address, size, { .type = ae::REGULAR });
+                ref.read(&expected, address.get_raw(), size, { .type = ae::REGULAR });
+                QCOMPARE(buffer, expected);
+            }
+        }
+        if (inclusion == MachineConfig::CI_INCLUSIVE) {
+            // Inner levels report status of the outer one for blocks they miss
+            for (const Cache *l1 : { &l1_program, &l1_data }) {
+                if (l1->location_status(address) & LOCSTAT_CACHED) {
+                    QVERIFY(l2.location_status(address) & LOCSTAT_CACHED);
+                }
+            }
+        }
+    }
+
+    l1_program.sync();
+    l1_data.sync();
+    l2.sync();
+    for (uint32_t address = 0; address < 0x400; address += 4) {
+        QCOMPARE(memory_read_u32(&m, address), memory_read_u32(&ref, address));
+    }
+}
+
+void MachineTests::cache_hierarchy_inclusion() {
+    Memory m(BIG);
+    TrivialBus m_frontend(&m);
+    CacheConfig l1_config, l2_config;
+    l1_config.set_enabled(true);
+    l1_config.set_set_count(1);
+    l1_config.set_block_size(1);
+    l1_config.set_associativity(1);
+    l1_config.set_write_policy(CacheConfig::WP_BACK);
+    l2_config = l1_config;
+    l2_config.set_set_count(4);
+
+    // L1 holds a single word, L2 has room for both
+    {
+        Cache l2(&m_frontend, &l2_config);
+        Cache l1(&l2, &l1_config);
+        l2.set_inner_levels({ &l1 }, MachineConfig::CI_NON_INCLUSIVE);
+        l1.read_u32(0x0_addr);
+        l1.read_u32(0x4_addr);
+        l1.read_u32(0x0_addr);
+        QCOMPARE(l2.get_hit_count(), 1U);
+        QCOMPARE(l2.get_miss_count(), 2U);
+        QCOMPARE(l2.get_read_count(), 2U);
+    }
+    {
+        // Blocks get to the exclusive level by evictions from L1 only
+        Cache l2(&m_frontend, &l2_config);
+        Cache l1(&l2, &l1_config);
+        l2.set_inner_levels({ &l1 }, MachineConfig::CI_EXCLUSIVE);
+        l1.read_u32(0x0_addr);
+        QVERIFY(!(l2.location_status(0x0_addr) & LOCSTAT_CACHED));
+        l1.read_u32(0x4_addr);
+        QVERIFY(l2.location_status(0x0_addr) & LOCSTAT_CACHED);
+        l1.read_u32(0x0_addr);
+        QVERIFY(!(l2.location_status(0x0_addr) & LOCSTAT_CACHED));
+        QVERIFY(l2.location_status(0x4_addr) & LOCSTAT_CACHED);
+        QCOMPARE(l2.get_hit_count(), 1U);
+        QCOMPARE(l2.get_miss_count(), 4U);
+        QCOMPARE(l2.get_read_count(), 2U);
+    }
+
+    // Inclusive L2 holding a single word evicts blocks from L1
+    l1_config.set_associativity(2);
+    l2_config.set_set_count(1);
+    {
+        Cache l2(&m_frontend, &l2_config);
+        Cache l1(&l2, &l1_config);
+        l2.set_inner_levels({ &l1 }, MachineConfig::CI_INCLUSIVE);
+        l1.write_u32(0x0_addr, 0x12345678);
+        l1.read_u32(0x4_addr);
+        QVERIFY(!(l1.location_status(0x0_addr) & LOCSTAT_CACHED));
+        // Dirty block was written back through L2
+        QCOMPARE(memory_read_u32(&m, 0x0), 0x12345678U);
+        QCOMPARE(l1.read_u32(0x0_addr), 0x12345678U);
+    }
+    {
+        Cache l2(&m_frontend, &l2_config);
+        Cache l1(&l2, &l1_config);
+        l2.set_inner_levels({ &l1 }, MachineConfig::CI_NON_INCLUSIVE);
+        l1.read_u32(0x0_addr);
+        l1.read_u32(0x4_addr);
+        QVERIFY(l1.location_status(0x0_addr) & LOCSTAT_CACHED);
+    }
+}
+
+void MachineTests::cache_prefetch_data() {
+    QTest::addColumn<CacheConfig>("cache_c");
+    QTest::addColumn<unsigned>("stride");
+    QTest::addColumn<unsigned>("count");
+    QTest::addColumn<unsigned>("passes");
+    QTest::addColumn<unsigned>("miss");
+    QTest::addColumn<unsigned>("prefetches");
+    QTest::addColumn<unsigned>("useful");
+    QTest::addColumn<unsigned>("pollution");
+
+    CacheConfig cache_c;
+    cache_c.set_enabled(true);
+    cache_c.set_set_count(4);
+    cache_c.set_block_size(1);
+    cache_c.set_associativity(2);
+    cache_c.set_replacement_policy(CacheConfig::RP_LRU);
+    QTest::newRow("None") << cache_c << 1U << 64U << 1U << 64U << 0U << 0U << 0U;
+    cache_c.set_prefetcher(CacheConfig::PF_NEXT_LINE);
+    QTest::newRow("Next-line") << cache_c << 1U << 64U << 1U << 1U << 64U << 63U << 0U;
+    QTest::newRow("Next-line, strided")
+        << cache_c << 3U << 64U << 1U << 64U << 64U << 0U << 0U;
+    cache_c.set_prefetch_degree(2);
+    cache_c.set_prefetch_distance(2);
+    QTest::newRow("Next-line, degree 2, distance 2")
+        << cache_c << 1U << 64U << 1U << 2U << 65U << 62U << 0U;
+    cache_c.set_prefetcher(CacheConfig::PF_STRIDE);
+    QTest::newRow("Stride, degree 2, distance 2")
+        << cache_c << 3U << 64U << 1U << 5U << 62U << 59U << 0U;
+    cache_c.set_prefetch_degree(1);
+    cache_c.set_prefetch_distance(1);
+    QTest::newRow("Stride") << cache_c << 3U << 64U << 1U << 4U << 61U << 60U << 0U;
+    cache_c.set_prefetcher(CacheConfig::PF_STREAM);
+    QTest::newRow("Stream") << cache_c << 1U << 64U << 1U << 2U << 63U << 62U << 0U;
+    QTest::newRow("Stream, strided") << cache_c << 3U << 64U << 1U << 64U << 0U << 0U << 0U;
+
+    // Prefetched blocks evict the loop working set
+    cache_c.set_set_count(1);
+    cache_c.set_associativity(3);
+    cache_c.set_prefetcher(CacheConfig::PF_NEXT_LINE);
+    QTest::newRow("Next-line, pollution") << cache_c << 2U << 2U << 4U << 8U << 8U << 0U << 6U;
+}
+
+void MachineTests::cache_prefetch() {
+    QFETCH(CacheConfig, cache_c);
+    QFETCH(unsigned, stride);
+    QFETCH(unsigned, count);
+    QFETCH(unsigned, passes);
+    QFETCH(unsigned, miss);
+    QFETCH(unsigned, prefetches);
+    QFETCH(unsigned, useful);
+    QFETCH(unsigned, pollution);
+
+    Memory m(BIG);
+    TrivialBus m_frontend(&m);
+    for (uint32_t address = 0; address < 0x400; address += 4) {
+        memory_write_u32(&m, address, address ^ 0x5a5a5a5a);
+    }
+    Cache cache(&m_frontend, &cache_c);
+    for (unsigned pass = 0; pass < passes; pass++) {
+        for (unsigned i = 0; i < count; i++) {
+            const uint32_t address = i * stride * 4;
+            QCOMPARE(cache.read_u32(Address(address)), address ^ 0x5a5a5a5a);
+        }
+    }
+
+    QCOMPARE(cache.get_miss_count(), miss);
+    QCOMPARE(cache.get_prefetch_count(), prefetches);
+    QCOMPARE(cache.get_prefetch_useful_count(), useful);
+    QCOMPARE(cache.get_prefetch_pollution(), pollution);
+}
@@ -41,6 +41,10 @@
 #include "tst_machine.h"
 
 #include <QVector>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
 
 using namespace machine;
 
@@ -699,6 +703,86 @@ static void run_code_fragment(
     QCOMPARE(mem_init, mem_res); // There should be no change in memory
 }
 
+/**
+ * Core with its own copy of the initial state of a code fragment. L1 caches
+ * in front of the memory are present only when configured.
+ */
+struct CoreFixture {
+    CoreFixture(
+        const QVector<uint32_t> &code,
+        const Registers &reg_init,
+        const Memory &mem_init,
+        const CacheConfig *cache_conf)
+        : regs(reg_init)
+        , mem(mem_init)
+        , mem_frontend(&mem) {
+        uint64_t addr = reg_init.read_pc().get_raw();
+        foreach (uint32_t i, code) {
+            memory_write_u32(&mem, addr, i);
+            addr += 4;
+        }
+        if (cache_conf != nullptr) {
+            i_cache = std::make_unique<Cache>(&mem_frontend, cache_conf, 10, 12, 2);
+            d_cache = std::make_unique<Cache>(&mem_frontend, cache_conf, 10, 12, 2);
+        }
+    }
+
+    FrontendMemory *program() {
+        return i_cache != nullptr ? (FrontendMemory *)i_cache.get() : &mem_frontend;
+    }
+    FrontendMemory *data() {
+        return d_cache != nullptr ? (FrontendMemory *)d_cache.get() : &mem_frontend;
+    }
+
+    // Step until PC reaches end or the limit of steps is exhausted
+    void run_to(Address end, int limit) {
+        for (int k = limit; k && regs.read_pc() != end; k--) {
+            core->step();
+        }
+    }
+
+    Registers regs;
+    Memory mem;
+    TrivialBus mem_frontend;
+    std::unique_ptr<Cache> i_cache;
+    std::unique_ptr<Cache> d_cache;
+    std::unique_ptr<Core> core; // Destroyed first, it may refer to the rest
+};
+
+using CoreFactory = std::function<Core *(CoreFixture &)>;
+
+/**
+ * Run code fragment on reference core and on variant core, each created by
+ * its factory (which attaches predictor, profiler etc.) for own copy of the
+ * initial state. Run steps both cores and compares them on the way, both
+ * have to end with the same registers (PC excluded) and memory.
+ */
+static void compare_core_variant(
+    const QVector<uint32_t> &code,
+    const Registers &reg_init,
+    const Memory &mem_init,
+    const CacheConfig *cache_conf,
+    const CoreFactory &make_ref,
+    const CoreFactory &make_var,
+    const std::function<void(CoreFixture &ref, CoreFixture &var)> &run) {
+    CoreFixture ref(code, reg_init, mem_init, cache_conf);
+    CoreFixture var(code, reg_init, mem_init, cache_conf);
+    ref.core.reset(make_ref(ref));
+    var.core.reset(make_var(var));
+    run(ref, var);
+    if (QTest::currentTestFailed()) {
+        return;
+    }
+    var.regs.pc_abs_jmp(ref.regs.read_pc());
+    QCOMPARE(var.regs, ref.regs);
+    QCOMPARE(var.mem, ref.mem);
+}
+
+static Core *make_pipelined(CoreFixture &f) {
+    return new CorePipelined(
+        &f.regs, f.program(), f.data(), MachineConfig::HU_STALL_FORWARD);
+}
+
 void MachineTests::singlecore_alu_forward() {
     QFETCH(QVector<uint32_t>, code);
     QFETCH(Registers, reg_init);
@@ -1154,3 +1238,680 @@ void MachineTests::pipecore_wb_memory_tests() {
         &reg_init, &i_cache, &d_cache, MachineConfig::HU_STALL_FORWARD);
     run_code_fragment(core, reg_init, reg_res, mem_init, mem_res, code);
 }
+
+void MachineTests::pipecore_memory_stalls_data() {
+    core_memory_tests_data();
+}
+
+void MachineTests::pipecore_memory_stalls() {
+    QFETCH(QVector<uint32_t>, code);
+    QFETCH(Registers, reg_init);
+    QFETCH(Registers, reg_res);
+    QFETCH(Memory, mem_init);
+
+    // Core stalling on memory access has to pass the same sequence of
+    // pipeline states as the core which ignores access time. Only the cycles
+    // spent waiting for memory are inserted.
+    const CacheConfig::WritePolicy policies[] = { CacheConfig::WP_THROUGH_ALLOC,
+                                                  CacheConfig::WP_BACK };
+    for (int variant = 0; variant < 3; variant++) {
+        CacheConfig cache_conf;
+        cache_conf.set_enabled(variant > 0);
+        cache_conf.set_set_count(4);
+        cache_conf.set_block_size(2);
+        cache_conf.set_associativity(2);
+        cache_conf.set_replacement_policy(CacheConfig::RP_LRU);
+        if (variant > 0) {
+            cache_conf.set_write_policy(policies[variant - 1]);
+        }
+
+        auto make_stalling = [](CoreFixture &f) {
+            Core *core = make_pipelined(f);
+            core->set_memory_stall_source([&f]() {
+                return f.i_cache->get_stall_count() + f.d_cache->get_stall_count();
+            });
+            return core;
+        };
+        compare_core_variant(
+            code, reg_init, mem_init, &cache_conf, make_pipelined, make_stalling,
+            [&](CoreFixture &base, CoreFixture &stall) {
+                base.run_to(reg_res.read_pc(), 10000);
+                stall.run_to(reg_res.read_pc(), 100000);
+                QCOMPARE(base.regs.read_pc(), reg_res.read_pc());
+                QCOMPARE(stall.regs.read_pc(), reg_res.read_pc());
+                QCOMPARE(base.core->get_memory_stall_count(), 0u);
+                QVERIFY(stall.core->get_memory_stall_count() > 0);
+                QCOMPARE(
+                    stall.core->get_cycle_count(),
+                    base.core->get_cycle_count() + stall.core->get_memory_stall_count());
+                QCOMPARE(
+                    stall.core->get_stall_count(),
+                    base.core->get_stall_count() + stall.core->get_memory_stall_count());
+
+                // End loop hits in cache, stalls of last accesses are drained then
+                for (int k = 0; k < 500; k++) {
+                    base.core->step();
+                    stall.core->step();
+                }
+                if (cache_conf.enabled()) {
+                    QCOMPARE(
+                        stall.core->get_memory_stall_count(),
+                        stall.i_cache->get_stall_count() + stall.d_cache->get_stall_count());
+                }
+            });
+        if (QTest::currentTestFailed()) {
+            return;
+        }
+    }
+}
+
+void MachineTests::pipecore_branch_predictor_data() {
+    core_memory_tests_data();
+}
+
+void MachineTests::pipecore_branch_predictor() {
+    QFETCH(QVector<uint32_t>, code);
+    QFETCH(Registers, reg_init);
+    QFETCH(Registers, reg_res);
+    QFETCH(Memory, mem_init);
+
+    // Predictions do not change executed path, every misprediction only
+    // freezes pipeline for the penalty cycles.
+    const MachineConfig::BranchPredictor kinds[]
+        = { MachineConfig::BP_STATIC_NOT_TAKEN, MachineConfig::BP_BIMODAL,
+            MachineConfig::BP_GSHARE, MachineConfig::BP_TOURNAMENT };
+    for (auto kind : kinds) {
+        MachineConfig config;
+        config.set_pipelined(true);
+        config.set_branch_predictor(kind);
+        config.set_branch_predictor_bits(4);
+        config.set_branch_mispredict_penalty(3);
+
+        auto make_predicting = [&config](CoreFixture &f) {
+            Core *core = make_pipelined(f);
+            core->set_branch_predictor(std::make_unique<BranchPredictionUnit>(config));
+            return core;
+        };
+        compare_core_variant(
+            code, reg_init, mem_init, nullptr, make_pipelined, make_predicting,
+            [&](CoreFixture &base, CoreFixture &bp) {
+                base.run_to(reg_res.read_pc(), 10000);
+                bp.run_to(reg_res.read_pc(), 100000);
+                QCOMPARE(base.regs.read_pc(), reg_res.read_pc());
+                QCOMPARE(bp.regs.read_pc(), reg_res.read_pc());
+                const BranchPredictionUnit *bpu = bp.core->get_branch_predictor();
+                QVERIFY(bpu != nullptr);
+                QCOMPARE(
+                    bp.core->get_cycle_count(),
+                    base.core->get_cycle_count() + bp.core->get_mispredict_stall_count());
+                QCOMPARE(
+                    bp.core->get_stall_count(),
+                    base.core->get_stall_count() + bp.core->get_mispredict_stall_count());
+
+                // Drain flush of the last mispredicted jump in the end loop
+                for (int k = 0; k < 500; k++) {
+                    base.core->step();
+                    bp.core->step();
+                }
+                QCOMPARE(
+                    bp.core->get_mispredict_stall_count(), bpu->get_mispredict_count() * 3);
+                QVERIFY(bpu->get_accuracy() >= 0.0 && bpu->get_accuracy() <= 100.0);
+            });
+        if (QTest::currentTestFailed()) {
+            return;
+        }
+    }
+}
+
+void MachineTests::pipecore_branch_predictor_accuracy_data() {
+    QTest::addColumn<int>("kind");
+    QTest::addColumn<uint>("ras_depth");
+    QTest::addColumn<uint>("counted_miss");
+    QTest::addColumn<uint>("alternating_miss");
+    QTest::addColumn<uint>("return_miss");
+
+    QTest::newRow("STATIC") << (int)MachineConfig::BP_STATIC_NOT_TAKEN << 8u << 15u << 8u << 0u;
+    QTest::newRow("BIMODAL") << (int)MachineConfig::BP_BIMODAL << 8u << 2u << 16u << 0u;
+    QTest::newRow("GSHARE") << (int)MachineConfig::BP_GSHARE << 8u << 4u << 2u << 0u;
+    QTest::newRow("TOURNAMENT") << (int)MachineConfig::BP_TOURNAMENT << 8u << 2u << 3u << 0u;
+    // Both call sites share one return, target buffer alone keeps missing it
+    QTest::newRow("BIMODAL-NO-RAS") << (int)MachineConfig::BP_BIMODAL << 0u << 2u << 16u << 32u;
+}
+
+void MachineTests::pipecore_branch_predictor_accuracy() {
+    QFETCH(int, kind);
+    QFETCH(uint, ras_depth);
+    QFETCH(uint, counted_miss);
+    QFETCH(uint, alternating_miss);
+    QFETCH(uint, return_miss);
+
+    QVector<uint32_t> code {
+        // _start:
+        0x20100010, // addi    s0,zero,16
+        0x20110000, // addi    s1,zero,0
+        // loop:
+        0x0c00800f, // jal     8002003c <func>
+        0x00000000, // nop
+        0x32080001, // andi    t0,s0,1
+        0x11000002, // beqz    t0,80020020 <skip>
+        0x00000000, // nop
+        0x22310001, // addi    s1,s1,1
+        // skip:
+        0x0c00800f, // jal     8002003c <func>
+        0x00000000, // nop
+        0x2210ffff, // addi    s0,s0,-1
+        0x1600fff6, // bnez    s0,80020008 <loop>
+        0x00000000, // nop
+        // end_loop:
+        0x0800800d, // j       80020034 <end_loop>
+        0x00000000, // nop
+        // func:
+        0x03e00008, // jr      ra
+        0x22520001, // addi    s2,s2,1
+    };
+    Registers regs_init;
+    regs_init.pc_abs_jmp(0x80020000_addr);
+
+    MachineConfig config;
+    config.set_pipelined(true);
+    config.set_branch_predictor((enum MachineConfig::BranchPredictor)kind);
+    config.set_branch_predictor_bits(4);
+    config.set_return_address_stack(ras_depth);
+    config.set_branch_mispredict_penalty(3);
+
+    CoreFixture f(code, regs_init, Memory(BIG), nullptr);
+    f.core.reset(make_pipelined(f));
+    f.core->set_branch_predictor(std::make_unique<BranchPredictionUnit>(config));
+    f.run_to(0x80020034_addr, 1000);
+    QCOMPARE(f.regs.read_pc(), 0x80020034_addr);
+    // Retire the rest of the loop from pipeline
+    for (int k = 0; k < 10; k++) {
+        f.core->step();
+    }
+    QCOMPARE(f.regs.read_gp(16).as_u32(), 0u);
+    QCOMPARE(f.regs.read_gp(17).as_u32(), 8u);
+    QCOMPARE(f.regs.read_gp(18).as_u32(), 32u);
+
+    std::map<uint64_t, BranchPredictionUnit::PcStatistics> stats;
+    for (const auto &s : f.core->get_branch_predictor()->get_pc_statistics()) {
+        stats[s.inst_addr.get_raw()] = s;
+    }
+    // Counted loop branch and the branch alternating with its parity
+    QCOMPARE(stats[0x8002002c].executed, 16u);
+    QCOMPARE(stats[0x8002002c].taken, 15u);
+    QCOMPARE(stats[0x8002002c].mispredicted, counted_miss);
+    QCOMPARE(stats[0x80020014].executed, 16u);
+    QCOMPARE(stats[0x80020014].taken, 8u);
+    QCOMPARE(stats[0x80020014].mispredicted, alternating_miss);
+    // Calls are found in target buffer since their first execution
+    QCOMPARE(stats[0x80020008].executed, 16u);
+    QCOMPARE(stats[0x80020008].mispredicted, 1u);
+    QCOMPARE(stats[0x80020020].executed, 16u);
+    QCOMPARE(stats[0x80020020].mispredicted, 1u);
+    // Return alternates between two call sites
+    QCOMPARE(stats[0x8002003c].executed, 32u);
+    QCOMPARE(stats[0x8002003c].mispredicted, return_miss);
+}
+
+void MachineTests::core_profiler_data() {
+    core_memory_tests_data();
+}
+
+void MachineTests::core_profiler() {
+    QFETCH(QVector<uint32_t>, code);
+    QFETCH(Registers, reg_init);
+    QFETCH(Registers, reg_res);
+    QFETCH(Memory, mem_init);
+
+    CacheConfig cache_conf;
+    cache_conf.set_enabled(true);
+    cache_conf.set_set_count(4);
+    cache_conf.set_block_size(2);
+    cache_conf.set_associativity(2);
+    cache_conf.set_replacement_policy(CacheConfig::RP_LRU);
+    cache_conf.set_write_policy(CacheConfig::WP_BACK);
+
+    Profiler prof_single(reg_init.read_pc());
+    Profiler prof_pipe(reg_init.read_pc());
+    auto profiled = [](Profiler &prof, Core *core, CoreFixture &f) {
+        prof.set_caches(f.i_cache.get(), f.d_cache.get());
+        core->set_profiler(&prof);
+        return core;
+    };
+    compare_core_variant(
+        code, reg_init, mem_init, &cache_conf,
+        [&](CoreFixture &f) {
+            return profiled(
+                prof_single, new CoreSingle(&f.regs, f.program(), f.data(), true), f);
+        },
+        [&](CoreFixture &f) { return profiled(prof_pipe, make_pipelined(f), f); },
+        [&](CoreFixture &single, CoreFixture &pipe) {
+            single.run_to(reg_res.read_pc(), 10000);
+            pipe.run_to(reg_res.read_pc(), 10000);
+            QCOMPARE(single.regs.read_pc(), reg_res.read_pc());
+            QCOMPARE(pipe.regs.read_pc(), reg_res.read_pc());
+            // Retire instructions still in pipeline
+            for (int k = 0; k < 8; k++) {
+                pipe.core->step();
+            }
+
+            // Both cores execute the same instructions, only the final loop
+            // (at the last two addresses) is repeated different number of times
+            const Address end_loop = reg_res.read_pc() - 4;
+            const std::vector<Profiler::Sample> samples_single = prof_single.samples();
+            const std::vector<Profiler::Sample> samples_pipe = prof_pipe.samples();
+            QVERIFY(!samples_single.empty());
+            for (const Profiler::Sample &s : samples_single) {
+                if (s.pc >= end_loop) {
+                    continue;
+                }
+                const Profiler::Counters *c = prof_pipe.find(s.pc);
+                QVERIFY(c != nullptr);
+                QCOMPARE(c->executed, s.counters.executed);
+                QCOMPARE(s.counters.stall_cycles, 0u);
+            }
+            for (const Profiler::Sample &s : samples_pipe) {
+                if (s.pc < end_loop) {
+                    QVERIFY(prof_single.find(s.pc) != nullptr);
+                }
+            }
+
+            const Profiler::Counters total_single = prof_single.total();
+            const Profiler::Counters total_pipe = prof_pipe.total();
+            QCOMPARE(total_pipe.stall_cycles, pipe.core->get_stall_count());
+            QCOMPARE(total_single.icache_misses, single.i_cache->get_miss_count());
+            QCOMPARE(total_single.dcache_misses, single.d_cache->get_miss_count());
+            QCOMPARE(total_pipe.icache_misses, pipe.i_cache->get_miss_count());
+            QCOMPARE(total_pipe.dcache_misses, pipe.d_cache->get_miss_count());
+            QCOMPARE(total_single.exceptions, 0u);
+            QCOMPARE(total_pipe.exceptions, 0u);
+            QVERIFY(total_pipe.icache_misses > 0);
+            QVERIFY(total_pipe.dcache_misses > 0);
+        });
+}
+
+void MachineTests::core_call_graph_data() {
+    QTest::addColumn<bool>("pipelined");
+    QTest::newRow("single") << false;
+    QTest::newRow("pipelined") << true;
+}
+
+void MachineTests::core_call_graph() {
+    QFETCH(bool, pipelined);
+
+    // main calls func three times, func returns by jr ra
+    const uint32_t code[] = {
+        0x24100003, // main: addiu s0,zero,3
+        0x0c008008, // loop: jal func
+        0x00000000, //       nop
+        0x2610ffff, //       addiu s0,s0,-1
+        0x1600fffc, //       bnez s0,loop
+        0x00000000, //       nop
+        0x1000ffff, // end:  b end
+        0x00000000, //       nop
+        0x24420001, // func: addiu v0,v0,1
+        0x03e00008, //       jr ra
+        0x00000000, //       nop
+    };
+    const Address main_addr = 0x80020000_addr;
+    const Address func_addr = 0x80020020_addr;
+    const Address end_addr = 0x80020018_addr;
+
+    CacheConfig cache_conf;
+    cache_conf.set_enabled(true);
+    cache_conf.set_set_count(2);
+    cache_conf.set_block_size(1);
+    cache_conf.set_associativity(1);
+
+    Registers regs;
+    Memory mem(BIG);
+    uint64_t addr = main_addr.get_raw();
+    for (uint32_t i : code) {
+        memory_write_u32(&mem, addr, i);
+        addr += 4;
+    }
+    TrivialBus mem_frontend(&mem);
+    Cache i_cache(&mem_frontend, &cache_conf);
+    Cache d_cache(&mem_frontend, &cache_conf);
+    std::unique_ptr<Core> core;
+    if (pipelined) {
+        core.reset(new CorePipelined(
+            &regs, &i_cache, &d_cache, MachineConfig::HU_STALL_FORWARD));
+    } else {
+        core.reset(new CoreSingle(&regs, &i_cache, &d_cache, true));
+    }
+    SymbolTable symtab;
+    symtab.add_symbol("main", main_addr.get_raw(), 0x20);
+    symtab.add_symbol("func", func_addr.get_raw(), 0x0c);
+    CallGraph graph(&symtab);
+    graph.set_caches(&i_cache, &d_cache);
+    core->set_call_graph(&graph);
+
+    for (int k = 1000; k && regs.read_pc() != end_addr; k--) {
+        core->step();
+    }
+    QCOMPARE(regs.read_pc(), end_addr);
+    for (int k = 0; k < 8; k++) {
+        core->step();
+    }
+
+    const std::vector<CallGraph::FunctionCost> functions = graph.functions();
+    QCOMPARE(functions.size(), (size_t)2);
+    const CallGraph::FunctionCost &main_cost = functions[0];
+    const CallGraph::FunctionCost &func_cost = functions[1];
+    QCOMPARE(main_cost.name, QString("main"));
+    QCOMPARE(main_cost.calls, (uint64_t)1);
+    QCOMPARE(func_cost.name, QString("func"));
+    QCOMPARE(func_cost.calls, (uint64_t)3);
+    QCOMPARE(func_cost.exclusive.instructions, (uint64_t)9);
+    QCOMPARE(func_cost.inclusive.instructions, (uint64_t)9);
+    QCOMPARE(func_cost.inclusive.cycles, func_cost.exclusive.cycles);
+
+    // Costs of the root function include everything
+    const CallGraph::Cost total = graph.total();
+    QCOMPARE(main_cost.inclusive.instructions, total.instructions);
+    QCOMPARE(main_cost.inclusive.cycles, total.cycles);
+    QCOMPARE(
+        main_cost.exclusive.cycles + func_cost.exclusive.cycles, total.cycles);
+    QCOMPARE(
+        main_cost.exclusive.icache_misses + func_cost.exclusive.icache_misses,
+        total.icache_misses);
+    QCOMPARE(total.icache_misses, (uint64_t)i_cache.get_miss_count());
+    QCOMPARE(total.dcache_misses, (uint64_t)d_cache.get_miss_count());
+    QVERIFY(total.icache_misses > 0);
+    // All cycles since the first instruction retired are counted
+    QVERIFY(total.cycles <= core->get_cycle_count());
+    QVERIFY(total.cycles + 4 >= core->get_cycle_count());
+
+    std::ostringstream out;
+    graph.write_callgrind(out, "test");
+    const std::string callgrind = out.str();
+    QVERIFY(callgrind.find("events: Ir Cycles I1miss D1miss\n") != std::string::npos);
+    QVERIFY(callgrind.find("\nfn=func\n") != std::string::npos);
+    QVERIFY(callgrind.find("\ncfn=func\ncalls=3 0x80020020\n0x80020004 9 ")
+            != std::string::npos);
+}
+
+void MachineTests::core_perf_counters_data() {
+    QTest::addColumn<bool>("pipelined");
+    QTest::addColumn<uint32_t>("instructions");
+    QTest::addColumn<uint32_t>("load_use_stalls");
+    // Single cycle core retires the enabling mtc0 after the counter starts,
+    // pipelined core reads the counter before nop leaves the pipeline
+    QTest::newRow("single") << false << 5u << 0u;
+    QTest::newRow("pipelined") << true << 3u << 1u;
+}
+
+void MachineTests::core_perf_counters() {
+    QFETCH(bool, pipelined);
+    QFETCH(uint32_t, instructions);
+    QFETCH(uint32_t, load_use_stalls);
+
+    const uint32_t code[] = {
+        0x4088c800, // mtc0 t0,$25,0 (PerfCtl0)
+        0x4089c802, // mtc0 t1,$25,2 (PerfCtl1)
+        0x8c0a0000, // lw t2,0(zero)
+        0x014a5821, // addu t3,t2,t2
+        0x00000000, // nop
+        0x4010c801, // mfc0 s0,$25,1 (PerfCnt0)
+        0x4011c803, // mfc0 s1,$25,3 (PerfCnt1)
+        0x1000ffff, // end: b end
+        0x00000000, //      nop
+    };
+    const Address end_addr = 0x8002001c_addr;
+
+    Registers regs;
+    regs.write_gp(
+        8, (Cop0State::PERF_INSTRUCTIONS << Cop0State::PerfCtl_EventShift) | Cop0State::PerfCtl_K);
+    regs.write_gp(
+        9, (Cop0State::PERF_LOAD_USE_STALLS << Cop0State::PerfCtl_EventShift)
+               | Cop0State::PerfCtl_K);
+    Memory mem(BIG);
+    uint64_t addr = regs.read_pc().get_raw();
+    for (uint32_t i : code) {
+        memory_write_u32(&mem, addr, i);
+        addr += 4;
+    }
+    TrivialBus mem_frontend(&mem);
+    Cop0State cop0;
+    std::unique_ptr<Core> core;
+    if (pipelined) {
+        core.reset(new CorePipelined(
+            &regs, &mem_frontend, &mem_frontend, MachineConfig::HU_STALL_FORWARD, 1, &cop0));
+    } else {
+        core.reset(new CoreSingle(&regs, &mem_frontend, &mem_frontend, true, 1, &cop0));
+    }
+    Core *c = core.get();
+    cop0.set_perf_event_source(
+        Cop0State::PERF_INSTRUCTIONS, [c]() { return c->get_retired_count(); });
+    cop0.set_perf_event_source(
+        Cop0State::PERF_LOAD_USE_STALLS, [c]() { return c->get_load_use_stall_count(); });
+    QVERIFY(!cop0.perf_counting());
+
+    for (int k = 100; k && regs.read_pc() != end_addr; k--) {
+        core->step();
+    }
+    QCOMPARE(regs.read_pc(), end_addr);
+    for (int k = 0; k < 8; k++) {
+        core->step();
+    }
+    QVERIFY(cop0.perf_counting());
+    QCOMPARE(cop0.read_cop0reg(Cop0State::PerfCtl0) & Cop0State::PerfCtl_M, 0x80000000u);
+    QCOMPARE(regs.read_gp(16), RegisterValue(instructions));
+    QCOMPARE(regs.read_gp(17), RegisterValue(load_use_stalls));
+    QCOMPARE(core->get_load_use_stall_count(), load_use_stalls);
+}
+
+/*======================================================================*/
+
+void MachineTests::singlecore_self_modifying_code() {
+    Registers regs;
+    Address pc = regs.read_pc();
+    Memory mem(BIG);
+    TrivialBus mem_frontend(&mem);
+    CoreSingle core(&regs, &mem_frontend, &mem_frontend, false);
+
+    memory_write_u32(&mem, pc.get_raw(), Instruction(9, 0, 26, 1).data()); // addiu k0,zero,1
+    core.step();
+    QCOMPARE(regs.read_gp(26), RegisterValue(1));
+
+    // Same address executed again after the code was rewritten has to
+    // decode the new instruction and not the cached one.
+    memory_write_u32(&mem, pc.get_raw(), Instruction(9, 0, 26, 2).data()); // addiu k0,zero,2
+    regs.pc_abs_jmp(pc);
+    core.step();
+    QCOMPARE(regs.read_gp(26), RegisterValue(2));
+
+    memory_write_u32(&mem, pc.get_raw(), Instruction(0, 26, 26, 27, 0, 33).data()); // addu k1,k0,k0
+    regs.pc_abs_jmp(pc);
+    core.step();
+    QCOMPARE(regs.read_gp(27), RegisterValue(4));
+}
+
+void MachineTests::singlecore_fast_path_data() {
+    core_memory_tests_data();
+}
+
+void MachineTests::singlecore_fast_path() {
+    QFETCH(QVector<uint32_t>, code);
+    QFETCH(Registers, reg_init);
+    QFETCH(Memory, mem_init);
+
+    // Core with connected stage signal runs full path, the other one
+    // executes translated blocks. Both have to stay in lockstep.
+    for (bool delay_slot : { true, false }) {
+        auto make_single = [delay_slot](CoreFixture &f) {
+            return new CoreSingle(&f.regs, f.program(), f.data(), delay_slot);
+        };
+        auto make_observed = [&make_single](CoreFixture &f) {
+            Core *core = make_single(f);
+            QObject::connect(
+                core, &Core::instruction_fetched,
+                [](const Instruction &, Address, ExceptionCause, bool) {});
+            return core;
+        };
+        compare_core_variant(
+            code, reg_init, mem_init, nullptr, make_observed, make_single,
+            [](CoreFixture &full, CoreFixture &fast) {
+                for (int k = 0; k < 2000; k++) {
+                    full.core->step();
+                    fast.core->step();
+                    QCOMPARE(fast.regs, full.regs);
+                }
+                QCOMPARE(fast.core->get_cycle_count(), full.core->get_cycle_count());
+            });
+        if (QTest::currentTestFailed()) {
+            return;
+        }
+    }
+}
+
+void MachineTests::singlecore_jit_data() {
+    core_memory_tests_data();
+
+    Registers regs;
+    Memory mem(BIG);
+    {
+        QVector<uint32_t> code {
+            0x3c108002, // lui s0, 0x8002
+            0x36100400, // ori s0, s0, 0x400
+            0x241100c8, // addiu s1, zero, 200
+            0x3c197fff, // lui t9, 0x7fff
+            0x3739fff0, // ori t9, t9, 0xfff0
+            0x2628ff9c, // addiu t0, s1, -100
+            0x01110018, // mult t0, s1
+            0x00004810, // mfhi t1
+            0x00005012, // mflo t2
+            0x01110019, // multu t0, s1
+            0x00005810, // mfhi t3
+            0x00006012, // mflo t4
+            0x01000011, // mthi t0
+            0x01400013, // mtlo t2
+            0x00006810, // mfhi t5
+            0x000870c3, // sra t6, t0, 3
+            0x02287807, // srav t7, t0, s1
+            0x02289004, // sllv s2, t0, s1
+            0x02289806, // srlv s3, t0, s1
+            0x0111a02a, // slt s4, t0, s1
+            0x0111a82b, // sltu s5, t0, s1
+            0x2916fffb, // slti s6, t0, -5
+            0x2d170007, // sltiu s7, t0, 7
+            0x71111002, // mul v0, t0, s1
+            0x01111827, // nor v1, t0, s1
+            0x39048181, // xori a0, t0, 0x8181
+            0x3105f0f0, // andi a1, t0, 0xf0f0
+            0x3226001c, // andi a2, s1, 0x1c
+            0x00d03021, // addu a2, a2, s0
+            0xacca0000, // sw t2, 0(a2)
+            0xa4c80002, // sh t0, 2(a2)
+            0xa0d10001, // sb s1, 1(a2)
+            0x80c70000, // lb a3, 0(a2)
+            0x90da0001, // lbu k0, 1(a2)
+            0x84db0002, // lh k1, 2(a2)
+            0x94dc0000, // lhu gp, 0(a2)
+            0x8cde0000, // lw fp, 0(a2)
+            0x00471021, // addu v0, v0, a3
+            0x005a1021, // addu v0, v0, k0
+            0x005b1021, // addu v0, v0, k1
+            0x005c1021, // addu v0, v0, gp
+            0x005e1021, // addu v0, v0, fp
+            0x0331c820, // add t9, t9, s1
+            0x0c008036, // jal func
+            0x24630001, // addiu v1, v1, 1
+            0x05000003, // bltz t0, neg
+            0x2631ffff, // addiu s1, s1, -1
+            0x05010002, // bgez t0, pos
+            0x00000000, // nop
+            0x24630003, // addiu v1, v1, 3
+            0x1620ffd2, // bne s1, zero, loop
+            0x03a2e821, // addu sp, sp, v0
+            0x08008034, // j end
+            0x00000000, // nop
+            0x03e0f826, // xor ra, ra, zero
+            0x03e00008, // jr ra
+            0x24840005, // addiu a0, a0, 5
+        };
+        QTest::newRow("jit_alu_mem_mix") << code << regs << regs << mem << mem;
+    }
+    {
+        // Stores rewrite instructions of the running block, the instruction
+        // following the store and code of the called function.
+        QVector<uint32_t> code {
+            0x3c108002, // lui s0, 0x8002
+            0x24110028, // addiu s1, zero, 40
+            0x8e08001c, // lw t0, patch(s0)
+            0x25290001, // addiu t1, t1, 1
+            0x39080003, // xori t0, t0, 3
+            0xae08001c, // sw t0, patch(s0)
+            0x00000000, // nop
+            0x25290002, // addiu t1, t1, 2
+            0x8e0d002c, // lw t5, next(s0)
+            0x39ad0001, // xori t5, t5, 1
+            0xae0d002c, // sw t5, next(s0)
+            0x254a0001, // addiu t2, t2, 1
+            0x0c008013, // jal func
+            0xae090500, // sw t1, 0x500(s0)
+            0x2631ffff, // addiu s1, s1, -1
+            0x1620fff2, // bne s1, zero, loop
+            0x00000000, // nop
+            0x08008011, // j end
+            0x00000000, // nop
+            0x8e0b0058, // lw t3, fpatch(s0)
+            0x396b0001, // xori t3, t3, 1
+            0xae0b0058, // sw t3, fpatch(s0)
+            0x258c0001, // addiu t4, t4, 1
+            0x03e00008, // jr ra
+            0x00000000, // nop
+        };
+        QTest::newRow("jit_self_modifying") << code << regs << regs << mem << mem;
+    }
+}
+
+void MachineTests::singlecore_jit() {
+    QFETCH(QVector<uint32_t>, code);
+    QFETCH(Registers, reg_init);
+    QFETCH(Memory, mem_init);
+
+    // Reference core is observed and runs full path, the other one executes
+    // translated blocks by threaded dispatch or native code. Registers are
+    // compared after each executed chunk.
+    const Address end = reg_init.read_pc() + 4 * code.size();
+    for (bool native : { false, true }) {
+        if (native && !JitX86_64::available()) {
+            continue; // JIT is not supported on this host
+        }
+        for (bool delay_slot : { true, false }) {
+            auto make_observed = [delay_slot](CoreFixture &f) {
+                Core *core = new CoreSingle(&f.regs, f.program(), f.data(), delay_slot);
+                QObject::connect(
+                    core, &Core::instruction_fetched,
+                    [](const Instruction &, Address, ExceptionCause, bool) {});
+                return core;
+            };
+            auto make_block = [delay_slot, native](CoreFixture &f) {
+                auto *core = new CoreSingle(&f.regs, f.program(), f.data(), delay_slot);
+                core->set_jit(native);
+                return core;
+            };
+            compare_core_variant(
+                code, reg_init, mem_init, nullptr, make_observed, make_block,
+                [&end](CoreFixture &ref, CoreFixture &blk) {
+                    unsigned int chunk = 1;
+                    while (blk.core->get_cycle_count() < 20000) {
+                        unsigned int cycles = blk.core->step_block(chunk, end);
+                        QVERIFY(cycles >= 1 && cycles <= chunk);
+                        while (cycles--) {
+                            ref.core->step();
+                        }
+                        QCOMPARE(blk.regs, ref.regs);
+                        chunk = chunk % 97 + 13;
+                    }
+                    QCOMPARE(blk.core->get_cycle_count(), ref.core->get_cycle_count());
+                    QCOMPARE(blk.core->get_retired_count(), ref.core->get_retired_count());
+                });
+            if (QTest::currentTestFailed()) {
+                return;
+            }
+        }
+    }
+}
@@ -62,3 +62,53 @@ void MachineTests::instruction_access() {
 }
 
 // TODO test to_str
+
+// Flattened decode table has to give same result as instruction map walk
+void MachineTests::instruction_decode_table() {
+    uint32_t x = 1;
+    for (int n = 0; n < 1 << 20; n++) {
+        x = x * 1664525 + 1013904223;
+        Instruction i(x ^ (x >> 11));
+        enum InstructionFlags flags, flags_ref;
+        enum AluOp alu_op, alu_op_ref;
+        enum AccessControl mem_ctl, mem_ctl_ref;
+        i.flags_alu_op_mem_ctl(flags, alu_op, mem_ctl);
+        i.flags_alu_op_mem_ctl_tree_walk(flags_ref, alu_op_ref, mem_ctl_ref);
+        if (flags != flags_ref || alu_op != alu_op_ref || mem_ctl != mem_ctl_ref) {
+            QFAIL(qPrintable(QString("Decode mismatch for 0x%1").arg(i.data(), 8, 16, QChar('0'))));
+        }
+    }
+}
+
+void MachineTests::instruction_decode_benchmark_data() {
+    QTest::addColumn<bool>("tree_walk");
+    QTest::newRow("flat table") << false;
+    QTest::newRow("tree walk") << true;
+}
+
+void MachineTests::instruction_decode_benchmark() {
+    QFETCH(bool, tree_walk);
+    // Mix of ALU register, load and COP0 instructions exercises nested maps
+    QVector<Instruction> code;
+    uint32_t x = 1;
+    for (int n = 0; n < 4096; n++) {
+        x = x * 1664525 + 1013904223;
+        static const uint32_t opcodes[] = { 0x00, 0x23, 0x10, 0x09 };
+        code.append(Instruction((opcodes[n % 4] << 26) | (x & 0x03ffffff)));
+    }
+    unsigned int sum = 0;
+    enum InstructionFlags flags;
+    enum AluOp alu_op;
+    enum AccessControl mem_ctl;
+    QBENCHMARK {
+        for (const Instruction &i : code) {
+            if (tree_walk) {
+                i.flags_alu_op_mem_ctl_tree_walk(flags, alu_op, mem_ctl);
+            } else {
+                i.flags_alu_op_mem_ctl(flags, alu_op, mem_ctl);
+            }
+            sum += flags + alu_op + mem_ctl;
+        }
+    }
+    QVERIFY(sum != 0);
+}
@@ -0,0 +1,390 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*******************************************************************************
+ * QtMips - MIPS 32-bit Architecture Subset Simulator
+ *
+ * Implemented to support following courses:
+ *
+ *   B35APO - Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b35apo
+ *
+ *   B4M35PAP - Advanced Computer Architectures
+ *   https://cw.fel.cvut.cz/wiki/courses/b4m35pap/start
+ *
+ * Copyright (c) 2017-2019 Karel Koci<cynerd@email.cz>
+ * Copyright (c) 2019      Pavel Pisa <pisa@cmp.felk.cvut.cz>
+ *
+ * Faculty of Electrical Engineering (http://www.fel.cvut.cz)
+ * Czech Technical University        (http://www.cvut.cz/)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+
+#include "machine/machine.h"
+#include "machine/memory/memory_bus.h"
+#include "machine/memorytrace.h"
+#include "tst_machine.h"
+
+#include <QDir>
+#include <QFile>
+
+using namespace machine;
+
+using ae = machine::AccessEffects;
+
+// Straight sequence of "addiu k0,k0,1" placed at the reset program counter
+static void load_increment_sequence(Machine &machine, unsigned int count) {
+    Address addr = machine.registers()->read_pc();
+    for (unsigned int i = 0; i < count; i++) {
+        machine.memory_data_bus_rw()->write_u32(
+            addr, Instruction(9, 26, 26, 1).data(), ae::INTERNAL);
+        addr += 4;
+    }
+}
+
+// Loop storing incremented counter to consecutive words
+static void load_store_loop(Machine &machine) {
+    uint32_t code[] = {
+        Instruction(15, 0, 16, 0x8003).data(),   // lui s0,0x8003
+        Instruction(9, 26, 26, 1).data(),        // loop: addiu k0,k0,1
+        Instruction(43, 16, 26, 0).data(),       // sw k0,0(s0)
+        Instruction(9, 16, 16, 4).data(),        // addiu s0,s0,4
+        Instruction(4, 0, 0, 0xfffc).data(),     // beq zero,zero,loop
+        Instruction(0, 0, 0, 0, 0, 0).data(),    // nop
+    };
+    Address addr = machine.registers()->read_pc();
+    for (uint32_t word : code) {
+        machine.memory_data_bus_rw()->write_u32(addr, word, ae::INTERNAL);
+        addr += 4;
+    }
+}
+
+void MachineTests::machine_run_for() {
+    Machine machine(MachineConfig(), false, false);
+    load_increment_sequence(machine, 64);
+
+    QCOMPARE(machine.run_for(10), 10U);
+    QCOMPARE(machine.core()->get_cycle_count(), 10U);
+    QCOMPARE(machine.status(), Machine::ST_READY);
+
+    // Predicate is evaluated after every single step
+    machine.run_until([&machine]() { return machine.registers()->read_gp(26).as_u32() >= 20; });
+    QCOMPARE(machine.registers()->read_gp(26), RegisterValue(20));
+    QCOMPARE(machine.status(), Machine::ST_READY);
+}
+
+void MachineTests::machine_run_for_hwbreak() {
+    Machine machine(MachineConfig(), false, false);
+    load_increment_sequence(machine, 64);
+    machine.insert_hwbreak(machine.registers()->read_pc() + 4 * 20);
+
+    QVERIFY(machine.run_for(1000) < 1000);
+    QCOMPARE(machine.status(), Machine::ST_READY);
+    // Instruction at breakpoint is not executed
+    QCOMPARE(machine.registers()->read_gp(26), RegisterValue(20));
+}
+
+void MachineTests::machine_mapped_ram() {
+#ifndef __unix__
+    QSKIP("Mapped RAM is supported only on Unix hosts");
+#endif
+    MachineConfig config;
+    config.set_mapped_ram(true);
+    Machine machine(config, false, false);
+    QVERIFY(machine.memory() == nullptr);
+    load_increment_sequence(machine, 64);
+
+    machine.run_until([&machine]() { return machine.registers()->read_gp(26).as_u32() >= 30; });
+    QCOMPARE(machine.registers()->read_gp(26), RegisterValue(30));
+
+    // Without loaded executable restart clears whole RAM
+    machine.restart();
+    QCOMPARE(
+        machine.memory_data_bus()->read_u32(machine.registers()->read_pc(), ae::INTERNAL),
+        0U);
+}
+
+void MachineTests::machine_checkpoint_data() {
+    QTest::addColumn<bool>("pipelined");
+    QTest::newRow("single") << false;
+    QTest::newRow("pipelined") << true;
+}
+
+void MachineTests::machine_checkpoint() {
+    QFETCH(bool, pipelined);
+    MachineConfig config;
+    config.set_pipelined(pipelined);
+    CacheConfig cache;
+    cache.set_enabled(true);
+    cache.set_set_count(4);
+    cache.set_block_size(2);
+    cache.set_associativity(2);
+    cache.set_replacement_policy(CacheConfig::RP_LRU);
+    cache.set_write_policy(CacheConfig::WP_BACK);
+    config.set_cache_data(cache);
+    Machine machine(config, false, false);
+    load_store_loop(machine);
+
+    machine.run_for(100);
+    auto checkpoint = machine.checkpoint();
+    Registers regs_checkpoint(*machine.registers());
+    Memory mem_checkpoint(*machine.memory());
+
+    machine.run_for(300);
+    Registers regs_after(*machine.registers());
+    unsigned int cycles_after = machine.core()->get_cycle_count();
+    uint32_t hits_after = machine.cache_data()->get_hit_count();
+    uint32_t misses_after = machine.cache_data()->get_miss_count();
+    machine.cache_data_rw()->flush();
+    Memory mem_after(*machine.memory());
+
+    machine.restore(*checkpoint);
+    QCOMPARE(*machine.registers(), regs_checkpoint);
+    QCOMPARE(*machine.memory(), mem_checkpoint);
+    QCOMPARE(machine.core()->get_cycle_count(), 100U);
+
+    // Same continuation is simulated again
+    machine.run_for(300);
+    QCOMPARE(*machine.registers(), regs_after);
+    QCOMPARE(machine.core()->get_cycle_count(), cycles_after);
+    QCOMPARE(machine.cache_data()->get_hit_count(), hits_after);
+    QCOMPARE(machine.cache_data()->get_miss_count(), misses_after);
+    machine.cache_data_rw()->flush();
+    QCOMPARE(*machine.memory(), mem_after);
+}
+
+void MachineTests::machine_reverse_execution_data() {
+    QTest::addColumn<bool>("pipelined");
+    QTest::newRow("single") << false;
+    QTest::newRow("pipelined") << true;
+}
+
+void MachineTests::machine_reverse_execution() {
+    QFETCH(bool, pipelined);
+    MachineConfig config;
+    config.set_pipelined(pipelined);
+    CacheConfig cache;
+    cache.set_enabled(true);
+    cache.set_set_count(4);
+    cache.set_block_size(2);
+    cache.set_associativity(2);
+    cache.set_replacement_policy(CacheConfig::RP_LRU);
+    cache.set_write_policy(CacheConfig::WP_BACK);
+    config.set_cache_data(cache);
+    Machine machine(config, false, false);
+    load_store_loop(machine);
+    Registers regs_start(*machine.registers());
+    // Window of 512 cycles, the run below gets past it
+    machine.set_history(16, 32);
+
+    machine.run_for(50);
+    Registers regs_50(*machine.registers());
+    uint32_t hits_50 = machine.cache_data()->get_hit_count();
+    machine.run_for(300);
+    Registers regs_350(*machine.registers());
+
+    QVERIFY(machine.step_back(300));
+    QCOMPARE(machine.core()->get_cycle_count(), 50U);
+    QCOMPARE(*machine.registers(), regs_50);
+    QCOMPARE(machine.cache_data()->get_hit_count(), hits_50);
+    QVERIFY(machine.step_back(1));
+    QCOMPARE(machine.core()->get_cycle_count(), 49U);
+    machine.run_for(1);
+    QCOMPARE(*machine.registers(), regs_50);
+    machine.run_for(300);
+    QCOMPARE(*machine.registers(), regs_350);
+
+    // Breakpoint hits are repeated when the history is replayed
+    Address brk = regs_start.read_pc() + 8; // sw k0,0(s0)
+    machine.insert_hwbreak(brk);
+    machine.run_for(1000);
+    QCOMPARE(machine.registers()->read_pc(), brk);
+    unsigned int cycle_hit = machine.core()->get_cycle_count();
+    machine.step();
+    machine.run_for(1000);
+    QCOMPARE(machine.registers()->read_pc(), brk);
+    unsigned int cycle_hit2 = machine.core()->get_cycle_count();
+    machine.step();
+    machine.run_for(2);
+    Registers regs_past(*machine.registers());
+    unsigned int cycle_past = machine.core()->get_cycle_count();
+    machine.step();
+    machine.run_for(1000);
+    QCOMPARE(machine.registers()->read_pc(), brk);
+    QVERIFY(machine.step_back(machine.core()->get_cycle_count() - cycle_past));
+    QCOMPARE(machine.core()->get_cycle_count(), cycle_past);
+    QCOMPARE(*machine.registers(), regs_past);
+
+    // Run back stops in the same state as the forward run did
+    QVERIFY(machine.run_back());
+    QCOMPARE(machine.registers()->read_pc(), brk);
+    QCOMPARE(machine.core()->get_cycle_count(), cycle_hit2);
+    QVERIFY(machine.run_back());
+    QCOMPARE(machine.registers()->read_pc(), brk);
+    QCOMPARE(machine.core()->get_cycle_count(), cycle_hit);
+    machine.remove_hwbreak(brk);
+
+    // Snapshots older than the window are dropped
+    unsigned int cycle_now = machine.core()->get_cycle_count();
+    QVERIFY(!machine.run_back());
+    QVERIFY(machine.core()->get_cycle_count() > 0);
+    QVERIFY(machine.core()->get_cycle_count() + 16 * 32 >= cycle_now);
+    QCOMPARE(machine.status(), Machine::ST_READY);
+}
+
+void MachineTests::machine_reverse_execution_peripherals_data() {
+    QTest::addColumn<bool>("pipelined");
+    QTest::newRow("single") << false;
+    QTest::newRow("pipelined") << true;
+}
+
+void MachineTests::machine_reverse_execution_peripherals() {
+    QFETCH(bool, pipelined);
+    MachineConfig config;
+    config.set_pipelined(pipelined);
+    Machine machine(config, false, false);
+    // Echo of serial port input, sum of received bytes is kept in k0
+    uint32_t code[] = {
+        Instruction(15, 0, 16, 0xffff).data(),     // lui s0,0xffff
+        Instruction(35, 16, 8, 0).data(),          // loop: lw t0,0(s0)
+        Instruction(35, 16, 9, 4).data(),          // lw t1,4(s0)
+        Instruction(43, 16, 9, 12).data(),         // sw t1,12(s0)
+        Instruction(0, 26, 9, 26, 0, 0x21).data(), // addu k0,k0,t1
+        Instruction(4, 0, 0, 0xfffb).data(),       // beq zero,zero,loop
+        Instruction(0, 0, 0, 0, 0, 0).data(),      // nop
+    };
+    Address addr = machine.registers()->read_pc();
+    for (uint32_t word : code) {
+        machine.memory_data_bus_rw()->write_u32(addr, word, ae::INTERNAL);
+        addr += 4;
+    }
+    unsigned int received = 0;
+    unsigned int sent = 0;
+    QObject::connect(
+        machine.serial_port(), &SerialPort::rx_byte_pool,
+        [&received](int, unsigned int &data, bool &available) {
+            data = ++received & 0xff;
+            available = true;
+        });
+    QObject::connect(
+        machine.serial_port(), &SerialPort::tx_byte, [&sent](unsigned int) { sent++; });
+    machine.set_history(16, 32);
+
+    machine.run_for(50);
+    Registers regs_50(*machine.registers());
+    machine.run_for(300);
+    QVERIFY(received > 0);
+    QVERIFY(sent > 0);
+    unsigned int received_350 = received;
+    unsigned int sent_350 = sent;
+
+    // Input is not consumed and output is not repeated by reverse execution
+    QVERIFY(machine.step_back(300));
+    QCOMPARE(machine.core()->get_cycle_count(), 50U);
+    QCOMPARE(*machine.registers(), regs_50);
+    QCOMPARE(received, received_350);
+    QCOMPARE(sent, sent_350);
+
+    // Forward run after return reads new input
+    machine.run_for(300);
+    QVERIFY(received > received_350);
+    QVERIFY(sent > sent_350);
+    QVERIFY(machine.step_back(10));
+    QCOMPARE(machine.core()->get_cycle_count(), 340U);
+
+    // Reads older than the window are dropped, the rest is still replayed
+    machine.run_for(1600);
+    Registers regs_mid(*machine.registers());
+    machine.run_for(400);
+    unsigned int cycle_end = machine.core()->get_cycle_count();
+    unsigned int received_end = received;
+    QVERIFY(machine.step_back(400));
+    QCOMPARE(*machine.registers(), regs_mid);
+    QCOMPARE(received, received_end);
+    QVERIFY(machine.step_back(cycle_end));
+    QVERIFY(machine.core()->get_cycle_count() > 0);
+    QVERIFY(machine.core()->get_cycle_count() + 16 * 32 >= cycle_end);
+}
+
+void MachineTests::machine_memory_trace_data() {
+    QTest::addColumn<bool>("pipelined");
+    QTest::newRow("single") << false;
+    QTest::newRow("pipelined") << true;
+}
+
+void MachineTests::machine_memory_trace() {
+    QFETCH(bool, pipelined);
+    MachineConfig config;
+    config.set_pipelined(pipelined);
+    CacheConfig cache;
+    cache.set_enabled(true);
+    cache.set_set_count(2);
+    cache.set_block_size(2);
+    cache.set_associativity(2);
+    cache.set_replacement_policy(CacheConfig::RP_LRU);
+    cache.set_write_policy(CacheConfig::WP_BACK);
+    config.set_cache_program(cache);
+    config.set_cache_data(cache);
+    Machine machine(config, false, false);
+    load_store_loop(machine);
+    Address start = machine.registers()->read_pc();
+    QString path = QDir::tempPath() + "/qtmips_test_memory_trace.bin";
+
+    uint64_t records;
+    {
+        MemoryTraceWriter writer(path, machine.core());
+        writer.attach(machine.cache_program_rw(), machine.cache_data_rw());
+        machine.run_for(200);
+        machine.cache_program_rw()->set_access_sink(nullptr);
+        machine.cache_data_rw()->set_access_sink(nullptr);
+        records = writer.get_record_count();
+    }
+
+    MemoryTraceReader reader(path);
+    MemoryTraceRecord rec;
+    QVERIFY(reader.next(rec));
+    QCOMPARE(rec.kind, MTK_FETCH);
+    QCOMPARE(rec.pc, start);
+    QCOMPARE(rec.address, start);
+    QCOMPARE(rec.size, 4U);
+    QCOMPARE(rec.cycle, 1U);
+    do {
+        QVERIFY(reader.next(rec));
+    } while (rec.kind == MTK_FETCH);
+    QCOMPARE(rec.kind, MTK_STORE);
+    QCOMPARE(rec.pc, start + 8);
+    QCOMPARE(rec.address, 0x80030000_addr);
+
+    // Replay reproduces statistics of caches without running the program
+    Memory mem(BIG);
+    TrivialBus bus(&mem);
+    Cache program(
+        &bus, &config.cache_program(), config.memory_access_time_read(),
+        config.memory_access_time_write(), config.memory_access_time_burst());
+    Cache data(
+        &bus, &config.cache_data(), config.memory_access_time_read(),
+        config.memory_access_time_write(), config.memory_access_time_burst());
+    QCOMPARE(MemoryTraceReader(path).replay(&program, &data), records);
+    QCOMPARE(program.get_hit_count(), machine.cache_program()->get_hit_count());
+    QCOMPARE(program.get_miss_count(), machine.cache_program()->get_miss_count());
+    QCOMPARE(data.get_hit_count(), machine.cache_data()->get_hit_count());
+    QCOMPARE(data.get_miss_count(), machine.cache_data()->get_miss_count());
+    QCOMPARE(data.get_read_count(), machine.cache_data()->get_read_count());
+    QCOMPARE(data.get_write_count(), machine.cache_data()->get_write_count());
+    QCOMPARE(data.get_stall_count(), machine.cache_data()->get_stall_count());
+    QFile::remove(path);
+}
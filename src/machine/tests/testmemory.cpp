@@ -35,12 +35,15 @@
 
 #include "common/endian.h"
 #include "machine/machinedefs.h"
+#include "machine/memory/backend/mappedram.h"
 #include "machine/memory/backend/memory.h"
 #include "machine/memory/memory_bus.h"
 #include "machine/memory/memory_utils.h"
 #include "tests/utils/integer_decomposition.h"
 #include "tst_machine.h"
 
+#include <memory>
+
 using namespace machine;
 
 // Default memory testing data. Some tests may use other values, where it
@@ -378,3 +381,190 @@ void MachineTests::memory_read_ctl() {
             (int8_t)result.u8.at(i));
     }
 }
+
+void MachineTests::memory_section_cache() {
+    Memory mem(BIG);
+    Memory other(BIG);
+    memory_write_u32(&mem, 0x100, 0x11223344);
+    memory_write_u32(&other, 0x100, 0x55667788);
+    QCOMPARE(memory_read_u32(&mem, 0x100), (uint32_t)0x11223344);
+
+    // Sections remembered by lookup cache are freed by reset
+    mem.reset(other);
+    QCOMPARE(memory_read_u32(&mem, 0x100), (uint32_t)0x55667788);
+    memory_write_u32(&mem, 0x100, 0x99aabbcc);
+    QCOMPARE(memory_read_u32(&other, 0x100), (uint32_t)0x55667788);
+    mem.reset();
+    QCOMPARE(memory_read_u32(&mem, 0x100), (uint32_t)0);
+
+    // Addresses aliasing in the cache have to resolve to own sections
+    const Offset alias = 0x100 + MEMORY_SECTION_SIZE * MEMORY_SECTION_CACHE_SIZE;
+    memory_write_u32(&mem, 0x100, 1);
+    memory_write_u32(&mem, alias, 2);
+    QCOMPARE(memory_read_u32(&mem, 0x100), (uint32_t)1);
+    QCOMPARE(memory_read_u32(&mem, alias), (uint32_t)2);
+}
+
+void MachineTests::memory_read_benchmark() {
+    Memory mem(LITTLE);
+    TrivialBus bus(&mem);
+    for (uint32_t addr = 0; addr < 0x4000; addr += 4) {
+        memory_write_u32(&mem, 0x80020000 + addr, addr);
+    }
+    uint32_t sum = 0;
+    QBENCHMARK {
+        for (uint32_t addr = 0; addr < 0x4000; addr += 4) {
+            sum += bus.read_u32(Address(0x80020000 + addr));
+        }
+    }
+    QVERIFY(sum != 0);
+}
+
+void MachineTests::memory_mapped_ram() {
+#ifndef __unix__
+    QSKIP("Mapped RAM is supported only on Unix hosts");
+#endif
+    for (auto endian : default_endians) {
+        MappedRam ram(endian, 0x100000);
+        Memory mem(endian);
+        TrivialBus ram_bus(&ram);
+        TrivialBus mem_bus(&mem);
+
+        // Accesses crossing 256 B sections of tree memory give same data
+        for (Offset offset : { 0x0, 0xfc, 0xfe, 0xff, 0x1234, 0xffff8 }) {
+            ram_bus.write_u64(Address(offset), 0x0102030405060708ULL);
+            mem_bus.write_u64(Address(offset), 0x0102030405060708ULL);
+        }
+        for (Offset offset = 0; offset < 0x1300; offset++) {
+            QCOMPARE(ram_bus.read_u32(Address(offset)), mem_bus.read_u32(Address(offset)));
+        }
+        QCOMPARE(
+            ram_bus.read_u64(Address(0xffff8)), mem_bus.read_u64(Address(0xffff8)));
+
+        ram.reset();
+        QCOMPARE(ram_bus.read_u64(Address(0x1234)), (uint64_t)0);
+
+        // Content of tree memory is copied, other ranges stay zero
+        memory_write_u32(&ram, 0x8000, 0xdeadbeef);
+        ram.reset(mem);
+        QCOMPARE(memory_read_u32(&ram, 0x8000), (uint32_t)0);
+        for (Offset offset = 0; offset < 0x1300; offset++) {
+            QCOMPARE(memory_read_u8(&ram, offset), memory_read_u8(&mem, offset));
+        }
+        QVERIFY(ram.direct_access(0xffffc, 4) != nullptr);
+        QVERIFY(ram.direct_access(0xffffc, 8) == nullptr);
+    }
+}
+
+void MachineTests::memory_bus_lookup() {
+#ifndef __unix__
+    QSKIP("Mapped RAM is supported only on Unix hosts");
+#endif
+    MemoryDataBus bus(BIG);
+    Memory mem(BIG);
+    Memory small(BIG);
+    MappedRam ram(BIG, 0x10000);
+    QVERIFY(bus.insert_device_to_range(&mem, 0x0_addr, 0xfffff_addr, false));
+    // Not aligned to lookup table chunk, uses second level pages
+    QVERIFY(bus.insert_device_to_range(&ram, 0x100000_addr, 0x10ffff_addr, false));
+    // Shares page with unmapped space
+    QVERIFY(bus.insert_device_to_range(&small, 0x110010_addr, 0x11001f_addr, false));
+    QVERIFY(!bus.insert_device_to_range(&small, 0x10fff0_addr, 0x110000_addr, false));
+
+    bus.write_u32(0xfff00_addr, 0x01020304);
+    bus.write_u32(0x100ffe_addr, 0x05060708); // Crosses page of direct map
+    bus.write_u32(0x110014_addr, 0x090a0b0c);
+    bus.write_u32(0x110020_addr, 0x0d0e0f10); // Unmapped, ignored
+    QCOMPARE(memory_read_u32(&mem, 0xfff00), (uint32_t)0x01020304);
+    QCOMPARE(memory_read_u32(&ram, 0xffe), (uint32_t)0x05060708);
+    QCOMPARE(memory_read_u32(&small, 0x4), (uint32_t)0x090a0b0c);
+    QCOMPARE(bus.read_u32(0x100ffe_addr), (uint32_t)0x05060708);
+    QCOMPARE(bus.read_u32(0x110014_addr), (uint32_t)0x090a0b0c);
+    QCOMPARE(bus.read_u32(0x110020_addr), (uint32_t)0);
+    QCOMPARE(bus.location_status(0x110020_addr), LOCSTAT_ILLEGAL);
+
+    uint32_t changes = bus.get_change_counter();
+    bus.write_u32(0x100100_addr, 0x11121314);
+    bus.write_u32(0x100100_addr, 0x11121314);
+    QCOMPARE(bus.get_change_counter(), changes + 1);
+    QVERIFY(bus.direct_access(0x100100_addr, 4) != nullptr);
+
+    // Ranges change at runtime
+    QVERIFY(bus.remove_device(&ram));
+    QCOMPARE(bus.read_u32(0x100100_addr), (uint32_t)0);
+    QVERIFY(bus.direct_access(0x100100_addr, 4) == nullptr);
+    QVERIFY(bus.insert_device_to_range(&ram, 0x400000_addr, 0x40ffff_addr, false));
+    QCOMPARE(bus.read_u32(0x400100_addr), (uint32_t)0x11121314);
+    bus.clean_range(0x110000_addr, 0x110fff_addr);
+    QCOMPARE(bus.read_u32(0x110014_addr), (uint32_t)0);
+    QCOMPARE(bus.read_u32(0xfff00_addr), (uint32_t)0x01020304);
+}
+
+void MachineTests::memory_copy_on_write() {
+    Memory image(BIG);
+    memory_write_u32(&image, 0x100, 0x11223344);
+    memory_write_u32(&image, 0x80000200, 0x55667788);
+
+    // Copy shares sections until they are written
+    Memory mem(image);
+    QCOMPARE(mem.get_section(0x100, false), image.get_section(0x100, false));
+    memory_write_u32(&mem, 0x104, 0x99aabbcc);
+    QVERIFY(mem.get_section(0x100, false) != image.get_section(0x100, false));
+    QCOMPARE(memory_read_u32(&image, 0x104), (uint32_t)0);
+    QCOMPARE(memory_read_u32(&mem, 0x100), (uint32_t)0x11223344);
+    QCOMPARE(mem.get_section(0x80000200, false), image.get_section(0x80000200, false));
+
+    // Read only pointer keeps the section shared
+    const byte *shared = mem.direct_read(0x80000200, 4);
+    QVERIFY(shared != nullptr);
+    QCOMPARE(mem.get_section(0x80000200, false), image.get_section(0x80000200, false));
+    QCOMPARE(shared, image.direct_read(0x80000200, 4));
+
+    // Direct pointer may be written, it cannot point to shared data
+    byte *direct = mem.direct_access(0x80000200, 4);
+    QVERIFY(direct != nullptr);
+    QVERIFY(mem.get_section(0x80000200, false) != image.get_section(0x80000200, false));
+    memset(direct, 0, 4);
+    QCOMPARE(memory_read_u32(&image, 0x80000200), (uint32_t)0x55667788);
+
+    // Reset shares sections again and drops ones missing in the image
+    memory_write_u32(&mem, 0x4000, 1);
+    mem.reset(image);
+    QCOMPARE(mem, image);
+    QCOMPARE(mem.get_section(0x100, false), image.get_section(0x100, false));
+    QVERIFY(mem.get_section(0x4000, false) == nullptr);
+    QCOMPARE(memory_read_u32(&mem, 0x80000200), (uint32_t)0x55667788);
+}
+
+void MachineTests::memory_image_cache() {
+    int loads = 0;
+    auto load = [&loads](Memory *image) {
+        loads++;
+        memory_write_u32(image, 0x80020000, 0x11223344 + loads);
+    };
+    std::shared_ptr<const Memory> first = MemoryImageCache::image("first", BIG, load);
+    std::shared_ptr<const Memory> second = MemoryImageCache::image("first", BIG, load);
+    QCOMPARE(loads, 1);
+    QVERIFY(first == second);
+    QCOMPARE(memory_read_u32(second.get(), 0x80020000), (uint32_t)0x11223345);
+    // Copies share sections of the cached image
+    Memory copy(*first);
+    QCOMPARE(copy.get_section(0x80020000, false), second->get_section(0x80020000, false));
+    memory_write_u32(&copy, 0x80020000, 0);
+    QCOMPARE(memory_read_u32(second.get(), 0x80020000), (uint32_t)0x11223345);
+
+    // Different content or endian is loaded again
+    std::shared_ptr<const Memory> other = MemoryImageCache::image("second", BIG, load);
+    QCOMPARE(loads, 2);
+    QCOMPARE(memory_read_u32(other.get(), 0x80020000), (uint32_t)0x11223346);
+    std::shared_ptr<const Memory> little = MemoryImageCache::image("first", LITTLE, load);
+    QCOMPARE(loads, 3);
+
+    // Image is released with its last user
+    std::weak_ptr<const Memory> released = first;
+    first.reset();
+    second.reset();
+    QVERIFY(released.expired());
+    MemoryImageCache::image("first", BIG, load);
+    QCOMPARE(loads, 4);
+}
@@ -39,7 +39,8 @@ SOURCES += tst_machine.cpp \
     testinstruction.cpp \
     testalu.cpp \
     testcore.cpp \
-    testcache.cpp
+    testcache.cpp \
+    testmachine.cpp
 
 HEADERS += tst_machine.h \
            utils/integer_decomposition.h  \
@@ -61,11 +61,20 @@ private Q_SLOTS:
     static void memory_write_ctl();
     static void memory_read_ctl_data();
     static void memory_read_ctl();
+    static void memory_section_cache();
+    static void memory_read_benchmark();
+    static void memory_mapped_ram();
+    static void memory_bus_lookup();
+    static void memory_copy_on_write();
+    static void memory_image_cache();
     // Program loader
     void program_loader();
     // Instruction
     void instruction();
     void instruction_access();
+    void instruction_decode_table();
+    void instruction_decode_benchmark();
+    void instruction_decode_benchmark_data();
     // Alu
     void alu();
     void alu_data();
@@ -79,6 +88,12 @@ private Q_SLOTS:
     static void cache();
     static void cache_correctness_data();
     static void cache_correctness();
+    static void cache_sweep();
+    static void cache_hierarchy_data();
+    static void cache_hierarchy();
+    static void cache_hierarchy_inclusion();
+    static void cache_prefetch_data();
+    static void cache_prefetch();
     // Core
     void singlecore_regs();
     void singlecore_regs_data();
@@ -108,6 +123,35 @@ private Q_SLOTS:
     void pipecore_wt_na_memory_tests();
     void pipecore_wt_a_memory_tests();
     void pipecore_wb_memory_tests();
+    void pipecore_memory_stalls();
+    void pipecore_memory_stalls_data();
+    void pipecore_branch_predictor();
+    void pipecore_branch_predictor_data();
+    void pipecore_branch_predictor_accuracy();
+    void pipecore_branch_predictor_accuracy_data();
+    void core_profiler();
+    void core_profiler_data();
+    void core_call_graph();
+    void core_call_graph_data();
+    void core_perf_counters();
+    void core_perf_counters_data();
+    void singlecore_self_modifying_code();
+    void singlecore_fast_path();
+    void singlecore_fast_path_data();
+    void singlecore_jit();
+    void singlecore_jit_data();
+    // Machine
+    void machine_run_for();
+    void machine_run_for_hwbreak();
+    void machine_mapped_ram();
+    void machine_checkpoint();
+    void machine_checkpoint_data();
+    void machine_reverse_execution();
+    void machine_reverse_execution_data();
+    void machine_reverse_execution_peripherals();
+    void machine_reverse_execution_peripherals_data();
+    void machine_memory_trace();
+    void machine_memory_trace_data();
 };
 
 #endif // TST_MACHINE_H